@@ -0,0 +1,164 @@
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <numbers>
+#include <random>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/ext/matrix_clip_space.hpp>
+#include <glm/ext/matrix_transform.hpp>
+
+#include <pf_gl/BoundingVolumeHierarchy.hpp>
+#include <pf_gl/BoundingVolumes.hpp>
+#include <pf_gl/Frustum.hpp>
+#include <pf_gl/ValueTypes.hpp>
+
+using pf::gl::BoundingBox;
+using pf::gl::BoundingSphere;
+using pf::gl::BoundingVolumeHierarchy;
+using pf::gl::Frustum;
+using pf::gl::Ray;
+using pf::gl::types::Float;
+using pf::gl::types::FVec3;
+using pf::gl::types::UInt;
+
+std::array<size_t, 3> const OBJECTS_COUNTS = {1'000, 100'000, 1'000'000};
+size_t const QUERIES_COUNT = 100;
+
+/**
+ * Objects are spread with the same density regardless of their count, so that the queries of a
+ * fixed size return roughly the same number of objects.
+ */
+std::vector<BoundingBox> generateBoxes(size_t count, std::mt19937 &randomEngine)
+{
+    auto worldSize = 10.0F * std::cbrt(static_cast<Float>(count));
+    std::uniform_real_distribution<Float> position(-worldSize / 2.0F, worldSize / 2.0F);
+    std::uniform_real_distribution<Float> size(0.5F, 2.0F);
+
+    std::vector<BoundingBox> boxes;
+    boxes.reserve(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        FVec3 min(position(randomEngine), position(randomEngine), position(randomEngine));
+        boxes.push_back({.min = min, .max = min + FVec3(size(randomEngine))});
+    }
+    return boxes;
+}
+
+template <typename Function>
+double measureMilliseconds(Function &&function)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+    function();
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+void printResult(size_t objectsCount, char const *name, double milliseconds)
+{
+    std::cout << std::setw(10) << objectsCount << "  " << std::left << std::setw(28) << name
+              << std::right << std::setw(12) << std::fixed << std::setprecision(3) << milliseconds
+              << " ms" << std::endl;
+}
+
+void benchmark(size_t objectsCount)
+{
+    std::mt19937 randomEngine(42);
+    std::vector<BoundingBox> boxes = generateBoxes(objectsCount, randomEngine);
+    std::vector<UInt> proxies(objectsCount);
+
+    BoundingVolumeHierarchy tree;
+
+    printResult(objectsCount,
+                "build (incremental)",
+                measureMilliseconds(
+                    [&]
+                    {
+                        for (size_t i = 0; i < objectsCount; i++)
+                        {
+                            proxies[i] = tree.insert(boxes[i], static_cast<UInt>(i));
+                        }
+                    }));
+
+    printResult(objectsCount, "build (binned SAH)", measureMilliseconds([&] { tree.rebuild(); }));
+
+    // Most of the objects stay inside of their fat boxes, some of them are reinserted
+    std::uniform_real_distribution<Float> offset(-0.15F, 0.15F);
+    for (auto &box : boxes)
+    {
+        FVec3 shift(offset(randomEngine), offset(randomEngine), offset(randomEngine));
+        box = {.min = box.min + shift, .max = box.max + shift};
+    }
+    printResult(objectsCount,
+                "refit (move all objects)",
+                measureMilliseconds(
+                    [&]
+                    {
+                        for (size_t i = 0; i < objectsCount; i++)
+                        {
+                            tree.move(proxies[i], boxes[i]);
+                        }
+                    }));
+
+    auto projection =
+        glm::perspective(std::numbers::pi_v<Float> / 3.0F, 16.0F / 9.0F, 0.1F, 100.0F);
+    std::vector<UInt> result;
+    std::uniform_real_distribution<Float> angle(0.0F, 2.0F * std::numbers::pi_v<Float>);
+
+    printResult(objectsCount,
+                "frustum query (per query)",
+                measureMilliseconds(
+                    [&]
+                    {
+                        for (size_t i = 0; i < QUERIES_COUNT; i++)
+                        {
+                            Float yaw = angle(randomEngine);
+                            FVec3 target(std::cos(yaw), 0.0F, std::sin(yaw));
+                            auto view = glm::lookAt(FVec3(0.0F), target, FVec3(0.0F, 1.0F, 0.0F));
+                            result.clear();
+                            tree.queryFrustum(Frustum(projection * view), result);
+                        }
+                    }) / QUERIES_COUNT);
+
+    printResult(objectsCount,
+                "sphere query (per query)",
+                measureMilliseconds(
+                    [&]
+                    {
+                        for (size_t i = 0; i < QUERIES_COUNT; i++)
+                        {
+                            result.clear();
+                            tree.querySphere({.center = boxes[i].center(), .radius = 10.0F},
+                                             result);
+                        }
+                    }) / QUERIES_COUNT);
+
+    printResult(objectsCount,
+                "raycast (per query)",
+                measureMilliseconds(
+                    [&]
+                    {
+                        for (size_t i = 0; i < QUERIES_COUNT; i++)
+                        {
+                            Float yaw = angle(randomEngine);
+                            Ray ray = {
+                                .origin = FVec3(0.0F),
+                                .direction = FVec3(std::cos(yaw), 0.1F, std::sin(yaw)),
+                            };
+                            [[maybe_unused]] auto hit = tree.raycast(ray);
+                        }
+                    }) / QUERIES_COUNT);
+}
+
+int main(int /*argc*/, char const ** /*argv*/)
+{
+    for (auto objectsCount : OBJECTS_COUNTS)
+    {
+        benchmark(objectsCount);
+    }
+    return 0;
+}
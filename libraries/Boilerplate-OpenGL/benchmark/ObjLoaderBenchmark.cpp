@@ -0,0 +1,124 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <thread>
+
+#include <pf_gl/ModelImporter.hpp>
+#include <pf_gl/ObjLoader.hpp>
+#include <pf_gl/ValueTypes.hpp>
+
+using pf::gl::ModelImporter;
+using pf::gl::ObjLoader;
+using pf::gl::types::Size;
+using pf::gl::types::UInt;
+
+std::array<UInt, 3> const GRID_SIZES = {64, 256, 512};
+size_t const REPETITIONS_COUNT = 3;
+
+/**
+ * A wavy grid of quads with all three attributes, written the way Blender writes them.
+ */
+std::filesystem::path writeGrid(UInt size)
+{
+    auto path = std::filesystem::temp_directory_path() /
+                ("pf-gl-obj-benchmark-" + std::to_string(size) + ".obj");
+    std::ofstream file(path);
+    file << std::fixed << std::setprecision(6);
+
+    for (UInt y = 0; y <= size; y++)
+    {
+        for (UInt x = 0; x <= size; x++)
+        {
+            auto u = static_cast<float>(x) / static_cast<float>(size);
+            auto v = static_cast<float>(y) / static_cast<float>(size);
+            file << "v " << u << " " << 0.1F * std::sin(10.0F * u) * std::cos(10.0F * v) << " "
+                 << v << "\n";
+            file << "vt " << u << " " << v << "\n";
+            file << "vn " << -std::cos(10.0F * u) << " 1.000000 " << std::sin(10.0F * v) << "\n";
+        }
+    }
+    for (UInt y = 0; y < size; y++)
+    {
+        for (UInt x = 0; x < size; x++)
+        {
+            UInt first = y * (size + 1) + x + 1;
+            file << "f";
+            for (UInt corner : {first, first + 1, first + size + 2, first + size + 1})
+            {
+                file << " " << corner << "/" << corner << "/" << corner;
+            }
+            file << "\n";
+        }
+    }
+    return path;
+}
+
+/**
+ * The best of several runs, the first one warms up the file cache.
+ */
+template <typename Function>
+double measureMilliseconds(Function &&function)
+{
+    double best = std::numeric_limits<double>::max();
+    for (size_t i = 0; i < REPETITIONS_COUNT; i++)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        function();
+        auto end = std::chrono::high_resolution_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    return best;
+}
+
+void printResult(std::uintmax_t fileSize, char const *name, double milliseconds)
+{
+    double megabytes = static_cast<double>(fileSize) / (1024.0 * 1024.0);
+    std::cout << std::setw(10) << std::fixed << std::setprecision(2) << megabytes << " MB  "
+              << std::left << std::setw(28) << name << std::right << std::setw(12)
+              << std::setprecision(3) << milliseconds << " ms" << std::setw(12)
+              << std::setprecision(1) << megabytes / (milliseconds / 1000.0) << " MB/s"
+              << std::endl;
+}
+
+void benchmark(std::filesystem::path const &path)
+{
+    auto fileSize = std::filesystem::file_size(path);
+    auto threadsCount = static_cast<Size>(std::thread::hardware_concurrency());
+
+    printResult(fileSize,
+                "native (1 thread)",
+                measureMilliseconds(
+                    [&] { [[maybe_unused]] auto meshes = ObjLoader::load(path, 1); }));
+    printResult(fileSize,
+                "native (all threads)",
+                measureMilliseconds(
+                    [&] { [[maybe_unused]] auto meshes = ObjLoader::load(path, threadsCount); }));
+    printResult(fileSize,
+                "assimp",
+                measureMilliseconds(
+                    [&]
+                    {
+                        [[maybe_unused]] auto meshes =
+                            ModelImporter::parse(path, ModelImporter::ASSIMP_PARSER);
+                    }));
+}
+
+int main(int /*argc*/, char const ** /*argv*/)
+{
+    for (auto size : GRID_SIZES)
+    {
+        auto path = writeGrid(size);
+        benchmark(path);
+        std::filesystem::remove(path);
+    }
+    return 0;
+}
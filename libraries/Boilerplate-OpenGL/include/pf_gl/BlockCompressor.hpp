@@ -0,0 +1,84 @@
+#ifndef BLOCK_COMPRESSOR_HPP
+#define BLOCK_COMPRESSOR_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <pf_gl/Image.hpp>
+#include <pf_gl/ValueTypes.hpp>
+
+namespace pf::gl
+{
+
+/**
+ * CPU encoder of the block compressed texture formats, meant for the offline cooking. Each 4x4
+ * block of texels is encoded on its own, so the rows of blocks are spread over several threads.
+ *
+ * The colors are fitted along the principal axis of the block and then refined with least squares
+ * against the chosen indices. It is not as thorough as the dedicated encoders, but it is fast and
+ * the quality is close enough for the diffuse and specular maps.
+ */
+class BlockCompressor final
+{
+public:
+    static types::Int constexpr BLOCK_WIDTH = 4;
+    static types::Int constexpr BLOCK_HEIGHT = 4;
+
+    enum Format : types::UInt
+    {
+        /**
+         * RGB in 8 bytes per block, the alpha is dropped.
+         */
+        BC1,
+
+        /**
+         * RGBA in 16 bytes per block, the alpha is encoded separately from the colors.
+         */
+        BC3,
+
+        /**
+         * Red and green channels in 16 bytes per block, each encoded separately, meant for the
+         * normal maps.
+         */
+        BC5,
+
+        /**
+         * RGBA in 16 bytes per block, noticeably better than BC3. Only the single subset mode 6 is
+         * used by the encoder.
+         */
+        BC7,
+    };
+
+    /**
+     * RGBA texels of a block, row by row.
+     */
+    using Block = std::array<std::uint8_t, BLOCK_WIDTH * BLOCK_HEIGHT * Image::CHANNELS_COUNT>;
+
+    [[nodiscard]] static size_t blockSize(Format format);
+
+    /**
+     * Partial blocks on the right and bottom edges take up as much as the whole ones.
+     */
+    [[nodiscard]] static size_t
+    compressedSize(Format format, types::Size width, types::Size height);
+
+    /**
+     * Blocks are stored row by row. Partial blocks are padded by repeating the edge texels.
+     *
+     * @param threadsCount Zero stands for the number of hardware threads.
+     */
+    [[nodiscard]] static std::vector<std::byte>
+    compress(Image const &image, Format format, types::Size threadsCount = 0);
+
+    /**
+     * @throws std::invalid_argument in case the destination is smaller than the block size.
+     */
+    static void compressBlock(Block const &texels, Format format, std::span<std::byte> destination);
+};
+
+} // namespace pf::gl
+
+#endif // !BLOCK_COMPRESSOR_HPP
@@ -0,0 +1,146 @@
+#ifndef BOUNDING_VOLUME_HIERARCHY_HPP
+#define BOUNDING_VOLUME_HIERARCHY_HPP
+
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include <pf_gl/BoundingVolumes.hpp>
+#include <pf_gl/Frustum.hpp>
+#include <pf_gl/ValueTypes.hpp>
+
+namespace pf::gl
+{
+
+/**
+ * Dynamic AABB tree over scene objects. Every object is stored in a leaf together with its "fat"
+ * box (the actual box expanded by a margin), so that an object which moves a bit does not change
+ * the tree at all. Objects leaving their fat boxes are reinserted, the insertion picks the sibling
+ * by the surface area heuristic and keeps the tree balanced with rotations.
+ *
+ * After a lot of objects have been inserted or moved, the quality of the tree can be restored by
+ * rebuilding it from scratch with the binned SAH.
+ */
+class BoundingVolumeHierarchy final
+{
+public:
+    static types::UInt constexpr NULL_NODE = std::numeric_limits<types::UInt>::max();
+    static types::Float constexpr DEFAULT_FAT_MARGIN = 0.1F;
+
+    struct RayHit
+    {
+        types::UInt userData;
+        types::Float distance;
+    };
+
+    explicit BoundingVolumeHierarchy(types::Float fatMargin = DEFAULT_FAT_MARGIN);
+
+    /**
+     * Returns the proxy of the object, which stays valid until the object is removed (rebuilding
+     * the tree does not invalidate it).
+     */
+    types::UInt insert(BoundingBox const &box, types::UInt userData);
+    void remove(types::UInt proxy);
+
+    /**
+     * Updates the box of the object. Returns true in case the new box is not inside of the fat box
+     * anymore and the object has been reinserted.
+     */
+    bool move(types::UInt proxy, BoundingBox const &box);
+
+    void rebuild();
+    void clear();
+
+    /**
+     * Appends user data of the objects intersecting the frustum to the `result`. Subtrees which are
+     * completely inside of the frustum are appended without any further tests.
+     */
+    void queryFrustum(Frustum const &frustum, std::vector<types::UInt> &result) const;
+    void querySphere(BoundingSphere const &sphere, std::vector<types::UInt> &result) const;
+
+    /**
+     * Returns the closest object whose box is hit by the ray.
+     */
+    [[nodiscard]] std::optional<RayHit>
+    raycast(Ray const &ray,
+            types::Float maxDistance = std::numeric_limits<types::Float>::max()) const;
+
+    [[nodiscard]] types::UInt userData(types::UInt proxy) const;
+    [[nodiscard]] BoundingBox const &boundingBox(types::UInt proxy) const;
+    [[nodiscard]] BoundingBox const &fatBoundingBox(types::UInt proxy) const;
+
+    [[nodiscard]] types::Size size() const;
+    [[nodiscard]] types::Int height() const;
+
+private:
+    struct Node
+    {
+        /**
+         * Fat box for the leaves.
+         */
+        BoundingBox box;
+
+        /**
+         * Actual box of the object, only valid for the leaves.
+         */
+        BoundingBox objectBox;
+
+        /**
+         * Next free node in case the node is not used.
+         */
+        types::UInt parent = NULL_NODE;
+        types::UInt left = NULL_NODE;
+        types::UInt right = NULL_NODE;
+
+        /**
+         * Zero for the leaves, -1 for the free nodes.
+         */
+        types::Int height = -1;
+        types::UInt userData = 0;
+
+        [[nodiscard]] bool isLeaf() const
+        {
+            return left == NULL_NODE;
+        }
+    };
+
+    static size_t constexpr SAH_BINS_COUNT = 16;
+
+    types::Float _fatMargin;
+    std::vector<Node> _nodes;
+    types::UInt _root = NULL_NODE;
+    types::UInt _freeList = NULL_NODE;
+    types::Size _leavesCount = 0;
+
+    types::UInt allocateNode();
+    void freeNode(types::UInt node);
+
+    void insertLeaf(types::UInt leaf);
+    void removeLeaf(types::UInt leaf);
+
+    /**
+     * Refits the boxes and the heights from the node up to the root, rebalancing along the way.
+     */
+    void refitUpwards(types::UInt node);
+
+    /**
+     * Performs a left or right rotation in case the node is imbalanced, returns the index of the
+     * node which has taken its place.
+     */
+    types::UInt balance(types::UInt node);
+
+    /**
+     * Builds the subtree from the passed leaves, returns the root of the subtree. Centroids of the
+     * leaves' boxes are indexed by the node indices.
+     */
+    types::UInt buildSubtree(std::span<types::UInt> leaves,
+                             std::span<types::FVec3 const> centroids);
+
+    void validateProxy(types::UInt proxy) const;
+};
+
+} // namespace pf::gl
+
+#endif // !BOUNDING_VOLUME_HIERARCHY_HPP
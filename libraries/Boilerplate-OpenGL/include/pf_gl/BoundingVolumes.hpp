@@ -0,0 +1,108 @@
+#ifndef BOUNDING_VOLUMES_HPP
+#define BOUNDING_VOLUMES_HPP
+
+#include <cstddef>
+#include <optional>
+#include <span>
+
+#include <pf_gl/ValueTypes.hpp>
+
+namespace pf::gl
+{
+
+/**
+ * Positions interleaved with the rest of the vertex data, `stride` bytes apart. The positions do
+ * not have to be aligned.
+ */
+struct StridedPoints
+{
+    std::byte const *first;
+    size_t count;
+    size_t stride;
+
+    [[nodiscard]] types::FVec3 operator[](size_t index) const;
+};
+
+/**
+ * Axis-aligned bounding box. An empty box has its minimum corner greater than its maximum corner,
+ * so that merging anything into it yields the merged volume itself.
+ */
+struct BoundingBox
+{
+    types::FVec3 min;
+    types::FVec3 max;
+
+    static BoundingBox const EMPTY;
+
+    /**
+     * A box which contains everything, it is never culled.
+     */
+    static BoundingBox const UNBOUNDED;
+
+    static BoundingBox fromPoints(std::span<types::FVec3 const> points);
+    static BoundingBox fromPoints(StridedPoints const &points);
+
+    [[nodiscard]] bool isEmpty() const;
+    [[nodiscard]] types::FVec3 center() const;
+
+    /**
+     * Half of the size of the box along each axis.
+     */
+    [[nodiscard]] types::FVec3 extents() const;
+    [[nodiscard]] types::Float surfaceArea() const;
+
+    [[nodiscard]] bool contains(types::FVec3 const &point) const;
+    [[nodiscard]] bool contains(BoundingBox const &other) const;
+    [[nodiscard]] bool intersects(BoundingBox const &other) const;
+
+    [[nodiscard]] BoundingBox merge(BoundingBox const &other) const;
+    [[nodiscard]] BoundingBox merge(types::FVec3 const &point) const;
+    [[nodiscard]] BoundingBox expand(types::Float margin) const;
+
+    /**
+     * Returns the box enclosing this box after it has been transformed by an affine transform (the
+     * result is generally larger than the transformed box itself).
+     */
+    [[nodiscard]] BoundingBox transform(types::FMat4 const &matrix) const;
+};
+
+struct BoundingSphere
+{
+    types::FVec3 center;
+    types::Float radius;
+
+    /**
+     * Centers the sphere at the center of the passed box and shrinks the radius to the farthest of
+     * the points.
+     */
+    static BoundingSphere fromPoints(std::span<types::FVec3 const> points,
+                                     BoundingBox const &boundingBox);
+    static BoundingSphere fromPoints(StridedPoints const &points, BoundingBox const &boundingBox);
+
+    [[nodiscard]] bool intersects(BoundingBox const &box) const;
+
+    /**
+     * In case of non-uniform scale the radius is scaled by the largest scale factor.
+     */
+    [[nodiscard]] BoundingSphere transform(types::FMat4 const &matrix) const;
+};
+
+struct Ray
+{
+    types::FVec3 origin;
+
+    /**
+     * Not required to be normalized, distances are measured in the units of its length.
+     */
+    types::FVec3 direction;
+
+    /**
+     * Returns the distance along the ray to the point where it enters the box (zero in case the
+     * origin is inside of the box), or nothing if the ray misses the box.
+     */
+    [[nodiscard]] std::optional<types::Float> intersect(BoundingBox const &box) const;
+};
+
+} // namespace pf::gl
+
+#endif // !BOUNDING_VOLUMES_HPP
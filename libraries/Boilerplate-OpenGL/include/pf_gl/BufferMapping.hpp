@@ -0,0 +1,60 @@
+#ifndef BUFFER_MAPPING_HPP
+#define BUFFER_MAPPING_HPP
+
+#include <cstddef>
+#include <functional>
+#include <span>
+
+#include <glad/glad.h>
+
+#include <pf_gl/ValueTypes.hpp>
+
+namespace pf::gl
+{
+
+/**
+ * Fills the mapped storage of a buffer. The mapped memory is usually uncached, so it should only be
+ * written to, sequentially, and never read. Might be called more than once, in case the contents of
+ * the buffer get lost before it is unmapped.
+ */
+using BufferWriter = std::function<void(std::span<std::byte>)>;
+
+/**
+ * Allocates the storage for the buffer bound to the target and fills it through a write-only
+ * mapping. The data is produced right in the memory the driver uploads from, instead of being
+ * prepared on the CPU side first and then copied by `glBufferData`.
+ *
+ * @throws std::runtime_error in case the buffer fails to map or keeps losing its contents.
+ */
+void writeMappedBuffer(GLenum target,
+                       types::BinarySize size,
+                       GLenum usage,
+                       BufferWriter const &write);
+
+/**
+ * Allocates the storage for the buffer and fills it with the data. The storage is immutable with
+ * Direct State Access (OpenGL 4.5), otherwise the buffer is bound to `GL_COPY_WRITE_BUFFER`, so the
+ * element buffer of the bound vertex array stays intact.
+ */
+void uploadBufferStorage(types::UInt buffer, std::span<std::byte const> data, GLenum usage);
+
+/**
+ * Same as `writeMappedBuffer`, for the buffer not bound anywhere, see `uploadBufferStorage`.
+ */
+void writeMappedBufferStorage(types::UInt buffer,
+                              types::BinarySize size,
+                              GLenum usage,
+                              BufferWriter const &write);
+
+/**
+ * Same as `writeMappedBuffer`, for the buffer not bound anywhere. The storage stays mutable, so the
+ * buffer can be respecified with another size every frame, the old storage is orphaned then.
+ */
+void respecifyMappedBuffer(types::UInt buffer,
+                           types::BinarySize size,
+                           GLenum usage,
+                           BufferWriter const &write);
+
+} // namespace pf::gl
+
+#endif // !BUFFER_MAPPING_HPP
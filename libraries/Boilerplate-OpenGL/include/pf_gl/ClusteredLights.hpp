@@ -0,0 +1,114 @@
+#ifndef CLUSTERED_LIGHTS_HPP
+#define CLUSTERED_LIGHTS_HPP
+
+#include <array>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include <pf_gl/DrawingContext3D.hpp>
+#include <pf_gl/LightClusterer.hpp>
+#include <pf_gl/MinecraftCamera.hpp>
+#include <pf_gl/ValueTypes.hpp>
+#include <pf_gl/Window.hpp>
+
+namespace pf::gl
+{
+
+/**
+ * Point lights assigned to the clusters of the view frustum (see `LightClusterer`), uploaded into
+ * shader storage buffers every frame. Requires OpenGL 4.3. The shaders declare the buffers like
+ * this (the binding points are the constants below):
+ *
+ * ```glsl
+ * struct PointLight
+ * {
+ *     vec4 positionRadius; // view space
+ *     vec4 ambient;
+ *     vec4 diffuse;
+ *     vec4 specular;
+ *     vec4 falloff;        // constant, linear, quadratic
+ * };
+ *
+ * layout(std430, binding = 0) readonly buffer PointLights { PointLight pointLights[]; };
+ * layout(std430, binding = 1) readonly buffer LightClusters
+ * {
+ *     uvec4 clustersCount;
+ *     vec4 clusterScale;   // screen tiles per pixel in xy, depth scale and bias in zw
+ *     uvec2 clusters[];    // offset and count in the light indices
+ * };
+ * layout(std430, binding = 2) readonly buffer LightIndices { uint lightIndices[]; };
+ * ```
+ */
+class ClusteredLights final
+{
+public:
+    static types::UInt constexpr POINT_LIGHTS_BINDING = 0;
+    static types::UInt constexpr CLUSTERS_BINDING = 1;
+    static types::UInt constexpr LIGHT_INDICES_BINDING = 2;
+
+    /**
+     * Point light in the std430 layout.
+     */
+    struct GpuPointLight
+    {
+        types::FVec4 positionRadius;
+        types::FVec4 ambient;
+        types::FVec4 diffuse;
+        types::FVec4 specular;
+        types::FVec4 falloff;
+    };
+
+    /**
+     * Header of the clusters buffer in the std430 layout.
+     */
+    struct ClustersHeader
+    {
+        std::array<types::UInt, 4> clustersCount;
+        types::FVec4 clusterScale;
+    };
+
+    /**
+     * @throws std::runtime_error in case shader storage buffers are not supported.
+     */
+    explicit ClusteredLights(std::shared_ptr<Window> window,
+                             LightClusterer clusterer = LightClusterer());
+
+    ClusteredLights(ClusteredLights const &) = delete;
+    ClusteredLights(ClusteredLights &&) = delete;
+
+    ~ClusteredLights();
+
+    ClusteredLights &operator=(ClusteredLights const &) = delete;
+    ClusteredLights &operator=(ClusteredLights &&) = delete;
+
+    /**
+     * Assigns the lights to the clusters of the camera frustum and uploads the results. The light
+     * positions are converted into view space along the way.
+     */
+    void update(MinecraftCamera const &camera,
+                types::FVec2 viewportSize,
+                std::span<PointLight const> lights);
+
+    /**
+     * Binds the buffers to their binding points.
+     */
+    void bind() const;
+
+    [[nodiscard]] LightClusterer const &clusterer() const;
+    [[nodiscard]] types::Size lightsCount() const;
+
+private:
+    std::shared_ptr<Window> _window;
+    LightClusterer _clusterer;
+    // Indexed by the binding points
+    std::array<types::UInt, 3> _buffers = {0, 0, 0};
+
+    std::vector<types::FVec4> _viewSpaceLights;
+
+    void upload(std::span<PointLight const> lights, types::FVec2 viewportSize);
+};
+
+} // namespace pf::gl
+
+#endif // !CLUSTERED_LIGHTS_HPP
@@ -0,0 +1,109 @@
+#ifndef DEFERRED_RENDERER_HPP
+#define DEFERRED_RENDERER_HPP
+
+#include <memory>
+
+#include <pf_gl/DrawingContext3D.hpp>
+#include <pf_gl/GBuffer.hpp>
+#include <pf_gl/Mesh.hpp>
+#include <pf_gl/Shader.hpp>
+#include <pf_gl/Transform3D.hpp>
+#include <pf_gl/ValueTypes.hpp>
+#include <pf_gl/Window.hpp>
+
+namespace pf::gl
+{
+
+/**
+ * Deferred shading path next to the forward one: the meshes are drawn into a `GBuffer` with a
+ * geometry shader of the application, then every light is drawn as a volume covering the pixels
+ * it can reach. The cost of the lighting depends on the lit pixels instead of the fragments of
+ * every mesh multiplied by the number of lights.
+ *
+ * The point lights are spheres and the spot light is a cone, both cut to the pixels where the
+ * surface is actually inside the volume with the stencil buffer: the back faces of the volume
+ * behind the surface increment it, the front faces behind the surface decrement it. The
+ * directional light covers the whole screen.
+ *
+ * The light shader gets the G-buffer in `u_normalDepth` and `u_albedoSpecular`, the kind of the
+ * light in `u_lightType` (see `LightType`), whether the vertices are already in clip space in
+ * `u_fullscreen`, and the light itself in the `u_light` structure, in view space.
+ */
+class DeferredRenderer final
+{
+public:
+    enum LightType
+    {
+        DIRECTIONAL_LIGHT,
+        POINT_LIGHT,
+        SPOT_LIGHT,
+    };
+
+    /**
+     * @throws std::invalid_argument in case the light shader lacks any of the uniforms.
+     */
+    DeferredRenderer(std::shared_ptr<Window> window, Shader lightShader);
+
+    DeferredRenderer(DeferredRenderer const &) = delete;
+    DeferredRenderer(DeferredRenderer &&) = delete;
+
+    ~DeferredRenderer() = default;
+
+    DeferredRenderer &operator=(DeferredRenderer const &) = delete;
+    DeferredRenderer &operator=(DeferredRenderer &&) = delete;
+
+    /**
+     * Everything drawn until `endGeometryPass` goes into the G-buffer, which is resized to the
+     * window first.
+     */
+    void beginGeometryPass();
+
+    /**
+     * Applies the lights of the context to the G-buffer and copies the result into the default
+     * framebuffer, along with the depth. The GL state is left with the depth test on, and the
+     * stencil test, the face culling and the blending off.
+     */
+    void endGeometryPass(DrawingContext3D const &drawingContext);
+
+    [[nodiscard]] GBuffer const &gBuffer() const;
+
+private:
+    /**
+     * Uniforms of the light shader, resolved once.
+     */
+    struct LightUniforms
+    {
+        UniformHandle<types::Int> normalDepth;
+        UniformHandle<types::Int> albedoSpecular;
+        UniformHandle<types::Int> lightType;
+        UniformHandle<types::Int> fullscreen;
+        UniformHandle<types::FVec3> position;
+        UniformHandle<types::FVec3> direction;
+        UniformHandle<types::Float> cosCutOff;
+        UniformHandle<types::Float> cosOuterCutOff;
+        UniformHandle<types::FVec3> ambient;
+        UniformHandle<types::FVec3> diffuse;
+        UniformHandle<types::FVec3> specular;
+        UniformHandle<types::FVec3> falloff;
+    };
+
+    std::shared_ptr<Window> _window;
+    Shader _lightShader;
+    LightUniforms _uniforms;
+    GBuffer _gBuffer;
+    Mesh _fullscreenQuad;
+    Mesh _sphere;
+    Mesh _cone;
+
+    static LightUniforms resolveUniforms(Shader const &lightShader);
+
+    void renderFullscreen(DrawingContext3D const &drawingContext);
+    void renderVolume(Mesh const &volume,
+                      Transform3D const &transform,
+                      DrawingContext3D const &drawingContext);
+    void setLightColor(LightColor const &color, LightFalloff const &falloff);
+};
+
+} // namespace pf::gl
+
+#endif // !DEFERRED_RENDERER_HPP
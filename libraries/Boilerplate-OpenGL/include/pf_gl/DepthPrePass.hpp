@@ -0,0 +1,95 @@
+#ifndef DEPTH_PRE_PASS_HPP
+#define DEPTH_PRE_PASS_HPP
+
+#include <filesystem>
+#include <memory>
+
+#include <pf_gl/GpuTimer.hpp>
+#include <pf_gl/Shader.hpp>
+#include <pf_gl/ShaderCache.hpp>
+#include <pf_gl/ValueTypes.hpp>
+#include <pf_gl/Window.hpp>
+
+namespace pf::gl
+{
+
+/**
+ * Optional pass which only fills the depth buffer before the main one, so that the expensive
+ * fragment shaders of the main pass only run for the visible surfaces instead of every fragment
+ * that gets overwritten later. The meshes are drawn from their position streams (see
+ * `Model::renderPositions`) with the depth-only variant of the main vertex shader, and the main
+ * pass is then drawn with the GL_EQUAL depth test and the depth writes off.
+ *
+ * Both passes are measured with the GPU timers, so the pass can be toggled to see whether it pays
+ * off: it does not in case there is little overdraw or the fragment shaders are cheap.
+ *
+ * The usage is `beginDepthPass`, the position draws in case the pass is enabled, `beginMainPass`,
+ * the regular draws, `endMainPass`.
+ */
+class DepthPrePass final
+{
+public:
+    /**
+     * The vertex shader must be the one of the main pass and declare `invariant gl_Position`,
+     * otherwise the depth may differ between the passes.
+     */
+    DepthPrePass(std::shared_ptr<Window> window,
+                 std::filesystem::path const &vertexShaderPath,
+                 std::shared_ptr<ShaderCache> const &cache = nullptr);
+
+    /**
+     * Takes the depth-only shader built in advance, see `Shader::depthOnly`.
+     */
+    DepthPrePass(std::shared_ptr<Window> window, Shader depthOnlyShader);
+
+    DepthPrePass(DepthPrePass const &) = delete;
+    DepthPrePass(DepthPrePass &&) = delete;
+
+    ~DepthPrePass() = default;
+
+    DepthPrePass &operator=(DepthPrePass const &) = delete;
+    DepthPrePass &operator=(DepthPrePass &&) = delete;
+
+    void enabled(bool enabled);
+    [[nodiscard]] bool enabled() const;
+
+    [[nodiscard]] Shader &shader();
+
+    /**
+     * Disables the color writes, does nothing in case the pass is disabled.
+     */
+    void beginDepthPass();
+
+    /**
+     * Restores the color writes and switches to the GL_EQUAL depth test in case the pass is
+     * enabled.
+     */
+    void beginMainPass();
+
+    /**
+     * Restores the regular GL_LESS depth test with the depth writes.
+     */
+    void endMainPass();
+
+    /**
+     * GPU time of the last measured depth pass, a few frames old.
+     */
+    [[nodiscard]] types::Float depthPassMilliseconds() const;
+
+    /**
+     * GPU time of the last measured main pass, a few frames old. Measured with the depth pass both
+     * enabled and disabled.
+     */
+    [[nodiscard]] types::Float mainPassMilliseconds() const;
+
+private:
+    std::shared_ptr<Window> _window;
+    Shader _shader;
+    GpuTimer _depthPassTimer;
+    GpuTimer _mainPassTimer;
+    bool _enabled = false;
+};
+
+} // namespace pf::gl
+
+#endif // !DEPTH_PRE_PASS_HPP
@@ -56,6 +56,20 @@ struct SpotLight
 
 struct DrawingContext3D
 {
+    enum RenderingPath
+    {
+        /**
+         * Every fragment goes through the lights affecting it.
+         */
+        FORWARD,
+
+        /**
+         * The surfaces are stored in a G-buffer first, then lit by the volumes of the lights (see
+         * `DeferredRenderer`).
+         */
+        DEFERRED,
+    };
+
     // TODO(poppyfanboy) This shouldn't be here, a proper place would be a material or something
     std::optional<types::Float> shininess;
 
@@ -65,6 +79,7 @@ struct DrawingContext3D
     std::optional<std::vector<PointLight>> pointLights;
     std::optional<DirectionalLight> directionalLight;
     std::optional<SpotLight> spotLight;
+    RenderingPath renderingPath = FORWARD;
 
     spp::sparse_hash_map<std::string, std::any> values =
         spp::sparse_hash_map<std::string, std::any>();
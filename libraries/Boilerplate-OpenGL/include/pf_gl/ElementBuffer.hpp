@@ -1,9 +1,11 @@
 #ifndef ELEMENT_BUFFER_HPP
 #define ELEMENT_BUFFER_HPP
 
+#include <cstddef>
 #include <memory>
 #include <span>
 
+#include <pf_gl/BufferMapping.hpp>
 #include <pf_gl/Window.hpp>
 #include <pf_gl/RenderingOptions.hpp>
 #include <pf_gl/ValueTypes.hpp>
@@ -14,10 +16,32 @@ namespace pf::gl
 class ElementBuffer final
 {
 public:
+    /**
+     * Indices are stored as 16-bit integers in case all of them fit, the largest 16-bit value is
+     * left out, it is commonly used as the primitive restart index.
+     */
     ElementBuffer(std::shared_ptr<Window> window,
                   std::span<const types::UInt> const &indices,
                   UsagePattern usagePattern);
 
+    /**
+     * Uploads the indices already packed into the given type.
+     */
+    ElementBuffer(std::shared_ptr<Window> window,
+                  std::span<std::byte const> indices,
+                  types::ValueType indexType,
+                  UsagePattern usagePattern);
+
+    /**
+     * Allocates the buffer for the given number of indices and lets `write` fill it in place,
+     * through the mapped memory of the buffer, so the packed indices are never stored elsewhere.
+     */
+    ElementBuffer(std::shared_ptr<Window> window,
+                  types::Size count,
+                  types::ValueType indexType,
+                  UsagePattern usagePattern,
+                  BufferWriter const &write);
+
     ElementBuffer(ElementBuffer const &) = delete;
     ElementBuffer(ElementBuffer &&) = default;
 
@@ -26,14 +50,27 @@ public:
     ElementBuffer &operator=(ElementBuffer const &) = delete;
     ElementBuffer &operator=(ElementBuffer &&) = default;
 
+    [[nodiscard]] types::UInt id() const;
     [[nodiscard]] types::Size count() const;
+
+    /**
+     * Either `UNSIGNED_INT` or `UNSIGNED_SHORT`.
+     */
+    [[nodiscard]] types::ValueType indexType() const;
+    [[nodiscard]] types::BinarySize sizeInBytes() const;
+
     void bind() const;
     void unbind() const;
 
 private:
     types::UInt _id;
     types::Size _count;
+    types::ValueType _indexType;
     std::shared_ptr<Window> _window;
+
+    void upload(std::span<std::byte const> indices, UsagePattern usagePattern);
+    void generate();
+    static void checkIndexType(types::ValueType indexType);
 };
 
 } // namespace pf::gl
@@ -0,0 +1,66 @@
+#ifndef FRUSTUM_HPP
+#define FRUSTUM_HPP
+
+#include <array>
+
+#include <pf_gl/BoundingVolumes.hpp>
+#include <pf_gl/ValueTypes.hpp>
+
+namespace pf::gl
+{
+
+/**
+ * A view frustum stored as six planes. Normals of the planes point inside the frustum, so a point
+ * is inside in case its signed distance to every plane is non-negative.
+ */
+class Frustum final
+{
+public:
+    enum Plane
+    {
+        LEFT_PLANE,
+        RIGHT_PLANE,
+        BOTTOM_PLANE,
+        TOP_PLANE,
+        NEAR_PLANE,
+        FAR_PLANE,
+    };
+
+    enum Intersection
+    {
+        OUTSIDE,
+        INTERSECTS,
+        INSIDE,
+    };
+
+    static types::Size constexpr PLANES_COUNT = 6;
+
+    /**
+     * Extracts the planes from the combined projection * view matrix (Gribb-Hartmann method). In
+     * case a projection * view * model matrix is passed, the planes end up in the model space.
+     */
+    explicit Frustum(types::FMat4 const &viewProjectionMatrix);
+
+    /**
+     * Each plane is stored as (normal, distance), so that the signed distance from the point to the
+     * plane is `dot(normal, point) + distance`.
+     */
+    [[nodiscard]] std::array<types::FVec4, PLANES_COUNT> const &planes() const;
+
+    [[nodiscard]] bool contains(types::FVec3 const &point) const;
+    [[nodiscard]] bool intersects(BoundingBox const &box) const;
+    [[nodiscard]] bool intersects(BoundingSphere const &sphere) const;
+
+    /**
+     * Unlike `intersects` also tells whether the box is completely inside, which lets hierarchical
+     * culling skip the tests for everything inside of the box.
+     */
+    [[nodiscard]] Intersection classify(BoundingBox const &box) const;
+
+private:
+    std::array<types::FVec4, PLANES_COUNT> _planes;
+};
+
+} // namespace pf::gl
+
+#endif // !FRUSTUM_HPP
@@ -0,0 +1,68 @@
+#ifndef FRUSTUM_CULLER_HPP
+#define FRUSTUM_CULLER_HPP
+
+#include <span>
+#include <vector>
+
+#include <pf_gl/BoundingVolumes.hpp>
+#include <pf_gl/Frustum.hpp>
+#include <pf_gl/ValueTypes.hpp>
+
+namespace pf::gl
+{
+
+/**
+ * Tests batches of world space bounding boxes against a frustum before they are submitted for
+ * drawing. Boxes are converted into a structure-of-arrays layout (centers and extents), so that
+ * four of them are tested against a plane at once with SSE (there is a scalar fallback for the
+ * other architectures).
+ */
+class FrustumCuller final
+{
+public:
+    /**
+     * Boxes closer than that (or containing the camera) are measured as if they were that far.
+     */
+    static types::Float constexpr MIN_SCREEN_SIZE_DISTANCE = 0.001F;
+
+    struct Statistics
+    {
+        types::Size visibleCount = 0;
+        types::Size culledCount = 0;
+    };
+
+    /**
+     * Clears `visibleIndices` and fills it with indices of the boxes which intersect the frustum
+     * (in ascending order). Statistics are accumulated until `resetStatistics` is called.
+     */
+    void cull(Frustum const &frustum,
+              std::span<BoundingBox const> boxes,
+              std::vector<types::UInt> &visibleIndices);
+
+    /**
+     * Fills `screenSizes` with the diameters in pixels of the spheres around the visible boxes, in
+     * the order of `visibleIndices`. Reuses the bounds gathered by the last `cull`, so it must be
+     * called right after it with the indices it produced.
+     *
+     * @param pixelsPerUnit Size in pixels of a unit long object one unit away from the camera: the
+     *                      [1][1] element of the projection matrix times the viewport height.
+     */
+    void screenSizes(types::FVec3 const &cameraPosition,
+                     types::Float pixelsPerUnit,
+                     std::span<types::UInt const> visibleIndices,
+                     std::vector<types::Float> &screenSizes) const;
+
+    [[nodiscard]] Statistics const &statistics() const;
+    void resetStatistics();
+
+private:
+    Statistics _statistics;
+
+    // Scratch buffers, kept between the calls to avoid reallocations every frame
+    std::vector<types::Float> _centersX, _centersY, _centersZ;
+    std::vector<types::Float> _extentsX, _extentsY, _extentsZ;
+};
+
+} // namespace pf::gl
+
+#endif // !FRUSTUM_CULLER_HPP
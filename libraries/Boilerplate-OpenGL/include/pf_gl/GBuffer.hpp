@@ -0,0 +1,102 @@
+#ifndef G_BUFFER_HPP
+#define G_BUFFER_HPP
+
+#include <array>
+#include <memory>
+
+#include <glad/glad.h>
+
+#include <pf_gl/ValueTypes.hpp>
+#include <pf_gl/Window.hpp>
+
+namespace pf::gl
+{
+
+/**
+ * Framebuffer the geometry of the scene is rendered into by the deferred renderer, the lights are
+ * then applied to the stored surfaces instead of the fragments of every mesh. The lighting is
+ * accumulated in an attachment of its own, which shares the depth and stencil buffer with the
+ * geometry.
+ */
+class GBuffer final
+{
+public:
+    enum Attachment : types::UInt
+    {
+        /**
+         * RGBA32F: view space normal packed into two octahedral coordinates, view space depth (zero
+         * where there is no geometry) and the shininess of the material.
+         */
+        NORMAL_DEPTH,
+
+        /**
+         * RGBA8: diffuse color and specular intensity.
+         */
+        ALBEDO_SPECULAR,
+
+        /**
+         * RGBA16F: lighting accumulated by the light passes.
+         */
+        LIGHT,
+
+        ATTACHMENTS_COUNT,
+    };
+
+    /**
+     * @throws std::runtime_error in case the framebuffer is not complete.
+     */
+    GBuffer(std::shared_ptr<Window> window, types::Size width, types::Size height);
+
+    GBuffer(GBuffer const &) = delete;
+    GBuffer(GBuffer &&) = delete;
+
+    ~GBuffer();
+
+    GBuffer &operator=(GBuffer const &) = delete;
+    GBuffer &operator=(GBuffer &&) = delete;
+
+    /**
+     * Reallocates the attachments in case the size differs, their contents are lost.
+     */
+    void resize(types::Size width, types::Size height);
+
+    /**
+     * Binds the framebuffer with the normal and the albedo attachments as the draw buffers.
+     */
+    void bindForGeometry() const;
+
+    /**
+     * Binds the framebuffer with the light attachment as the only draw buffer.
+     */
+    void bindForLighting() const;
+
+    /**
+     * Binds the normal and the albedo attachments to two consecutive texture units.
+     */
+    void bindTextures(types::UInt firstUnit) const;
+
+    /**
+     * Copies the accumulated lighting and the depth into the default framebuffer, so that the
+     * forward rendered objects can be drawn on top. The depth formats of the framebuffers must
+     * match (24-bit depth with 8-bit stencil).
+     */
+    void blitToScreen() const;
+
+    [[nodiscard]] types::Size width() const;
+    [[nodiscard]] types::Size height() const;
+
+private:
+    std::shared_ptr<Window> _window;
+    types::Size _width = 0;
+    types::Size _height = 0;
+    types::UInt _framebuffer = 0;
+    std::array<types::UInt, ATTACHMENTS_COUNT> _textures = {0, 0, 0};
+    types::UInt _depthStencilTexture = 0;
+
+    void allocate();
+    void allocateStorage();
+};
+
+} // namespace pf::gl
+
+#endif // !G_BUFFER_HPP
@@ -86,6 +86,14 @@ public:
     void swapBuffers(GLContext context);
     void hideCursor(GLContext context, bool hide);
 
+    // * Extensions *
+
+    /**
+     * The extensions which are not a part of the loaded OpenGL functions.
+     */
+    bool isExtensionSupported(GLContext context, char const *name);
+    GLFWglproc procAddress(GLContext context, char const *name);
+
 private:
     GLContext _boundContext = NULL_CONTEXT;
 };
@@ -0,0 +1,66 @@
+#ifndef GPU_TIMER_HPP
+#define GPU_TIMER_HPP
+
+#include <array>
+#include <memory>
+
+#include <glad/glad.h>
+
+#include <pf_gl/Window.hpp>
+#include <pf_gl/ValueTypes.hpp>
+
+namespace pf::gl
+{
+
+/**
+ * Measures the time the GPU spends on the commands issued between `begin` and `end` with
+ * GL_TIME_ELAPSED queries. The results arrive a few frames late: several queries are kept in
+ * flight so that the CPU does not wait for them, the oldest one is only waited for once all of
+ * them are in use. The timers must not overlap with each other.
+ */
+class GpuTimer final
+{
+public:
+    static types::Size constexpr QUERIES_COUNT = 4;
+
+    explicit GpuTimer(std::shared_ptr<Window> window);
+
+    GpuTimer(GpuTimer const &) = delete;
+    GpuTimer(GpuTimer &&) = delete;
+
+    ~GpuTimer();
+
+    GpuTimer &operator=(GpuTimer const &) = delete;
+    GpuTimer &operator=(GpuTimer &&) = delete;
+
+    void begin();
+    void end();
+
+    /**
+     * Fetches the results of the finished queries without blocking. Returns `true` in case a new
+     * result has been fetched.
+     */
+    bool pollResults();
+
+    /**
+     * Last fetched result, zero until the first one arrives.
+     */
+    [[nodiscard]] types::Float milliseconds() const;
+
+private:
+    std::shared_ptr<Window> _window;
+    std::array<types::UInt, QUERIES_COUNT> _ids = {};
+    types::Size _firstPending = 0;
+    types::Size _pendingCount = 0;
+    types::Float _milliseconds = 0.0F;
+
+    /**
+     * Returns `false` in case the result of the oldest query is not available and it is not
+     * waited for.
+     */
+    bool fetchOldest(bool wait);
+};
+
+} // namespace pf::gl
+
+#endif // !GPU_TIMER_HPP
@@ -0,0 +1,71 @@
+#ifndef IMAGE_HPP
+#define IMAGE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+#include <pf_gl/ValueTypes.hpp>
+
+namespace pf::gl
+{
+
+/**
+ * Decoded image with 8-bit RGBA pixels, stored row by row. Images with fewer channels are expanded
+ * on load, the missing alpha is opaque.
+ */
+class Image final
+{
+public:
+    static size_t constexpr CHANNELS_COUNT = 4;
+
+    /**
+     * Safe to call from several threads at once, the image is flipped after it is decoded instead
+     * of going through the global flag of stb.
+     *
+     * @throws std::runtime_error in case the image cannot be read or decoded.
+     */
+    explicit Image(std::filesystem::path const &path, bool flipVertically = false);
+
+    /**
+     * @throws std::invalid_argument in case the pixels do not match the size.
+     */
+    Image(types::Size width, types::Size height, std::vector<std::uint8_t> pixels);
+
+    [[nodiscard]] types::Size width() const;
+    [[nodiscard]] types::Size height() const;
+    [[nodiscard]] std::span<std::uint8_t const> pixels() const;
+
+    /**
+     * Channels of the pixel, the coordinates are clamped to the edges of the image.
+     */
+    [[nodiscard]] std::uint8_t const *pixel(types::Int x, types::Int y) const;
+
+    /**
+     * Swaps the rows, so that the first one is at the bottom, the way OpenGL expects it.
+     */
+    void flipVertically();
+
+    /**
+     * Half the size, rounded down to at least a pixel, each pixel is the average of a 2x2 square.
+     * Colors of the sRGB images are averaged in the linear space, otherwise the smaller levels of
+     * the mip chain get darker.
+     */
+    [[nodiscard]] Image downsample(bool srgb = false) const;
+
+    /**
+     * Levels in the full mip chain of the image, down to a single pixel.
+     */
+    [[nodiscard]] types::Size levelsCount() const;
+
+private:
+    types::Size _width = 0;
+    types::Size _height = 0;
+    std::vector<std::uint8_t> _pixels;
+};
+
+} // namespace pf::gl
+
+#endif // !IMAGE_HPP
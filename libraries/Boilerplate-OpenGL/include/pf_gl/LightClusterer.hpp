@@ -0,0 +1,131 @@
+#ifndef LIGHT_CLUSTERER_HPP
+#define LIGHT_CLUSTERER_HPP
+
+#include <memory>
+#include <span>
+#include <vector>
+
+#include <pf_gl/BoundingVolumes.hpp>
+#include <pf_gl/DrawingContext3D.hpp>
+#include <pf_gl/ValueTypes.hpp>
+#include <pf_utils/WorkerPool.hpp>
+
+namespace pf::gl
+{
+
+/**
+ * Splits the view frustum into a grid of clusters and finds the point lights affecting each of
+ * them, so that a fragment only goes through the lights of its own cluster instead of all of them.
+ * The grid is uniform in screen space and exponential in depth (every slice is deeper than the
+ * previous one by the same factor), that way the clusters stay roughly cubic.
+ *
+ * Works on the CPU only, the results are uploaded by `ClusteredLights`. The depth slices are
+ * processed in parallel. Within a slice, the lights are first filtered by the depth range of the
+ * slice, then the rest of them are tested against the cluster bounds four at a time with SSE
+ * (there is a scalar fallback for the other architectures).
+ */
+class LightClusterer final
+{
+public:
+    static types::Size constexpr DEFAULT_CLUSTERS_X = 16;
+    static types::Size constexpr DEFAULT_CLUSTERS_Y = 9;
+    static types::Size constexpr DEFAULT_CLUSTERS_Z = 24;
+
+    /**
+     * Lights are cut off where they get dimmer than that, in the units of the color components.
+     */
+    static types::Float constexpr DEFAULT_CUTOFF = 1.0F / 256.0F;
+
+    /**
+     * Range of the cluster in the light indices, laid out the same way as the `uvec2` in std430.
+     */
+    struct Cluster
+    {
+        types::UInt offset;
+        types::UInt count;
+    };
+
+    /**
+     * Zero threads count means that the number of the hardware threads is used.
+     *
+     * @throws std::invalid_argument in case any of the grid sizes is not positive.
+     */
+    explicit LightClusterer(types::Size clustersX = DEFAULT_CLUSTERS_X,
+                            types::Size clustersY = DEFAULT_CLUSTERS_Y,
+                            types::Size clustersZ = DEFAULT_CLUSTERS_Z,
+                            types::Size threadsCount = 0);
+
+    /**
+     * Distance at which the brightest color component of the light drops below the cutoff. Lights
+     * without any falloff never drop below it, the radius is infinite then.
+     */
+    [[nodiscard]] static types::Float radius(PointLight const &light,
+                                             types::Float cutoff = DEFAULT_CUTOFF);
+
+    /**
+     * Assigns the lights to the clusters of the frustum. Lights are spheres in view space: center
+     * in `xyz`, radius in `w`. The projection must be a perspective one, the cluster bounds are
+     * only recomputed when it changes.
+     */
+    void assign(types::FMat4 const &projectionMatrix, std::span<types::FVec4 const> lights);
+
+    /**
+     * Clusters in the order of x, then y, then z (the depth slice), as returned by `clusterIndex`.
+     */
+    [[nodiscard]] std::span<Cluster const> clusters() const;
+    [[nodiscard]] std::span<types::UInt const> lightIndices() const;
+
+    /**
+     * Bounding box of the cluster in view space.
+     */
+    [[nodiscard]] BoundingBox const &bounds(types::Size clusterIndex) const;
+    [[nodiscard]] types::Size clusterIndex(types::Size x, types::Size y, types::Size z) const;
+
+    /**
+     * Depth slice of a point at the given distance along the view direction, the same formula is
+     * used by the shaders: `log(depth) * depthScale + depthBias`.
+     */
+    [[nodiscard]] types::Size depthSlice(types::Float depth) const;
+    [[nodiscard]] types::Float depthScale() const;
+    [[nodiscard]] types::Float depthBias() const;
+
+    [[nodiscard]] types::Size clustersX() const;
+    [[nodiscard]] types::Size clustersY() const;
+    [[nodiscard]] types::Size clustersZ() const;
+    [[nodiscard]] types::Size clustersCount() const;
+
+private:
+    types::Size _clustersX, _clustersY, _clustersZ;
+
+    // Persistent, woken up once per `assign`; behind a pointer to keep the clusterer movable
+    std::unique_ptr<pf::util::WorkerPool> _workers;
+
+    types::FMat4 _projectionMatrix = types::FMat4(0.0F);
+    types::Float _near = 0.0F, _far = 0.0F;
+    types::Float _depthScale = 0.0F, _depthBias = 0.0F;
+    std::vector<BoundingBox> _bounds;
+
+    std::vector<Cluster> _clusters;
+    std::vector<types::UInt> _lightIndices;
+
+    /**
+     * Scratch buffers of a single depth slice, kept between the calls to avoid reallocations every
+     * frame. Every slice has its own, since the slices are processed in parallel.
+     */
+    struct Slice
+    {
+        std::vector<types::UInt> indices;
+        std::vector<types::UInt> candidates;
+        std::vector<types::Float> centersX, centersY, centersZ;
+        std::vector<types::Float> squaredRadii;
+    };
+
+    std::vector<Slice> _slices;
+
+    void computeBounds(types::FMat4 const &projectionMatrix);
+    void assignSlice(types::Size z, std::span<types::FVec4 const> lights);
+};
+
+} // namespace pf::gl
+
+#endif // !LIGHT_CLUSTERER_HPP
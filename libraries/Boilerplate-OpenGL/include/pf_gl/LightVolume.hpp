@@ -0,0 +1,43 @@
+#ifndef LIGHT_VOLUME_HPP
+#define LIGHT_VOLUME_HPP
+
+#include <vector>
+
+#include <glad/glad.h>
+
+#include <pf_gl/Mesh.hpp>
+#include <pf_gl/ValueTypes.hpp>
+
+namespace pf::gl
+{
+
+/**
+ * Closed low-poly mesh covering the pixels a light can reach, drawn by the deferred renderer
+ * instead of a fullscreen pass. The polygons are circumscribed around the exact shapes, so that
+ * the volume never cuts off the edge of the light. Triangles are counter-clockwise when looked at
+ * from the outside.
+ */
+struct LightVolume
+{
+    std::vector<Mesh::SimpleVertex> vertices;
+    std::vector<GLuint> indices;
+
+    /**
+     * Sphere of radius 1 centered at the origin.
+     *
+     * @throws std::invalid_argument in case there are less than 3 segments or 2 rings.
+     */
+    static LightVolume sphere(types::Size segmentsCount = 16, types::Size ringsCount = 8);
+
+    /**
+     * Cone with the apex at the origin and the base of radius 1 at z = -1, so it looks down the
+     * negative Z axis like a camera does.
+     *
+     * @throws std::invalid_argument in case there are less than 3 segments.
+     */
+    static LightVolume cone(types::Size segmentsCount = 16);
+};
+
+} // namespace pf::gl
+
+#endif // !LIGHT_VOLUME_HPP
@@ -1,13 +1,18 @@
 #ifndef MESH_HPP
 #define MESH_HPP
 
+#include <cstddef>
 #include <memory>
+#include <span>
 #include <vector>
 
 #include <glad/glad.h>
 
+#include <pf_gl/BoundingVolumes.hpp>
 #include <pf_gl/VertexArray.hpp>
+#include <pf_gl/VertexBuffer.hpp>
 #include <pf_gl/Texture.hpp>
+#include <pf_gl/TextureArray.hpp>
 #include <pf_gl/Shader.hpp>
 #include <pf_gl/ElementBuffer.hpp>
 #include <pf_gl/MinecraftCamera.hpp>
@@ -19,6 +24,8 @@
 #include <pf_utils/IndexedString.hpp>
 #include <pf_gl/DrawingContext3D.hpp>
 #include <pf_gl/Material.hpp>
+#include <pf_gl/MeshSimplifier.hpp>
+#include <pf_gl/MeshData.hpp>
 
 namespace pf::gl
 {
@@ -37,13 +44,38 @@ public:
         types::FVec2 textureCoordinates;
     };
 
+    enum VertexCompression : types::UInt
+    {
+        UNCOMPRESSED,
+
+        /**
+         * Vertices are uploaded in the compact layout of the `VertexQuantizer`, 16 bytes instead
+         * of 32. Positions lose precision relative to the size of the mesh, about 1/65536 of it.
+         */
+        QUANTIZED,
+    };
+
     /**
-     * Create mesh from a set of vertices with (position, normal, UV) layout.
+     * Create mesh from a set of vertices with (position, normal, UV) layout. Levels of detail are
+     * coarser index sets for the same vertices, from the most detailed one to the least detailed.
+     *
+     * The vertices are quantized and the indices are packed right into the mapped GPU buffers,
+     * there is no intermediate copy of the converted mesh.
      */
     Mesh(std::shared_ptr<Window> window,
          std::vector<SimpleVertex> const &vertices,
          std::vector<GLuint> const &indices,
          std::vector<std::shared_ptr<Texture>> textures,
+         UsagePattern usagePattern,
+         std::vector<MeshSimplifier::Result> const &levelsOfDetail = {},
+         VertexCompression vertexCompression = UNCOMPRESSED);
+
+    /**
+     * Create mesh from the data prepared in advance, like the one loaded from a cooked mesh file.
+     */
+    Mesh(std::shared_ptr<Window> window,
+         MeshData const &data,
+         std::vector<std::shared_ptr<Texture>> textures,
          UsagePattern usagePattern);
 
     /**
@@ -59,16 +91,121 @@ public:
     void render(Shader &shader,
                 DrawingContext3D const &drawingContext,
                 Transform3D const &transform,
-                Material const &material = {}) const;
+                Material const &material = {},
+                types::Size levelOfDetail = 0) const;
 
     void render(Shader &shader,
                 DrawingContext3D const &drawingContext,
                 Material const &material = {}) const;
 
+    /**
+     * Draws the mesh from a separate stream of tightly packed positions, for the passes that read
+     * nothing else, like the depth pre-pass. The positions are bound to the same location as in
+     * the full layout, so the shaders of the regular render can be used too.
+     */
+    void renderPositions(Shader &shader,
+                         DrawingContext3D const &drawingContext,
+                         Transform3D const &transform,
+                         types::Size levelOfDetail = 0) const;
+
+    /**
+     * Texture array sampled through the `u_diffuseTextureArray` uniform, the layer is passed in
+     * `u_textureLayer`. Texture coordinates of the mesh must already be remapped into the layer
+     * (see `TextureArrayBuilder::Region::remap`). The array is not bound on every draw like the
+     * textures are, it is bound once before the draws of all meshes sampling it.
+     */
+    void textureArray(std::shared_ptr<TextureArray> textureArray, types::Int layer);
+    [[nodiscard]] std::shared_ptr<TextureArray> const &textureArray() const;
+
+    /**
+     * Textures bound on every draw of the mesh, the texture array is not one of them.
+     */
+    [[nodiscard]] types::Size texturesCount() const;
+
+    /**
+     * Bounds in the local space of the mesh. In case the vertex layout of the mesh has no 3D float
+     * positions, the bounds are unbounded.
+     */
+    [[nodiscard]] BoundingBox const &boundingBox() const;
+    [[nodiscard]] BoundingSphere const &boundingSphere() const;
+
+    /**
+     * The level zero is the original mesh, the rest of them are simplified versions of it.
+     */
+    [[nodiscard]] types::Size levelsOfDetailCount() const;
+    [[nodiscard]] types::Size trianglesCount(types::Size levelOfDetail = 0) const;
+
+    /**
+     * How far the surface of the level of detail may deviate from the original one, in the local
+     * space of the mesh.
+     */
+    [[nodiscard]] types::Float error(types::Size levelOfDetail) const;
+
+    /**
+     * GPU memory taken by the vertices and the indices.
+     */
+    [[nodiscard]] types::BinarySize sizeInBytes() const;
+
+    /**
+     * Converts the vertices and the indices into the form they are uploaded to the GPU in, without
+     * touching the GPU itself. The textures of the data are left empty.
+     */
+    [[nodiscard]] static MeshData
+    prepare(std::vector<SimpleVertex> const &vertices,
+            std::vector<GLuint> const &indices,
+            std::vector<MeshSimplifier::Result> const &levelsOfDetail = {},
+            VertexCompression vertexCompression = UNCOMPRESSED);
+
 private:
     std::shared_ptr<Window> _window;
     std::vector<std::shared_ptr<Texture>> _textures;
+    std::shared_ptr<TextureArray> _textureArray;
+    types::Int _textureLayer = 0;
+
+    /**
+     * Vertex arrays are shared by all meshes of the same layout, the buffers of the mesh are
+     * attached to them on every draw.
+     */
     std::shared_ptr<VertexArray> _vertexArray;
+    std::shared_ptr<VertexBuffer> _vertexBuffer;
+    std::shared_ptr<ElementBuffer> _elementBuffer;
+
+    /**
+     * Drawn with the same element buffer, null in case the layout of the mesh has no positions.
+     */
+    std::shared_ptr<VertexArray> _positionsVertexArray;
+    std::shared_ptr<VertexBuffer> _positionsBuffer;
+    std::vector<MeshData::LevelOfDetail> _levelsOfDetail;
+    types::BinarySize _sizeInBytes = 0;
+
+    /**
+     * Appended to the model matrix, restores the quantized positions.
+     */
+    types::FMat4 _dequantizationMatrix = types::DEFAULT_VALUE<types::FMat4>;
+
+    BoundingBox _boundingBox = BoundingBox::UNBOUNDED;
+    BoundingSphere _boundingSphere = {.center = types::DEFAULT_VALUE<types::FVec3>, .radius = 0.0F};
+
+    void setUniforms(Shader &shader,
+                     DrawingContext3D const &drawingContext,
+                     Transform3D const &transform,
+                     Material const &material) const;
+
+    /**
+     * Returns the size of the uploaded positions.
+     */
+    types::BinarySize addPositionsStream(VertexLayout const &layout,
+                                         std::span<std::byte const> vertices,
+                                         UsagePattern usagePattern);
+
+    /**
+     * Positions are read from the interleaved vertex data with the given stride.
+     */
+    static void computeBounds(std::byte const *positions,
+                              size_t verticesCount,
+                              size_t stride,
+                              BoundingBox &boundingBox,
+                              BoundingSphere &boundingSphere);
 };
 
 } // namespace pf::gl
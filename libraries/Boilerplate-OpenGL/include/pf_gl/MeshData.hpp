@@ -0,0 +1,97 @@
+#ifndef MESH_DATA_HPP
+#define MESH_DATA_HPP
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include <pf_gl/BoundingVolumes.hpp>
+#include <pf_gl/Texture.hpp>
+#include <pf_gl/VertexLayout.hpp>
+#include <pf_gl/ValueTypes.hpp>
+
+namespace pf::gl
+{
+
+/**
+ * Everything needed to create a mesh on the GPU, with the vertices and the indices already in the
+ * form they are uploaded in. The data itself is not owned, it is kept alive by the `storage`
+ * pointer, which is either a set of buffers or a memory mapped file.
+ */
+struct MeshData
+{
+    /**
+     * Range of the element buffer, the first one is the whole mesh.
+     */
+    struct LevelOfDetail
+    {
+        types::Size firstIndex;
+        types::Size indicesCount;
+        types::Float error;
+    };
+
+    struct TextureReference
+    {
+        TextureType type;
+        std::filesystem::path path;
+    };
+
+    std::vector<AttributeEntry> attributes;
+    std::span<std::byte const> vertices;
+
+    /**
+     * Either `UNSIGNED_INT` or `UNSIGNED_SHORT`.
+     */
+    types::ValueType indexType = types::UNSIGNED_INT;
+    std::span<std::byte const> indices;
+
+    std::vector<LevelOfDetail> levelsOfDetail;
+
+    BoundingBox boundingBox = BoundingBox::EMPTY;
+    BoundingSphere boundingSphere = {.center = types::DEFAULT_VALUE<types::FVec3>, .radius = 0.0F};
+
+    /**
+     * Appended to the model matrix, identity unless the positions are quantized.
+     */
+    types::FMat4 dequantizationMatrix = types::DEFAULT_VALUE<types::FMat4>;
+
+    std::vector<TextureReference> textures;
+
+    std::shared_ptr<void const> storage;
+
+    /**
+     * Converts the indices to 16-bit integers in case all of them fit, the largest 16-bit value is
+     * left out, it is commonly used as the primitive restart index. Returns the resulting type.
+     */
+    static types::ValueType packIndices(std::span<types::UInt const> indices,
+                                        std::vector<std::byte> &packedIndices);
+
+    /**
+     * Same rule as in `packIndices`, for the indices no larger than the given one.
+     */
+    [[nodiscard]] static types::ValueType indexTypeFor(types::UInt maxIndex);
+
+    /**
+     * Writes the indices converted to the given type, the destination must fit all of them. Meant
+     * for the memory mapped buffers, so the destination is only written to, never read.
+     */
+    static void packIndices(std::span<types::UInt const> indices,
+                            types::ValueType indexType,
+                            std::span<std::byte> destination);
+
+    /**
+     * Copies the positions out of the interleaved vertices into a tightly packed stream, for the
+     * passes which read nothing else. Returns the attribute of the positions, or nothing in case
+     * the layout has none, the positions are left empty then.
+     */
+    static std::optional<AttributeEntry> extractPositions(VertexLayout const &layout,
+                                                          std::span<std::byte const> vertices,
+                                                          std::vector<std::byte> &positions);
+};
+
+} // namespace pf::gl
+
+#endif // !MESH_DATA_HPP
@@ -0,0 +1,95 @@
+#ifndef MESH_FILE_HPP
+#define MESH_FILE_HPP
+
+#include <cstddef>
+#include <filesystem>
+#include <future>
+#include <span>
+#include <vector>
+
+#include <pf_gl/MeshData.hpp>
+#include <pf_gl/ValueTypes.hpp>
+
+namespace pf::gl
+{
+
+/**
+ * Binary file with the meshes cooked in advance (`.pfmesh`), so that loading them is not much more
+ * than handing the file contents to the GPU.
+ *
+ * The file is memory mapped, uncompressed vertices and indices are uploaded straight from the
+ * mapping. Compressed ones are decompressed in a worker thread started as soon as the file is
+ * opened, everything else (like the textures) can be loaded in the meantime.
+ *
+ * Layout, all values are little-endian:
+ *  - header: magic, version, meshes count, reserved (4 bytes each);
+ *  - for each mesh:
+ *     - attributes count, then attribute, value type, normalized flag for each;
+ *     - index type;
+ *     - levels of detail count, then first index, indices count, error for each;
+ *     - bounding box (6 floats), bounding sphere (4 floats), dequantization matrix (16 floats);
+ *     - textures count, then type, path length and path (padded to 4 bytes) for each;
+ *     - vertices and indices blocks: compression, reserved, size, stored size (the last two are
+ *       8 bytes each), then the data, which starts at 16 bytes alignment.
+ */
+class MeshFile final
+{
+public:
+    static constexpr char const *EXTENSION = ".pfmesh";
+
+    /**
+     * "PFMS" when read as bytes.
+     */
+    static types::UInt constexpr MAGIC = 0x534D4650U;
+
+    /**
+     * Files of the other versions are rejected, they are meant to be cooked again.
+     */
+    static types::UInt constexpr VERSION = 1;
+
+    static size_t constexpr DATA_ALIGNMENT = 16;
+
+    enum Compression : types::UInt
+    {
+        NO_COMPRESSION,
+
+        /**
+         * The LZ4 block format, the blocks which do not get smaller are stored as is.
+         */
+        LZ4_COMPRESSION,
+    };
+
+    /**
+     * @throws std::runtime_error in case the file cannot be read or is malformed.
+     */
+    explicit MeshFile(std::filesystem::path const &path);
+
+    [[nodiscard]] size_t meshesCount() const;
+
+    /**
+     * Available right away, the paths are resolved relative to the file.
+     */
+    [[nodiscard]] std::vector<MeshData::TextureReference> const &
+    textures(size_t meshIndex) const;
+
+    /**
+     * Waits for the decompression to finish. The data stays valid even after the file object is
+     * destroyed, as long as it is referenced.
+     */
+    [[nodiscard]] MeshData const &mesh(size_t meshIndex) const;
+
+    /**
+     * Texture paths are written as they are, they are expected to be relative to the written file.
+     */
+    static void write(std::filesystem::path const &path,
+                      std::span<MeshData const> meshes,
+                      Compression compression = NO_COMPRESSION);
+
+private:
+    std::vector<MeshData> _meshes;
+    std::shared_future<void> _decompression;
+};
+
+} // namespace pf::gl
+
+#endif // !MESH_FILE_HPP
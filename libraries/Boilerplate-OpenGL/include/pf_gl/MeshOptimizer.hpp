@@ -0,0 +1,135 @@
+#ifndef MESH_OPTIMIZER_HPP
+#define MESH_OPTIMIZER_HPP
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include <pf_gl/ValueTypes.hpp>
+
+namespace pf::gl
+{
+
+/**
+ * Reorders the triangles and the vertices of an indexed mesh to make it cheaper to draw, without
+ * changing what is drawn. Vertices are interleaved structures made only of floats, the position
+ * being three of them at the given byte offset.
+ *
+ * The whole pipeline is run by `optimize`, the steps go in this order:
+ *  - welding of the equal vertices;
+ *  - vertex cache ordering (Forsyth), so that the transformed vertices are reused as much as
+ *    possible;
+ *  - overdraw ordering (Sander, Nehab, Barczak), the triangles are split into the clusters which
+ *    do not hurt the vertex cache much, and the clusters facing outwards are drawn first;
+ *  - vertex fetch ordering, vertices are placed in the order of their first use.
+ */
+class MeshOptimizer final
+{
+public:
+    /**
+     * Size of the vertex cache simulated by the Forsyth's algorithm.
+     */
+    static size_t constexpr CACHE_SIZE = 32;
+
+    /**
+     * Size of the FIFO cache for the statistics, close to what the hardware actually has.
+     */
+    static size_t constexpr STATISTICS_CACHE_SIZE = 16;
+
+    /**
+     * A cluster of the overdraw ordering can have this much worse cache performance than the
+     * whole mesh.
+     */
+    static types::Float constexpr DEFAULT_OVERDRAW_THRESHOLD = 1.05F;
+
+    struct Statistics
+    {
+        /**
+         * Average cache miss ratio: transformed vertices per triangle, between 0.5 and 3.
+         */
+        types::Float acmr = 0.0F;
+
+        /**
+         * Average transform to vertex ratio: transformed vertices per unique vertex, 1 is the best.
+         */
+        types::Float atvr = 0.0F;
+    };
+
+    struct Report
+    {
+        Statistics before, after;
+        size_t verticesCountBefore = 0, verticesCountAfter = 0;
+    };
+
+    /**
+     * Runs all the steps. The vertices are compacted in place, the returned report tells how many
+     * of them are left. Zero epsilon welds only the vertices which are equal bit by bit.
+     */
+    static Report optimize(std::span<std::byte> vertices,
+                           size_t stride,
+                           size_t positionOffset,
+                           std::vector<types::UInt> &indices,
+                           types::Float weldEpsilon = 0.0F);
+
+    /**
+     * Reorders only the triangles, for the index sets sharing already optimized vertices (like
+     * the levels of detail).
+     */
+    static void optimizeTriangles(std::span<std::byte const> vertices,
+                                  size_t stride,
+                                  size_t positionOffset,
+                                  std::span<types::UInt> indices);
+
+    /**
+     * Fills the table from the old vertex indices to the new ones, equal vertices get the same
+     * index. With a non-zero epsilon every float component is snapped to a grid of that size
+     * before comparing. Returns the number of the unique vertices.
+     */
+    static size_t generateWeldRemap(std::span<std::byte const> vertices,
+                                    size_t stride,
+                                    types::Float epsilon,
+                                    std::vector<types::UInt> &remap);
+
+    static void optimizeVertexCache(std::span<types::UInt> indices, size_t verticesCount);
+
+    /**
+     * Expects the indices to be already optimized for the vertex cache.
+     */
+    static void optimizeOverdraw(std::span<types::UInt> indices,
+                                 std::span<types::FVec3 const> positions,
+                                 types::Float threshold = DEFAULT_OVERDRAW_THRESHOLD);
+
+    /**
+     * Fills the table from the old vertex indices to the new ones in the order of the first use,
+     * unused vertices are mapped to `NO_VERTEX`. Returns the number of the used vertices.
+     */
+    static size_t generateVertexFetchRemap(std::span<types::UInt const> indices,
+                                           size_t verticesCount,
+                                           std::vector<types::UInt> &remap);
+
+    /**
+     * Moves the vertices in place according to the remap table, so that the vertex `i` ends up at
+     * `remap[i]`. Several vertices with the same target are expected to be equal.
+     */
+    static void remapVertices(std::span<std::byte> vertices,
+                              size_t stride,
+                              std::span<types::UInt const> remap);
+
+    static void remapIndices(std::span<types::UInt> indices, std::span<types::UInt const> remap);
+
+    [[nodiscard]] static Statistics analyze(std::span<types::UInt const> indices,
+                                            size_t verticesCount);
+
+    static types::UInt constexpr NO_VERTEX = ~types::UInt(0);
+
+private:
+    /**
+     * Positions are read from the interleaved vertex data.
+     */
+    static std::vector<types::FVec3>
+    extractPositions(std::span<std::byte const> vertices, size_t stride, size_t positionOffset);
+};
+
+} // namespace pf::gl
+
+#endif // !MESH_OPTIMIZER_HPP
@@ -0,0 +1,137 @@
+#ifndef MESH_SIMPLIFIER_HPP
+#define MESH_SIMPLIFIER_HPP
+
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include <pf_gl/ValueTypes.hpp>
+
+namespace pf::gl
+{
+
+/**
+ * Mesh simplification with the quadric error metrics (Garland, Heckbert). Edges are only collapsed
+ * into one of their endpoints, so the simplified index lists still refer to the original vertices,
+ * and all levels of detail of a mesh can share the same vertex buffer.
+ *
+ * Vertices with the same position are treated as a single vertex, so that the texture seams and
+ * the sharp edges are not torn apart. Vertices on the seams can only slide along the seam, vertices
+ * where more than two UV-islands meet are never moved, unless the seams are allowed to be
+ * collapsed. Vertices on the open borders of the mesh are never moved.
+ */
+class MeshSimplifier final
+{
+public:
+    enum Seams : types::UInt
+    {
+        KEEP_SEAMS,
+
+        /**
+         * Vertices on the seams are moved freely, the attributes of the triangles around them are
+         * replaced with the ones from a neighbouring UV-island. Heavily faceted meshes barely
+         * simplify otherwise, and at a distance the difference is hard to notice anyway.
+         */
+        COLLAPSE_SEAMS,
+    };
+
+    struct Result
+    {
+        std::vector<types::UInt> indices;
+
+        /**
+         * Estimate of the distance between the simplified and the original surfaces, in the same
+         * units as the positions. Does not account for the distortion of the vertex attributes.
+         */
+        types::Float error;
+    };
+
+    /**
+     * Indices are a triangle list. The spans must outlive the simplifier.
+     */
+    MeshSimplifier(std::span<types::FVec3 const> positions, std::span<types::UInt const> indices);
+
+    /**
+     * Collapses edges until the mesh has no more than the target count of indices, or until the
+     * next collapse would exceed the error limit. The result may have more indices than requested
+     * in case the mesh cannot be simplified any further.
+     */
+    [[nodiscard]] Result
+    simplify(size_t targetIndicesCount,
+             types::Float maxError = std::numeric_limits<types::Float>::max(),
+             Seams seams = KEEP_SEAMS) const;
+
+private:
+    enum VertexKind : types::UInt
+    {
+        MANIFOLD,
+        SEAM,
+        COMPLEX,
+        BORDER,
+    };
+
+    /**
+     * Symmetric 4x4 matrix of the quadric. Doubles, because the errors are differences of large
+     * and almost equal numbers.
+     */
+    struct Quadric
+    {
+        double a2 = 0.0, ab = 0.0, ac = 0.0, ad = 0.0;
+        double b2 = 0.0, bc = 0.0, bd = 0.0;
+        double c2 = 0.0, cd = 0.0;
+        double d2 = 0.0;
+
+        /**
+         * Total area of the planes, dividing by it turns the error into a squared distance.
+         */
+        double weight = 0.0;
+
+        void add(Quadric const &other);
+        [[nodiscard]] double error(types::FVec3 const &point) const;
+    };
+
+    struct Collapse
+    {
+        types::UInt from, to;
+        double error;
+    };
+
+    std::span<types::FVec3 const> _positions;
+    std::span<types::UInt const> _indices;
+
+    /**
+     * Index of the first vertex with the same position, for every vertex.
+     */
+    std::vector<types::UInt> _positionIds;
+    std::vector<VertexKind> _kinds;
+    std::vector<Quadric> _quadrics;
+
+    void classifyVertices();
+    void computeQuadrics();
+
+    /**
+     * Finds where each of the vertices sharing the `from` position goes after the collapse. Returns
+     * false in case the collapse would tear the mesh apart.
+     */
+    [[nodiscard]] bool
+    remapWedges(types::UInt from,
+                types::UInt to,
+                Seams seams,
+                std::vector<types::UInt> const &indices,
+                std::vector<std::vector<types::UInt>> const &positionTriangles,
+                std::vector<types::UInt> &remap) const;
+
+    /**
+     * Checks that none of the triangles around the `from` position turns over after the collapse.
+     */
+    [[nodiscard]] bool
+    flipsTriangles(types::UInt from,
+                   types::UInt to,
+                   std::vector<types::UInt> const &indices,
+                   std::vector<std::vector<types::UInt>> const &positionTriangles) const;
+};
+
+} // namespace pf::gl
+
+#endif // !MESH_SIMPLIFIER_HPP
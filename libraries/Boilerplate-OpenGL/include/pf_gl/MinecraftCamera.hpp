@@ -4,6 +4,8 @@
 #include <cmath>
 #include <numbers>
 
+#include <pf_gl/BoundingVolumes.hpp>
+#include <pf_gl/Frustum.hpp>
 #include <pf_gl/ValueTypes.hpp>
 
 namespace pf::gl
@@ -49,9 +51,16 @@ public:
 
     [[nodiscard]] types::FMat4 const &viewMatrix() const;
     [[nodiscard]] types::FMat4 const &projectionMatrix() const;
+    [[nodiscard]] types::FMat4 viewProjectionMatrix() const;
+    [[nodiscard]] Frustum frustum() const;
     [[nodiscard]] types::FVec3 const &position() const;
     [[nodiscard]] types::FVec3 direction() const;
 
+    /**
+     * Ray going from the camera position through the center of the screen, used for picking.
+     */
+    [[nodiscard]] Ray ray() const;
+
     void move(types::FVec3 const &movementInput, types::Float deltaTime);
     void rotate(types::FVec2 const &rotationInput, types::Float deltaTime);
     void fov(types::Float fov);
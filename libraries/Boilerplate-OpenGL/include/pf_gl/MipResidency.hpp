@@ -0,0 +1,107 @@
+#ifndef MIP_RESIDENCY_HPP
+#define MIP_RESIDENCY_HPP
+
+#include <unordered_map>
+#include <vector>
+
+#include <pf_gl/ValueTypes.hpp>
+
+namespace pf::gl
+{
+
+/**
+ * Decides which levels of the mip chains stay in the video memory, without touching OpenGL itself
+ * (see `TextureStreamer`). Each texture has a range of the resident levels, from its base level
+ * down to the smallest one. The smallest levels are always resident, the larger ones are loaded
+ * once they are requested and evicted in the least recently used order when the budget runs out.
+ */
+class MipResidency final
+{
+public:
+    /**
+     * New base level of a texture, the levels in between are to be loaded or evicted.
+     */
+    struct Change
+    {
+        types::UInt id;
+        types::Size previousBaseLevel;
+        types::Size baseLevel;
+    };
+
+    /**
+     * @param budget Bytes taken by all resident levels, except for the ones which are always
+     * resident.
+     * @param uploadBudget Bytes loaded per update, at least one level is loaded anyway.
+     */
+    MipResidency(types::BinarySize budget, types::BinarySize uploadBudget);
+
+    /**
+     * The level which is large enough for a texture covering the given number of pixels on screen,
+     * so that a texel is not smaller than a pixel.
+     */
+    [[nodiscard]] static types::Size
+    levelFor(types::Size textureSize, types::Float screenSize, types::Size levelsCount);
+
+    /**
+     * @param levelSizes Bytes taken by each level, starting with the largest one.
+     * @param alwaysResidentLevel The levels starting with this one are resident right away and are
+     * never evicted.
+     * @throws std::invalid_argument in case the level is out of range.
+     */
+    types::UInt add(std::vector<types::BinarySize> levelSizes, types::Size alwaysResidentLevel);
+    void remove(types::UInt id);
+
+    /**
+     * Marks the texture as used in the current update. Out of several requests the largest level
+     * wins.
+     */
+    void request(types::UInt id, types::Size level);
+
+    /**
+     * Loads the requested levels one by one, starting with the most recently used textures, and
+     * evicts the levels which were not requested in this update once they do not fit into the
+     * budget. Starts the next update afterwards.
+     */
+    std::vector<Change> update();
+
+    void budget(types::BinarySize budget);
+    [[nodiscard]] types::BinarySize budget() const;
+
+    [[nodiscard]] types::Size baseLevel(types::UInt id) const;
+    [[nodiscard]] types::BinarySize residentBytes(types::UInt id) const;
+
+    /**
+     * Bytes counted against the budget.
+     */
+    [[nodiscard]] types::BinarySize residentBytes() const;
+
+private:
+    struct Texture
+    {
+        std::vector<types::BinarySize> levelSizes;
+        types::Size alwaysResidentLevel;
+        types::Size baseLevel;
+        types::Size requestedLevel;
+        types::UInt lastUse = 0;
+    };
+
+    types::BinarySize _budget;
+    types::BinarySize _uploadBudget;
+    types::BinarySize _residentBytes = 0;
+
+    types::UInt _nextId = 0;
+    types::UInt _currentUse = 1;
+    std::unordered_map<types::UInt, Texture> _textures;
+
+    /**
+     * Evicts the levels of the least recently used textures until the extra bytes fit into the
+     * budget. Nothing requested in the current update is ever evicted.
+     *
+     * @return Whether the bytes fit.
+     */
+    bool makeRoom(types::BinarySize bytes, std::unordered_map<types::UInt, types::Size> &changes);
+};
+
+} // namespace pf::gl
+
+#endif // !MIP_RESIDENCY_HPP
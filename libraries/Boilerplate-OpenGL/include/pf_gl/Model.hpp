@@ -6,17 +6,23 @@
 #include <vector>
 #include <filesystem>
 
-#include <assimp/scene.h>
-
+#include <pf_gl/BoundingVolumes.hpp>
 #include <pf_gl/Shader.hpp>
 #include <pf_gl/MinecraftCamera.hpp>
 #include <pf_gl/Mesh.hpp>
 #include <pf_gl/Transform3D.hpp>
 #include <pf_gl/EulerTransform3D.hpp>
 #include <pf_gl/Texture.hpp>
+#include <pf_gl/TextureArray.hpp>
+#include <pf_gl/TextureLoader.hpp>
+#include <pf_gl/TextureStreamer.hpp>
 #include <pf_gl/Window.hpp>
 #include <pf_gl/DrawingContext3D.hpp>
 #include <pf_gl/Material.hpp>
+#include <pf_gl/OcclusionQuery.hpp>
+#include <pf_gl/MeshData.hpp>
+#include <pf_gl/MeshOptimizer.hpp>
+#include <pf_gl/ValueTypes.hpp>
 
 namespace pf::gl
 {
@@ -24,16 +30,44 @@ namespace pf::gl
 class Model
 {
 public:
+    static types::Float constexpr DEFAULT_MAX_SCREEN_SPACE_ERROR = 1.0F;
+
+    /**
+     * A coarser level of detail is only picked once its error is this much below the maximum, so
+     * that a model at the boundary distance does not switch back and forth every frame.
+     */
+    static types::Float constexpr LEVEL_OF_DETAIL_HYSTERESIS = 0.25F;
+
+    /**
+     * Keeps the projected errors finite when the camera is inside of the bounding sphere.
+     */
+    static types::Float constexpr MIN_LEVEL_OF_DETAIL_DISTANCE = 0.001F;
+
     /**
-     * Load model from disk.
+     * Load model from disk. Cooked mesh files (see `MeshFile`) are loaded as they are, the vertex
+     * compression is chosen when they are cooked. Any other format is imported with assimp.
+     *
+     * With a texture loader the textures are decoded in the background and the model is drawn
+     * without them until the loader uploads them, otherwise they are loaded right away. With a
+     * texture streamer the cooked textures are streamed according to the size of the model on the
+     * screen.
+     *
+     * With `diffuseTextureArrays` the diffuse textures of the imported models are arranged into
+     * texture arrays (see `ModelImporter`), which have to be bound before the model is drawn (see
+     * `textureArrays`). The cooked models keep their textures as they are.
      */
     Model(std::shared_ptr<Window> window,
           std::filesystem::path const &path,
           std::unique_ptr<Transform3D> &&transform = std::make_unique<EulerTransform3D>(),
-          Material const &material = {});
+          Material const &material = {},
+          Mesh::VertexCompression vertexCompression = Mesh::UNCOMPRESSED,
+          std::shared_ptr<TextureLoader> textureLoader = nullptr,
+          std::shared_ptr<TextureStreamer> textureStreamer = nullptr,
+          bool diffuseTextureArrays = false);
 
     /**
-     * Create model from a collection of meshes.
+     * Create model from a collection of meshes, possibly the ones of another model, so that
+     * several copies of it share the buffers and the textures.
      */
     Model(std::shared_ptr<Window> window,
           std::vector<std::shared_ptr<Mesh>> meshes,
@@ -41,46 +75,117 @@ public:
           Material const &material = {});
 
     [[nodiscard]] Transform3D const &transform() const;
+    [[nodiscard]] std::vector<std::shared_ptr<Mesh>> const &meshes() const;
+
+    /**
+     * Arrays sampled by the meshes, each of them is bound once for all of the models sharing it,
+     * before they are drawn (see `TextureArray::bind`).
+     */
+    [[nodiscard]] std::vector<std::shared_ptr<TextureArray>> const &textureArrays() const;
+
+    /**
+     * Union of the bounds of all meshes in the local space of the model.
+     */
+    [[nodiscard]] BoundingBox const &boundingBox() const;
+    [[nodiscard]] BoundingBox worldBoundingBox() const;
+    [[nodiscard]] BoundingSphere worldBoundingSphere() const;
 
+    /**
+     * In case the occlusion culling is enabled, visibility of the model from the previous frames is
+     * reused: a model which was visible is drawn as usual (the draw itself is wrapped in a query),
+     * while for a hidden model only its bounding box is drawn under a query, and the actual draw is
+     * performed with the conditional rendering, so that the CPU never waits for the results.
+     *
+     * Each mesh is drawn with the coarsest level of detail whose error projected onto the screen
+     * does not exceed the maximum. The selection needs both the camera and the viewport size in the
+     * drawing context, without them the most detailed meshes are drawn.
+     */
     void render(Shader &shader, DrawingContext3D const &drawingContext) const;
 
+    /**
+     * Draws only the positions of the meshes for the depth pre-pass (see `DepthPrePass`), with the
+     * same levels of detail `render` picks for the same context. There is no occlusion culling
+     * here: a model hidden in the previous frame still needs its depth in case it shows up now.
+     */
+    void renderPositions(Shader &shader, DrawingContext3D const &drawingContext) const;
+
     void transform(std::unique_ptr<Transform3D> &&transform);
 
+    /**
+     * Asks the texture streamer for the levels matching the size of the model on the screen in
+     * pixels, as if the textures were stretched over the whole model once. Meant to be called for
+     * the visible models only, with the sizes the culling pass has computed anyway (see
+     * `FrustumCuller::screenSizes`).
+     */
+    void requestTextureLevels(types::Float screenSize) const;
+
+    /**
+     * Toggles the GPU occlusion culling for this model. Pays off for heavy models which are often
+     * hidden behind other objects.
+     */
+    void occlusionCulling(bool enabled);
+    [[nodiscard]] bool occlusionCulling() const;
+
+    /**
+     * Maximum screen space error of the levels of detail in pixels, zero disables them.
+     */
+    void maxScreenSpaceError(types::Float pixels);
+    [[nodiscard]] types::Float maxScreenSpaceError() const;
+
+    /**
+     * Results of the mesh optimization for every imported mesh, empty for the cooked models.
+     */
+    [[nodiscard]] std::vector<MeshOptimizer::Report> const &optimizationReports() const;
+
+    /**
+     * Triangles of the levels of detail picked during the last render.
+     */
+    [[nodiscard]] types::Size trianglesCount() const;
+
+    /**
+     * GPU memory taken by the vertices and the indices of all meshes.
+     */
+    [[nodiscard]] types::BinarySize sizeInBytes() const;
+
 private:
     std::shared_ptr<Window> _window;
     std::vector<std::shared_ptr<Mesh>> _meshes;
     std::vector<std::shared_ptr<Texture>> _loadedTextures;
+    std::vector<std::shared_ptr<TextureArray>> _textureArrays;
+    std::shared_ptr<TextureLoader> _textureLoader;
+    std::shared_ptr<TextureStreamer> _textureStreamer;
     std::unique_ptr<Transform3D> _transform;
     Material _material;
+    BoundingBox _boundingBox = BoundingBox::EMPTY;
 
-    void loadModel(std::filesystem::path const &modelPath);
+    std::unique_ptr<OcclusionQuery> _occlusionQuery;
+    std::shared_ptr<Mesh> _boundingBoxMesh;
 
-    /**
-     * In assimp each scene (the complete model) is a tree-like structure of nodes.  Each node can
-     * have multiple meshes. Going from the root node first we process every mesh belonging to the
-     * node, and then process all children nodes in a recursive manner.
-     *
-     * Pointers to meshes are only stored inside the scene as an array. Nodes refer to meshes by
-     * their indices. Same thing with materials: meshes store materials as indices of the array in
-     * the scene.
-     */
-    void processNode(aiNode *node, aiScene const *scene, std::filesystem::path const &modelPath);
+    std::vector<MeshOptimizer::Report> _optimizationReports;
+    Mesh::VertexCompression _vertexCompression = Mesh::UNCOMPRESSED;
+
+    types::Float _maxScreenSpaceError = DEFAULT_MAX_SCREEN_SPACE_ERROR;
+    mutable std::vector<types::Size> _levelsOfDetail;
+
+    void computeBoundingBox();
+    void collectTextureArrays();
+    void selectLevelsOfDetail(DrawingContext3D const &drawingContext) const;
+
+    void renderMeshes(Shader &shader, DrawingContext3D const &drawingContext) const;
 
     /**
-     * Converts the model from assimp format to my custom object for meshes. May return a nullptr in
-     * case assimp parser returns a mesh with no vertices or something else goes wrong.
+     * Draws the bounding box with the color and depth writes disabled.
      */
-    std::unique_ptr<Mesh>
-    processMesh(aiMesh *mesh, aiScene const *scene, std::filesystem::path const &modelPath);
+    void renderBoundingBox(Shader &shader, DrawingContext3D const &drawingContext) const;
+
+    void loadModel(std::filesystem::path const &modelPath, bool diffuseTextureArrays);
+    void loadCookedModel(std::filesystem::path const &modelPath);
 
     /**
-     * Loads textures assigned to the material from the disk.
+     * Textures referenced by several meshes are only loaded once.
      */
     std::vector<std::shared_ptr<Texture>>
-    loadMaterialTextures(aiMaterial *material,
-                         aiTextureType type,
-                         TextureType textureType,
-                         std::filesystem::path const &modelPath);
+    loadTextures(std::vector<MeshData::TextureReference> const &textureReferences);
 };
 
 } // namespace pf::gl
@@ -0,0 +1,149 @@
+#ifndef MODEL_IMPORTER_HPP
+#define MODEL_IMPORTER_HPP
+
+#include <array>
+#include <filesystem>
+#include <optional>
+#include <vector>
+
+#include <assimp/scene.h>
+
+#include <pf_gl/Image.hpp>
+#include <pf_gl/Mesh.hpp>
+#include <pf_gl/MeshData.hpp>
+#include <pf_gl/MeshOptimizer.hpp>
+#include <pf_gl/MeshSimplifier.hpp>
+#include <pf_gl/TextureArrayBuilder.hpp>
+#include <pf_gl/ValueTypes.hpp>
+
+namespace pf::gl
+{
+
+/**
+ * Reads a model and prepares its meshes for the upload: each one is optimized and its levels of
+ * detail are generated. Nothing is sent to the GPU here, so the same code is shared by the model
+ * loading at runtime and by the offline cooking.
+ *
+ * OBJ files are read by the `ObjLoader`, everything else goes through assimp.
+ *
+ * The diffuse textures can be arranged into texture arrays here as well (see
+ * `TextureArrayBuilder`), so that the meshes of the model are drawn without switching the textures.
+ */
+class ModelImporter final
+{
+public:
+    /**
+     * Target triangle counts of the generated levels of detail, relative to the original mesh.
+     */
+    static std::array<types::Float, 3> constexpr LEVELS_OF_DETAIL_RATIOS = {0.5F, 0.25F, 0.125F};
+
+    /**
+     * Meshes with fewer triangles are not worth simplifying.
+     */
+    static types::Size constexpr MIN_SIMPLIFIED_TRIANGLES_COUNT = 64;
+
+    enum Parser : types::UInt
+    {
+        NATIVE_PARSER,
+
+        /**
+         * Reads the OBJ files with assimp as well, mostly to compare the results.
+         */
+        ASSIMP_PARSER,
+    };
+
+    struct ImportedMesh
+    {
+        std::vector<Mesh::SimpleVertex> vertices;
+        std::vector<types::UInt> indices;
+        std::vector<MeshSimplifier::Result> levelsOfDetail;
+
+        /**
+         * Paths are resolved relative to the model file.
+         */
+        std::vector<MeshData::TextureReference> textures;
+        MeshOptimizer::Report optimizationReport;
+
+        /**
+         * Where the diffuse texture ended up in case the textures are arranged into arrays, the
+         * texture coordinates are already remapped into it. The diffuse textures are removed from
+         * the references then.
+         */
+        std::optional<TextureArrayBuilder::Region> diffuseRegion;
+    };
+
+    /**
+     * @param diffuseTextureArrays Whether the first diffuse texture of every mesh is moved into a
+     * texture array, the rest of the diffuse textures are dropped.
+     *
+     * @throws std::runtime_error in case the model or its diffuse textures fail to load.
+     */
+    explicit ModelImporter(std::filesystem::path const &modelPath,
+                           Parser parser = NATIVE_PARSER,
+                           bool diffuseTextureArrays = false);
+
+    [[nodiscard]] std::vector<ImportedMesh> const &meshes() const;
+
+    /**
+     * Layers of the arrays the diffuse textures are arranged into, indexed by the regions of the
+     * meshes. Empty unless they were requested.
+     */
+    [[nodiscard]] std::vector<std::vector<Image>> const &diffuseTextureArrays() const;
+
+    /**
+     * Only reads the meshes, without any optimization or levels of detail. Points and lines are
+     * skipped, the polygons are triangulated.
+     */
+    static std::vector<ImportedMesh> parse(std::filesystem::path const &modelPath,
+                                           Parser parser = NATIVE_PARSER);
+
+private:
+    std::vector<ImportedMesh> _meshes;
+    std::vector<std::vector<Image>> _diffuseTextureArrays;
+
+    /**
+     * In assimp each scene (the complete model) is a tree-like structure of nodes.  Each node can
+     * have multiple meshes. Going from the root node first we process every mesh belonging to the
+     * node, and then process all children nodes in a recursive manner.
+     *
+     * Pointers to meshes are only stored inside the scene as an array. Nodes refer to meshes by
+     * their indices. Same thing with materials: meshes store materials as indices of the array in
+     * the scene.
+     */
+    static void processNode(aiNode *node,
+                            aiScene const *scene,
+                            std::filesystem::path const &modelPath,
+                            std::vector<ImportedMesh> &meshes);
+
+    /**
+     * Converts the mesh from assimp format. Meshes with no triangles are skipped.
+     */
+    static void processMesh(aiMesh *mesh,
+                            aiScene const *scene,
+                            std::filesystem::path const &modelPath,
+                            std::vector<ImportedMesh> &meshes);
+
+    static void optimize(ImportedMesh &mesh);
+
+    /**
+     * Meshes sharing a diffuse texture share its region as well.
+     */
+    void arrangeDiffuseTextures();
+
+    static std::vector<MeshSimplifier::Result>
+    generateLevelsOfDetail(std::vector<Mesh::SimpleVertex> const &vertices,
+                           std::vector<types::UInt> const &indices);
+
+    /**
+     * Collects the textures assigned to the material.
+     */
+    static void materialTextures(aiMaterial *material,
+                                 aiTextureType assimpTextureType,
+                                 TextureType textureType,
+                                 std::filesystem::path const &modelPath,
+                                 std::vector<MeshData::TextureReference> &textures);
+};
+
+} // namespace pf::gl
+
+#endif // !MODEL_IMPORTER_HPP
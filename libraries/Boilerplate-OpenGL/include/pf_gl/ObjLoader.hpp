@@ -0,0 +1,66 @@
+#ifndef OBJ_LOADER_HPP
+#define OBJ_LOADER_HPP
+
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <pf_gl/Mesh.hpp>
+#include <pf_gl/MeshData.hpp>
+#include <pf_gl/ValueTypes.hpp>
+
+namespace pf::gl
+{
+
+/**
+ * Wavefront OBJ loader which does not go through assimp. The file is memory mapped and cut into
+ * chunks at line boundaries, the chunks are parsed in parallel and then merged.
+ *
+ * Faces are triangulated as fans and split by their materials, texture coordinates are flipped
+ * vertically and the vertices are welded by their (position, texture coordinates, normal) indices,
+ * which matches what the assimp import produces. Missing normals and texture coordinates are left
+ * zeroed. Only the diffuse (`map_Kd`) and specular (`map_Ks`) maps of the materials are read, lines
+ * and points are skipped.
+ */
+class ObjLoader final
+{
+public:
+    /**
+     * Smaller files are not worth splitting between the threads.
+     */
+    static size_t constexpr MIN_CHUNK_SIZE = 256 * 1024;
+
+    struct MaterialGroup
+    {
+        std::string material;
+        std::vector<Mesh::SimpleVertex> vertices;
+        std::vector<types::UInt> indices;
+
+        /**
+         * Paths are resolved relative to the model file.
+         */
+        std::vector<MeshData::TextureReference> textures;
+    };
+
+    /**
+     * Zero threads count means that the number of the hardware threads is used.
+     *
+     * @throws std::runtime_error in case the file cannot be read or is malformed.
+     */
+    static std::vector<MaterialGroup> load(std::filesystem::path const &path,
+                                           types::Size threadsCount = 0);
+
+    /**
+     * Parses the contents of an OBJ file, the material libraries are looked up in the directory.
+     */
+    static std::vector<MaterialGroup> parse(std::string_view text,
+                                            std::filesystem::path const &directory,
+                                            types::Size threadsCount = 0,
+                                            size_t minChunkSize = MIN_CHUNK_SIZE);
+};
+
+} // namespace pf::gl
+
+#endif // !OBJ_LOADER_HPP
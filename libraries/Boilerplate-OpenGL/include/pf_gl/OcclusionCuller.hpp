@@ -0,0 +1,122 @@
+#ifndef OCCLUSION_CULLER_HPP
+#define OCCLUSION_CULLER_HPP
+
+#include <memory>
+#include <span>
+#include <vector>
+
+#include <pf_gl/BoundingVolumes.hpp>
+#include <pf_gl/ValueTypes.hpp>
+#include <pf_utils/WorkerPool.hpp>
+
+namespace pf::gl
+{
+
+/**
+ * Software occlusion culling, which does not touch the GPU at all. Designated occluder meshes are
+ * rasterized into a low resolution depth buffer, then the screen space bounds of the occludees are
+ * tested against it. Depth values are in [0; 1], where 0 is the near plane.
+ *
+ * Every frame looks like this: `beginFrame`, `addOccluder` for every occluder, `rasterize`, then
+ * any number of `isVisible` calls (those can be made from multiple threads).
+ *
+ * The screen is split into tiles which are rasterized in parallel, four pixels at a time with SSE.
+ * After a tile is finished, the maximum depth of each 8x8 block of pixels is stored in the
+ * hierarchical depth buffer, so that most of the occludees are rejected without looking at the
+ * individual pixels.
+ */
+class OcclusionCuller final
+{
+public:
+    static types::Size constexpr DEFAULT_WIDTH = 256;
+    static types::Size constexpr DEFAULT_HEIGHT = 128;
+
+    static types::Size constexpr TILE_WIDTH = 64;
+    static types::Size constexpr TILE_HEIGHT = 32;
+    static types::Size constexpr BLOCK_SIZE = 8;
+
+    struct Statistics
+    {
+        types::Size rasterizedTrianglesCount = 0;
+        types::Size visibleCount = 0;
+        types::Size occludedCount = 0;
+    };
+
+    /**
+     * Width and height must be multiples of the tile size. Zero threads count means that the
+     * number of the hardware threads is used.
+     */
+    explicit OcclusionCuller(types::Size width = DEFAULT_WIDTH,
+                             types::Size height = DEFAULT_HEIGHT,
+                             types::Size threadsCount = 0);
+
+    /**
+     * Clears the depth buffer and the occluders from the previous frame.
+     */
+    void beginFrame(types::FMat4 const &viewProjectionMatrix);
+
+    /**
+     * Triangles are expected to be counter-clockwise, back faces are skipped. Triangles crossing
+     * the near plane are skipped as well, which can only make the culling less efficient, but never
+     * incorrect.
+     */
+    void addOccluder(std::span<types::FVec3 const> vertices,
+                     std::span<types::UInt const> indices,
+                     types::FMat4 const &modelMatrix);
+
+    void rasterize();
+
+    /**
+     * Conservative test: returns false only in case the box is completely hidden behind the
+     * rasterized occluders (or is outside of the screen).
+     */
+    [[nodiscard]] bool isVisible(BoundingBox const &worldBox) const;
+
+    /**
+     * Tests the boxes referenced by `indices` and leaves only the visible ones there (the order is
+     * preserved). Unlike `isVisible` updates the statistics.
+     */
+    void cull(std::span<BoundingBox const> worldBoxes, std::vector<types::UInt> &indices);
+
+    [[nodiscard]] types::Float depth(types::Size x, types::Size y) const;
+    [[nodiscard]] types::Size width() const;
+    [[nodiscard]] types::Size height() const;
+
+    [[nodiscard]] Statistics const &statistics() const;
+    void resetStatistics();
+
+private:
+    /**
+     * Triangle prepared for rasterization: three edge functions and a depth plane, all of the form
+     * `a * x + b * y + c` in pixel coordinates.
+     */
+    struct ScreenTriangle
+    {
+        types::FVec3 edges[3];
+        types::FVec3 depthPlane;
+        types::IntVec2 min, max;
+    };
+
+    types::Size _width, _height;
+    types::Size _tilesX, _tilesY;
+
+    // Persistent, woken up once per `rasterize`; behind a pointer to keep the culler movable
+    std::unique_ptr<pf::util::WorkerPool> _workers;
+
+    types::FMat4 _viewProjectionMatrix = types::DEFAULT_VALUE<types::FMat4>;
+
+    std::vector<types::Float> _depth;
+    std::vector<types::Float> _blocksMaxDepth;
+
+    std::vector<ScreenTriangle> _triangles;
+    std::vector<std::vector<types::UInt>> _tileBins;
+
+    Statistics _statistics;
+
+    void rasterizeTile(types::Size tileIndex);
+    void updateBlocksDepth(types::Size tileIndex);
+};
+
+} // namespace pf::gl
+
+#endif // !OCCLUSION_CULLER_HPP
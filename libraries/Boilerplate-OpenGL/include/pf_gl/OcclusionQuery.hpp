@@ -0,0 +1,79 @@
+#ifndef OCCLUSION_QUERY_HPP
+#define OCCLUSION_QUERY_HPP
+
+#include <memory>
+
+#include <glad/glad.h>
+
+#include <pf_gl/Window.hpp>
+#include <pf_gl/ValueTypes.hpp>
+
+namespace pf::gl
+{
+
+/**
+ * Query telling whether any samples of the draws issued between `begin` and `end` have passed the
+ * depth test. Uses GL_ANY_SAMPLES_PASSED_CONSERVATIVE when it is available (OpenGL 4.3+).
+ *
+ * The result is never waited for on the CPU: it is either polled with `pollResult` or consumed on
+ * the GPU side by the conditional rendering.
+ */
+class OcclusionQuery final
+{
+public:
+    enum ConditionalRenderMode
+    {
+        /**
+         * The GPU waits for the result of the query.
+         */
+        WAIT,
+
+        /**
+         * Draws are performed in case the result is not available yet.
+         */
+        NO_WAIT,
+    };
+
+    explicit OcclusionQuery(std::shared_ptr<Window> window);
+
+    OcclusionQuery(OcclusionQuery const &) = delete;
+    OcclusionQuery(OcclusionQuery &&) = default;
+
+    ~OcclusionQuery();
+
+    OcclusionQuery &operator=(OcclusionQuery const &) = delete;
+    OcclusionQuery &operator=(OcclusionQuery &&) = default;
+
+    void begin();
+    void end();
+
+    /**
+     * Fetches the result of the last issued query without blocking. Returns `true` in case a new
+     * result has been fetched.
+     */
+    bool pollResult();
+
+    /**
+     * Returns `true` in case the query has been issued, but its result has not been fetched yet.
+     */
+    [[nodiscard]] bool isPending() const;
+
+    /**
+     * Last fetched result. Objects are considered visible until the first result is fetched.
+     */
+    [[nodiscard]] bool anySamplesPassed() const;
+
+    void beginConditionalRender(ConditionalRenderMode mode) const;
+    void endConditionalRender() const;
+
+private:
+    std::shared_ptr<Window> _window;
+    types::UInt _id;
+    GLenum _target;
+    bool _pending = false;
+    bool _anySamplesPassed = true;
+};
+
+} // namespace pf::gl
+
+#endif // !OCCLUSION_QUERY_HPP
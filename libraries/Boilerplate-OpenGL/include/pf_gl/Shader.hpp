@@ -1,24 +1,86 @@
 #ifndef SHADER_HPP
 #define SHADER_HPP
 
+#include <cassert>
+#include <concepts>
+#include <cstdint>
 #include <memory>
 #include <filesystem>
 #include <span>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 #include <stdexcept>
 
-#include <sparsepp/spp.h>
+#include <glad/glad.h>
 
+#include <pf_gl/ShaderCache.hpp>
 #include <pf_gl/Window.hpp>
 #include <pf_gl/ValueTypes.hpp>
-#include <pf_utils/Hashing.hpp>
 
 namespace pf::gl
 {
 
 struct Uniform;
+struct ShaderBlock;
+struct VertexInput;
+
+/**
+ * Types of the values the uniforms can be set to. The integers also set the booleans and the
+ * samplers.
+ */
+template <typename T>
+concept UniformValue = std::same_as<T, types::Float> || std::same_as<T, types::FVec2> ||
+                       std::same_as<T, types::FVec3> || std::same_as<T, types::FVec4> ||
+                       std::same_as<T, types::FMat4> || std::same_as<T, types::Int> ||
+                       std::same_as<T, types::IntVec2> || std::same_as<T, types::Bool>;
+
+template <UniformValue T>
+struct UniformAssignment;
+
+/**
+ * Uniform of a program resolved once by `Shader::uniformHandle`, so that setting it does not look
+ * the name up. The type of the values is checked against the uniform when the handle is created.
+ *
+ * The default handle refers to no uniform, setting it does nothing.
+ */
+template <UniformValue T>
+class UniformHandle final
+{
+public:
+    UniformHandle() = default;
+
+    [[nodiscard]] types::Int location() const
+    {
+        return _location;
+    }
+
+    [[nodiscard]] UniformAssignment<T> with(T const &value) const
+    {
+        return {*this, value};
+    }
+
+private:
+    friend class Shader;
+
+    types::UInt _programId = 0;
+    types::Int _location = -1;
+
+    UniformHandle(types::UInt programId, types::Int location)
+        : _programId(programId)
+        , _location(location)
+    {
+    }
+};
+
+template <UniformValue T>
+struct UniformAssignment
+{
+    UniformHandle<T> handle;
+    T value;
+};
 
 class Shader final
 {
@@ -36,20 +98,39 @@ public:
     Shader();
 
     Shader(Shader const &) = delete;
-    Shader(Shader &&) = default;
+    Shader(Shader &&other) noexcept;
 
+    /**
+     * The `#include` directives of the sources are resolved relative to the including file, see
+     * `ShaderPreprocessor`.
+     *
+     * With a cache the program is loaded from its binary in case the sources have not changed
+     * since it was last linked, otherwise it is compiled and the binary is stored.
+     */
     Shader(std::shared_ptr<Window> window,
            std::filesystem::path const &vertexShaderPath,
-           std::filesystem::path const &fragmentShaderPath);
+           std::filesystem::path const &fragmentShaderPath,
+           std::shared_ptr<ShaderCache> const &cache = nullptr);
 
     Shader(std::shared_ptr<Window> window,
            std::filesystem::path const &shaderPath,
-           Type shaderType);
+           Type shaderType,
+           std::shared_ptr<ShaderCache> const &cache = nullptr);
 
     ~Shader();
 
     Shader &operator=(Shader const &) = delete;
-    Shader &operator=(Shader &&) = default;
+    Shader &operator=(Shader &&other) noexcept;
+
+    /**
+     * Variant of a program which only writes the depth: the given vertex shader is linked with a
+     * generated fragment shader that does nothing. The vertex shader is compiled from the same
+     * source as for the full program, so the positions match exactly in case it declares
+     * `invariant gl_Position`.
+     */
+    static Shader depthOnly(std::shared_ptr<Window> window,
+                            std::filesystem::path const &vertexShaderPath,
+                            std::shared_ptr<ShaderCache> const &cache = nullptr);
 
     void use() const;
     void unbind() const;
@@ -57,6 +138,43 @@ public:
     [[nodiscard]] types::UInt id() const;
     [[nodiscard]] std::span<Uniform const> uniforms() const;
 
+    /**
+     * Only listed with GL 4.3, as well as the storage blocks and the vertex inputs.
+     */
+    [[nodiscard]] std::span<ShaderBlock const> uniformBlocks() const;
+    [[nodiscard]] std::span<ShaderBlock const> storageBlocks() const;
+    [[nodiscard]] std::span<VertexInput const> vertexInputs() const;
+
+    /**
+     * Also accepts the name of an array without the index of the first element.
+     *
+     * @throws std::invalid_argument in case there is no such active uniform, or it is of another
+     * type.
+     */
+    template <UniformValue T>
+    [[nodiscard]] UniformHandle<T> uniformHandle(std::string_view name) const;
+
+    template <UniformValue T>
+    void setUniformValue(UniformHandle<T> handle, T const &value)
+    {
+        setUniforms(handle.with(value));
+    }
+
+    /**
+     * Sets the uniforms without making the program current, unless there is no GL 4.1 to do
+     * that. Then the program is made current once for all of them.
+     */
+    template <UniformValue... T>
+    void setUniforms(UniformAssignment<T> const &...assignments)
+    {
+        prepareUniforms();
+        (assert(assignments.handle._location == -1 || assignments.handle._programId == _id), ...);
+        (uploadUniform(assignments.handle._location, assignments.value), ...);
+    }
+
+    /**
+     * These look the uniform up on every call, the handles are meant for the frame loop.
+     */
     void setUniformValue(char const *name, types::Float value);
     void setUniformValue(char const *name, types::FVec3 value);
     void setUniformValue(char const *name, types::FVec2 value);
@@ -66,14 +184,56 @@ public:
     void setUniformValue(char const *name, types::Bool value);
 
 private:
+    friend class ShaderBuilder;
+    friend class ShaderLibrary;
+
     types::UInt _id;
     std::shared_ptr<Window> _window;
     std::vector<Uniform> _uniforms;
+    std::vector<ShaderBlock> _uniformBlocks;
+    std::vector<ShaderBlock> _storageBlocks;
+    std::vector<VertexInput> _vertexInputs;
+
+    /**
+     * Takes over the program which has already been linked.
+     */
+    Shader(std::shared_ptr<Window> window, types::UInt programId);
+
+    /**
+     * Source of the shader with its includes resolved.
+     */
+    static std::string readSource(std::filesystem::path const &shaderPath);
+
+    /**
+     * Fragment shader of the `depthOnly` variant, same version as the vertex shader.
+     */
+    static std::string depthOnlyFragmentSource(std::string const &vertexShaderSource);
+
+    /**
+     * Key of the program in the cache, needs the context of the program to be bound.
+     */
+    static std::uint64_t cacheKey(std::vector<std::pair<Type, std::string>> const &stages);
 
     GLint getUniformLocation(char const *name);
+    void prepareUniforms() const;
+    void uploadUniform(types::Int location, types::Float value) const;
+    void uploadUniform(types::Int location, types::FVec2 const &value) const;
+    void uploadUniform(types::Int location, types::FVec3 const &value) const;
+    void uploadUniform(types::Int location, types::FVec4 const &value) const;
+    void uploadUniform(types::Int location, types::FMat4 const &value) const;
+    void uploadUniform(types::Int location, types::Int value) const;
+    void uploadUniform(types::Int location, types::IntVec2 const &value) const;
+    void uploadUniform(types::Int location, types::Bool value) const;
+    void createProgram(std::vector<std::pair<Type, std::string>> const &stages, ShaderCache *cache);
     GLuint compileShader(char const *shaderSource, Type shaderType);
-    GLuint linkProgram(std::vector<types::UInt> const &shaderIds);
-    void retrieveUniforms();
+    GLuint linkProgram(std::vector<types::UInt> const &shaderIds, bool retrievable = false);
+
+    /**
+     * Lists the active resources of the linked program, the uniforms of the default block are
+     * listed with their locations.
+     */
+    void introspect();
+    void introspectUniformsWithoutInterfaceQuery();
 };
 
 struct Uniform
@@ -87,6 +247,8 @@ struct Uniform
         PROJECTION_MATRIX,
         DIFFUSE_TEXTURE,
         SPECULAR_TEXTURE,
+        DIFFUSE_TEXTURE_ARRAY,
+        TEXTURE_LAYER,
         SHININESS,
         COLOR,
 
@@ -123,11 +285,6 @@ struct Uniform
         GENERIC,
     };
 
-    static spp::sparse_hash_map<std::string, Purpose> const NAME_TO_PURPOSE;
-    static spp::sparse_hash_map<std::pair<Uniform::Purpose, std::string>,
-                                Uniform::Purpose,
-                                pf::util::PairHash> const CONTEXT_NAME_TO_PURPOSE;
-
     std::string fullName;
     // everything before the first period in the full name, also the array index is removed
     std::string baseName;
@@ -140,8 +297,36 @@ struct Uniform
     // In case the base name of the uniform name has an array index it is stored here
     types::Int arrayIndex = -1;
 
-    types::Int location;
+    types::Int location = -1;
     Purpose purpose = GENERIC;
+
+    // GL type of the uniform and the number of the elements in case it is an array
+    GLenum type = 0;
+    types::Int arraySize = 1;
+
+    /**
+     * Splits the name of an active uniform as it is reported by GL and derives the purpose from
+     * it, the rest is left to the caller.
+     */
+    static Uniform fromName(std::string_view fullName);
+};
+
+/**
+ * Uniform or shader storage block.
+ */
+struct ShaderBlock
+{
+    std::string name;
+    types::Int binding = 0;
+    types::Int dataSize = 0;
+};
+
+struct VertexInput
+{
+    std::string name;
+    types::Int location = -1;
+    GLenum type = 0;
+    types::Int arraySize = 1;
 };
 
 } // namespace pf::gl
@@ -0,0 +1,127 @@
+#ifndef SHADER_BUILDER_HPP
+#define SHADER_BUILDER_HPP
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <pf_gl/Shader.hpp>
+#include <pf_gl/ShaderCache.hpp>
+#include <pf_gl/ValueTypes.hpp>
+#include <pf_gl/Window.hpp>
+
+namespace pf::gl
+{
+
+/**
+ * Builds a batch of programs without waiting for each of them in turn. `Shader` checks the status
+ * right after every compilation and link, which makes the driver finish them one by one. Here all
+ * the compilations and links are issued as the programs are added, and their status is only
+ * checked once the driver reports them as completed (GL_KHR_parallel_shader_compile), so that the
+ * driver is free to build them on several threads while the application keeps going.
+ *
+ * Without the extension the completion cannot be checked without blocking, `poll` finishes one
+ * program per call then, still after all of them have been issued.
+ *
+ * Programs found in the cache are ready right away.
+ */
+class ShaderBuilder final
+{
+public:
+    using Handle = types::Size;
+
+    explicit ShaderBuilder(std::shared_ptr<Window> window,
+                           std::shared_ptr<ShaderCache> cache = nullptr);
+
+    ShaderBuilder(ShaderBuilder const &) = delete;
+    ShaderBuilder(ShaderBuilder &&) = delete;
+
+    /**
+     * Deletes the programs which have not been taken.
+     */
+    ~ShaderBuilder();
+
+    ShaderBuilder &operator=(ShaderBuilder const &) = delete;
+    ShaderBuilder &operator=(ShaderBuilder &&) = delete;
+
+    Handle add(std::filesystem::path const &vertexShaderPath,
+               std::filesystem::path const &fragmentShaderPath);
+    Handle add(std::filesystem::path const &shaderPath, Shader::Type shaderType);
+
+    /**
+     * Same as `Shader::depthOnly`.
+     */
+    Handle addDepthOnly(std::filesystem::path const &vertexShaderPath);
+
+    /**
+     * Checks the programs the driver has completed, never blocks in case the parallel compilation
+     * is supported. Returns `true` in case all programs are ready.
+     */
+    bool poll();
+
+    /**
+     * Blocks until all programs are ready.
+     */
+    void finish();
+
+    /**
+     * Whether the program has been built, successfully or not.
+     */
+    [[nodiscard]] bool isReady(Handle handle) const;
+
+    /**
+     * Hands the program over, the handle cannot be used anymore.
+     *
+     * @throws std::logic_error in case the program is not ready yet or has been taken already.
+     * @throws std::runtime_error in case the program has failed to compile or link.
+     */
+    [[nodiscard]] Shader take(Handle handle);
+
+    [[nodiscard]] types::Size pendingCount() const;
+
+    /**
+     * Whether the driver reports the completion of the builds (GL_KHR_parallel_shader_compile or
+     * its ARB variant).
+     */
+    [[nodiscard]] bool isParallel() const;
+
+private:
+    enum State
+    {
+        PENDING,
+        READY,
+        FAILED,
+        TAKEN,
+    };
+
+    struct Program
+    {
+        std::string name;
+        types::UInt id = 0;
+        std::vector<std::pair<types::UInt, Shader::Type>> shaders;
+        std::uint64_t cacheKey = 0;
+        State state = PENDING;
+        std::string error;
+    };
+
+    std::shared_ptr<Window> _window;
+    std::shared_ptr<ShaderCache> _cache;
+    std::vector<Program> _programs;
+    types::Size _pendingCount = 0;
+    bool _parallel = false;
+
+    Handle add(std::string name, std::vector<std::pair<Shader::Type, std::string>> const &stages);
+    [[nodiscard]] bool isCompleted(Program const &program) const;
+
+    /**
+     * Reads the status of the program and its shaders, blocks in case they are not completed.
+     */
+    void complete(Program &program);
+};
+
+} // namespace pf::gl
+
+#endif // !SHADER_BUILDER_HPP
@@ -0,0 +1,125 @@
+#ifndef SHADER_CACHE_HPP
+#define SHADER_CACHE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include <pf_gl/ValueTypes.hpp>
+
+namespace pf::gl
+{
+
+/**
+ * Linked programs stored on disk as the driver binaries (`glGetProgramBinary`), so that they are
+ * not compiled again on the next launch. Every program is a file of its own in the directory of
+ * the cache, named after its key.
+ *
+ * A binary is only valid for the exact driver it was produced by, which is a part of the key, and
+ * the driver may still reject it after an update. The programs are compiled from the sources then
+ * and the cache entry is rewritten.
+ */
+class ShaderCache final
+{
+public:
+    static constexpr char const *EXTENSION = ".pfprogram";
+
+    /**
+     * "PFPB" in the little-endian order.
+     */
+    static std::uint32_t constexpr MAGIC = 0x42504650;
+    static std::uint32_t constexpr VERSION = 1;
+
+    struct Entry
+    {
+        GLenum binaryFormat = 0;
+        std::vector<std::byte> binary;
+    };
+
+    struct Statistics
+    {
+        /**
+         * Programs loaded from the binaries.
+         */
+        types::Size hits = 0;
+
+        /**
+         * Programs compiled from the sources, either missing from the cache or rejected.
+         */
+        types::Size misses = 0;
+
+        /**
+         * Binaries the driver has refused to load, included into the misses.
+         */
+        types::Size rejected = 0;
+    };
+
+    /**
+     * The directory is created in case it does not exist.
+     */
+    explicit ShaderCache(std::filesystem::path directory);
+
+    /**
+     * Hash of everything the compiled program depends on: the sources of all stages in order, the
+     * preprocessor definitions and the identity of the driver (see `driverIdentity`).
+     */
+    [[nodiscard]] static std::uint64_t key(std::span<std::string const> sources,
+                                           std::span<std::string const> definitions,
+                                           std::string_view driverIdentity);
+
+    /**
+     * Vendor, renderer and version strings of the current context.
+     */
+    [[nodiscard]] static std::string driverIdentity();
+
+    /**
+     * Whether the current context can retrieve and load the program binaries (OpenGL 4.1+ with at
+     * least one binary format).
+     */
+    [[nodiscard]] static bool isSupported();
+
+    /**
+     * Reads the entry from disk, nothing in case there is none or the file is malformed.
+     */
+    [[nodiscard]] std::optional<Entry> load(std::uint64_t key) const;
+
+    /**
+     * The file is written under a temporary name first, a crash never leaves a partial entry.
+     *
+     * @throws std::runtime_error in case the file cannot be written.
+     */
+    void store(std::uint64_t key, Entry const &entry) const;
+
+    /**
+     * Creates a program from the cached binary. Returns nothing in case there is no entry or the
+     * driver rejects it, the program is counted as a miss then and is expected to be compiled.
+     */
+    [[nodiscard]] std::optional<types::UInt> loadProgram(std::uint64_t key);
+
+    /**
+     * Stores the binary of the linked program, which must have been linked with
+     * GL_PROGRAM_BINARY_RETRIEVABLE_HINT. Failures are ignored, the program is compiled again next
+     * time. Returns `true` in case the entry has been written.
+     */
+    bool storeProgram(std::uint64_t key, types::UInt program);
+
+    [[nodiscard]] std::filesystem::path const &directory() const;
+    [[nodiscard]] Statistics const &statistics() const;
+
+private:
+    std::filesystem::path _directory;
+    Statistics _statistics;
+
+    [[nodiscard]] std::filesystem::path entryPath(std::uint64_t key) const;
+};
+
+} // namespace pf::gl
+
+#endif // !SHADER_CACHE_HPP
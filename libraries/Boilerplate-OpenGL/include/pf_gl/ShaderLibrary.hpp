@@ -0,0 +1,87 @@
+#ifndef SHADER_LIBRARY_HPP
+#define SHADER_LIBRARY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <sparsepp/spp.h>
+
+#include <pf_gl/Shader.hpp>
+#include <pf_gl/ShaderCache.hpp>
+#include <pf_gl/ShaderPreprocessor.hpp>
+#include <pf_gl/ValueTypes.hpp>
+#include <pf_gl/Window.hpp>
+
+namespace pf::gl
+{
+
+/**
+ * Specialized permutations of one program: every feature (an enabled light, a present texture)
+ * is a bit of the mask the program is requested with, and a macro the shaders check with `#ifdef`.
+ * The branches of the disabled features are compiled out instead of being skipped per fragment.
+ *
+ * The sources are read and their includes resolved once, the permutations are compiled on the
+ * first request. With a cache the permutations seen in the previous launches are only loaded.
+ */
+class ShaderLibrary final
+{
+public:
+    using Features = std::uint32_t;
+
+    static std::size_t constexpr MAX_FEATURES_COUNT = 32;
+
+    /**
+     * @param featureNames Macro defined for each bit of the features, starting with the lowest.
+     * @param constants Definitions shared by all of the permutations, such as the array sizes.
+     *
+     * @throws std::invalid_argument in case there are more than `MAX_FEATURES_COUNT` features.
+     */
+    ShaderLibrary(std::shared_ptr<Window> window,
+                  std::filesystem::path const &vertexShaderPath,
+                  std::filesystem::path const &fragmentShaderPath,
+                  std::vector<std::string> featureNames,
+                  std::vector<ShaderDefinition> constants = {},
+                  std::shared_ptr<ShaderCache> cache = nullptr,
+                  ShaderPreprocessor const &preprocessor = ShaderPreprocessor());
+
+    ShaderLibrary(ShaderLibrary const &) = delete;
+    ShaderLibrary(ShaderLibrary &&) = delete;
+
+    ~ShaderLibrary() = default;
+
+    ShaderLibrary &operator=(ShaderLibrary const &) = delete;
+    ShaderLibrary &operator=(ShaderLibrary &&) = delete;
+
+    /**
+     * The permutation stays valid for the lifetime of the library.
+     *
+     * @throws std::invalid_argument in case a bit without a feature is set.
+     */
+    Shader &get(Features features);
+
+    /**
+     * The constants followed by the enabled features.
+     *
+     * @throws std::invalid_argument in case a bit without a feature is set.
+     */
+    [[nodiscard]] std::vector<ShaderDefinition> definitions(Features features) const;
+
+    [[nodiscard]] types::Size permutationsCount() const;
+
+private:
+    std::shared_ptr<Window> _window;
+    std::shared_ptr<ShaderCache> _cache;
+    std::string _vertexShaderSource;
+    std::string _fragmentShaderSource;
+    std::vector<std::string> _featureNames;
+    std::vector<ShaderDefinition> _constants;
+    spp::sparse_hash_map<Features, std::unique_ptr<Shader>> _permutations;
+};
+
+} // namespace pf::gl
+
+#endif // !SHADER_LIBRARY_HPP
@@ -0,0 +1,76 @@
+#ifndef SHADER_PREPROCESSOR_HPP
+#define SHADER_PREPROCESSOR_HPP
+
+#include <filesystem>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace pf::gl
+{
+
+struct ShaderDefinition
+{
+    std::string name;
+
+    /**
+     * Left empty for the flags which are only checked with `#ifdef`.
+     */
+    std::string value;
+};
+
+/**
+ * Does what the GLSL compiler does not: resolves the `#include` directives and injects the
+ * definitions of the application into the sources. Everything else is left to the preprocessor of
+ * the driver.
+ *
+ * Quoted includes (`#include "lights.glsl"`) are looked up next to the including file first, then
+ * in the include directories, angled ones (`#include <lights.glsl>`) only in the include
+ * directories. Every file is pasted once per shader, the later includes of the same file are
+ * dropped, so that the shared files do not need any guards.
+ */
+class ShaderPreprocessor final
+{
+public:
+    struct Result
+    {
+        std::string source;
+
+        /**
+         * The shader itself and then every included file in the order of the first inclusion. The
+         * source string numbers of the `#line` directives put around the included parts are the
+         * indices in here, the compilation errors are reported with them.
+         */
+        std::vector<std::filesystem::path> files;
+    };
+
+    explicit ShaderPreprocessor(std::vector<std::filesystem::path> includeDirectories = {});
+
+    /**
+     * @throws std::runtime_error in case an included file cannot be found.
+     */
+    [[nodiscard]] Result process(std::filesystem::path const &shaderPath) const;
+
+    /**
+     * Puts a `#define` for each of the definitions right after the `#version` directive, which
+     * has to stay the first one. The line numbers of the rest of the source are kept.
+     *
+     * @throws std::invalid_argument in case the source has no version directive.
+     */
+    [[nodiscard]] static std::string define(std::string const &source,
+                                            std::span<ShaderDefinition const> definitions);
+
+    [[nodiscard]] std::span<std::filesystem::path const> includeDirectories() const;
+
+private:
+    std::vector<std::filesystem::path> _includeDirectories;
+
+    void processFile(std::filesystem::path const &path, Result &result) const;
+    [[nodiscard]] std::filesystem::path resolve(std::string const &includedName,
+                                                bool quoted,
+                                                std::filesystem::path const &includingPath) const;
+};
+
+} // namespace pf::gl
+
+#endif // !SHADER_PREPROCESSOR_HPP
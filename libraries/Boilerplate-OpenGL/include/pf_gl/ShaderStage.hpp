@@ -0,0 +1,37 @@
+#ifndef SHADER_STAGE_HPP
+#define SHADER_STAGE_HPP
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+#include <glad/glad.h>
+
+#include <pf_gl/Shader.hpp>
+
+namespace pf::gl
+{
+
+struct ShaderStage
+{
+    GLenum glEnum;
+    std::string_view humanName;
+};
+
+/**
+ * Indexed by `Shader::Type`.
+ */
+inline constexpr std::array<ShaderStage, 3> SHADER_STAGES = {{
+    {.glEnum = GL_VERTEX_SHADER, .humanName = "vertex shader"},
+    {.glEnum = GL_FRAGMENT_SHADER, .humanName = "fragment shader"},
+    {.glEnum = GL_COMPUTE_SHADER, .humanName = "compute shader"},
+}};
+
+constexpr bool isSupported(Shader::Type shaderType)
+{
+    return shaderType >= 0 && static_cast<std::size_t>(shaderType) < SHADER_STAGES.size();
+}
+
+} // namespace pf::gl
+
+#endif // !SHADER_STAGE_HPP
@@ -0,0 +1,67 @@
+#ifndef SKYLINE_PACKER_HPP
+#define SKYLINE_PACKER_HPP
+
+#include <optional>
+#include <vector>
+
+#include <pf_gl/ValueTypes.hpp>
+
+namespace pf::gl
+{
+
+/**
+ * Packs rectangles into a fixed size bin, keeping track of the skyline: the top edge of the
+ * packed rectangles, as a list of horizontal segments. A rectangle is placed at the lowest
+ * position along the skyline, the space below the skyline which is not covered is lost. Works
+ * best for the rectangles sorted by height, tallest first.
+ */
+class SkylinePacker final
+{
+public:
+    struct Rectangle
+    {
+        types::Size x;
+        types::Size y;
+        types::Size width;
+        types::Size height;
+    };
+
+    /**
+     * @throws std::invalid_argument in case the bin is empty.
+     */
+    SkylinePacker(types::Size width, types::Size height);
+
+    /**
+     * @return Position of the rectangle within the bin, or nothing in case it does not fit.
+     */
+    std::optional<Rectangle> insert(types::Size width, types::Size height);
+
+    /**
+     * Part of the bin covered by the packed rectangles.
+     */
+    [[nodiscard]] types::Float occupancy() const;
+
+private:
+    struct Segment
+    {
+        types::Size x;
+        types::Size y;
+        types::Size width;
+    };
+
+    types::Size _width;
+    types::Size _height;
+    std::vector<Segment> _skyline;
+    types::BinarySize _usedArea = 0;
+
+    /**
+     * Height at which the rectangle would rest, when its left edge is at the start of the segment.
+     */
+    [[nodiscard]] std::optional<types::Size> fit(size_t segmentIndex,
+                                                 types::Size width,
+                                                 types::Size height) const;
+};
+
+} // namespace pf::gl
+
+#endif // !SKYLINE_PACKER_HPP
@@ -6,6 +6,7 @@
 
 #include <glad/glad.h>
 
+#include <pf_gl/TextureFile.hpp>
 #include <pf_gl/Window.hpp>
 #include <pf_gl/ValueTypes.hpp>
 
@@ -18,9 +19,6 @@ enum TextureType
     SPECULAR,
 };
 
-// TODO(poppyfanboy) Add an Image class which will be used to convert images to raw RGB(A) data.
-// Pass `Image` class instances to `Texture` constructors.
-
 // TODO(poppyfanboy) Replace GLenums with custom enums.
 
 // TODO(poppyfanboy) Add a builder for the texture objects.
@@ -28,6 +26,14 @@ enum TextureType
 class Texture final
 {
 public:
+    /**
+     * Images are decoded with stb into RGBA8 and their mip chain is generated on the GPU. Textures
+     * cooked into `TextureFile`s (`.ktx2`) are uploaded compressed with the mip chain stored in the
+     * file, they are flipped at cooking, so `flipVertically` is ignored for them.
+     *
+     * The storage is immutable (`glTexStorage2D`) when the context supports it. Decoding blocks the
+     * calling thread, use `TextureLoader` to load many textures without stalling the frames.
+     */
     Texture(std::shared_ptr<Window> window,
             std::filesystem::path const &,
             TextureType textureType,
@@ -50,12 +56,64 @@ public:
     [[nodiscard]] TextureType type() const;
     [[nodiscard]] std::filesystem::path filePath() const;
 
+    /**
+     * False for the textures of a `TextureLoader` until their image is uploaded, sampling them
+     * gives black in the meantime.
+     */
+    [[nodiscard]] bool isLoaded() const;
+
 private:
+    friend class TextureLoader;
+    friend class TextureStreamer;
+
     std::shared_ptr<Window> _window;
     TextureType _textureType;
-    types::Size _width, _height;
-    types::UInt _texture;
+    types::Size _width = 0;
+    types::Size _height = 0;
+    types::UInt _texture = 0;
     std::filesystem::path _filePath;
+    bool _loaded = false;
+
+    /**
+     * Texture without any storage, it is allocated by `TextureLoader` once the image is decoded.
+     */
+    Texture(std::shared_ptr<Window> window,
+            std::filesystem::path filePath,
+            TextureType textureType,
+            types::Int wrapS,
+            types::Int wrapT,
+            types::Int minFilter,
+            types::Int magFilter);
+
+    void generate(types::Int wrapS, types::Int wrapT, types::Int minFilter, types::Int magFilter);
+
+    /**
+     * Immutable storage in case `glTexStorage2D` is available (OpenGL 4.2). The texture is edited
+     * with Direct State Access (OpenGL 4.5) when possible, otherwise it is bound to `GL_TEXTURE_2D`
+     * for the time of the call.
+     */
+    void allocateStorage(types::Size width,
+                         types::Size height,
+                         GLenum internalFormat,
+                         types::Size levelsCount);
+
+    /**
+     * Rows of RGBA8 pixels of the base level. With a buffer bound to `GL_PIXEL_UNPACK_BUFFER` the
+     * pixels are an offset into it.
+     */
+    void uploadPixels(types::Int firstRow, types::Size rowsCount, void const *pixels);
+    void generateMipmap();
+
+    void loadImage(bool flipVertically);
+    void loadCompressed();
+
+    /**
+     * Partial residency used by `TextureStreamer`: the storage is mutable, and only the levels
+     * between the base level and the smallest one are there, the rest are released.
+     */
+    void uploadLevel(TextureFile const &file, types::Size level);
+    void releaseLevel(TextureFile const &file, types::Size level);
+    void residentLevels(types::Size baseLevel, types::Size levelsCount);
 };
 
 } // namespace pf::gl
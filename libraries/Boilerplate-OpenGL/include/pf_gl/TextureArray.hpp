@@ -0,0 +1,72 @@
+#ifndef TEXTURE_ARRAY_HPP
+#define TEXTURE_ARRAY_HPP
+
+#include <memory>
+#include <span>
+
+#include <glad/glad.h>
+
+#include <pf_gl/Image.hpp>
+#include <pf_gl/Texture.hpp>
+#include <pf_gl/ValueTypes.hpp>
+#include <pf_gl/Window.hpp>
+
+namespace pf::gl
+{
+
+/**
+ * `GL_TEXTURE_2D_ARRAY` with RGBA8 layers of the same size, usually made by `TextureArrayBuilder`.
+ * Meshes which sample different layers of the same array do not need any texture switches between
+ * their draws, only the layer index changes. Sampled with a `sampler2DArray`.
+ */
+class TextureArray final
+{
+public:
+    /**
+     * Unit the arrays are sampled from, away from the units of the regular textures, which start
+     * from the first one. Nothing else is bound there, so an array stays bound between the draws.
+     */
+    static types::Int constexpr TEXTURE_UNIT = 15;
+
+    /**
+     * @throws std::invalid_argument in case there are no layers or their sizes differ.
+     */
+    TextureArray(std::shared_ptr<Window> window,
+                 std::span<Image const> layers,
+                 TextureType textureType,
+                 types::Int wrapS = GL_CLAMP_TO_EDGE,
+                 types::Int wrapT = GL_CLAMP_TO_EDGE,
+                 types::Int minFilter = GL_LINEAR_MIPMAP_LINEAR,
+                 types::Int magFilter = GL_LINEAR);
+
+    TextureArray(TextureArray const &) = delete;
+    TextureArray(TextureArray &&) = delete;
+
+    ~TextureArray();
+
+    TextureArray &operator=(TextureArray const &) = delete;
+    TextureArray &operator=(TextureArray &&) = delete;
+
+    /**
+     * Binds the array to `TEXTURE_UNIT`, once before the draws of all meshes sampling it (see
+     * `Mesh::textureArray`).
+     */
+    void bind() const;
+    void unbind() const;
+    [[nodiscard]] TextureType type() const;
+    [[nodiscard]] types::Size width() const;
+    [[nodiscard]] types::Size height() const;
+    [[nodiscard]] types::Size layersCount() const;
+
+private:
+    std::shared_ptr<Window> _window;
+    TextureType _textureType;
+    types::Size _width = 0;
+    types::Size _height = 0;
+    types::Size _layersCount = 0;
+    types::UInt _texture = 0;
+};
+
+} // namespace pf::gl
+
+#endif // !TEXTURE_ARRAY_HPP
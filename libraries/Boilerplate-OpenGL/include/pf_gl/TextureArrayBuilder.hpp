@@ -0,0 +1,90 @@
+#ifndef TEXTURE_ARRAY_BUILDER_HPP
+#define TEXTURE_ARRAY_BUILDER_HPP
+
+#include <vector>
+
+#include <pf_gl/Image.hpp>
+#include <pf_gl/ValueTypes.hpp>
+
+namespace pf::gl
+{
+
+/**
+ * Arranges images into the layers of texture arrays, so that meshes with different textures can
+ * be drawn with the same texture bound. The images with both sides not larger than the maximum
+ * packed size are packed into atlases (see `SkylinePacker`), which become the layers of a single
+ * array. The larger images are grouped by their size, each group is an array of its own.
+ *
+ * The texture coordinates of the meshes are remapped into the layers once, at import. Only the
+ * coordinates within [0, 1] survive the packing into an atlas, repeating textures should be kept
+ * larger than the maximum packed size. The packed images are surrounded by their edge pixels, so
+ * that the neighbors do not bleed into each other while the smaller levels of the mip chain are
+ * sampled.
+ */
+class TextureArrayBuilder final
+{
+public:
+    static types::Size constexpr DEFAULT_ATLAS_SIZE = 2048;
+    static types::Size constexpr DEFAULT_MAX_PACKED_SIZE = 256;
+    static types::Size constexpr DEFAULT_PADDING = 4;
+
+    /**
+     * Where an image ended up.
+     */
+    struct Region
+    {
+        types::Size array;
+        types::Size layer;
+        types::FVec2 offset;
+        types::FVec2 scale;
+
+        /**
+         * Texture coordinates of the original image mapped into the layer.
+         */
+        [[nodiscard]] types::FVec2 remap(types::FVec2 textureCoordinates) const;
+    };
+
+    struct Result
+    {
+        /**
+         * Layers of each array, all of them have the same size.
+         */
+        std::vector<std::vector<Image>> arrays;
+
+        /**
+         * Region of each image, in the order they were added.
+         */
+        std::vector<Region> regions;
+    };
+
+    /**
+     * @throws std::invalid_argument in case the padded image of the maximum packed size does not
+     * fit into the atlas.
+     */
+    explicit TextureArrayBuilder(types::Size atlasSize = DEFAULT_ATLAS_SIZE,
+                                 types::Size maxPackedSize = DEFAULT_MAX_PACKED_SIZE,
+                                 types::Size padding = DEFAULT_PADDING);
+
+    /**
+     * @return Index of the image in the regions of the result.
+     */
+    types::UInt add(Image image);
+
+    /**
+     * Moves the added images into the layers, the builder is empty afterwards.
+     */
+    [[nodiscard]] Result build();
+
+private:
+    types::Size _atlasSize;
+    types::Size _maxPackedSize;
+    types::Size _padding;
+    std::vector<Image> _images;
+
+    void pack(std::vector<types::UInt> const &imageIndices, Result &result);
+    void group(std::vector<types::UInt> const &imageIndices, Result &result);
+};
+
+} // namespace pf::gl
+
+#endif // !TEXTURE_ARRAY_BUILDER_HPP
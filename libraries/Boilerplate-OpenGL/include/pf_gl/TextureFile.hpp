@@ -0,0 +1,84 @@
+#ifndef TEXTURE_FILE_HPP
+#define TEXTURE_FILE_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+#include <pf_gl/BlockCompressor.hpp>
+#include <pf_gl/ValueTypes.hpp>
+#include <pf_utils/MappedFile.hpp>
+
+namespace pf::gl
+{
+
+/**
+ * Block compressed texture with its mip chain cooked in advance, stored in the KTX2 container
+ * (`.ktx2`). Only the subset of the format written by `write` is read: a single 2D image without
+ * supercompression, in one of the `BlockCompressor` formats.
+ *
+ * The file is memory mapped, the levels point straight into the mapping and are uploaded from
+ * there.
+ */
+class TextureFile final
+{
+public:
+    static constexpr char const *EXTENSION = ".ktx2";
+
+    /**
+     * "\xABKTX 20\xBB\r\n\x1A\n", the first bytes of every KTX2 file.
+     */
+    static std::array<std::uint8_t, 12> constexpr IDENTIFIER = {
+        0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+
+    /**
+     * @throws std::runtime_error in case the file cannot be read, is malformed or uses the parts of
+     * the format which are not supported.
+     */
+    explicit TextureFile(std::filesystem::path const &path);
+
+    [[nodiscard]] BlockCompressor::Format format() const;
+
+    /**
+     * The colors are in the sRGB space and are converted to linear when sampled.
+     */
+    [[nodiscard]] bool srgb() const;
+
+    [[nodiscard]] types::Size width() const;
+    [[nodiscard]] types::Size height() const;
+
+    [[nodiscard]] types::Size levelsCount() const;
+
+    /**
+     * The level zero is the largest one. Valid as long as the file object exists.
+     */
+    [[nodiscard]] std::span<std::byte const> level(types::Size levelIndex) const;
+
+    /**
+     * The levels start with the largest one, each next one is half the size of the previous one.
+     *
+     * @throws std::invalid_argument in case the levels do not match the size and the format, or
+     * the format has no sRGB variant.
+     */
+    static void write(std::filesystem::path const &path,
+                      BlockCompressor::Format format,
+                      bool srgb,
+                      types::Size width,
+                      types::Size height,
+                      std::span<std::vector<std::byte> const> levels);
+
+private:
+    pf::util::MappedFile _file;
+    BlockCompressor::Format _format = BlockCompressor::BC1;
+    bool _srgb = false;
+    types::Size _width = 0;
+    types::Size _height = 0;
+    std::vector<std::span<std::byte const>> _levels;
+};
+
+} // namespace pf::gl
+
+#endif // !TEXTURE_FILE_HPP
@@ -0,0 +1,164 @@
+#ifndef TEXTURE_LOADER_HPP
+#define TEXTURE_LOADER_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include <pf_gl/Image.hpp>
+#include <pf_gl/Texture.hpp>
+#include <pf_gl/ValueTypes.hpp>
+#include <pf_gl/Window.hpp>
+
+namespace pf::gl
+{
+
+/**
+ * Loads textures without stalling the frames: images are decoded by a pool of worker threads, and
+ * the GL thread only copies the decoded pixels into a ring of pixel buffer objects, from which the
+ * driver uploads them to the textures asynchronously. A pixel buffer is only reused once the GPU
+ * is done with its previous contents, which is tracked with fences.
+ *
+ * Cooked textures (`.ktx2`) are uploaded right away by `load`, they need no decoding and are
+ * read straight from a memory mapping.
+ */
+class TextureLoader final
+{
+public:
+    static types::Size constexpr DEFAULT_PIXEL_BUFFERS_COUNT = 3;
+    static types::BinarySize constexpr DEFAULT_PIXEL_BUFFER_SIZE = 4 * 1024 * 1024;
+
+    /**
+     * @param threadsCount Decoding threads, zero picks the hardware concurrency.
+     *
+     * @throws std::invalid_argument in case of a negative threads count or an empty ring of the
+     * pixel buffers.
+     */
+    explicit TextureLoader(std::shared_ptr<Window> window,
+                           types::Size threadsCount = 0,
+                           types::Size pixelBuffersCount = DEFAULT_PIXEL_BUFFERS_COUNT,
+                           types::BinarySize pixelBufferSize = DEFAULT_PIXEL_BUFFER_SIZE);
+
+    TextureLoader(TextureLoader const &) = delete;
+    TextureLoader(TextureLoader &&) = delete;
+
+    ~TextureLoader();
+
+    TextureLoader &operator=(TextureLoader const &) = delete;
+    TextureLoader &operator=(TextureLoader &&) = delete;
+
+    /**
+     * Returns the texture right away, it has no storage until its image gets uploaded by `update`.
+     * Textures which are loaded or still loading by this loader are shared, in case they are
+     * requested once again.
+     *
+     * @throws std::runtime_error in case a cooked texture cannot be loaded.
+     */
+    std::shared_ptr<Texture> load(std::filesystem::path const &path,
+                                  TextureType textureType,
+                                  bool flipVertically = false);
+
+    /**
+     * Uploads the decoded images through the ring of pixel buffers, supposed to be called once per
+     * frame. Never waits for the GPU: it stops at the first pixel buffer which is still in use, and
+     * goes around the ring at most once.
+     *
+     * @throws std::runtime_error in case an image could not be decoded, its texture is left empty
+     * and forgotten by the loader, the rest of the textures keep loading.
+     */
+    void update();
+
+    /**
+     * Blocks until every requested texture is uploaded.
+     *
+     * @throws std::runtime_error same as `update`.
+     */
+    void finish();
+
+    /**
+     * Textures which are not uploaded yet.
+     */
+    [[nodiscard]] types::Size pendingCount() const;
+
+private:
+    struct Request
+    {
+        types::UInt id;
+        std::filesystem::path path;
+        bool flipVertically;
+    };
+
+    struct DecodedImage
+    {
+        types::UInt id;
+        std::optional<Image> image;
+        std::exception_ptr error;
+    };
+
+    struct Upload
+    {
+        types::UInt id;
+        std::shared_ptr<Texture> texture;
+        Image image;
+        types::Size uploadedRows = 0;
+    };
+
+    struct PixelBuffer
+    {
+        types::UInt buffer = 0;
+        GLsync fence = nullptr;
+    };
+
+    std::shared_ptr<Window> _window;
+    types::BinarySize _pixelBufferSize;
+    std::vector<PixelBuffer> _pixelBuffers;
+    size_t _nextPixelBuffer = 0;
+
+    // Only touched by the GL thread, so that textures are never destroyed by the workers
+    types::UInt _nextId = 0;
+    std::unordered_map<types::UInt, std::shared_ptr<Texture>> _pendingTextures;
+    std::map<std::filesystem::path, std::weak_ptr<Texture>> _textures;
+    std::deque<Upload> _uploads;
+
+    std::mutex _mutex;
+    std::condition_variable_any _requestAdded;
+    std::condition_variable _imageDecoded;
+    std::deque<Request> _requests;
+    std::vector<DecodedImage> _decodedImages;
+
+    // Joined before anything else is destroyed
+    std::vector<std::jthread> _threads;
+
+    void decode(std::stop_token const &stopToken);
+
+    /**
+     * Moves the decoded images to the upload queue and allocates the storage of their textures.
+     */
+    void collectDecodedImages();
+
+    /**
+     * @param wait Whether to wait for the pixel buffers which are in use, otherwise the upload
+     * stops at the first one.
+     */
+    void upload(bool wait);
+
+    /**
+     * Copies as many rows as fit into the pixel buffer, and starts their transfer to the texture.
+     */
+    void uploadRows(Upload &upload, PixelBuffer &pixelBuffer);
+};
+
+} // namespace pf::gl
+
+#endif // !TEXTURE_LOADER_HPP
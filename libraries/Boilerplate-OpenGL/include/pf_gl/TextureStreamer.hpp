@@ -0,0 +1,111 @@
+#ifndef TEXTURE_STREAMER_HPP
+#define TEXTURE_STREAMER_HPP
+
+#include <filesystem>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <pf_gl/MipResidency.hpp>
+#include <pf_gl/Texture.hpp>
+#include <pf_gl/TextureFile.hpp>
+#include <pf_gl/ValueTypes.hpp>
+#include <pf_gl/Window.hpp>
+
+namespace pf::gl
+{
+
+/**
+ * Keeps only the levels of the cooked textures (`.ktx2`) which are actually seen in the video
+ * memory. The small levels are uploaded right away, the larger ones are streamed in from the
+ * memory mapped files as the textures get closer to the camera, and are evicted in the least
+ * recently used order once the resident levels exceed the budget (see `MipResidency`).
+ *
+ * The sampled levels are limited with `GL_TEXTURE_BASE_LEVEL`, so that the texture stays
+ * complete no matter which levels are resident.
+ */
+class TextureStreamer final
+{
+public:
+    static types::BinarySize constexpr DEFAULT_BUDGET = 256 * 1024 * 1024;
+    static types::BinarySize constexpr DEFAULT_UPLOAD_BUDGET = 8 * 1024 * 1024;
+
+    /**
+     * The levels not larger than this are always resident.
+     */
+    static types::Size constexpr ALWAYS_RESIDENT_SIZE = 64;
+
+    struct TextureStatistics
+    {
+        std::filesystem::path path;
+        types::Size baseLevel;
+        types::Size levelsCount;
+        types::BinarySize residentBytes;
+    };
+
+    /**
+     * @param budget Video memory for the levels which are streamed in.
+     * @param uploadBudget Bytes uploaded by a single update.
+     */
+    explicit TextureStreamer(std::shared_ptr<Window> window,
+                             types::BinarySize budget = DEFAULT_BUDGET,
+                             types::BinarySize uploadBudget = DEFAULT_UPLOAD_BUDGET);
+
+    TextureStreamer(TextureStreamer const &) = delete;
+    TextureStreamer(TextureStreamer &&) = delete;
+
+    ~TextureStreamer() = default;
+
+    TextureStreamer &operator=(TextureStreamer const &) = delete;
+    TextureStreamer &operator=(TextureStreamer &&) = delete;
+
+    /**
+     * Textures which are already streamed are shared.
+     *
+     * @throws std::invalid_argument in case the texture is not a cooked one.
+     * @throws std::runtime_error in case the texture file cannot be read.
+     */
+    std::shared_ptr<Texture> load(std::filesystem::path const &path, TextureType textureType);
+
+    /**
+     * Requests the level matching the size of the textured object on the screen, in pixels. Meant
+     * to be called for the visible objects only, the levels of the rest are the first to go. The
+     * textures which are not streamed are ignored.
+     */
+    void request(Texture const &texture, types::Float screenSize);
+
+    /**
+     * Uploads and evicts the levels according to the requests since the last update, supposed to
+     * be called once per frame. Textures which are not used by anyone else are dropped.
+     */
+    void update();
+
+    void budget(types::BinarySize budget);
+    [[nodiscard]] types::BinarySize budget() const;
+
+    /**
+     * Bytes counted against the budget, the always resident levels are not included.
+     */
+    [[nodiscard]] types::BinarySize residentBytes() const;
+
+    /**
+     * Resident levels of each streamed texture, including the always resident ones.
+     */
+    [[nodiscard]] std::vector<TextureStatistics> statistics() const;
+
+private:
+    struct StreamedTexture
+    {
+        std::shared_ptr<Texture> texture;
+        TextureFile file;
+    };
+
+    std::shared_ptr<Window> _window;
+    MipResidency _residency;
+    std::unordered_map<types::UInt, StreamedTexture> _textures;
+    std::unordered_map<Texture const *, types::UInt> _residencyIds;
+};
+
+} // namespace pf::gl
+
+#endif // !TEXTURE_STREAMER_HPP
@@ -9,8 +9,12 @@
 #ifndef VALUE_TYPES_HPP
 #define VALUE_TYPES_HPP
 
+#include <array>
+#include <cstddef>
 #include <variant>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <limits>
 
 #include <glad/glad.h>
@@ -45,6 +49,14 @@ using UInt = GLuint;
 using Int = GLint;
 using IntVec2 = glm::ivec2;
 
+// Compact vertex attributes
+using Short = GLshort;
+using UShort = GLushort;
+using ShortVec4 = glm::vec<4, Short>;
+
+// Half floats are stored as their bit patterns
+using HalfVec2 = glm::vec<2, GLhalf>;
+
 // Other types
 using Size = GLsizei;
 using BinarySize = GLsizeiptr;
@@ -136,6 +148,19 @@ inline Int constexpr DEFAULT_VALUE<Int> = Int(0);
 template <>
 inline IntVec2 constexpr DEFAULT_VALUE<IntVec2> = IntVec2(Int(0), Int(0));
 
+template <>
+inline Short constexpr DEFAULT_VALUE<Short> = Short(0);
+
+template <>
+inline UShort constexpr DEFAULT_VALUE<UShort> = UShort(0);
+
+template <>
+inline ShortVec4 constexpr DEFAULT_VALUE<ShortVec4> =
+    ShortVec4(Short(0), Short(0), Short(0), Short(0));
+
+template <>
+inline HalfVec2 constexpr DEFAULT_VALUE<HalfVec2> = HalfVec2(GLhalf(0), GLhalf(0));
+
 // template <>
 // constexpr inline Size DEFAULT_VALUE<Size> = Size(0);
 
@@ -251,6 +276,10 @@ using ValueTypeVariant = std::variant<Float,
                                       UInt,
                                       Int,
                                       IntVec2,
+                                      Short,
+                                      UShort,
+                                      ShortVec4,
+                                      HalfVec2,
                                       // Size,
                                       BinarySize,
                                       Bool,
@@ -276,8 +305,283 @@ enum ValueType
     BINARY_SIZE,
     BOOL,
     BYTE,
+    SHORT,
+    UNSIGNED_SHORT,
+    SHORT_VECTOR_4,
+    HALF_FLOAT,
+    HALF_FLOAT_VECTOR_2,
+
+    /**
+     * Signed 3D vector packed into a single 32-bit integer, 10 bits per component and 2 bits for
+     * the unused fourth one, the X component goes into the lowest bits.
+     */
+    INT_2_10_10_10_REV,
+};
+
+
+// * Metadata *
+
+struct ValueTypeMeta
+{
+    ValueType type;
+    ValueType scalarType;
+    GLenum openglScalarType;
+    BinarySize scalarSize;
+    Size count;
+    ValueTypeVariant defaultValue;
+    std::string_view name;
 };
 
+/**
+ * Indexed by the `ValueType` itself. A corresponding GLenum does not exist for every single type.
+ * In case there is no corresponding GLenum, the value of GL_FALSE is stored.
+ */
+inline std::array<ValueTypeMeta, INT_2_10_10_10_REV + 1> constexpr VALUE_TYPE_TO_META = {{
+    {
+        .type = FLOAT,
+        .scalarType = FLOAT,
+        .openglScalarType = GL_FLOAT,
+        .scalarSize = static_cast<BinarySize>(sizeof(Float)),
+        .count = static_cast<Size>(1),
+        .defaultValue = DEFAULT_VALUE<Float>,
+        .name = "Float",
+    },
+    {
+        .type = FLOAT_VECTOR_2,
+        .scalarType = FLOAT,
+        .openglScalarType = GL_FLOAT,
+        .scalarSize = static_cast<BinarySize>(sizeof(Float)),
+        .count = static_cast<Size>(2),
+        .defaultValue = DEFAULT_VALUE<FVec2>,
+        .name = "Float Vector2",
+    },
+    {
+        .type = FLOAT_VECTOR_3,
+        .scalarType = FLOAT,
+        .openglScalarType = GL_FLOAT,
+        .scalarSize = static_cast<BinarySize>(sizeof(Float)),
+        .count = static_cast<Size>(3),
+        .defaultValue = DEFAULT_VALUE<FVec3>,
+        .name = "Float Vector3",
+    },
+    {
+        .type = FLOAT_VECTOR_4,
+        .scalarType = FLOAT,
+        .openglScalarType = GL_FLOAT,
+        .scalarSize = static_cast<BinarySize>(sizeof(Float)),
+        .count = static_cast<Size>(4),
+        .defaultValue = DEFAULT_VALUE<FVec4>,
+        .name = "Float Vector4",
+    },
+    {
+        .type = DOUBLE,
+        .scalarType = DOUBLE,
+        .openglScalarType = GL_DOUBLE,
+        .scalarSize = static_cast<BinarySize>(sizeof(Double)),
+        .count = static_cast<Size>(1),
+        .defaultValue = DEFAULT_VALUE<Double>,
+        .name = "Double",
+    },
+    {
+        .type = DOUBLE_VECTOR_2,
+        .scalarType = DOUBLE,
+        .openglScalarType = GL_DOUBLE,
+        .scalarSize = static_cast<BinarySize>(sizeof(Double)),
+        .count = static_cast<Size>(2),
+        .defaultValue = DEFAULT_VALUE<DVec2>,
+        .name = "Double Vector2",
+    },
+    {
+        .type = DOUBLE_VECTOR_3,
+        .scalarType = DOUBLE,
+        .openglScalarType = GL_DOUBLE,
+        .scalarSize = static_cast<BinarySize>(sizeof(Double)),
+        .count = static_cast<Size>(3),
+        .defaultValue = DEFAULT_VALUE<DVec3>,
+        .name = "Double Vector3",
+    },
+    {
+        .type = DOUBLE_VECTOR_4,
+        .scalarType = DOUBLE,
+        .openglScalarType = GL_DOUBLE,
+        .scalarSize = static_cast<BinarySize>(sizeof(Double)),
+        .count = static_cast<Size>(4),
+        .defaultValue = DEFAULT_VALUE<DVec4>,
+        .name = "Double Vector4",
+    },
+    {
+        .type = FLOAT_MATRIX_2,
+        .scalarType = FLOAT,
+        .openglScalarType = GL_FLOAT,
+        .scalarSize = static_cast<BinarySize>(sizeof(Float)),
+        .count = static_cast<Size>(2) * 2,
+        .defaultValue = DEFAULT_VALUE<FMat2>,
+        .name = "Float Matrix2x2",
+    },
+    {
+        .type = FLOAT_MATRIX_3,
+        .scalarType = FLOAT,
+        .openglScalarType = GL_FLOAT,
+        .scalarSize = static_cast<BinarySize>(sizeof(Float)),
+        .count = static_cast<Size>(3) * 3,
+        .defaultValue = DEFAULT_VALUE<FMat3>,
+        .name = "Float Matrix3x3",
+    },
+    {
+        .type = FLOAT_MATRIX_4,
+        .scalarType = FLOAT,
+        .openglScalarType = GL_FLOAT,
+        .scalarSize = static_cast<BinarySize>(sizeof(Float)),
+        .count = static_cast<Size>(4) * 4,
+        .defaultValue = DEFAULT_VALUE<FMat4>,
+        .name = "Float Matrix4x4",
+    },
+    {
+        .type = UNSIGNED_INT,
+        .scalarType = UNSIGNED_INT,
+        .openglScalarType = GL_UNSIGNED_INT,
+        .scalarSize = static_cast<BinarySize>(sizeof(UInt)),
+        .count = static_cast<Size>(1),
+        .defaultValue = DEFAULT_VALUE<UInt>,
+        .name = "Unsigned Integer",
+    },
+    {
+        .type = INT,
+        .scalarType = INT,
+        .openglScalarType = GL_INT,
+        .scalarSize = static_cast<BinarySize>(sizeof(Int)),
+        .count = static_cast<Size>(1),
+        .defaultValue = DEFAULT_VALUE<Int>,
+        .name = "Integer",
+    },
+    {
+        .type = INT_VECTOR_2,
+        .scalarType = INT,
+        .openglScalarType = GL_INT,
+        .scalarSize = static_cast<BinarySize>(sizeof(Int)),
+        .count = static_cast<Size>(2),
+        .defaultValue = DEFAULT_VALUE<IntVec2>,
+        .name = "Integer Vector2",
+    },
+    {
+        .type = SIZE,
+        .scalarType = SIZE,
+        .openglScalarType = GL_FALSE,
+        .scalarSize = static_cast<BinarySize>(sizeof(Size)),
+        .count = static_cast<Size>(1),
+        .defaultValue = DEFAULT_VALUE<Size>,
+        .name = "Size Type",
+    },
+    {
+        .type = BINARY_SIZE,
+        .scalarType = BINARY_SIZE,
+        .openglScalarType = GL_FALSE,
+        .scalarSize = static_cast<BinarySize>(sizeof(BinarySize)),
+        .count = static_cast<Size>(1),
+        .defaultValue = DEFAULT_VALUE<BinarySize>,
+        .name = "Binary Size Type",
+    },
+    {
+        .type = BOOL,
+        .scalarType = BOOL,
+        .openglScalarType = GL_FALSE,
+        .scalarSize = static_cast<BinarySize>(sizeof(Bool)),
+        .count = static_cast<Size>(1),
+        .defaultValue = DEFAULT_VALUE<Bool>,
+        .name = "Boolean",
+    },
+    {
+        .type = BYTE,
+        .scalarType = BYTE,
+        .openglScalarType = GL_FALSE,
+        .scalarSize = static_cast<BinarySize>(sizeof(Byte)),
+        .count = static_cast<Size>(1),
+        .defaultValue = DEFAULT_VALUE<Byte>,
+        .name = "Byte",
+    },
+    {
+        .type = SHORT,
+        .scalarType = SHORT,
+        .openglScalarType = GL_SHORT,
+        .scalarSize = static_cast<BinarySize>(sizeof(Short)),
+        .count = static_cast<Size>(1),
+        .defaultValue = DEFAULT_VALUE<Short>,
+        .name = "Short",
+    },
+    {
+        .type = UNSIGNED_SHORT,
+        .scalarType = UNSIGNED_SHORT,
+        .openglScalarType = GL_UNSIGNED_SHORT,
+        .scalarSize = static_cast<BinarySize>(sizeof(UShort)),
+        .count = static_cast<Size>(1),
+        .defaultValue = DEFAULT_VALUE<UShort>,
+        .name = "Unsigned Short",
+    },
+    {
+        .type = SHORT_VECTOR_4,
+        .scalarType = SHORT,
+        .openglScalarType = GL_SHORT,
+        .scalarSize = static_cast<BinarySize>(sizeof(Short)),
+        .count = static_cast<Size>(4),
+        .defaultValue = DEFAULT_VALUE<ShortVec4>,
+        .name = "Short Vector4",
+    },
+    {
+        .type = HALF_FLOAT,
+        .scalarType = HALF_FLOAT,
+        .openglScalarType = GL_HALF_FLOAT,
+        .scalarSize = static_cast<BinarySize>(sizeof(GLhalf)),
+        .count = static_cast<Size>(1),
+        .defaultValue = DEFAULT_VALUE<UShort>,
+        .name = "Half Float",
+    },
+    {
+        .type = HALF_FLOAT_VECTOR_2,
+        .scalarType = HALF_FLOAT,
+        .openglScalarType = GL_HALF_FLOAT,
+        .scalarSize = static_cast<BinarySize>(sizeof(GLhalf)),
+        .count = static_cast<Size>(2),
+        .defaultValue = DEFAULT_VALUE<HalfVec2>,
+        .name = "Half Float Vector2",
+    },
+    // Four components share a single 32-bit integer, a byte per component on average
+    {
+        .type = INT_2_10_10_10_REV,
+        .scalarType = INT_2_10_10_10_REV,
+        .openglScalarType = GL_INT_2_10_10_10_REV,
+        .scalarSize = static_cast<BinarySize>(sizeof(UInt) / 4),
+        .count = static_cast<Size>(4),
+        .defaultValue = DEFAULT_VALUE<UInt>,
+        .name = "Packed Integer Vector 2-10-10-10",
+    },
+}};
+
+static_assert(
+    []
+    {
+        for (std::size_t i = 0; i < VALUE_TYPE_TO_META.size(); i++)
+        {
+            if (static_cast<std::size_t>(VALUE_TYPE_TO_META[i].type) != i)
+            {
+                return false;
+            }
+        }
+        return true;
+    }(),
+    "Value types metadata must be in the order of the enum.");
+
+/**
+ * @throws std::runtime_error for a value outside of the `ValueType` enum.
+ */
+constexpr ValueTypeMeta const &meta(ValueType valueType)
+{
+    if (valueType < 0 || static_cast<std::size_t>(valueType) >= VALUE_TYPE_TO_META.size())
+    {
+        throw std::runtime_error("Unknown vertex attribute type.");
+    }
+    return VALUE_TYPE_TO_META[valueType];
+}
+
 
 // * Utility functions *
 
@@ -297,15 +601,15 @@ bool isErrorValue(ValueType const &value);
  * is compound, returns the scalar type of this compound type.
  * @returns `GL_FALSE` in case there is no corresponding `GLenum` for the given type.
  */
-GLenum openglScalar(ValueType valueType);
+constexpr GLenum openglScalar(ValueType valueType);
 
 /**
  * For the compound type returns how many scalar values it contains. For the scalar
  * types returns just a value of 1.
  */
-Size scalarCount(ValueType valueType);
+constexpr Size scalarCount(ValueType valueType);
 
-BinarySize sizeInBytes(ValueType valueType);
+constexpr BinarySize sizeInBytes(ValueType valueType);
 
 /**
  * Provides a placeholder value for the variable of the given type. 0 for numbers and
@@ -319,7 +623,23 @@ ValueTypeVariant defaultValue(ValueType valueType);
 std::string name(ValueType valueType);
 
 
-// * Templates definitions *
+// * Inline and templates definitions *
+
+constexpr GLenum openglScalar(ValueType valueType)
+{
+    return meta(valueType).openglScalarType;
+}
+
+constexpr Size scalarCount(ValueType valueType)
+{
+    return meta(valueType).count;
+}
+
+constexpr BinarySize sizeInBytes(ValueType valueType)
+{
+    ValueTypeMeta const &valueTypeMeta = meta(valueType);
+    return valueTypeMeta.scalarSize * valueTypeMeta.count;
+}
 
 template <typename CompoundType, typename ScalarType>
 ScalarType *dataPointer(CompoundType &value)
@@ -2,9 +2,9 @@
 #define VERTEX_ARRAY_HPP
 
 #include <memory>
-#include <vector>
 
 #include <pf_gl/VertexBuffer.hpp>
+#include <pf_gl/VertexLayout.hpp>
 #include <pf_gl/ElementBuffer.hpp>
 #include <pf_gl/Window.hpp>
 #include <pf_gl/ValueTypes.hpp>
@@ -12,10 +12,15 @@
 namespace pf::gl
 {
 
+/**
+ * Vertex array of a single vertex format. It does not own any buffers: the vertex buffer and the
+ * element buffer are attached right before the draw, so the meshes of the same format can share
+ * a single vertex array and switching between them only rebinds the buffers.
+ */
 class VertexArray final
 {
 public:
-    explicit VertexArray(std::shared_ptr<Window> window);
+    VertexArray(std::shared_ptr<Window> window, VertexLayout layout);
 
     VertexArray(VertexArray const &) = delete;
     VertexArray(VertexArray &&) = default;
@@ -25,18 +30,33 @@ public:
     VertexArray &operator=(VertexArray const &) = delete;
     VertexArray &operator=(VertexArray &&) = default;
 
+    /**
+     * The vertex array of the layout shared by everyone who uses the same window. It lives as long
+     * as someone holds it.
+     */
+    [[nodiscard]] static std::shared_ptr<VertexArray> shared(std::shared_ptr<Window> const &window,
+                                                             VertexLayout const &layout);
+
+    [[nodiscard]] VertexLayout const &layout() const;
+
     void bind() const;
     void unbind() const;
 
-    void addVertexBuffer(std::shared_ptr<VertexBuffer> const &vertexBuffer);
-    void setElementBuffer(std::shared_ptr<ElementBuffer> const &elementBuffer);
-    void draw();
+    /**
+     * Draws a range of the element buffer. The vertex buffer must have the layout of the vertex
+     * array.
+     */
+    void draw(VertexBuffer const &vertexBuffer,
+              ElementBuffer const &elementBuffer,
+              types::Size indicesCount,
+              types::Size firstIndex);
 
 private:
     std::shared_ptr<Window> _window;
     types::UInt _id;
-    std::vector<std::shared_ptr<VertexBuffer>> _vertexBuffers;
-    std::shared_ptr<ElementBuffer> _elementBuffer;
+    VertexLayout _layout;
+
+    void attachBuffers(VertexBuffer const &vertexBuffer, ElementBuffer const &elementBuffer);
 };
 
 } // namespace pf::gl
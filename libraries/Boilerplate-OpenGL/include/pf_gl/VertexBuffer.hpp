@@ -3,6 +3,7 @@
 
 #include <memory>
 
+#include <pf_gl/BufferMapping.hpp>
 #include <pf_gl/VertexLayout.hpp>
 #include <pf_gl/RenderingOptions.hpp>
 #include <pf_gl/Window.hpp>
@@ -20,6 +21,16 @@ public:
                  UsagePattern usagePattern,
                  VertexLayout layout);
 
+    /**
+     * Allocates the buffer of the given size and lets `write` fill it in place, through the mapped
+     * memory of the buffer.
+     */
+    VertexBuffer(std::shared_ptr<Window> window,
+                 types::BinarySize size,
+                 UsagePattern usagePattern,
+                 VertexLayout layout,
+                 BufferWriter const &write);
+
     VertexBuffer(VertexBuffer const &) = delete;
     VertexBuffer(VertexBuffer &&) = default;
 
@@ -30,12 +41,15 @@ public:
 
     void bind() const;
     void unbind() const;
-    [[nodiscard]] VertexLayout layout() const;
+    [[nodiscard]] types::UInt id() const;
+    [[nodiscard]] VertexLayout const &layout() const;
 
 private:
     types::UInt _id;
     VertexLayout _layout;
     std::shared_ptr<Window> _window;
+
+    void generate();
 };
 
 } // namespace pf::gl
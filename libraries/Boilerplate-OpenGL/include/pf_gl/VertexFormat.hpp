@@ -0,0 +1,68 @@
+#ifndef VERTEX_FORMAT_HPP
+#define VERTEX_FORMAT_HPP
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include <pf_gl/VertexLayout.hpp>
+#include <pf_gl/ValueTypes.hpp>
+
+namespace pf::gl
+{
+
+/**
+ * A single member of the vertex structure, in the order of declaration.
+ */
+template <types::ValueType VALUE_TYPE, Attribute ATTRIBUTE, bool NORMALIZED = false>
+struct VertexField
+{
+    static AttributeEntry constexpr ENTRY = AttributeEntry(VALUE_TYPE, ATTRIBUTE, NORMALIZED);
+};
+
+/**
+ * Vertex layout known at compile time. The stride and the offsets of the attributes are computed
+ * from the fields, and the stride is checked against the size of the vertex structure, so the
+ * structure can be uploaded as it is.
+ */
+template <typename Vertex, typename... Fields>
+class VertexFormat final
+{
+public:
+    static std::size_t constexpr ATTRIBUTES_COUNT = sizeof...(Fields);
+
+    static std::array<AttributeEntry, ATTRIBUTES_COUNT> constexpr ATTRIBUTES = {Fields::ENTRY...};
+
+    static types::BinarySize constexpr STRIDE =
+        (types::BinarySize(0) + ... + types::sizeInBytes(Fields::ENTRY.valueType));
+
+    static std::array<types::BinarySize, ATTRIBUTES_COUNT> constexpr OFFSETS = []
+    {
+        std::array<types::BinarySize, ATTRIBUTES_COUNT> offsets = {};
+        types::BinarySize offset = 0;
+        for (std::size_t i = 0; i < ATTRIBUTES_COUNT; i++)
+        {
+            offsets[i] = offset;
+            offset += types::sizeInBytes(ATTRIBUTES[i].valueType);
+        }
+        return offsets;
+    }();
+
+    static_assert(ATTRIBUTES_COUNT > 0, "Vertex format must have at least one attribute.");
+    static_assert(STRIDE == sizeof(Vertex),
+                  "Fields of the vertex format must cover the vertex structure without padding.");
+
+    [[nodiscard]] static std::vector<AttributeEntry> attributes()
+    {
+        return {ATTRIBUTES.begin(), ATTRIBUTES.end()};
+    }
+
+    [[nodiscard]] static VertexLayout layout()
+    {
+        return VertexLayout(attributes());
+    }
+};
+
+} // namespace pf::gl
+
+#endif // !VERTEX_FORMAT_HPP
@@ -1,6 +1,7 @@
 #ifndef VERTEX_LAYOUT_HPP
 #define VERTEX_LAYOUT_HPP
 
+#include <cstddef>
 #include <vector>
 #include <string>
 #include <array>
@@ -29,9 +30,22 @@ struct AttributeEntry
     types::ValueType valueType;
     bool normalized;
 
-    AttributeEntry(types::ValueType valueType, Attribute attribute, bool normalized = false);
+    constexpr AttributeEntry(types::ValueType valueType,
+                             Attribute attribute,
+                             bool normalized = false)
+        : attribute(attribute)
+        , valueType(valueType)
+        , normalized(normalized)
+    {
+    }
+
+    constexpr bool operator==(AttributeEntry const &) const = default;
 };
 
+/**
+ * Attributes of a single interleaved vertex buffer, tightly packed in the given order. The
+ * attribute index in the shader is the position of the attribute in the layout.
+ */
 class VertexLayout final
 {
 public:
@@ -39,10 +53,19 @@ public:
 
     [[nodiscard]] std::vector<AttributeEntry>::const_iterator begin() const noexcept;
     [[nodiscard]] std::vector<AttributeEntry>::const_iterator end() const noexcept;
+    [[nodiscard]] std::size_t size() const noexcept;
     [[nodiscard]] types::BinarySize stride() const;
 
+    /**
+     * Offset of the attribute relative to the start of the vertex.
+     */
+    [[nodiscard]] types::BinarySize offset(std::size_t attributeIndex) const;
+
+    bool operator==(VertexLayout const &other) const;
+
 private:
     std::vector<AttributeEntry> _attributes;
+    std::vector<types::BinarySize> _offsets;
     types::BinarySize _stride;
 };
 
@@ -0,0 +1,80 @@
+#ifndef VERTEX_QUANTIZER_HPP
+#define VERTEX_QUANTIZER_HPP
+
+#include <pf_gl/BoundingVolumes.hpp>
+#include <pf_gl/ValueTypes.hpp>
+
+namespace pf::gl
+{
+
+/**
+ * Packs the (position, normal, UV) vertices into half of their size:
+ *  - positions are 16-bit normalized integers relative to the bounding box of the mesh;
+ *  - normals are 10-bit normalized integers packed into a single 32-bit integer;
+ *  - texture coordinates are half floats.
+ *
+ * Positions are restored with the dequantization matrix, which is meant to be appended to the
+ * model matrix, so that the shaders work with either layout unchanged. The normals are stored
+ * already scaled by the inverse of that matrix' normal matrix, so they come out right after the
+ * usual inverse transpose of the model matrix (the shaders are expected to normalize them).
+ */
+class VertexQuantizer final
+{
+public:
+    struct CompactVertex
+    {
+        /**
+         * The fourth component is always one, it keeps the attribute aligned to 8 bytes.
+         */
+        types::ShortVec4 position;
+        types::UInt normal;
+        types::HalfVec2 textureCoordinates;
+    };
+
+    static types::Float constexpr MAX_SNORM_16 = 32767.0F;
+    static types::Float constexpr MAX_SNORM_10 = 511.0F;
+
+    /**
+     * The box must not be empty. Flat boxes are fine, the zero sizes are replaced with ones so that
+     * the dequantization matrix stays invertible.
+     */
+    explicit VertexQuantizer(BoundingBox const &boundingBox);
+
+    [[nodiscard]] CompactVertex quantize(types::FVec3 const &position,
+                                         types::FVec3 const &normal,
+                                         types::FVec2 const &textureCoordinates) const;
+
+    /**
+     * Position of the compact vertex in the original space of the mesh.
+     */
+    [[nodiscard]] types::FVec3 dequantizePosition(types::ShortVec4 const &position) const;
+
+    /**
+     * Maps the quantized positions (between -1 and 1) back into the original space of the mesh.
+     */
+    [[nodiscard]] types::FMat4 const &dequantizationMatrix() const;
+
+    [[nodiscard]] static types::Short toSnorm16(types::Float value);
+    [[nodiscard]] static types::Float fromSnorm16(types::Short value);
+
+    /**
+     * Packs the vector into the `INT_2_10_10_10_REV` format, the fourth component is zero.
+     */
+    [[nodiscard]] static types::UInt toSnorm10(types::FVec3 const &vector);
+    [[nodiscard]] static types::FVec3 fromSnorm10(types::UInt packed);
+
+    /**
+     * Rounds to the nearest half float, the values too large for it become infinities.
+     */
+    [[nodiscard]] static GLhalf toHalfFloat(types::Float value);
+    [[nodiscard]] static types::Float fromHalfFloat(GLhalf value);
+
+private:
+    types::FVec3 _center;
+    types::FVec3 _scale;
+    types::FMat4 _dequantizationMatrix;
+};
+
+} // namespace pf::gl
+
+#endif // !VERTEX_QUANTIZER_HPP
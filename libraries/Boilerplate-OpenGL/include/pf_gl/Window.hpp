@@ -84,6 +84,14 @@ public:
     void initialize();
 
     void bindContext();
+
+    /**
+     * Whether the context supports an OpenGL extension which is not loaded along with the rest of
+     * the functions, `procAddress` returns its functions then.
+     */
+    [[nodiscard]] bool isExtensionSupported(char const *name);
+    [[nodiscard]] GLFWglproc procAddress(char const *name);
+
     void swapBuffers();
     void enableCursor(bool value);
     void close();
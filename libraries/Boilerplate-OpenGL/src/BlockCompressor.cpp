@@ -0,0 +1,651 @@
+#include <pf_gl/BlockCompressor.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gsl/util>
+
+#include <pf_gl/Image.hpp>
+#include <pf_gl/ValueTypes.hpp>
+
+namespace pf::gl
+{
+
+namespace
+{
+
+size_t constexpr TEXELS_COUNT =
+    static_cast<size_t>(BlockCompressor::BLOCK_WIDTH * BlockCompressor::BLOCK_HEIGHT);
+
+template <size_t N>
+using Color = std::array<types::Float, N>;
+
+template <size_t N>
+using BlockColors = std::array<Color<N>, TEXELS_COUNT>;
+
+using Indices = std::array<std::uint8_t, TEXELS_COUNT>;
+
+/**
+ * Interpolation weights of the second endpoint in BC7 with 4-bit indices, out of 64.
+ */
+std::array<types::Int, 16> constexpr BC7_WEIGHTS = {
+    0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+/**
+ * Powers through the covariance matrix to get closer to its largest eigenvector.
+ */
+size_t constexpr POWER_ITERATIONS_COUNT = 8;
+
+size_t constexpr REFINEMENT_ITERATIONS_COUNT = 2;
+
+template <size_t N>
+BlockColors<N> blockColors(BlockCompressor::Block const &texels)
+{
+    BlockColors<N> colors{};
+    for (size_t i = 0; i < TEXELS_COUNT; i++)
+    {
+        for (size_t channel = 0; channel < N; channel++)
+        {
+            colors[i][channel] =
+                static_cast<types::Float>(texels[i * Image::CHANNELS_COUNT + channel]);
+        }
+    }
+    return colors;
+}
+
+template <size_t N>
+types::Float squaredDistance(Color<N> const &first, Color<N> const &second)
+{
+    types::Float distance = 0.0F;
+    for (size_t channel = 0; channel < N; channel++)
+    {
+        types::Float difference = first[channel] - second[channel];
+        distance += difference * difference;
+    }
+    return distance;
+}
+
+/**
+ * Index of the closest palette entry for each color, returns the total squared error.
+ */
+template <size_t N, size_t PaletteSize>
+types::Float closestIndices(BlockColors<N> const &colors,
+                            std::array<Color<N>, PaletteSize> const &palette,
+                            Indices &indices)
+{
+    types::Float error = 0.0F;
+    for (size_t i = 0; i < TEXELS_COUNT; i++)
+    {
+        types::Float bestDistance = std::numeric_limits<types::Float>::max();
+        for (size_t entry = 0; entry < PaletteSize; entry++)
+        {
+            types::Float distance = squaredDistance(colors[i], palette[entry]);
+            if (distance < bestDistance)
+            {
+                bestDistance = distance;
+                indices[i] = static_cast<std::uint8_t>(entry);
+            }
+        }
+        error += bestDistance;
+    }
+    return error;
+}
+
+/**
+ * Extreme points of the colors projected onto the axis along which they vary the most.
+ */
+template <size_t N>
+std::pair<Color<N>, Color<N>> principalEndpoints(BlockColors<N> const &colors)
+{
+    Color<N> mean{};
+    Color<N> minColor = colors[0];
+    Color<N> maxColor = colors[0];
+    for (auto const &color : colors)
+    {
+        for (size_t channel = 0; channel < N; channel++)
+        {
+            mean[channel] += color[channel] / static_cast<types::Float>(TEXELS_COUNT);
+            minColor[channel] = std::min(minColor[channel], color[channel]);
+            maxColor[channel] = std::max(maxColor[channel], color[channel]);
+        }
+    }
+
+    std::array<Color<N>, N> covariance{};
+    for (auto const &color : colors)
+    {
+        for (size_t row = 0; row < N; row++)
+        {
+            for (size_t column = 0; column < N; column++)
+            {
+                covariance[row][column] +=
+                    (color[row] - mean[row]) * (color[column] - mean[column]);
+            }
+        }
+    }
+
+    // The diagonal of the bounding box is a good enough starting point
+    Color<N> axis{};
+    for (size_t channel = 0; channel < N; channel++)
+    {
+        axis[channel] = maxColor[channel] - minColor[channel];
+    }
+    for (size_t iteration = 0; iteration < POWER_ITERATIONS_COUNT; iteration++)
+    {
+        Color<N> product{};
+        types::Float largest = 0.0F;
+        for (size_t row = 0; row < N; row++)
+        {
+            for (size_t column = 0; column < N; column++)
+            {
+                product[row] += covariance[row][column] * axis[column];
+            }
+            largest = std::max(largest, std::abs(product[row]));
+        }
+        if (largest == 0.0F)
+        {
+            break;
+        }
+        for (size_t channel = 0; channel < N; channel++)
+        {
+            axis[channel] = product[channel] / largest;
+        }
+    }
+
+    types::Float axisLength = 0.0F;
+    for (auto component : axis)
+    {
+        axisLength += component * component;
+    }
+    if (axisLength == 0.0F)
+    {
+        return {mean, mean};
+    }
+
+    types::Float minProjection = std::numeric_limits<types::Float>::max();
+    types::Float maxProjection = std::numeric_limits<types::Float>::lowest();
+    for (auto const &color : colors)
+    {
+        types::Float projection = 0.0F;
+        for (size_t channel = 0; channel < N; channel++)
+        {
+            projection += (color[channel] - mean[channel]) * axis[channel];
+        }
+        minProjection = std::min(minProjection, projection / axisLength);
+        maxProjection = std::max(maxProjection, projection / axisLength);
+    }
+
+    Color<N> first{};
+    Color<N> second{};
+    for (size_t channel = 0; channel < N; channel++)
+    {
+        first[channel] = std::clamp(mean[channel] + axis[channel] * maxProjection, 0.0F, 255.0F);
+        second[channel] = std::clamp(mean[channel] + axis[channel] * minProjection, 0.0F, 255.0F);
+    }
+    return {first, second};
+}
+
+/**
+ * Endpoints with the least squared error, given how much of the first endpoint goes into each
+ * color. Returns false in case all colors use the same palette entry.
+ */
+template <size_t N>
+bool leastSquaresEndpoints(BlockColors<N> const &colors,
+                           std::array<types::Float, TEXELS_COUNT> const &firstWeights,
+                           Color<N> &first,
+                           Color<N> &second)
+{
+    types::Float firstSquared = 0.0F;
+    types::Float mixed = 0.0F;
+    types::Float secondSquared = 0.0F;
+    Color<N> firstSum{};
+    Color<N> secondSum{};
+    for (size_t i = 0; i < TEXELS_COUNT; i++)
+    {
+        types::Float firstWeight = firstWeights[i];
+        types::Float secondWeight = 1.0F - firstWeight;
+        firstSquared += firstWeight * firstWeight;
+        mixed += firstWeight * secondWeight;
+        secondSquared += secondWeight * secondWeight;
+        for (size_t channel = 0; channel < N; channel++)
+        {
+            firstSum[channel] += firstWeight * colors[i][channel];
+            secondSum[channel] += secondWeight * colors[i][channel];
+        }
+    }
+
+    types::Float determinant = firstSquared * secondSquared - mixed * mixed;
+    if (std::abs(determinant) < 1e-6F)
+    {
+        return false;
+    }
+    for (size_t channel = 0; channel < N; channel++)
+    {
+        first[channel] = std::clamp(
+            (secondSquared * firstSum[channel] - mixed * secondSum[channel]) / determinant,
+            0.0F,
+            255.0F);
+        second[channel] = std::clamp(
+            (firstSquared * secondSum[channel] - mixed * firstSum[channel]) / determinant,
+            0.0F,
+            255.0F);
+    }
+    return true;
+}
+
+/**
+ * Little-endian sequence of bit fields, the first field takes the lowest bits.
+ */
+class BitWriter
+{
+public:
+    explicit BitWriter(std::span<std::byte> destination)
+        : _destination(destination)
+    {
+        std::fill(_destination.begin(), _destination.end(), std::byte{0});
+    }
+
+    void write(std::uint64_t value, size_t bitsCount)
+    {
+        for (size_t bit = 0; bit < bitsCount; bit++, _position++)
+        {
+            if (((value >> bit) & 1U) != 0)
+            {
+                _destination[_position / 8] |= std::byte{1} << (_position % 8);
+            }
+        }
+    }
+
+private:
+    std::span<std::byte> _destination;
+    size_t _position = 0;
+};
+
+// * BC1 *
+
+types::UShort packColor565(Color<3> const &color)
+{
+    auto red = static_cast<types::UShort>(std::lround(color[0] * 31.0F / 255.0F));
+    auto green = static_cast<types::UShort>(std::lround(color[1] * 63.0F / 255.0F));
+    auto blue = static_cast<types::UShort>(std::lround(color[2] * 31.0F / 255.0F));
+    return static_cast<types::UShort>((red << 11U) | (green << 5U) | blue);
+}
+
+Color<3> unpackColor565(types::UShort color)
+{
+    types::UInt red = (color >> 11U) & 0x1FU;
+    types::UInt green = (color >> 5U) & 0x3FU;
+    types::UInt blue = color & 0x1FU;
+    return {static_cast<types::Float>((red << 3U) | (red >> 2U)),
+            static_cast<types::Float>((green << 2U) | (green >> 4U)),
+            static_cast<types::Float>((blue << 3U) | (blue >> 2U))};
+}
+
+struct ColorBlockFit
+{
+    types::UShort first = 0;
+    types::UShort second = 0;
+    Indices indices{};
+    types::Float error = std::numeric_limits<types::Float>::max();
+};
+
+/**
+ * Weights of the first endpoint in the four color palette.
+ */
+std::array<types::Float, 4> constexpr BC1_FIRST_WEIGHTS = {1.0F, 0.0F, 2.0F / 3.0F, 1.0F / 3.0F};
+
+ColorBlockFit
+fitColorBlock(BlockColors<3> const &colors, Color<3> const &first, Color<3> const &second)
+{
+    ColorBlockFit fit{.first = packColor565(first), .second = packColor565(second)};
+
+    std::array<Color<3>, 4> palette{};
+    Color<3> firstColor = unpackColor565(fit.first);
+    Color<3> secondColor = unpackColor565(fit.second);
+    for (size_t entry = 0; entry < palette.size(); entry++)
+    {
+        for (size_t channel = 0; channel < 3; channel++)
+        {
+            palette[entry][channel] = BC1_FIRST_WEIGHTS[entry] * firstColor[channel] +
+                                      (1.0F - BC1_FIRST_WEIGHTS[entry]) * secondColor[channel];
+        }
+    }
+    fit.error = closestIndices(colors, palette, fit.indices);
+    return fit;
+}
+
+void compressColorBlock(BlockCompressor::Block const &texels, std::span<std::byte> destination)
+{
+    auto colors = blockColors<3>(texels);
+    auto [first, second] = principalEndpoints(colors);
+    ColorBlockFit fit = fitColorBlock(colors, first, second);
+
+    for (size_t iteration = 0; iteration < REFINEMENT_ITERATIONS_COUNT; iteration++)
+    {
+        std::array<types::Float, TEXELS_COUNT> firstWeights{};
+        for (size_t i = 0; i < TEXELS_COUNT; i++)
+        {
+            firstWeights[i] = BC1_FIRST_WEIGHTS[fit.indices[i]];
+        }
+        if (!leastSquaresEndpoints(colors, firstWeights, first, second))
+        {
+            break;
+        }
+        ColorBlockFit refinedFit = fitColorBlock(colors, first, second);
+        if (refinedFit.error >= fit.error)
+        {
+            break;
+        }
+        fit = refinedFit;
+    }
+
+    // The four color palette is only used when the first endpoint is the larger one, swapping the
+    // endpoints swaps the indices 0 with 1 and 2 with 3
+    if (fit.first < fit.second)
+    {
+        std::swap(fit.first, fit.second);
+        for (auto &index : fit.indices)
+        {
+            index ^= 1U;
+        }
+    }
+    else if (fit.first == fit.second)
+    {
+        fit.indices.fill(0);
+    }
+
+    BitWriter writer(destination.first(8));
+    writer.write(fit.first, 16);
+    writer.write(fit.second, 16);
+    for (auto index : fit.indices)
+    {
+        writer.write(index, 2);
+    }
+}
+
+// * BC4, used by BC3 and BC5 *
+
+void compressChannelBlock(BlockCompressor::Block const &texels,
+                          size_t channel,
+                          std::span<std::byte> destination)
+{
+    std::uint8_t minValue = std::numeric_limits<std::uint8_t>::max();
+    std::uint8_t maxValue = 0;
+    for (size_t i = 0; i < TEXELS_COUNT; i++)
+    {
+        minValue = std::min(minValue, texels[i * Image::CHANNELS_COUNT + channel]);
+        maxValue = std::max(maxValue, texels[i * Image::CHANNELS_COUNT + channel]);
+    }
+
+    // With equal endpoints the block is read as the six value palette, its first entry is still
+    // the first endpoint
+    Indices indices{};
+    if (maxValue > minValue)
+    {
+        std::array<Color<1>, 8> palette{};
+        palette[0] = {static_cast<types::Float>(maxValue)};
+        palette[1] = {static_cast<types::Float>(minValue)};
+        for (size_t entry = 2; entry < palette.size(); entry++)
+        {
+            palette[entry] = {(static_cast<types::Float>(8 - entry) * maxValue +
+                               static_cast<types::Float>(entry - 1) * minValue) /
+                              7.0F};
+        }
+
+        BlockColors<1> values{};
+        for (size_t i = 0; i < TEXELS_COUNT; i++)
+        {
+            values[i] = {static_cast<types::Float>(texels[i * Image::CHANNELS_COUNT + channel])};
+        }
+        closestIndices(values, palette, indices);
+    }
+
+    BitWriter writer(destination.first(8));
+    writer.write(maxValue, 8);
+    writer.write(minValue, 8);
+    for (auto index : indices)
+    {
+        writer.write(index, 3);
+    }
+}
+
+// * BC7 *
+
+/**
+ * Mode 6 endpoint: seven bits for each channel, the shared lowest bit is the p-bit.
+ */
+struct Mode6Endpoint
+{
+    std::array<std::uint8_t, 4> channels{};
+    std::uint8_t pBit = 0;
+
+    [[nodiscard]] types::Int value(size_t channel) const
+    {
+        return (channels[channel] << 1U) | pBit;
+    }
+};
+
+struct Mode6Fit
+{
+    Mode6Endpoint first;
+    Mode6Endpoint second;
+    Indices indices{};
+    types::Float error = std::numeric_limits<types::Float>::max();
+};
+
+Mode6Endpoint quantizeMode6Endpoint(Color<4> const &color, std::uint8_t pBit)
+{
+    Mode6Endpoint endpoint{.pBit = pBit};
+    for (size_t channel = 0; channel < 4; channel++)
+    {
+        auto value = std::lround((color[channel] - static_cast<types::Float>(pBit)) / 2.0F);
+        endpoint.channels[channel] = static_cast<std::uint8_t>(std::clamp(value, 0L, 127L));
+    }
+    return endpoint;
+}
+
+/**
+ * Tries all the p-bit combinations for the endpoints.
+ */
+Mode6Fit fitMode6Block(BlockColors<4> const &colors, Color<4> const &first, Color<4> const &second)
+{
+    Mode6Fit bestFit;
+    for (std::uint8_t firstPBit = 0; firstPBit < 2; firstPBit++)
+    {
+        for (std::uint8_t secondPBit = 0; secondPBit < 2; secondPBit++)
+        {
+            Mode6Fit fit{.first = quantizeMode6Endpoint(first, firstPBit),
+                         .second = quantizeMode6Endpoint(second, secondPBit)};
+
+            std::array<Color<4>, 16> palette{};
+            for (size_t entry = 0; entry < palette.size(); entry++)
+            {
+                for (size_t channel = 0; channel < 4; channel++)
+                {
+                    palette[entry][channel] = static_cast<types::Float>(
+                        ((64 - BC7_WEIGHTS[entry]) * fit.first.value(channel) +
+                         BC7_WEIGHTS[entry] * fit.second.value(channel) + 32) >>
+                        6);
+                }
+            }
+            fit.error = closestIndices(colors, palette, fit.indices);
+            if (fit.error < bestFit.error)
+            {
+                bestFit = fit;
+            }
+        }
+    }
+    return bestFit;
+}
+
+void compressMode6Block(BlockCompressor::Block const &texels, std::span<std::byte> destination)
+{
+    auto colors = blockColors<4>(texels);
+    auto [first, second] = principalEndpoints(colors);
+    Mode6Fit fit = fitMode6Block(colors, first, second);
+
+    for (size_t iteration = 0; iteration < REFINEMENT_ITERATIONS_COUNT; iteration++)
+    {
+        std::array<types::Float, TEXELS_COUNT> firstWeights{};
+        for (size_t i = 0; i < TEXELS_COUNT; i++)
+        {
+            firstWeights[i] = static_cast<types::Float>(64 - BC7_WEIGHTS[fit.indices[i]]) / 64.0F;
+        }
+        if (!leastSquaresEndpoints(colors, firstWeights, first, second))
+        {
+            break;
+        }
+        Mode6Fit refinedFit = fitMode6Block(colors, first, second);
+        if (refinedFit.error >= fit.error)
+        {
+            break;
+        }
+        fit = refinedFit;
+    }
+
+    // The highest bit of the first index is implied to be zero
+    if (fit.indices[0] >= 8)
+    {
+        std::swap(fit.first, fit.second);
+        for (auto &index : fit.indices)
+        {
+            index = static_cast<std::uint8_t>(15 - index);
+        }
+    }
+
+    BitWriter writer(destination.first(16));
+    writer.write(1U << 6U, 7);
+    for (size_t channel = 0; channel < 4; channel++)
+    {
+        writer.write(fit.first.channels[channel], 7);
+        writer.write(fit.second.channels[channel], 7);
+    }
+    writer.write(fit.first.pBit, 1);
+    writer.write(fit.second.pBit, 1);
+    writer.write(fit.indices[0], 3);
+    for (size_t i = 1; i < TEXELS_COUNT; i++)
+    {
+        writer.write(fit.indices[i], 4);
+    }
+}
+
+} // namespace
+
+size_t BlockCompressor::blockSize(Format format)
+{
+    switch (format)
+    {
+    case BC1:
+        return 8;
+    case BC3:
+    case BC5:
+    case BC7:
+        return 16;
+    default:
+        throw std::invalid_argument(fmt::format("Unknown block compression format: {}.",
+                                                static_cast<types::UInt>(format)));
+    }
+}
+
+size_t BlockCompressor::compressedSize(Format format, types::Size width, types::Size height)
+{
+    auto blocksX = static_cast<size_t>((width + BLOCK_WIDTH - 1) / BLOCK_WIDTH);
+    auto blocksY = static_cast<size_t>((height + BLOCK_HEIGHT - 1) / BLOCK_HEIGHT);
+    return blocksX * blocksY * blockSize(format);
+}
+
+std::vector<std::byte>
+BlockCompressor::compress(Image const &image, Format format, types::Size threadsCount)
+{
+    if (threadsCount < 0)
+    {
+        throw std::invalid_argument("Threads count must not be negative.");
+    }
+    if (threadsCount == 0)
+    {
+        threadsCount =
+            std::max(1, gsl::narrow_cast<types::Size>(std::thread::hardware_concurrency()));
+    }
+
+    size_t size = blockSize(format);
+    types::Int blocksX = (image.width() + BLOCK_WIDTH - 1) / BLOCK_WIDTH;
+    types::Int blocksY = (image.height() + BLOCK_HEIGHT - 1) / BLOCK_HEIGHT;
+    std::vector<std::byte> compressed(compressedSize(format, image.width(), image.height()));
+
+    std::atomic<types::Int> nextRow = 0;
+    auto worker = [&]()
+    {
+        Block texels{};
+        for (types::Int blockY = nextRow++; blockY < blocksY; blockY = nextRow++)
+        {
+            for (types::Int blockX = 0; blockX < blocksX; blockX++)
+            {
+                for (types::Int y = 0; y < BLOCK_HEIGHT; y++)
+                {
+                    for (types::Int x = 0; x < BLOCK_WIDTH; x++)
+                    {
+                        std::uint8_t const *pixel = image.pixel(blockX * BLOCK_WIDTH + x,
+                                                                blockY * BLOCK_HEIGHT + y);
+                        auto texelOffset =
+                            static_cast<size_t>(y * BLOCK_WIDTH + x) * Image::CHANNELS_COUNT;
+                        std::copy(pixel, pixel + Image::CHANNELS_COUNT, &texels[texelOffset]);
+                    }
+                }
+                auto offset = static_cast<size_t>(blockY * blocksX + blockX) * size;
+                compressBlock(texels, format, std::span(compressed).subspan(offset, size));
+            }
+        }
+    };
+
+    // The calling thread takes part in the work too
+    std::vector<std::jthread> threads;
+    for (types::Size i = 1; i < std::min(threadsCount, blocksY); i++)
+    {
+        threads.emplace_back(worker);
+    }
+    worker();
+    threads.clear();
+
+    return compressed;
+}
+
+void BlockCompressor::compressBlock(Block const &texels,
+                                    Format format,
+                                    std::span<std::byte> destination)
+{
+    if (destination.size() < blockSize(format))
+    {
+        throw std::invalid_argument(fmt::format(
+            "A block takes {} bytes, only {} given.", blockSize(format), destination.size()));
+    }
+
+    switch (format)
+    {
+    case BC1:
+        compressColorBlock(texels, destination);
+        break;
+    case BC3:
+        compressChannelBlock(texels, 3, destination);
+        compressColorBlock(texels, destination.subspan(8));
+        break;
+    case BC5:
+        compressChannelBlock(texels, 0, destination);
+        compressChannelBlock(texels, 1, destination.subspan(8));
+        break;
+    case BC7:
+        compressMode6Block(texels, destination);
+        break;
+    }
+}
+
+} // namespace pf::gl
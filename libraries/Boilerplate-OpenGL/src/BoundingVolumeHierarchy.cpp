@@ -0,0 +1,631 @@
+#include <pf_gl/BoundingVolumeHierarchy.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+#include <glm/glm.hpp>
+#include <gsl/util>
+
+#include <pf_gl/BoundingVolumes.hpp>
+#include <pf_gl/Frustum.hpp>
+#include <pf_gl/ValueTypes.hpp>
+
+namespace pf::gl
+{
+
+BoundingVolumeHierarchy::BoundingVolumeHierarchy(types::Float fatMargin)
+    : _fatMargin(fatMargin)
+{
+    if (_fatMargin < 0.0F)
+    {
+        throw std::invalid_argument("Fat margin must not be negative.");
+    }
+}
+
+types::UInt BoundingVolumeHierarchy::insert(BoundingBox const &box, types::UInt userData)
+{
+    types::UInt leaf = allocateNode();
+    _nodes[leaf].box = box.expand(_fatMargin);
+    _nodes[leaf].objectBox = box;
+    _nodes[leaf].userData = userData;
+    _nodes[leaf].height = 0;
+
+    insertLeaf(leaf);
+    _leavesCount++;
+    return leaf;
+}
+
+void BoundingVolumeHierarchy::remove(types::UInt proxy)
+{
+    validateProxy(proxy);
+
+    removeLeaf(proxy);
+    freeNode(proxy);
+    _leavesCount--;
+}
+
+bool BoundingVolumeHierarchy::move(types::UInt proxy, BoundingBox const &box)
+{
+    validateProxy(proxy);
+
+    _nodes[proxy].objectBox = box;
+    if (_nodes[proxy].box.contains(box))
+    {
+        return false;
+    }
+
+    removeLeaf(proxy);
+    _nodes[proxy].box = box.expand(_fatMargin);
+    insertLeaf(proxy);
+    return true;
+}
+
+void BoundingVolumeHierarchy::rebuild()
+{
+    if (_root == NULL_NODE)
+    {
+        return;
+    }
+
+    std::vector<types::UInt> leaves;
+    leaves.reserve(_leavesCount);
+    std::vector<types::FVec3> centroids(_nodes.size());
+
+    for (types::UInt i = 0; i < _nodes.size(); i++)
+    {
+        if (_nodes[i].height < 0)
+        {
+            continue;
+        }
+
+        if (_nodes[i].isLeaf())
+        {
+            leaves.push_back(i);
+            centroids[i] = _nodes[i].box.center();
+        }
+        else
+        {
+            freeNode(i);
+        }
+    }
+
+    _root = buildSubtree(leaves, centroids);
+    _nodes[_root].parent = NULL_NODE;
+}
+
+void BoundingVolumeHierarchy::clear()
+{
+    _nodes.clear();
+    _root = NULL_NODE;
+    _freeList = NULL_NODE;
+    _leavesCount = 0;
+}
+
+void BoundingVolumeHierarchy::queryFrustum(Frustum const &frustum,
+                                           std::vector<types::UInt> &result) const
+{
+    if (_root == NULL_NODE)
+    {
+        return;
+    }
+
+    // The second value tells whether the node is known to be completely inside of the frustum
+    std::vector<std::pair<types::UInt, bool>> stack;
+    stack.reserve(64);
+    stack.emplace_back(_root, false);
+
+    while (!stack.empty())
+    {
+        auto [nodeIndex, insideFrustum] = stack.back();
+        stack.pop_back();
+        Node const &node = _nodes[nodeIndex];
+
+        if (node.isLeaf())
+        {
+            if (insideFrustum || frustum.intersects(node.objectBox))
+            {
+                result.push_back(node.userData);
+            }
+            continue;
+        }
+
+        if (!insideFrustum)
+        {
+            Frustum::Intersection intersection = frustum.classify(node.box);
+            if (intersection == Frustum::OUTSIDE)
+            {
+                continue;
+            }
+            insideFrustum = intersection == Frustum::INSIDE;
+        }
+
+        stack.emplace_back(node.left, insideFrustum);
+        stack.emplace_back(node.right, insideFrustum);
+    }
+}
+
+void BoundingVolumeHierarchy::querySphere(BoundingSphere const &sphere,
+                                          std::vector<types::UInt> &result) const
+{
+    if (_root == NULL_NODE)
+    {
+        return;
+    }
+
+    std::vector<types::UInt> stack;
+    stack.reserve(64);
+    stack.push_back(_root);
+
+    while (!stack.empty())
+    {
+        Node const &node = _nodes[stack.back()];
+        stack.pop_back();
+
+        if (node.isLeaf())
+        {
+            if (sphere.intersects(node.objectBox))
+            {
+                result.push_back(node.userData);
+            }
+        }
+        else if (sphere.intersects(node.box))
+        {
+            stack.push_back(node.left);
+            stack.push_back(node.right);
+        }
+    }
+}
+
+std::optional<BoundingVolumeHierarchy::RayHit>
+BoundingVolumeHierarchy::raycast(Ray const &ray, types::Float maxDistance) const
+{
+    if (_root == NULL_NODE)
+    {
+        return std::nullopt;
+    }
+
+    std::optional<RayHit> closestHit;
+    types::Float closestDistance = maxDistance;
+
+    std::vector<std::pair<types::UInt, types::Float>> stack;
+    stack.reserve(64);
+    if (auto distance = ray.intersect(_nodes[_root].box); distance.has_value())
+    {
+        stack.emplace_back(_root, *distance);
+    }
+
+    while (!stack.empty())
+    {
+        auto [nodeIndex, entryDistance] = stack.back();
+        stack.pop_back();
+
+        // Something closer has been found after the node was pushed
+        if (entryDistance > closestDistance)
+        {
+            continue;
+        }
+
+        Node const &node = _nodes[nodeIndex];
+        if (node.isLeaf())
+        {
+            auto distance = ray.intersect(node.objectBox);
+            if (distance.has_value() && *distance <= closestDistance)
+            {
+                closestDistance = *distance;
+                closestHit = RayHit{.userData = node.userData, .distance = *distance};
+            }
+            continue;
+        }
+
+        auto leftDistance = ray.intersect(_nodes[node.left].box);
+        auto rightDistance = ray.intersect(_nodes[node.right].box);
+        std::array<std::pair<types::UInt, std::optional<types::Float>>, 2> children = {
+            std::pair(node.left, leftDistance),
+            std::pair(node.right, rightDistance),
+        };
+
+        // The closer child is pushed last, so that it is visited first
+        if (leftDistance.has_value() && rightDistance.has_value() &&
+            *leftDistance < *rightDistance)
+        {
+            std::swap(children[0], children[1]);
+        }
+        for (auto const &[child, distance] : children)
+        {
+            if (distance.has_value() && *distance <= closestDistance)
+            {
+                stack.emplace_back(child, *distance);
+            }
+        }
+    }
+
+    return closestHit;
+}
+
+types::UInt BoundingVolumeHierarchy::userData(types::UInt proxy) const
+{
+    validateProxy(proxy);
+    return _nodes[proxy].userData;
+}
+
+BoundingBox const &BoundingVolumeHierarchy::boundingBox(types::UInt proxy) const
+{
+    validateProxy(proxy);
+    return _nodes[proxy].objectBox;
+}
+
+BoundingBox const &BoundingVolumeHierarchy::fatBoundingBox(types::UInt proxy) const
+{
+    validateProxy(proxy);
+    return _nodes[proxy].box;
+}
+
+types::Size BoundingVolumeHierarchy::size() const
+{
+    return _leavesCount;
+}
+
+types::Int BoundingVolumeHierarchy::height() const
+{
+    return _root == NULL_NODE ? 0 : _nodes[_root].height;
+}
+
+
+// * Tree modification *
+
+types::UInt BoundingVolumeHierarchy::allocateNode()
+{
+    if (_freeList == NULL_NODE)
+    {
+        _nodes.emplace_back();
+        return gsl::narrow_cast<types::UInt>(_nodes.size() - 1);
+    }
+
+    types::UInt node = _freeList;
+    _freeList = _nodes[node].parent;
+    _nodes[node] = Node();
+    return node;
+}
+
+void BoundingVolumeHierarchy::freeNode(types::UInt node)
+{
+    _nodes[node].height = -1;
+    _nodes[node].left = NULL_NODE;
+    _nodes[node].right = NULL_NODE;
+    _nodes[node].parent = _freeList;
+    _freeList = node;
+}
+
+void BoundingVolumeHierarchy::insertLeaf(types::UInt leaf)
+{
+    if (_root == NULL_NODE)
+    {
+        _root = leaf;
+        _nodes[leaf].parent = NULL_NODE;
+        return;
+    }
+
+    BoundingBox const leafBox = _nodes[leaf].box;
+
+    // Descend to the sibling which minimizes the total surface area of the tree. Creating a new
+    // parent for the current node costs the area of the merged box, and every ancestor of the new
+    // parent grows by the same delta, which is accumulated as the inherited cost.
+    types::UInt index = _root;
+    while (!_nodes[index].isLeaf())
+    {
+        Node const &node = _nodes[index];
+
+        types::Float area = node.box.surfaceArea();
+        types::Float mergedArea = node.box.merge(leafBox).surfaceArea();
+
+        types::Float cost = 2.0F * mergedArea;
+        types::Float inheritedCost = 2.0F * (mergedArea - area);
+
+        auto descendCost = [this, &leafBox, inheritedCost](types::UInt child)
+        {
+            Node const &childNode = _nodes[child];
+            types::Float childMergedArea = childNode.box.merge(leafBox).surfaceArea();
+            if (childNode.isLeaf())
+            {
+                return childMergedArea + inheritedCost;
+            }
+            return childMergedArea - childNode.box.surfaceArea() + inheritedCost;
+        };
+
+        types::Float leftCost = descendCost(node.left);
+        types::Float rightCost = descendCost(node.right);
+
+        if (cost < leftCost && cost < rightCost)
+        {
+            break;
+        }
+        index = leftCost < rightCost ? node.left : node.right;
+    }
+
+    types::UInt sibling = index;
+    types::UInt oldParent = _nodes[sibling].parent;
+    types::UInt newParent = allocateNode();
+
+    _nodes[newParent].parent = oldParent;
+    _nodes[newParent].box = _nodes[sibling].box.merge(leafBox);
+    _nodes[newParent].height = _nodes[sibling].height + 1;
+    _nodes[newParent].left = sibling;
+    _nodes[newParent].right = leaf;
+    _nodes[sibling].parent = newParent;
+    _nodes[leaf].parent = newParent;
+
+    if (oldParent == NULL_NODE)
+    {
+        _root = newParent;
+    }
+    else if (_nodes[oldParent].left == sibling)
+    {
+        _nodes[oldParent].left = newParent;
+    }
+    else
+    {
+        _nodes[oldParent].right = newParent;
+    }
+
+    refitUpwards(_nodes[leaf].parent);
+}
+
+void BoundingVolumeHierarchy::removeLeaf(types::UInt leaf)
+{
+    if (leaf == _root)
+    {
+        _root = NULL_NODE;
+        return;
+    }
+
+    types::UInt parent = _nodes[leaf].parent;
+    types::UInt grandParent = _nodes[parent].parent;
+    types::UInt sibling =
+        _nodes[parent].left == leaf ? _nodes[parent].right : _nodes[parent].left;
+
+    _nodes[sibling].parent = grandParent;
+    freeNode(parent);
+
+    if (grandParent == NULL_NODE)
+    {
+        _root = sibling;
+        return;
+    }
+
+    if (_nodes[grandParent].left == parent)
+    {
+        _nodes[grandParent].left = sibling;
+    }
+    else
+    {
+        _nodes[grandParent].right = sibling;
+    }
+    refitUpwards(grandParent);
+}
+
+void BoundingVolumeHierarchy::refitUpwards(types::UInt node)
+{
+    types::UInt index = node;
+    while (index != NULL_NODE)
+    {
+        index = balance(index);
+
+        Node &current = _nodes[index];
+        Node const &left = _nodes[current.left];
+        Node const &right = _nodes[current.right];
+
+        current.height = 1 + std::max(left.height, right.height);
+        current.box = left.box.merge(right.box);
+
+        index = current.parent;
+    }
+}
+
+types::UInt BoundingVolumeHierarchy::balance(types::UInt nodeA)
+{
+    Node &a = _nodes[nodeA];
+    if (a.isLeaf() || a.height < 2)
+    {
+        return nodeA;
+    }
+
+    types::UInt nodeB = a.left;
+    types::UInt nodeC = a.right;
+    Node &b = _nodes[nodeB];
+    Node &c = _nodes[nodeC];
+
+    types::Int balanceFactor = c.height - b.height;
+
+    // Depending on which side is deeper, its root (B or C) replaces A, and A adopts the shallower
+    // of the grandchildren, so that the height of the subtree decreases.
+    auto rotateUp = [this, nodeA, &a](types::UInt nodeUp, Node &up, Node &stayingChild)
+    {
+        types::UInt nodeF = up.left;
+        types::UInt nodeG = up.right;
+        Node &f = _nodes[nodeF];
+        Node &g = _nodes[nodeG];
+
+        up.left = nodeA;
+        up.parent = a.parent;
+        a.parent = nodeUp;
+
+        if (up.parent == NULL_NODE)
+        {
+            _root = nodeUp;
+        }
+        else if (_nodes[up.parent].left == nodeA)
+        {
+            _nodes[up.parent].left = nodeUp;
+        }
+        else
+        {
+            _nodes[up.parent].right = nodeUp;
+        }
+
+        types::UInt nodeKept = f.height > g.height ? nodeF : nodeG;
+        types::UInt nodeGiven = f.height > g.height ? nodeG : nodeF;
+        Node &kept = _nodes[nodeKept];
+        Node &given = _nodes[nodeGiven];
+
+        up.right = nodeKept;
+        if (a.left == nodeUp)
+        {
+            a.left = nodeGiven;
+        }
+        else
+        {
+            a.right = nodeGiven;
+        }
+        given.parent = nodeA;
+
+        a.box = stayingChild.box.merge(given.box);
+        a.height = 1 + std::max(stayingChild.height, given.height);
+        up.box = a.box.merge(kept.box);
+        up.height = 1 + std::max(a.height, kept.height);
+    };
+
+    if (balanceFactor > 1)
+    {
+        rotateUp(nodeC, c, b);
+        return nodeC;
+    }
+    if (balanceFactor < -1)
+    {
+        rotateUp(nodeB, b, c);
+        return nodeB;
+    }
+    return nodeA;
+}
+
+types::UInt BoundingVolumeHierarchy::buildSubtree(std::span<types::UInt> leaves,
+                                                  std::span<types::FVec3 const> centroids)
+{
+    if (leaves.size() == 1)
+    {
+        return leaves.front();
+    }
+
+    BoundingBox centroidBounds = BoundingBox::EMPTY;
+    for (auto leaf : leaves)
+    {
+        centroidBounds = centroidBounds.merge(centroids[leaf]);
+    }
+
+    types::FVec3 centroidSize = centroidBounds.max - centroidBounds.min;
+    glm::length_t axis = 0;
+    if (centroidSize.y > centroidSize[axis])
+    {
+        axis = 1;
+    }
+    if (centroidSize.z > centroidSize[axis])
+    {
+        axis = 2;
+    }
+
+    size_t splitIndex = leaves.size() / 2;
+    bool splitFound = false;
+
+    if (centroidSize[axis] > 0.0F)
+    {
+        struct Bin
+        {
+            BoundingBox box = BoundingBox::EMPTY;
+            size_t count = 0;
+        };
+        std::array<Bin, SAH_BINS_COUNT> bins;
+
+        types::Float binScale = static_cast<types::Float>(SAH_BINS_COUNT) / centroidSize[axis];
+        auto binIndex = [&centroids, &centroidBounds, axis, binScale](types::UInt leaf)
+        {
+            types::Float offset = centroids[leaf][axis] - centroidBounds.min[axis];
+            return std::min(SAH_BINS_COUNT - 1, static_cast<size_t>(offset * binScale));
+        };
+
+        for (auto leaf : leaves)
+        {
+            Bin &bin = bins.at(binIndex(leaf));
+            bin.box = bin.box.merge(_nodes[leaf].box);
+            bin.count++;
+        }
+
+        // Sweep from the right to get the costs of all of the right halves, then from the left
+        std::array<types::Float, SAH_BINS_COUNT> rightCosts{};
+        BoundingBox rightBox = BoundingBox::EMPTY;
+        size_t rightCount = 0;
+        for (size_t i = SAH_BINS_COUNT - 1; i > 0; i--)
+        {
+            rightBox = rightBox.merge(bins.at(i).box);
+            rightCount += bins.at(i).count;
+            rightCosts.at(i) = rightBox.surfaceArea() * static_cast<types::Float>(rightCount);
+        }
+
+        types::Float bestCost = std::numeric_limits<types::Float>::max();
+        size_t bestSplit = 0;
+        BoundingBox leftBox = BoundingBox::EMPTY;
+        size_t leftCount = 0;
+        for (size_t i = 0; i < SAH_BINS_COUNT - 1; i++)
+        {
+            leftBox = leftBox.merge(bins.at(i).box);
+            leftCount += bins.at(i).count;
+            types::Float cost =
+                leftBox.surfaceArea() * static_cast<types::Float>(leftCount) + rightCosts.at(i + 1);
+            if (leftCount > 0 && leftCount < leaves.size() && cost < bestCost)
+            {
+                bestCost = cost;
+                bestSplit = i;
+            }
+        }
+
+        auto middle = std::partition(leaves.begin(),
+                                     leaves.end(),
+                                     [&binIndex, bestSplit](types::UInt leaf)
+                                     { return binIndex(leaf) <= bestSplit; });
+        auto leftSize = static_cast<size_t>(std::distance(leaves.begin(), middle));
+        if (leftSize > 0 && leftSize < leaves.size())
+        {
+            splitIndex = leftSize;
+            splitFound = true;
+        }
+    }
+
+    // All of the centroids fall into a single bin, split by the median instead
+    if (!splitFound)
+    {
+        std::nth_element(leaves.begin(),
+                         leaves.begin() + gsl::narrow_cast<std::ptrdiff_t>(splitIndex),
+                         leaves.end(),
+                         [&centroids, axis](types::UInt first, types::UInt second)
+                         { return centroids[first][axis] < centroids[second][axis]; });
+    }
+
+    types::UInt left = buildSubtree(leaves.subspan(0, splitIndex), centroids);
+    types::UInt right = buildSubtree(leaves.subspan(splitIndex), centroids);
+
+    types::UInt node = allocateNode();
+    _nodes[node].left = left;
+    _nodes[node].right = right;
+    _nodes[node].box = _nodes[left].box.merge(_nodes[right].box);
+    _nodes[node].height = 1 + std::max(_nodes[left].height, _nodes[right].height);
+    _nodes[left].parent = node;
+    _nodes[right].parent = node;
+    return node;
+}
+
+void BoundingVolumeHierarchy::validateProxy(types::UInt proxy) const
+{
+    if (proxy >= _nodes.size() || !_nodes[proxy].isLeaf() || _nodes[proxy].height < 0)
+    {
+        throw std::invalid_argument(fmt::format("Invalid BVH proxy: {}.", proxy));
+    }
+}
+
+} // namespace pf::gl
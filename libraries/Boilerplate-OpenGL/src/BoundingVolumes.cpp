@@ -0,0 +1,214 @@
+#include <pf_gl/BoundingVolumes.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <span>
+
+#include <glm/glm.hpp>
+
+#include <pf_gl/ValueTypes.hpp>
+
+namespace pf::gl
+{
+
+namespace
+{
+
+// Not an actual infinity, so that transforming the box does not produce NaNs.
+types::Float constexpr UNBOUNDED_EXTENT = 1e30F;
+
+StridedPoints stridedPoints(std::span<types::FVec3 const> points)
+{
+    return {.first = reinterpret_cast<std::byte const *>(points.data()),
+            .count = points.size(),
+            .stride = sizeof(types::FVec3)};
+}
+
+} // namespace
+
+BoundingBox const BoundingBox::EMPTY = {
+    .min = types::FVec3(std::numeric_limits<types::Float>::max()),
+    .max = types::FVec3(std::numeric_limits<types::Float>::lowest()),
+};
+
+BoundingBox const BoundingBox::UNBOUNDED = {
+    .min = types::FVec3(-UNBOUNDED_EXTENT),
+    .max = types::FVec3(UNBOUNDED_EXTENT),
+};
+
+types::FVec3 StridedPoints::operator[](size_t index) const
+{
+    types::FVec3 point;
+    std::memcpy(&point, first + index * stride, sizeof(types::FVec3));
+    return point;
+}
+
+BoundingBox BoundingBox::fromPoints(std::span<types::FVec3 const> points)
+{
+    return fromPoints(stridedPoints(points));
+}
+
+BoundingBox BoundingBox::fromPoints(StridedPoints const &points)
+{
+    BoundingBox box = EMPTY;
+    for (size_t i = 0; i < points.count; i++)
+    {
+        types::FVec3 point = points[i];
+        box.min = glm::min(box.min, point);
+        box.max = glm::max(box.max, point);
+    }
+    return box;
+}
+
+bool BoundingBox::isEmpty() const
+{
+    return min.x > max.x || min.y > max.y || min.z > max.z;
+}
+
+types::FVec3 BoundingBox::center() const
+{
+    return (min + max) * 0.5F;
+}
+
+types::FVec3 BoundingBox::extents() const
+{
+    return (max - min) * 0.5F;
+}
+
+types::Float BoundingBox::surfaceArea() const
+{
+    if (isEmpty())
+    {
+        return 0.0F;
+    }
+
+    types::FVec3 size = max - min;
+    return 2.0F * (size.x * size.y + size.y * size.z + size.z * size.x);
+}
+
+bool BoundingBox::contains(types::FVec3 const &point) const
+{
+    return point.x >= min.x && point.y >= min.y && point.z >= min.z && point.x <= max.x &&
+           point.y <= max.y && point.z <= max.z;
+}
+
+bool BoundingBox::contains(BoundingBox const &other) const
+{
+    return other.min.x >= min.x && other.min.y >= min.y && other.min.z >= min.z &&
+           other.max.x <= max.x && other.max.y <= max.y && other.max.z <= max.z;
+}
+
+bool BoundingBox::intersects(BoundingBox const &other) const
+{
+    return min.x <= other.max.x && min.y <= other.max.y && min.z <= other.max.z &&
+           other.min.x <= max.x && other.min.y <= max.y && other.min.z <= max.z;
+}
+
+BoundingBox BoundingBox::merge(BoundingBox const &other) const
+{
+    return {.min = glm::min(min, other.min), .max = glm::max(max, other.max)};
+}
+
+BoundingBox BoundingBox::merge(types::FVec3 const &point) const
+{
+    return {.min = glm::min(min, point), .max = glm::max(max, point)};
+}
+
+BoundingBox BoundingBox::expand(types::Float margin) const
+{
+    return {.min = min - types::FVec3(margin), .max = max + types::FVec3(margin)};
+}
+
+BoundingBox BoundingBox::transform(types::FMat4 const &matrix) const
+{
+    if (isEmpty())
+    {
+        return EMPTY;
+    }
+
+    // Arvo's method: every column of the matrix contributes to the new bounds independently, so
+    // there is no need to transform all of the 8 corners of the box.
+    types::FVec3 newMin = types::FVec3(matrix[3]);
+    types::FVec3 newMax = newMin;
+
+    for (glm::length_t column = 0; column < 3; column++)
+    {
+        types::FVec3 axis = types::FVec3(matrix[column]);
+        types::FVec3 a = axis * min[column];
+        types::FVec3 b = axis * max[column];
+        newMin += glm::min(a, b);
+        newMax += glm::max(a, b);
+    }
+
+    return {.min = newMin, .max = newMax};
+}
+
+BoundingSphere BoundingSphere::fromPoints(std::span<types::FVec3 const> points,
+                                          BoundingBox const &boundingBox)
+{
+    return fromPoints(stridedPoints(points), boundingBox);
+}
+
+BoundingSphere BoundingSphere::fromPoints(StridedPoints const &points,
+                                          BoundingBox const &boundingBox)
+{
+    // The center of the box is not the center of the minimal sphere, but it is close enough
+    types::FVec3 center = boundingBox.center();
+    types::Float squaredRadius = 0.0F;
+    for (size_t i = 0; i < points.count; i++)
+    {
+        types::FVec3 offset = points[i] - center;
+        squaredRadius = std::max(squaredRadius, glm::dot(offset, offset));
+    }
+
+    return {.center = center, .radius = std::sqrt(squaredRadius)};
+}
+
+bool BoundingSphere::intersects(BoundingBox const &box) const
+{
+    types::FVec3 closestPoint = glm::max(box.min, glm::min(center, box.max));
+    types::FVec3 offset = closestPoint - center;
+    return glm::dot(offset, offset) <= radius * radius;
+}
+
+BoundingSphere BoundingSphere::transform(types::FMat4 const &matrix) const
+{
+    types::Float maxScale = std::max({
+        glm::length(types::FVec3(matrix[0])),
+        glm::length(types::FVec3(matrix[1])),
+        glm::length(types::FVec3(matrix[2])),
+    });
+
+    return {
+        .center = types::FVec3(matrix * types::FVec4(center, 1.0F)),
+        .radius = radius * maxScale,
+    };
+}
+
+std::optional<types::Float> Ray::intersect(BoundingBox const &box) const
+{
+    // Slab method. Division by a zero component yields infinities, which are handled correctly by
+    // the comparisons below.
+    types::FVec3 inverseDirection = types::FVec3(1.0F) / direction;
+    types::FVec3 t0 = (box.min - origin) * inverseDirection;
+    types::FVec3 t1 = (box.max - origin) * inverseDirection;
+
+    types::FVec3 tNear = glm::min(t0, t1);
+    types::FVec3 tFar = glm::max(t0, t1);
+
+    types::Float entry = std::max({tNear.x, tNear.y, tNear.z, 0.0F});
+    types::Float exit = std::min({tFar.x, tFar.y, tFar.z});
+
+    if (entry > exit)
+    {
+        return std::nullopt;
+    }
+    return entry;
+}
+
+} // namespace pf::gl
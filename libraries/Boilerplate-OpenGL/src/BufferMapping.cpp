@@ -0,0 +1,184 @@
+#include <pf_gl/BufferMapping.hpp>
+
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+
+#include <fmt/format.h>
+#include <gsl/util>
+
+#include <pf_gl/ValueTypes.hpp>
+
+namespace pf::gl
+{
+
+namespace
+{
+
+/**
+ * `glUnmapBuffer` fails when the video memory is lost in the meantime (on a mode switch, for
+ * example), the data has to be written once again then.
+ */
+types::Size constexpr MAX_MAPPING_ATTEMPTS = 3;
+
+/**
+ * The immutable storage can only be changed later on in case it is created dynamic.
+ */
+GLbitfield storageFlags(GLenum usage)
+{
+    bool isStatic = usage == GL_STATIC_DRAW || usage == GL_STATIC_READ || usage == GL_STATIC_COPY;
+    return isStatic ? 0 : GL_DYNAMIC_STORAGE_BIT;
+}
+
+/**
+ * @returns false in case the contents of the buffer got lost and have to be written once again.
+ */
+template <typename Unmap>
+bool writeMapping(void *pointer,
+                  types::BinarySize size,
+                  BufferWriter const &write,
+                  Unmap const &unmap)
+{
+    if (pointer == nullptr)
+    {
+        throw std::runtime_error(fmt::format(
+            "Failed to map a buffer of {} bytes (error 0x{:x}).", size, glGetError()));
+    }
+
+    try
+    {
+        write(std::span(static_cast<std::byte *>(pointer), static_cast<size_t>(size)));
+    }
+    catch (...)
+    {
+        unmap();
+        throw;
+    }
+    return unmap() == GL_TRUE;
+}
+
+/**
+ * Fallback without Direct State Access. `GL_COPY_WRITE_BUFFER` is used, so that the element buffer
+ * of the bound vertex array stays intact.
+ */
+void writeMappedCopyBuffer(types::UInt buffer,
+                           types::BinarySize size,
+                           GLenum usage,
+                           BufferWriter const &write)
+{
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+    try
+    {
+        writeMappedBuffer(GL_COPY_WRITE_BUFFER, size, usage, write);
+    }
+    catch (...)
+    {
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        throw;
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+} // namespace
+
+void writeMappedBuffer(GLenum target,
+                       types::BinarySize size,
+                       GLenum usage,
+                       BufferWriter const &write)
+{
+    for (types::Size attempt = 0; attempt < MAX_MAPPING_ATTEMPTS; attempt++)
+    {
+        glBufferData(target, size, nullptr, usage);
+        if (size == 0)
+        {
+            return;
+        }
+
+        void *pointer =
+            glMapBufferRange(target, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+        if (writeMapping(pointer, size, write, [target] { return glUnmapBuffer(target); }))
+        {
+            return;
+        }
+    }
+    throw std::runtime_error("Contents of a mapped buffer kept getting lost.");
+}
+
+void uploadBufferStorage(types::UInt buffer, std::span<std::byte const> data, GLenum usage)
+{
+    auto size = gsl::narrow_cast<types::BinarySize>(data.size());
+    if (GLAD_GL_VERSION_4_5 == 0)
+    {
+        glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+        glBufferData(GL_COPY_WRITE_BUFFER, size, data.data(), usage);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        return;
+    }
+
+    // An immutable storage cannot be empty
+    if (size != 0)
+    {
+        glNamedBufferStorage(buffer, size, data.data(), storageFlags(usage));
+    }
+}
+
+void writeMappedBufferStorage(types::UInt buffer,
+                              types::BinarySize size,
+                              GLenum usage,
+                              BufferWriter const &write)
+{
+    if (GLAD_GL_VERSION_4_5 == 0)
+    {
+        writeMappedCopyBuffer(buffer, size, usage, write);
+        return;
+    }
+
+    if (size == 0)
+    {
+        return;
+    }
+
+    // The storage stays, only the mapping is repeated in case the contents get lost
+    glNamedBufferStorage(buffer, size, nullptr, storageFlags(usage) | GL_MAP_WRITE_BIT);
+    for (types::Size attempt = 0; attempt < MAX_MAPPING_ATTEMPTS; attempt++)
+    {
+        void *pointer = glMapNamedBufferRange(
+            buffer, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+        if (writeMapping(pointer, size, write, [buffer] { return glUnmapNamedBuffer(buffer); }))
+        {
+            return;
+        }
+    }
+    throw std::runtime_error("Contents of a mapped buffer kept getting lost.");
+}
+
+void respecifyMappedBuffer(types::UInt buffer,
+                           types::BinarySize size,
+                           GLenum usage,
+                           BufferWriter const &write)
+{
+    if (GLAD_GL_VERSION_4_5 == 0)
+    {
+        writeMappedCopyBuffer(buffer, size, usage, write);
+        return;
+    }
+
+    for (types::Size attempt = 0; attempt < MAX_MAPPING_ATTEMPTS; attempt++)
+    {
+        glNamedBufferData(buffer, size, nullptr, usage);
+        if (size == 0)
+        {
+            return;
+        }
+
+        void *pointer = glMapNamedBufferRange(
+            buffer, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+        if (writeMapping(pointer, size, write, [buffer] { return glUnmapNamedBuffer(buffer); }))
+        {
+            return;
+        }
+    }
+    throw std::runtime_error("Contents of a mapped buffer kept getting lost.");
+}
+
+} // namespace pf::gl
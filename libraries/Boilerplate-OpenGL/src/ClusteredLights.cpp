@@ -0,0 +1,144 @@
+#include <pf_gl/ClusteredLights.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <utility>
+
+#include <glad/glad.h>
+#include <gsl/util>
+
+#include <pf_gl/BufferMapping.hpp>
+#include <pf_gl/DrawingContext3D.hpp>
+#include <pf_gl/LightClusterer.hpp>
+#include <pf_gl/MinecraftCamera.hpp>
+#include <pf_gl/ValueTypes.hpp>
+#include <pf_gl/Window.hpp>
+
+namespace pf::gl
+{
+
+ClusteredLights::ClusteredLights(std::shared_ptr<Window> window, LightClusterer clusterer)
+    : _window(std::move(window))
+    , _clusterer(std::move(clusterer))
+{
+    _window->bindContext();
+    if (GLAD_GL_VERSION_4_3 == 0)
+    {
+        throw std::runtime_error("Clustered lights need shader storage buffers (OpenGL 4.3).");
+    }
+    if (GLAD_GL_VERSION_4_5 != 0)
+    {
+        glCreateBuffers(gsl::narrow_cast<GLsizei>(_buffers.size()), _buffers.data());
+    }
+    else
+    {
+        glGenBuffers(gsl::narrow_cast<GLsizei>(_buffers.size()), _buffers.data());
+    }
+}
+
+ClusteredLights::~ClusteredLights()
+{
+    _window->bindContext();
+    glDeleteBuffers(gsl::narrow_cast<GLsizei>(_buffers.size()), _buffers.data());
+}
+
+void ClusteredLights::update(MinecraftCamera const &camera,
+                             types::FVec2 viewportSize,
+                             std::span<PointLight const> lights)
+{
+    _viewSpaceLights.clear();
+    for (auto const &light : lights)
+    {
+        types::FVec4 position = camera.viewMatrix() * types::FVec4(light.position, 1.0F);
+        _viewSpaceLights.emplace_back(types::FVec3(position), LightClusterer::radius(light));
+    }
+    _clusterer.assign(camera.projectionMatrix(), _viewSpaceLights);
+
+    upload(lights, viewportSize);
+}
+
+void ClusteredLights::upload(std::span<PointLight const> lights, types::FVec2 viewportSize)
+{
+    _window->bindContext();
+
+    // The buffers never get empty, so that they can always be bound. They are respecified without
+    // being bound, the bindings are only made in `bind`
+    respecifyMappedBuffer(
+        _buffers[POINT_LIGHTS_BINDING],
+        gsl::narrow_cast<types::BinarySize>(std::max<size_t>(lights.size(), 1) *
+                                            sizeof(GpuPointLight)),
+        GL_DYNAMIC_DRAW,
+        [this, lights](std::span<std::byte> storage)
+        {
+            auto *gpuLights = reinterpret_cast<GpuPointLight *>(storage.data());
+            for (size_t i = 0; i < lights.size(); i++)
+            {
+                PointLight const &light = lights[i];
+                gpuLights[i] = {
+                    .positionRadius = _viewSpaceLights[i],
+                    .ambient = types::FVec4(light.color.ambient, 0.0F),
+                    .diffuse = types::FVec4(light.color.diffuse, 0.0F),
+                    .specular = types::FVec4(light.color.specular, 0.0F),
+                    .falloff = types::FVec4(light.falloff.constant,
+                                            light.falloff.linear,
+                                            light.falloff.quadratic,
+                                            0.0F),
+                };
+            }
+        });
+
+    auto clusters = _clusterer.clusters();
+    respecifyMappedBuffer(
+        _buffers[CLUSTERS_BINDING],
+        gsl::narrow_cast<types::BinarySize>(sizeof(ClustersHeader) + clusters.size_bytes()),
+        GL_DYNAMIC_DRAW,
+        [this, clusters, viewportSize](std::span<std::byte> storage)
+        {
+            ClustersHeader header = {
+                .clustersCount = {gsl::narrow_cast<types::UInt>(_clusterer.clustersX()),
+                                  gsl::narrow_cast<types::UInt>(_clusterer.clustersY()),
+                                  gsl::narrow_cast<types::UInt>(_clusterer.clustersZ()),
+                                  0},
+                .clusterScale =
+                    types::FVec4(static_cast<types::Float>(_clusterer.clustersX()) / viewportSize.x,
+                                 static_cast<types::Float>(_clusterer.clustersY()) / viewportSize.y,
+                                 _clusterer.depthScale(),
+                                 _clusterer.depthBias()),
+            };
+            std::memcpy(storage.data(), &header, sizeof(header));
+            std::memcpy(storage.data() + sizeof(header), clusters.data(), clusters.size_bytes());
+        });
+
+    auto indices = _clusterer.lightIndices();
+    respecifyMappedBuffer(_buffers[LIGHT_INDICES_BINDING],
+                          gsl::narrow_cast<types::BinarySize>(std::max<size_t>(indices.size(), 1) *
+                                                              sizeof(types::UInt)),
+                          GL_DYNAMIC_DRAW,
+                          [indices](std::span<std::byte> storage)
+                          { std::memcpy(storage.data(), indices.data(), indices.size_bytes()); });
+}
+
+void ClusteredLights::bind() const
+{
+    _window->bindContext();
+    for (types::UInt binding : {POINT_LIGHTS_BINDING, CLUSTERS_BINDING, LIGHT_INDICES_BINDING})
+    {
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, binding, _buffers[binding]);
+    }
+}
+
+LightClusterer const &ClusteredLights::clusterer() const
+{
+    return _clusterer;
+}
+
+types::Size ClusteredLights::lightsCount() const
+{
+    return gsl::narrow_cast<types::Size>(_viewSpaceLights.size());
+}
+
+} // namespace pf::gl
@@ -0,0 +1,265 @@
+#include <pf_gl/DeferredRenderer.hpp>
+
+#include <cmath>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <pf_gl/DrawingContext3D.hpp>
+#include <pf_gl/EulerTransform3D.hpp>
+#include <pf_gl/GBuffer.hpp>
+#include <pf_gl/LightClusterer.hpp>
+#include <pf_gl/LightVolume.hpp>
+#include <pf_gl/Mesh.hpp>
+#include <pf_gl/Shader.hpp>
+#include <pf_gl/Transform3D.hpp>
+#include <pf_gl/ValueTypes.hpp>
+#include <pf_gl/Window.hpp>
+
+namespace pf::gl
+{
+
+namespace
+{
+
+/**
+ * Spot lights wider than that are drawn as spheres, the cone gets too flat.
+ */
+types::Float const MIN_CONE_COS_ANGLE = 0.2F;
+
+Mesh createVolumeMesh(std::shared_ptr<Window> window, LightVolume const &volume)
+{
+    return {std::move(window), volume.vertices, volume.indices, {}, STATIC_DRAW};
+}
+
+Mesh createFullscreenQuad(std::shared_ptr<Window> window)
+{
+    std::vector<Mesh::SimpleVertex> vertices;
+    for (types::FVec2 corner : {types::FVec2(-1.0F, -1.0F),
+                                types::FVec2(1.0F, -1.0F),
+                                types::FVec2(1.0F, 1.0F),
+                                types::FVec2(-1.0F, 1.0F)})
+    {
+        vertices.push_back({
+            .position = types::FVec3(corner, 0.0F),
+            .normal = types::FVec3(0.0F, 0.0F, 1.0F),
+            .textureCoordinates = (corner + 1.0F) / 2.0F,
+        });
+    }
+    return {std::move(window), vertices, {0, 1, 2, 0, 2, 3}, {}, STATIC_DRAW};
+}
+
+/**
+ * Rotation turning the negative Z axis into the given direction.
+ */
+types::FMat3 lookAlong(types::FVec3 const &direction)
+{
+    types::FVec3 back = -glm::normalize(direction);
+    types::FVec3 up = std::abs(back.y) < 0.99F ? Transform3D::Y_AXIS : Transform3D::X_AXIS;
+    types::FVec3 right = glm::normalize(glm::cross(up, back));
+    return types::FMat3(right, glm::cross(back, right), back);
+}
+
+} // namespace
+
+DeferredRenderer::DeferredRenderer(std::shared_ptr<Window> window, Shader lightShader)
+    : _window(std::move(window))
+    , _lightShader(std::move(lightShader))
+    , _uniforms(resolveUniforms(_lightShader))
+    , _gBuffer(_window, _window->width(), _window->height())
+    , _fullscreenQuad(createFullscreenQuad(_window))
+    , _sphere(createVolumeMesh(_window, LightVolume::sphere()))
+    , _cone(createVolumeMesh(_window, LightVolume::cone()))
+{
+}
+
+void DeferredRenderer::beginGeometryPass()
+{
+    _gBuffer.resize(_window->width(), _window->height());
+    _gBuffer.bindForGeometry();
+
+    glClearColor(0.0F, 0.0F, 0.0F, 0.0F);
+    glClearStencil(0);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+    glEnable(GL_DEPTH_TEST);
+    glDepthMask(GL_TRUE);
+}
+
+void DeferredRenderer::endGeometryPass(DrawingContext3D const &drawingContext)
+{
+    _gBuffer.bindForLighting();
+    glClearColor(0.0F, 0.0F, 0.0F, 1.0F);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    _gBuffer.bindTextures(0);
+    _lightShader.use();
+    _lightShader.setUniforms(_uniforms.normalDepth.with(GBuffer::NORMAL_DEPTH),
+                             _uniforms.albedoSpecular.with(GBuffer::ALBEDO_SPECULAR));
+
+    // Every light adds up to the previous ones, the depth of the surfaces is never touched
+    glDepthMask(GL_FALSE);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_ONE, GL_ONE);
+
+    if (drawingContext.directionalLight.has_value())
+    {
+        DirectionalLight const &light = drawingContext.directionalLight.value();
+        _lightShader.setUniforms(_uniforms.lightType.with(DIRECTIONAL_LIGHT),
+                                 _uniforms.direction.with(light.direction));
+        setLightColor(light.color, {.constant = 1.0F, .linear = 0.0F, .quadratic = 0.0F});
+        renderFullscreen(drawingContext);
+    }
+
+    // The volumes are placed in world space, there is nothing to draw them with without a camera
+    if (drawingContext.camera.has_value())
+    {
+        types::FMat4 const &viewMatrix = drawingContext.camera->viewMatrix();
+
+        auto const &pointLights = drawingContext.pointLights;
+        for (size_t i = 0; pointLights.has_value() && i < pointLights->size(); i++)
+        {
+            PointLight const &light = pointLights->at(i);
+            _lightShader.setUniforms(
+                _uniforms.lightType.with(POINT_LIGHT),
+                _uniforms.position.with(
+                    types::FVec3(viewMatrix * types::FVec4(light.position, 1.0F))));
+            setLightColor(light.color, light.falloff);
+
+            types::Float radius = LightClusterer::radius(light);
+            if (std::isinf(radius))
+            {
+                renderFullscreen(drawingContext);
+                continue;
+            }
+            auto transform = EulerTransform3D::Builder()
+                                 .withShift(light.position)
+                                 .withScale(types::FVec3(radius))
+                                 .build();
+            renderVolume(_sphere, *transform, drawingContext);
+        }
+
+        if (drawingContext.spotLight.has_value())
+        {
+            // Unlike the point lights, the spot light is already in view space
+            SpotLight const &light = drawingContext.spotLight.value();
+            _lightShader.setUniforms(_uniforms.lightType.with(SPOT_LIGHT),
+                                     _uniforms.position.with(light.position),
+                                     _uniforms.direction.with(light.direction),
+                                     _uniforms.cosCutOff.with(light.cutoff),
+                                     _uniforms.cosOuterCutOff.with(light.outerCutoff));
+            setLightColor(light.color, light.falloff);
+
+            types::Float range = LightClusterer::radius(
+                {.position = light.position, .color = light.color, .falloff = light.falloff});
+            types::FMat4 viewToWorld = glm::inverse(viewMatrix);
+            types::FVec3 position = viewToWorld * types::FVec4(light.position, 1.0F);
+
+            if (std::isinf(range))
+            {
+                renderFullscreen(drawingContext);
+            }
+            else if (light.outerCutoff < MIN_CONE_COS_ANGLE)
+            {
+                auto transform = EulerTransform3D::Builder()
+                                     .withShift(position)
+                                     .withScale(types::FVec3(range))
+                                     .build();
+                renderVolume(_sphere, *transform, drawingContext);
+            }
+            else
+            {
+                types::Float cosAngle = light.outerCutoff;
+                types::Float coneRadius = range * std::sqrt(1.0F - cosAngle * cosAngle) / cosAngle;
+                auto transform =
+                    EulerTransform3D::Builder()
+                        .withShift(position)
+                        .withRotationMatrix(lookAlong(types::FMat3(viewToWorld) * light.direction))
+                        .withScale(types::FVec3(coneRadius, coneRadius, range))
+                        .build();
+                renderVolume(_cone, *transform, drawingContext);
+            }
+        }
+    }
+
+    glDisable(GL_BLEND);
+    glDisable(GL_STENCIL_TEST);
+    glDisable(GL_CULL_FACE);
+    glCullFace(GL_BACK);
+    glEnable(GL_DEPTH_TEST);
+    glDepthMask(GL_TRUE);
+
+    _gBuffer.blitToScreen();
+}
+
+GBuffer const &DeferredRenderer::gBuffer() const
+{
+    return _gBuffer;
+}
+
+DeferredRenderer::LightUniforms DeferredRenderer::resolveUniforms(Shader const &lightShader)
+{
+    return {
+        .normalDepth = lightShader.uniformHandle<types::Int>("u_normalDepth"),
+        .albedoSpecular = lightShader.uniformHandle<types::Int>("u_albedoSpecular"),
+        .lightType = lightShader.uniformHandle<types::Int>("u_lightType"),
+        .fullscreen = lightShader.uniformHandle<types::Int>("u_fullscreen"),
+        .position = lightShader.uniformHandle<types::FVec3>("u_light.position"),
+        .direction = lightShader.uniformHandle<types::FVec3>("u_light.direction"),
+        .cosCutOff = lightShader.uniformHandle<types::Float>("u_light.cosCutOff"),
+        .cosOuterCutOff = lightShader.uniformHandle<types::Float>("u_light.cosOuterCutOff"),
+        .ambient = lightShader.uniformHandle<types::FVec3>("u_light.ambient"),
+        .diffuse = lightShader.uniformHandle<types::FVec3>("u_light.diffuse"),
+        .specular = lightShader.uniformHandle<types::FVec3>("u_light.specular"),
+        .falloff = lightShader.uniformHandle<types::FVec3>("u_light.falloff"),
+    };
+}
+
+void DeferredRenderer::renderFullscreen(DrawingContext3D const &drawingContext)
+{
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_STENCIL_TEST);
+    glDisable(GL_CULL_FACE);
+
+    _lightShader.setUniformValue(_uniforms.fullscreen, 1);
+    _fullscreenQuad.render(_lightShader, drawingContext);
+    _lightShader.setUniformValue(_uniforms.fullscreen, 0);
+}
+
+void DeferredRenderer::renderVolume(Mesh const &volume,
+                                    Transform3D const &transform,
+                                    DrawingContext3D const &drawingContext)
+{
+    // Marks the pixels where the surface is inside the volume: only the back faces are behind it
+    glEnable(GL_STENCIL_TEST);
+    glClear(GL_STENCIL_BUFFER_BIT);
+    glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+    glEnable(GL_DEPTH_TEST);
+    glDisable(GL_CULL_FACE);
+    glStencilFunc(GL_ALWAYS, 0, 0);
+    glStencilOpSeparate(GL_BACK, GL_KEEP, GL_INCR_WRAP, GL_KEEP);
+    glStencilOpSeparate(GL_FRONT, GL_KEEP, GL_DECR_WRAP, GL_KEEP);
+    volume.render(_lightShader, drawingContext, transform);
+
+    // Lights the marked pixels, the back faces still cover them when the camera is inside
+    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+    glStencilFunc(GL_NOTEQUAL, 0, 0xFF);
+    glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
+    glDisable(GL_DEPTH_TEST);
+    glEnable(GL_CULL_FACE);
+    glCullFace(GL_FRONT);
+    volume.render(_lightShader, drawingContext, transform);
+}
+
+void DeferredRenderer::setLightColor(LightColor const &color, LightFalloff const &falloff)
+{
+    _lightShader.setUniforms(
+        _uniforms.ambient.with(color.ambient),
+        _uniforms.diffuse.with(color.diffuse),
+        _uniforms.specular.with(color.specular),
+        _uniforms.falloff.with(types::FVec3(falloff.constant, falloff.linear, falloff.quadratic)));
+}
+
+} // namespace pf::gl
@@ -0,0 +1,99 @@
+#include <pf_gl/DepthPrePass.hpp>
+
+#include <filesystem>
+#include <memory>
+#include <utility>
+
+#include <glad/glad.h>
+
+#include <pf_gl/GpuTimer.hpp>
+#include <pf_gl/Shader.hpp>
+#include <pf_gl/ShaderCache.hpp>
+#include <pf_gl/ValueTypes.hpp>
+#include <pf_gl/Window.hpp>
+
+namespace pf::gl
+{
+
+DepthPrePass::DepthPrePass(std::shared_ptr<Window> window,
+                           std::filesystem::path const &vertexShaderPath,
+                           std::shared_ptr<ShaderCache> const &cache)
+    : _window(std::move(window))
+    , _shader(Shader::depthOnly(_window, vertexShaderPath, cache))
+    , _depthPassTimer(_window)
+    , _mainPassTimer(_window)
+{
+}
+
+DepthPrePass::DepthPrePass(std::shared_ptr<Window> window, Shader depthOnlyShader)
+    : _window(std::move(window))
+    , _shader(std::move(depthOnlyShader))
+    , _depthPassTimer(_window)
+    , _mainPassTimer(_window)
+{
+}
+
+void DepthPrePass::enabled(bool enabled)
+{
+    _enabled = enabled;
+}
+
+bool DepthPrePass::enabled() const
+{
+    return _enabled;
+}
+
+Shader &DepthPrePass::shader()
+{
+    return _shader;
+}
+
+void DepthPrePass::beginDepthPass()
+{
+    if (!_enabled)
+    {
+        return;
+    }
+
+    _window->bindContext();
+    _depthPassTimer.begin();
+    glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+    glDepthFunc(GL_LESS);
+    glDepthMask(GL_TRUE);
+}
+
+void DepthPrePass::beginMainPass()
+{
+    _window->bindContext();
+    if (_enabled)
+    {
+        _depthPassTimer.end();
+        glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+        glDepthFunc(GL_EQUAL);
+        glDepthMask(GL_FALSE);
+    }
+    _mainPassTimer.begin();
+}
+
+void DepthPrePass::endMainPass()
+{
+    _window->bindContext();
+    _mainPassTimer.end();
+    glDepthFunc(GL_LESS);
+    glDepthMask(GL_TRUE);
+
+    _depthPassTimer.pollResults();
+    _mainPassTimer.pollResults();
+}
+
+types::Float DepthPrePass::depthPassMilliseconds() const
+{
+    return _depthPassTimer.milliseconds();
+}
+
+types::Float DepthPrePass::mainPassMilliseconds() const
+{
+    return _mainPassTimer.milliseconds();
+}
+
+} // namespace pf::gl
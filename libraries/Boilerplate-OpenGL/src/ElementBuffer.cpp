@@ -1,15 +1,20 @@
 #include <pf_gl/ElementBuffer.hpp>
 
+#include <cstddef>
 #include <utility>
 #include <stdexcept>
 #include <memory>
 #include <span>
+#include <vector>
 
 #include <gsl/util>
+#include <fmt/format.h>
 
+#include <pf_gl/BufferMapping.hpp>
 #include <pf_gl/RenderingOptions.hpp>
 #include <pf_gl/Window.hpp>
 #include <pf_gl/ValueTypes.hpp>
+#include <pf_gl/MeshData.hpp>
 #include <pf_utils/RawBuffer.hpp>
 
 namespace pf::gl
@@ -22,21 +27,49 @@ ElementBuffer::ElementBuffer(std::shared_ptr<Window> window,
     , _id(0)
     , _count(gsl::narrow_cast<types::Size>(indices.size()))
 {
-    GLenum glUsage = usagePatternToGLenum(usagePattern);
+    std::vector<std::byte> packedIndices;
+    _indexType = MeshData::packIndices(indices, packedIndices);
+    upload(packedIndices, usagePattern);
+}
 
-    _window->bindContext();
-    glGenBuffers(1, &_id);
-    if (_id == 0)
+ElementBuffer::ElementBuffer(std::shared_ptr<Window> window,
+                             std::span<std::byte const> indices,
+                             types::ValueType indexType,
+                             UsagePattern usagePattern)
+    : _window(std::move(window))
+    , _id(0)
+    , _count(0)
+    , _indexType(indexType)
+{
+    checkIndexType(indexType);
+
+    auto indexSize = static_cast<size_t>(types::sizeInBytes(indexType));
+    if (indices.size() % indexSize != 0)
     {
-        throw std::runtime_error("Failed to generate an element buffer.");
+        throw std::invalid_argument("Indices buffer size is not a multiple of the index size.");
     }
+    _count = gsl::narrow_cast<types::Size>(indices.size() / indexSize);
 
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _id);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER,
-                 gsl::narrow_cast<types::BinarySize>(indices.size_bytes()),
-                 indices.data(),
-                 glUsage);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    upload(indices, usagePattern);
+}
+
+ElementBuffer::ElementBuffer(std::shared_ptr<Window> window,
+                             types::Size count,
+                             types::ValueType indexType,
+                             UsagePattern usagePattern,
+                             BufferWriter const &write)
+    : _window(std::move(window))
+    , _id(0)
+    , _count(count)
+    , _indexType(indexType)
+{
+    checkIndexType(indexType);
+
+    generate();
+    writeMappedBufferStorage(_id,
+                             static_cast<types::BinarySize>(count) * types::sizeInBytes(indexType),
+                             usagePatternToGLenum(usagePattern),
+                             write);
 }
 
 ElementBuffer::~ElementBuffer()
@@ -51,11 +84,58 @@ void ElementBuffer::bind() const
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _id);
 }
 
+void ElementBuffer::upload(std::span<std::byte const> indices, UsagePattern usagePattern)
+{
+    generate();
+    uploadBufferStorage(_id, indices, usagePatternToGLenum(usagePattern));
+}
+
+void ElementBuffer::generate()
+{
+    _window->bindContext();
+    if (GLAD_GL_VERSION_4_5 != 0)
+    {
+        glCreateBuffers(1, &_id);
+    }
+    else
+    {
+        glGenBuffers(1, &_id);
+    }
+    if (_id == 0)
+    {
+        throw std::runtime_error("Failed to generate an element buffer.");
+    }
+}
+
+void ElementBuffer::checkIndexType(types::ValueType indexType)
+{
+    if (indexType != types::UNSIGNED_INT && indexType != types::UNSIGNED_SHORT)
+    {
+        throw std::invalid_argument(
+            fmt::format("Unsupported index type: {}.", types::name(indexType)));
+    }
+}
+
+types::UInt ElementBuffer::id() const
+{
+    return _id;
+}
+
 types::Size ElementBuffer::count() const
 {
     return _count;
 }
 
+types::ValueType ElementBuffer::indexType() const
+{
+    return _indexType;
+}
+
+types::BinarySize ElementBuffer::sizeInBytes() const
+{
+    return static_cast<types::BinarySize>(_count) * types::sizeInBytes(_indexType);
+}
+
 void ElementBuffer::unbind() const
 {
     _window->bindContext();
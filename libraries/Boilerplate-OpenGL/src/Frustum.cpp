@@ -0,0 +1,106 @@
+#include <pf_gl/Frustum.hpp>
+
+#include <array>
+
+#include <glm/glm.hpp>
+
+#include <pf_gl/BoundingVolumes.hpp>
+#include <pf_gl/ValueTypes.hpp>
+
+namespace pf::gl
+{
+
+Frustum::Frustum(types::FMat4 const &viewProjectionMatrix)
+{
+    // GLM matrices are column-major, so the rows have to be gathered manually
+    types::FMat4 transposed = glm::transpose(viewProjectionMatrix);
+    types::FVec4 const &row0 = transposed[0];
+    types::FVec4 const &row1 = transposed[1];
+    types::FVec4 const &row2 = transposed[2];
+    types::FVec4 const &row3 = transposed[3];
+
+    _planes[LEFT_PLANE] = row3 + row0;
+    _planes[RIGHT_PLANE] = row3 - row0;
+    _planes[BOTTOM_PLANE] = row3 + row1;
+    _planes[TOP_PLANE] = row3 - row1;
+    _planes[NEAR_PLANE] = row3 + row2;
+    _planes[FAR_PLANE] = row3 - row2;
+
+    for (auto &plane : _planes)
+    {
+        plane /= glm::length(types::FVec3(plane));
+    }
+}
+
+std::array<types::FVec4, Frustum::PLANES_COUNT> const &Frustum::planes() const
+{
+    return _planes;
+}
+
+bool Frustum::contains(types::FVec3 const &point) const
+{
+    for (auto const &plane : _planes)
+    {
+        if (glm::dot(types::FVec3(plane), point) + plane.w < 0.0F)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Frustum::intersects(BoundingBox const &box) const
+{
+    types::FVec3 center = box.center();
+    types::FVec3 extents = box.extents();
+
+    // The box is outside in case even its corner closest to the inner side of a plane (the one
+    // whose projection onto the plane normal is the largest) lies behind the plane.
+    for (auto const &plane : _planes)
+    {
+        types::FVec3 normal = types::FVec3(plane);
+        if (glm::dot(normal, center) + glm::dot(glm::abs(normal), extents) + plane.w < 0.0F)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Frustum::intersects(BoundingSphere const &sphere) const
+{
+    for (auto const &plane : _planes)
+    {
+        if (glm::dot(types::FVec3(plane), sphere.center) + plane.w < -sphere.radius)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+Frustum::Intersection Frustum::classify(BoundingBox const &box) const
+{
+    types::FVec3 center = box.center();
+    types::FVec3 extents = box.extents();
+
+    Intersection result = INSIDE;
+    for (auto const &plane : _planes)
+    {
+        types::FVec3 normal = types::FVec3(plane);
+        types::Float distance = glm::dot(normal, center) + plane.w;
+        types::Float radius = glm::dot(glm::abs(normal), extents);
+
+        if (distance + radius < 0.0F)
+        {
+            return OUTSIDE;
+        }
+        if (distance - radius < 0.0F)
+        {
+            result = INTERSECTS;
+        }
+    }
+    return result;
+}
+
+} // namespace pf::gl
@@ -0,0 +1,149 @@
+#include <pf_gl/FrustumCuller.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <gsl/util>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define PF_GL_FRUSTUM_CULLER_SSE
+#include <xmmintrin.h>
+#endif
+
+#include <pf_gl/BoundingVolumes.hpp>
+#include <pf_gl/Frustum.hpp>
+#include <pf_gl/ValueTypes.hpp>
+
+namespace pf::gl
+{
+
+namespace
+{
+
+size_t constexpr BATCH_SIZE = 4;
+
+} // namespace
+
+void FrustumCuller::cull(Frustum const &frustum,
+                         std::span<BoundingBox const> boxes,
+                         std::vector<types::UInt> &visibleIndices)
+{
+    visibleIndices.clear();
+    if (boxes.empty())
+    {
+        return;
+    }
+
+    // Pad the arrays up to the batch size, so that the last batch can be loaded as a whole
+    size_t paddedCount = (boxes.size() + BATCH_SIZE - 1) / BATCH_SIZE * BATCH_SIZE;
+    for (auto *array : {&_centersX, &_centersY, &_centersZ, &_extentsX, &_extentsY, &_extentsZ})
+    {
+        array->resize(paddedCount, 0.0F);
+    }
+
+    for (size_t i = 0; i < boxes.size(); i++)
+    {
+        types::FVec3 center = boxes[i].center();
+        types::FVec3 extents = boxes[i].extents();
+        _centersX[i] = center.x;
+        _centersY[i] = center.y;
+        _centersZ[i] = center.z;
+        _extentsX[i] = extents.x;
+        _extentsY[i] = extents.y;
+        _extentsZ[i] = extents.z;
+    }
+
+    auto const &planes = frustum.planes();
+
+    for (size_t batchStart = 0; batchStart < boxes.size(); batchStart += BATCH_SIZE)
+    {
+        // One bit per box in the batch, set in case the box is behind any of the planes
+        types::UInt outsideMask = 0;
+
+#ifdef PF_GL_FRUSTUM_CULLER_SSE
+        __m128 centersX = _mm_loadu_ps(&_centersX[batchStart]);
+        __m128 centersY = _mm_loadu_ps(&_centersY[batchStart]);
+        __m128 centersZ = _mm_loadu_ps(&_centersZ[batchStart]);
+        __m128 extentsX = _mm_loadu_ps(&_extentsX[batchStart]);
+        __m128 extentsY = _mm_loadu_ps(&_extentsY[batchStart]);
+        __m128 extentsZ = _mm_loadu_ps(&_extentsZ[batchStart]);
+
+        for (auto const &plane : planes)
+        {
+            __m128 distance = _mm_set1_ps(plane.w);
+            distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(plane.x), centersX));
+            distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(plane.y), centersY));
+            distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(plane.z), centersZ));
+            distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(std::abs(plane.x)), extentsX));
+            distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(std::abs(plane.y)), extentsY));
+            distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(std::abs(plane.z)), extentsZ));
+
+            outsideMask |= gsl::narrow_cast<types::UInt>(
+                _mm_movemask_ps(_mm_cmplt_ps(distance, _mm_setzero_ps())));
+        }
+#else
+        for (size_t lane = 0; lane < BATCH_SIZE; lane++)
+        {
+            size_t i = batchStart + lane;
+            for (auto const &plane : planes)
+            {
+                types::Float distance = plane.w + plane.x * _centersX[i] +
+                                        plane.y * _centersY[i] + plane.z * _centersZ[i] +
+                                        std::abs(plane.x) * _extentsX[i] +
+                                        std::abs(plane.y) * _extentsY[i] +
+                                        std::abs(plane.z) * _extentsZ[i];
+                if (distance < 0.0F)
+                {
+                    outsideMask |= 1U << lane;
+                    break;
+                }
+            }
+        }
+#endif
+
+        for (size_t lane = 0; lane < BATCH_SIZE && batchStart + lane < boxes.size(); lane++)
+        {
+            if ((outsideMask & (1U << lane)) == 0)
+            {
+                visibleIndices.push_back(gsl::narrow_cast<types::UInt>(batchStart + lane));
+            }
+        }
+    }
+
+    auto visibleCount = gsl::narrow_cast<types::Size>(visibleIndices.size());
+    _statistics.visibleCount += visibleCount;
+    _statistics.culledCount += gsl::narrow_cast<types::Size>(boxes.size()) - visibleCount;
+}
+
+void FrustumCuller::screenSizes(types::FVec3 const &cameraPosition,
+                                types::Float pixelsPerUnit,
+                                std::span<types::UInt const> visibleIndices,
+                                std::vector<types::Float> &screenSizes) const
+{
+    screenSizes.clear();
+    for (types::UInt index : visibleIndices)
+    {
+        types::FVec3 center(_centersX[index], _centersY[index], _centersZ[index]);
+        types::Float radius =
+            glm::length(types::FVec3(_extentsX[index], _extentsY[index], _extentsZ[index]));
+        types::Float distance = std::max(glm::length(cameraPosition - center) - radius,
+                                         MIN_SCREEN_SIZE_DISTANCE);
+        screenSizes.push_back(pixelsPerUnit * radius / distance);
+    }
+}
+
+FrustumCuller::Statistics const &FrustumCuller::statistics() const
+{
+    return _statistics;
+}
+
+void FrustumCuller::resetStatistics()
+{
+    _statistics = {};
+}
+
+} // namespace pf::gl
@@ -0,0 +1,229 @@
+#include <pf_gl/GBuffer.hpp>
+
+#include <array>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include <glad/glad.h>
+#include <fmt/format.h>
+#include <gsl/util>
+
+#include <pf_gl/ValueTypes.hpp>
+#include <pf_gl/Window.hpp>
+
+namespace pf::gl
+{
+
+namespace
+{
+
+struct AttachmentFormat
+{
+    GLenum internalFormat;
+    GLenum format;
+    GLenum type;
+};
+
+std::array<AttachmentFormat, GBuffer::ATTACHMENTS_COUNT> constexpr ATTACHMENT_FORMATS = {{
+    {.internalFormat = GL_RGBA32F, .format = GL_RGBA, .type = GL_FLOAT},
+    {.internalFormat = GL_RGBA8, .format = GL_RGBA, .type = GL_UNSIGNED_BYTE},
+    {.internalFormat = GL_RGBA16F, .format = GL_RGBA, .type = GL_FLOAT},
+}};
+
+bool isDirectStateAccessSupported()
+{
+    return GLAD_GL_VERSION_4_5 != 0;
+}
+
+} // namespace
+
+GBuffer::GBuffer(std::shared_ptr<Window> window, types::Size width, types::Size height)
+    : _window(std::move(window))
+    , _width(width)
+    , _height(height)
+{
+    _window->bindContext();
+    if (isDirectStateAccessSupported())
+    {
+        glCreateFramebuffers(1, &_framebuffer);
+        allocate();
+
+        GLenum status = glCheckNamedFramebufferStatus(_framebuffer, GL_FRAMEBUFFER);
+        if (status != GL_FRAMEBUFFER_COMPLETE)
+        {
+            throw std::runtime_error(
+                fmt::format("G-buffer is not complete (status 0x{:x}).", status));
+        }
+        return;
+    }
+
+    glGenFramebuffers(1, &_framebuffer);
+    glGenTextures(gsl::narrow_cast<GLsizei>(_textures.size()), _textures.data());
+    glGenTextures(1, &_depthStencilTexture);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, _framebuffer);
+    for (types::UInt attachment = 0; attachment < ATTACHMENTS_COUNT; attachment++)
+    {
+        glBindTexture(GL_TEXTURE_2D, _textures[attachment]);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glFramebufferTexture2D(GL_FRAMEBUFFER,
+                               GL_COLOR_ATTACHMENT0 + attachment,
+                               GL_TEXTURE_2D,
+                               _textures[attachment],
+                               0);
+    }
+    glBindTexture(GL_TEXTURE_2D, _depthStencilTexture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glFramebufferTexture2D(
+        GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_TEXTURE_2D, _depthStencilTexture, 0);
+
+    allocate();
+
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    if (status != GL_FRAMEBUFFER_COMPLETE)
+    {
+        throw std::runtime_error(fmt::format("G-buffer is not complete (status 0x{:x}).", status));
+    }
+}
+
+GBuffer::~GBuffer()
+{
+    _window->bindContext();
+    glDeleteFramebuffers(1, &_framebuffer);
+    glDeleteTextures(gsl::narrow_cast<GLsizei>(_textures.size()), _textures.data());
+    glDeleteTextures(1, &_depthStencilTexture);
+}
+
+void GBuffer::resize(types::Size width, types::Size height)
+{
+    if (width == _width && height == _height)
+    {
+        return;
+    }
+    _width = width;
+    _height = height;
+    _window->bindContext();
+    allocate();
+}
+
+void GBuffer::allocate()
+{
+    if (isDirectStateAccessSupported())
+    {
+        allocateStorage();
+        return;
+    }
+
+    for (types::UInt attachment = 0; attachment < ATTACHMENTS_COUNT; attachment++)
+    {
+        AttachmentFormat const &format = ATTACHMENT_FORMATS.at(attachment);
+        glBindTexture(GL_TEXTURE_2D, _textures[attachment]);
+        glTexImage2D(GL_TEXTURE_2D,
+                     0,
+                     gsl::narrow_cast<GLint>(format.internalFormat),
+                     _width,
+                     _height,
+                     0,
+                     format.format,
+                     format.type,
+                     nullptr);
+    }
+    glBindTexture(GL_TEXTURE_2D, _depthStencilTexture);
+    glTexImage2D(GL_TEXTURE_2D,
+                 0,
+                 GL_DEPTH24_STENCIL8,
+                 _width,
+                 _height,
+                 0,
+                 GL_DEPTH_STENCIL,
+                 GL_UNSIGNED_INT_24_8,
+                 nullptr);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void GBuffer::allocateStorage()
+{
+    // Immutable storage cannot be resized, the textures are created anew and attached in place of
+    // the old ones
+    glDeleteTextures(gsl::narrow_cast<GLsizei>(_textures.size()), _textures.data());
+    glDeleteTextures(1, &_depthStencilTexture);
+    glCreateTextures(GL_TEXTURE_2D, gsl::narrow_cast<GLsizei>(_textures.size()), _textures.data());
+    glCreateTextures(GL_TEXTURE_2D, 1, &_depthStencilTexture);
+
+    for (types::UInt attachment = 0; attachment < ATTACHMENTS_COUNT; attachment++)
+    {
+        types::UInt texture = _textures[attachment];
+        glTextureParameteri(texture, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTextureParameteri(texture, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTextureStorage2D(
+            texture, 1, ATTACHMENT_FORMATS.at(attachment).internalFormat, _width, _height);
+        glNamedFramebufferTexture(_framebuffer, GL_COLOR_ATTACHMENT0 + attachment, texture, 0);
+    }
+    glTextureParameteri(_depthStencilTexture, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTextureParameteri(_depthStencilTexture, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTextureStorage2D(_depthStencilTexture, 1, GL_DEPTH24_STENCIL8, _width, _height);
+    glNamedFramebufferTexture(_framebuffer, GL_DEPTH_STENCIL_ATTACHMENT, _depthStencilTexture, 0);
+}
+
+void GBuffer::bindForGeometry() const
+{
+    _window->bindContext();
+    glBindFramebuffer(GL_FRAMEBUFFER, _framebuffer);
+    std::array<GLenum, 2> drawBuffers = {GL_COLOR_ATTACHMENT0 + NORMAL_DEPTH,
+                                         GL_COLOR_ATTACHMENT0 + ALBEDO_SPECULAR};
+    glDrawBuffers(gsl::narrow_cast<GLsizei>(drawBuffers.size()), drawBuffers.data());
+    glViewport(0, 0, _width, _height);
+}
+
+void GBuffer::bindForLighting() const
+{
+    _window->bindContext();
+    glBindFramebuffer(GL_FRAMEBUFFER, _framebuffer);
+    glDrawBuffer(GL_COLOR_ATTACHMENT0 + LIGHT);
+    glViewport(0, 0, _width, _height);
+}
+
+void GBuffer::bindTextures(types::UInt firstUnit) const
+{
+    _window->bindContext();
+    for (types::UInt attachment : {NORMAL_DEPTH, ALBEDO_SPECULAR})
+    {
+        glActiveTexture(GL_TEXTURE0 + firstUnit + attachment);
+        glBindTexture(GL_TEXTURE_2D, _textures[attachment]);
+    }
+}
+
+void GBuffer::blitToScreen() const
+{
+    _window->bindContext();
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, _framebuffer);
+    glReadBuffer(GL_COLOR_ATTACHMENT0 + LIGHT);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+    glBlitFramebuffer(0,
+                      0,
+                      _width,
+                      _height,
+                      0,
+                      0,
+                      _width,
+                      _height,
+                      GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT,
+                      GL_NEAREST);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+types::Size GBuffer::width() const
+{
+    return _width;
+}
+
+types::Size GBuffer::height() const
+{
+    return _height;
+}
+
+} // namespace pf::gl
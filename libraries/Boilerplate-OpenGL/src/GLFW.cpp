@@ -151,6 +151,18 @@ void GLFW::hideCursor(GLContext context, bool hide)
     glfwSetInputMode(context, GLFW_CURSOR, hide ? GLFW_CURSOR_DISABLED : GLFW_CURSOR_NORMAL);
 }
 
+bool GLFW::isExtensionSupported(GLContext context, char const *name)
+{
+    bindContext(context);
+    return glfwExtensionSupported(name) == GLFW_TRUE;
+}
+
+GLFWglproc GLFW::procAddress(GLContext context, char const *name)
+{
+    bindContext(context);
+    return glfwGetProcAddress(name);
+}
+
 void GLFW::pollEvents()
 {
     glfwPollEvents();
@@ -0,0 +1,94 @@
+#include <pf_gl/GpuTimer.hpp>
+
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include <glad/glad.h>
+#include <gsl/util>
+
+#include <pf_gl/Window.hpp>
+#include <pf_gl/ValueTypes.hpp>
+
+namespace pf::gl
+{
+
+GpuTimer::GpuTimer(std::shared_ptr<Window> window)
+    : _window(std::move(window))
+{
+    _window->bindContext();
+
+    glGenQueries(gsl::narrow_cast<GLsizei>(_ids.size()), _ids.data());
+    for (types::UInt id : _ids)
+    {
+        if (id == 0)
+        {
+            throw std::runtime_error("Failed to generate a timer query.");
+        }
+    }
+}
+
+GpuTimer::~GpuTimer()
+{
+    _window->bindContext();
+    glDeleteQueries(gsl::narrow_cast<GLsizei>(_ids.size()), _ids.data());
+}
+
+void GpuTimer::begin()
+{
+    _window->bindContext();
+
+    if (_pendingCount == QUERIES_COUNT)
+    {
+        fetchOldest(true);
+    }
+    glBeginQuery(GL_TIME_ELAPSED, _ids.at((_firstPending + _pendingCount) % QUERIES_COUNT));
+}
+
+void GpuTimer::end()
+{
+    _window->bindContext();
+    glEndQuery(GL_TIME_ELAPSED);
+    _pendingCount++;
+}
+
+bool GpuTimer::pollResults()
+{
+    _window->bindContext();
+
+    bool fetched = false;
+    while (_pendingCount > 0 && fetchOldest(false))
+    {
+        fetched = true;
+    }
+    return fetched;
+}
+
+types::Float GpuTimer::milliseconds() const
+{
+    return _milliseconds;
+}
+
+bool GpuTimer::fetchOldest(bool wait)
+{
+    types::UInt id = _ids.at(_firstPending);
+    if (!wait)
+    {
+        types::UInt available = GL_FALSE;
+        glGetQueryObjectuiv(id, GL_QUERY_RESULT_AVAILABLE, &available);
+        if (available == GL_FALSE)
+        {
+            return false;
+        }
+    }
+
+    GLuint64 nanoseconds = 0;
+    glGetQueryObjectui64v(id, GL_QUERY_RESULT, &nanoseconds);
+    _milliseconds = static_cast<types::Float>(static_cast<double>(nanoseconds) / 1.0e6);
+
+    _firstPending = (_firstPending + 1) % QUERIES_COUNT;
+    _pendingCount--;
+    return true;
+}
+
+} // namespace pf::gl
@@ -0,0 +1,165 @@
+#include <pf_gl/Image.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb/stb_image.h>
+#include <fmt/format.h>
+#include <gsl/util>
+
+#include <pf_gl/ValueTypes.hpp>
+
+namespace pf::gl
+{
+
+namespace
+{
+
+types::Float srgbToLinear(std::uint8_t value)
+{
+    types::Float color = static_cast<types::Float>(value) / 255.0F;
+    return color <= 0.04045F ? color / 12.92F : std::pow((color + 0.055F) / 1.055F, 2.4F);
+}
+
+types::Float linearToSrgb(types::Float color)
+{
+    color = std::clamp(color, 0.0F, 1.0F);
+    return color <= 0.0031308F ? color * 12.92F : 1.055F * std::pow(color, 1.0F / 2.4F) - 0.055F;
+}
+
+std::array<types::Float, 256> const SRGB_TO_LINEAR = []
+{
+    std::array<types::Float, 256> table{};
+    for (size_t i = 0; i < table.size(); i++)
+    {
+        table[i] = srgbToLinear(static_cast<std::uint8_t>(i));
+    }
+    return table;
+}();
+
+} // namespace
+
+Image::Image(std::filesystem::path const &path, bool flipVertically)
+{
+    int channelsCount = 0;
+    unsigned char *data = stbi_load(path.string().c_str(),
+                                    &_width,
+                                    &_height,
+                                    &channelsCount,
+                                    static_cast<int>(CHANNELS_COUNT));
+    if (data == nullptr)
+    {
+        throw std::runtime_error(fmt::format(
+            "Could not load the image \"{}\" ({}).", path.string(), stbi_failure_reason()));
+    }
+    _pixels.assign(data, data + static_cast<size_t>(_width * _height) * CHANNELS_COUNT);
+    stbi_image_free(data);
+
+    if (flipVertically)
+    {
+        this->flipVertically();
+    }
+}
+
+Image::Image(types::Size width, types::Size height, std::vector<std::uint8_t> pixels)
+    : _width(width)
+    , _height(height)
+    , _pixels(std::move(pixels))
+{
+    if (_width <= 0 || _height <= 0 ||
+        _pixels.size() != static_cast<size_t>(_width * _height) * CHANNELS_COUNT)
+    {
+        throw std::invalid_argument(fmt::format(
+            "{} bytes do not make a {}x{} RGBA image.", _pixels.size(), _width, _height));
+    }
+}
+
+types::Size Image::width() const
+{
+    return _width;
+}
+
+types::Size Image::height() const
+{
+    return _height;
+}
+
+std::span<std::uint8_t const> Image::pixels() const
+{
+    return _pixels;
+}
+
+std::uint8_t const *Image::pixel(types::Int x, types::Int y) const
+{
+    x = std::clamp(x, 0, _width - 1);
+    y = std::clamp(y, 0, _height - 1);
+    return _pixels.data() + static_cast<size_t>(y * _width + x) * CHANNELS_COUNT;
+}
+
+void Image::flipVertically()
+{
+    auto rowSize = static_cast<long>(_width) * static_cast<long>(CHANNELS_COUNT);
+    auto top = _pixels.begin();
+    auto bottom = _pixels.end() - rowSize;
+    for (; top < bottom; top += rowSize, bottom -= rowSize)
+    {
+        std::swap_ranges(top, top + rowSize, bottom);
+    }
+}
+
+Image Image::downsample(bool srgb) const
+{
+    types::Size width = std::max(1, _width / 2);
+    types::Size height = std::max(1, _height / 2);
+    std::vector<std::uint8_t> pixels(static_cast<size_t>(width * height) * CHANNELS_COUNT);
+
+    for (types::Int y = 0; y < height; y++)
+    {
+        for (types::Int x = 0; x < width; x++)
+        {
+            std::array<std::uint8_t const *, 4> square = {pixel(2 * x, 2 * y),
+                                                          pixel(2 * x + 1, 2 * y),
+                                                          pixel(2 * x, 2 * y + 1),
+                                                          pixel(2 * x + 1, 2 * y + 1)};
+            std::uint8_t *result =
+                pixels.data() + static_cast<size_t>(y * width + x) * CHANNELS_COUNT;
+
+            for (size_t channel = 0; channel < CHANNELS_COUNT; channel++)
+            {
+                // Alpha is linear either way
+                bool linearize = srgb && channel != 3;
+                types::Float sum = 0.0F;
+                for (auto const *squarePixel : square)
+                {
+                    sum += linearize ? SRGB_TO_LINEAR[squarePixel[channel]]
+                                     : static_cast<types::Float>(squarePixel[channel]);
+                }
+                types::Float average = sum / static_cast<types::Float>(square.size());
+                if (linearize)
+                {
+                    average = linearToSrgb(average) * 255.0F;
+                }
+                result[channel] = static_cast<std::uint8_t>(std::lround(average));
+            }
+        }
+    }
+    return {width, height, std::move(pixels)};
+}
+
+types::Size Image::levelsCount() const
+{
+    auto largestSide = static_cast<types::UInt>(std::max(_width, _height));
+    return gsl::narrow_cast<types::Size>(std::bit_width(largestSide));
+}
+
+} // namespace pf::gl
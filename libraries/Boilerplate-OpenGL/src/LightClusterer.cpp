@@ -0,0 +1,340 @@
+#include <pf_gl/LightClusterer.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+#include <glm/glm.hpp>
+#include <gsl/util>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define PF_GL_LIGHT_CLUSTERER_SSE
+#include <xmmintrin.h>
+#endif
+
+#include <pf_gl/BoundingVolumes.hpp>
+#include <pf_gl/DrawingContext3D.hpp>
+#include <pf_gl/ValueTypes.hpp>
+#include <pf_utils/WorkerPool.hpp>
+
+namespace pf::gl
+{
+
+namespace
+{
+
+size_t constexpr BATCH_SIZE = 4;
+
+} // namespace
+
+LightClusterer::LightClusterer(types::Size clustersX,
+                               types::Size clustersY,
+                               types::Size clustersZ,
+                               types::Size threadsCount)
+    : _clustersX(clustersX)
+    , _clustersY(clustersY)
+    , _clustersZ(clustersZ)
+{
+    if (_clustersX <= 0 || _clustersY <= 0 || _clustersZ <= 0)
+    {
+        throw std::invalid_argument(fmt::format(
+            "Clusters grid must not be empty, got {}x{}x{}.", _clustersX, _clustersY, _clustersZ));
+    }
+    if (threadsCount < 0)
+    {
+        throw std::invalid_argument("Threads count must not be negative.");
+    }
+    if (threadsCount == 0)
+    {
+        threadsCount =
+            std::max(1, gsl::narrow_cast<types::Size>(std::thread::hardware_concurrency()));
+    }
+    _workers = std::make_unique<pf::util::WorkerPool>(
+        static_cast<size_t>(std::min(threadsCount, _clustersZ)));
+
+    _clusters.resize(static_cast<size_t>(clustersCount()), {.offset = 0, .count = 0});
+    _bounds.resize(static_cast<size_t>(clustersCount()), BoundingBox::UNBOUNDED);
+    _slices.resize(static_cast<size_t>(_clustersZ));
+}
+
+types::Float LightClusterer::radius(PointLight const &light, types::Float cutoff)
+{
+    types::FVec3 color = glm::max(light.color.ambient,
+                                  glm::max(light.color.diffuse, light.color.specular));
+    types::Float brightness = std::max({color.x, color.y, color.z});
+    if (brightness <= 0.0F)
+    {
+        return 0.0F;
+    }
+
+    // Solve `brightness / (constant + linear * d + quadratic * d^2) = cutoff` for the distance
+    types::Float target = brightness / cutoff - light.falloff.constant;
+    if (target <= 0.0F)
+    {
+        return 0.0F;
+    }
+    types::Float linear = light.falloff.linear;
+    types::Float quadratic = light.falloff.quadratic;
+    if (quadratic > 0.0F)
+    {
+        return (-linear + std::sqrt(linear * linear + 4.0F * quadratic * target)) /
+               (2.0F * quadratic);
+    }
+    if (linear > 0.0F)
+    {
+        return target / linear;
+    }
+    return std::numeric_limits<types::Float>::infinity();
+}
+
+void LightClusterer::assign(types::FMat4 const &projectionMatrix,
+                            std::span<types::FVec4 const> lights)
+{
+    if (projectionMatrix != _projectionMatrix)
+    {
+        computeBounds(projectionMatrix);
+    }
+
+    _lightIndices.clear();
+    if (lights.empty())
+    {
+        std::fill(_clusters.begin(), _clusters.end(), Cluster{.offset = 0, .count = 0});
+        return;
+    }
+
+    _workers->run(static_cast<size_t>(_clustersZ),
+                  [this, lights](size_t z)
+                  { assignSlice(gsl::narrow_cast<types::Size>(z), lights); });
+
+    // Offsets within the slices become offsets within the whole list
+    size_t clustersPerSlice = static_cast<size_t>(_clustersX * _clustersY);
+    for (size_t z = 0; z < _slices.size(); z++)
+    {
+        auto sliceOffset = gsl::narrow_cast<types::UInt>(_lightIndices.size());
+        for (size_t i = z * clustersPerSlice; i < (z + 1) * clustersPerSlice; i++)
+        {
+            _clusters[i].offset += sliceOffset;
+        }
+        std::vector<types::UInt> const &sliceIndices = _slices[z].indices;
+        _lightIndices.insert(_lightIndices.end(), sliceIndices.begin(), sliceIndices.end());
+    }
+}
+
+void LightClusterer::computeBounds(types::FMat4 const &projectionMatrix)
+{
+    _projectionMatrix = projectionMatrix;
+
+    // Inverse of the perspective projection terms, see `glm::perspective`
+    _near = projectionMatrix[3][2] / (projectionMatrix[2][2] - 1.0F);
+    _far = projectionMatrix[3][2] / (projectionMatrix[2][2] + 1.0F);
+    types::Float logDepthRange = std::log(_far / _near);
+    _depthScale = static_cast<types::Float>(_clustersZ) / logDepthRange;
+    _depthBias = -static_cast<types::Float>(_clustersZ) * std::log(_near) / logDepthRange;
+
+    for (types::Size z = 0; z < _clustersZ; z++)
+    {
+        types::Float nearDepth =
+            _near * std::pow(_far / _near, static_cast<types::Float>(z) / _clustersZ);
+        types::Float farDepth =
+            _near * std::pow(_far / _near, static_cast<types::Float>(z + 1) / _clustersZ);
+
+        for (types::Size y = 0; y < _clustersY; y++)
+        {
+            types::Float bottom = -1.0F + 2.0F * static_cast<types::Float>(y) / _clustersY;
+            types::Float top = -1.0F + 2.0F * static_cast<types::Float>(y + 1) / _clustersY;
+
+            for (types::Size x = 0; x < _clustersX; x++)
+            {
+                types::Float left = -1.0F + 2.0F * static_cast<types::Float>(x) / _clustersX;
+                types::Float right = -1.0F + 2.0F * static_cast<types::Float>(x + 1) / _clustersX;
+
+                // The tile widens with depth, the box has to hold both of its ends
+                BoundingBox bounds = BoundingBox::EMPTY;
+                for (types::Float depth : {nearDepth, farDepth})
+                {
+                    for (auto [ndcX, ndcY] : {std::pair{left, bottom}, std::pair{right, top}})
+                    {
+                        bounds = bounds.merge(types::FVec3(ndcX * depth / projectionMatrix[0][0],
+                                                           ndcY * depth / projectionMatrix[1][1],
+                                                           -depth));
+                    }
+                }
+                _bounds[static_cast<size_t>(clusterIndex(x, y, z))] = bounds;
+            }
+        }
+    }
+}
+
+void LightClusterer::assignSlice(types::Size z, std::span<types::FVec4 const> lights)
+{
+    Slice &slice = _slices[static_cast<size_t>(z)];
+    std::vector<types::UInt> &indices = slice.indices;
+    std::vector<types::UInt> &candidates = slice.candidates;
+    std::vector<types::Float> &centersX = slice.centersX;
+    std::vector<types::Float> &centersY = slice.centersY;
+    std::vector<types::Float> &centersZ = slice.centersZ;
+    std::vector<types::Float> &squaredRadii = slice.squaredRadii;
+    indices.clear();
+    candidates.clear();
+
+    // Lights touching the slice at all, in the structure-of-arrays layout padded to the batch size
+    BoundingBox sliceBounds = _bounds[static_cast<size_t>(clusterIndex(0, 0, z))].merge(
+        _bounds[static_cast<size_t>(clusterIndex(_clustersX - 1, _clustersY - 1, z))]);
+    for (size_t i = 0; i < lights.size(); i++)
+    {
+        BoundingSphere sphere = {.center = types::FVec3(lights[i]), .radius = lights[i].w};
+        if (sphere.intersects(sliceBounds))
+        {
+            candidates.push_back(gsl::narrow_cast<types::UInt>(i));
+        }
+    }
+
+    size_t paddedCount = (candidates.size() + BATCH_SIZE - 1) / BATCH_SIZE * BATCH_SIZE;
+    for (auto *values : {&centersX, &centersY, &centersZ, &squaredRadii})
+    {
+        // Unlike resizing, keeps the padding zeroed, the capacity stays from the previous frames
+        values->assign(paddedCount, 0.0F);
+    }
+    for (size_t i = 0; i < candidates.size(); i++)
+    {
+        types::FVec4 const &light = lights[candidates[i]];
+        centersX[i] = light.x;
+        centersY[i] = light.y;
+        centersZ[i] = light.z;
+        squaredRadii[i] = light.w * light.w;
+    }
+
+    for (types::Size y = 0; y < _clustersY; y++)
+    {
+        for (types::Size x = 0; x < _clustersX; x++)
+        {
+            auto index = static_cast<size_t>(clusterIndex(x, y, z));
+            BoundingBox const &bounds = _bounds[index];
+            auto offset = gsl::narrow_cast<types::UInt>(indices.size());
+
+            for (size_t batchStart = 0; batchStart < candidates.size(); batchStart += BATCH_SIZE)
+            {
+                // One bit per light in the batch, set in case it reaches the cluster
+                types::UInt insideMask = 0;
+
+#ifdef PF_GL_LIGHT_CLUSTERER_SSE
+                // Distance from the centers to the box along one of the axes, zero when inside
+                auto axisDistance = [batchStart](std::vector<types::Float> const &centers,
+                                                 types::Float min,
+                                                 types::Float max)
+                {
+                    __m128 center = _mm_loadu_ps(&centers[batchStart]);
+                    __m128 distance = _mm_max_ps(_mm_sub_ps(_mm_set1_ps(min), center),
+                                                 _mm_sub_ps(center, _mm_set1_ps(max)));
+                    return _mm_max_ps(distance, _mm_setzero_ps());
+                };
+                __m128 distanceX = axisDistance(centersX, bounds.min.x, bounds.max.x);
+                __m128 distanceY = axisDistance(centersY, bounds.min.y, bounds.max.y);
+                __m128 distanceZ = axisDistance(centersZ, bounds.min.z, bounds.max.z);
+                __m128 squaredDistance = _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(distanceX, distanceX), _mm_mul_ps(distanceY, distanceY)),
+                    _mm_mul_ps(distanceZ, distanceZ));
+
+                insideMask = gsl::narrow_cast<types::UInt>(_mm_movemask_ps(
+                    _mm_cmple_ps(squaredDistance, _mm_loadu_ps(&squaredRadii[batchStart]))));
+#else
+                for (size_t lane = 0; lane < BATCH_SIZE; lane++)
+                {
+                    size_t i = batchStart + lane;
+                    types::FVec3 center(centersX[i], centersY[i], centersZ[i]);
+                    types::FVec3 distance =
+                        glm::max(glm::max(bounds.min - center, center - bounds.max), 0.0F);
+                    if (glm::dot(distance, distance) <= squaredRadii[i])
+                    {
+                        insideMask |= 1U << lane;
+                    }
+                }
+#endif
+
+                for (size_t lane = 0; lane < BATCH_SIZE && batchStart + lane < candidates.size();
+                     lane++)
+                {
+                    if ((insideMask & (1U << lane)) != 0)
+                    {
+                        indices.push_back(candidates[batchStart + lane]);
+                    }
+                }
+            }
+
+            _clusters[index] = {
+                .offset = offset,
+                .count = gsl::narrow_cast<types::UInt>(indices.size()) - offset,
+            };
+        }
+    }
+}
+
+std::span<LightClusterer::Cluster const> LightClusterer::clusters() const
+{
+    return _clusters;
+}
+
+std::span<types::UInt const> LightClusterer::lightIndices() const
+{
+    return _lightIndices;
+}
+
+BoundingBox const &LightClusterer::bounds(types::Size clusterIndex) const
+{
+    return _bounds.at(static_cast<size_t>(clusterIndex));
+}
+
+types::Size LightClusterer::clusterIndex(types::Size x, types::Size y, types::Size z) const
+{
+    return (z * _clustersY + y) * _clustersX + x;
+}
+
+types::Size LightClusterer::depthSlice(types::Float depth) const
+{
+    if (depth <= 0.0F)
+    {
+        return 0;
+    }
+    auto slice = static_cast<types::Size>(std::floor(std::log(depth) * _depthScale + _depthBias));
+    return std::clamp(slice, 0, _clustersZ - 1);
+}
+
+types::Float LightClusterer::depthScale() const
+{
+    return _depthScale;
+}
+
+types::Float LightClusterer::depthBias() const
+{
+    return _depthBias;
+}
+
+types::Size LightClusterer::clustersX() const
+{
+    return _clustersX;
+}
+
+types::Size LightClusterer::clustersY() const
+{
+    return _clustersY;
+}
+
+types::Size LightClusterer::clustersZ() const
+{
+    return _clustersZ;
+}
+
+types::Size LightClusterer::clustersCount() const
+{
+    return _clustersX * _clustersY * _clustersZ;
+}
+
+} // namespace pf::gl
@@ -0,0 +1,134 @@
+#include <pf_gl/LightVolume.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <stdexcept>
+
+#include <fmt/format.h>
+#include <glm/glm.hpp>
+#include <gsl/util>
+
+#include <pf_gl/Mesh.hpp>
+#include <pf_gl/ValueTypes.hpp>
+
+namespace pf::gl
+{
+
+namespace
+{
+
+types::Float constexpr PI = std::numbers::pi_v<types::Float>;
+
+Mesh::SimpleVertex volumeVertex(types::FVec3 const &position)
+{
+    return {
+        .position = position,
+        .normal = position == types::FVec3(0.0F) ? types::FVec3(0.0F, 0.0F, 1.0F)
+                                                 : glm::normalize(position),
+        .textureCoordinates = types::FVec2(0.0F, 0.0F),
+    };
+}
+
+} // namespace
+
+LightVolume LightVolume::sphere(types::Size segmentsCount, types::Size ringsCount)
+{
+    if (segmentsCount < 3 || ringsCount < 2)
+    {
+        throw std::invalid_argument(
+            fmt::format("Sphere needs at least 3 segments and 2 rings, got {} and {}.",
+                        segmentsCount,
+                        ringsCount));
+    }
+
+    LightVolume volume;
+    volume.vertices.push_back(volumeVertex(types::FVec3(0.0F, 1.0F, 0.0F)));
+    for (types::Size ring = 1; ring < ringsCount; ring++)
+    {
+        types::Float polar = PI * static_cast<types::Float>(ring) / ringsCount;
+        for (types::Size segment = 0; segment < segmentsCount; segment++)
+        {
+            types::Float azimuth = 2.0F * PI * static_cast<types::Float>(segment) / segmentsCount;
+            volume.vertices.push_back(volumeVertex(
+                types::FVec3(std::sin(polar) * std::cos(azimuth),
+                             std::cos(polar),
+                             std::sin(polar) * std::sin(azimuth))));
+        }
+    }
+    volume.vertices.push_back(volumeVertex(types::FVec3(0.0F, -1.0F, 0.0F)));
+
+    auto ringVertex = [segmentsCount](types::Size ring, types::Size segment)
+    { return gsl::narrow_cast<GLuint>(1 + (ring - 1) * segmentsCount + segment % segmentsCount); };
+    auto bottom = gsl::narrow_cast<GLuint>(volume.vertices.size() - 1);
+
+    for (types::Size segment = 0; segment < segmentsCount; segment++)
+    {
+        volume.indices.insert(volume.indices.end(),
+                              {0, ringVertex(1, segment + 1), ringVertex(1, segment)});
+        for (types::Size ring = 1; ring + 1 < ringsCount; ring++)
+        {
+            GLuint upper = ringVertex(ring, segment);
+            GLuint upperNext = ringVertex(ring, segment + 1);
+            GLuint lower = ringVertex(ring + 1, segment);
+            GLuint lowerNext = ringVertex(ring + 1, segment + 1);
+            volume.indices.insert(volume.indices.end(),
+                                  {upper, upperNext, lowerNext, upper, lowerNext, lower});
+        }
+        volume.indices.insert(
+            volume.indices.end(),
+            {bottom, ringVertex(ringsCount - 1, segment), ringVertex(ringsCount - 1, segment + 1)});
+    }
+
+    // The vertices lie on the unit sphere, so the flat faces cut into it. The whole mesh is pushed
+    // out until the closest of the faces touches the sphere
+    types::Float closestFace = 1.0F;
+    for (size_t i = 0; i < volume.indices.size(); i += 3)
+    {
+        types::FVec3 const &first = volume.vertices[volume.indices[i]].position;
+        types::FVec3 const &second = volume.vertices[volume.indices[i + 1]].position;
+        types::FVec3 const &third = volume.vertices[volume.indices[i + 2]].position;
+        types::FVec3 normal = glm::normalize(glm::cross(second - first, third - first));
+        closestFace = std::min(closestFace, glm::dot(normal, first));
+    }
+    for (auto &vertex : volume.vertices)
+    {
+        vertex.position /= closestFace;
+    }
+    return volume;
+}
+
+LightVolume LightVolume::cone(types::Size segmentsCount)
+{
+    if (segmentsCount < 3)
+    {
+        throw std::invalid_argument(
+            fmt::format("Cone needs at least 3 segments, got {}.", segmentsCount));
+    }
+
+    types::Float scale = 1.0F / std::cos(PI / static_cast<types::Float>(segmentsCount));
+
+    LightVolume volume;
+    volume.vertices.push_back(volumeVertex(types::FVec3(0.0F, 0.0F, 0.0F)));
+    volume.vertices.push_back(volumeVertex(types::FVec3(0.0F, 0.0F, -1.0F)));
+    for (types::Size segment = 0; segment < segmentsCount; segment++)
+    {
+        types::Float azimuth = 2.0F * PI * static_cast<types::Float>(segment) / segmentsCount;
+        volume.vertices.push_back(volumeVertex(
+            types::FVec3(scale * std::cos(azimuth), scale * std::sin(azimuth), -1.0F)));
+    }
+
+    auto baseVertex = [segmentsCount](types::Size segment)
+    { return gsl::narrow_cast<GLuint>(2 + segment % segmentsCount); };
+
+    for (types::Size segment = 0; segment < segmentsCount; segment++)
+    {
+        volume.indices.insert(volume.indices.end(),
+                              {0, baseVertex(segment), baseVertex(segment + 1)});
+        volume.indices.insert(volume.indices.end(),
+                              {1, baseVertex(segment + 1), baseVertex(segment)});
+    }
+    return volume;
+}
+
+} // namespace pf::gl
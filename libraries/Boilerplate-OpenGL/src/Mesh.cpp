@@ -1,20 +1,27 @@
 #include <pf_gl/Mesh.hpp>
 
 #include <cstddef>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
 #include <utility>
 #include <memory>
+#include <optional>
 #include <vector>
 #include <string>
 #include <span>
 
 #include <gsl/util>
 
+#include <pf_gl/BoundingVolumes.hpp>
 #include <pf_gl/VertexBuffer.hpp>
 #include <pf_gl/ElementBuffer.hpp>
 #include <pf_gl/Texture.hpp>
+#include <pf_gl/TextureArray.hpp>
 #include <pf_gl/Transform3D.hpp>
 #include <pf_gl/MinecraftCamera.hpp>
 #include <pf_gl/VertexLayout.hpp>
+#include <pf_gl/VertexFormat.hpp>
 #include <pf_gl/ValueTypes.hpp>
 #include <pf_gl/RenderingOptions.hpp>
 #include <pf_gl/Window.hpp>
@@ -22,34 +29,242 @@
 #include <pf_gl/ValueTypes.hpp>
 #include <pf_gl/DrawingContext3D.hpp>
 #include <pf_gl/EulerTransform3D.hpp>
+#include <pf_gl/MeshSimplifier.hpp>
+#include <pf_gl/VertexQuantizer.hpp>
+#include <pf_gl/MeshData.hpp>
 
 namespace pf::gl
 {
 
+namespace
+{
+
+using SimpleVertexFormat = VertexFormat<Mesh::SimpleVertex,
+                                        VertexField<types::FLOAT_VECTOR_3, POSITION>,
+                                        VertexField<types::FLOAT_VECTOR_3, NORMAL>,
+                                        VertexField<types::FLOAT_VECTOR_2, TEXTURE_COORDINATES>>;
+
+using CompactVertexFormat =
+    VertexFormat<VertexQuantizer::CompactVertex,
+                 VertexField<types::SHORT_VECTOR_4, POSITION, true>,
+                 VertexField<types::INT_2_10_10_10_REV, NORMAL, true>,
+                 VertexField<types::HALF_FLOAT_VECTOR_2, TEXTURE_COORDINATES>>;
+
+using CompactPositionFormat =
+    VertexFormat<types::ShortVec4, VertexField<types::SHORT_VECTOR_4, POSITION, true>>;
+
+static_assert(SimpleVertexFormat::OFFSETS[1] == offsetof(Mesh::SimpleVertex, normal));
+static_assert(SimpleVertexFormat::OFFSETS[2] ==
+              offsetof(Mesh::SimpleVertex, textureCoordinates));
+static_assert(CompactVertexFormat::OFFSETS[1] == offsetof(VertexQuantizer::CompactVertex, normal));
+static_assert(CompactVertexFormat::OFFSETS[2] ==
+              offsetof(VertexQuantizer::CompactVertex, textureCoordinates));
+
+std::vector<AttributeEntry> vertexAttributes(bool quantized)
+{
+    return quantized ? CompactVertexFormat::attributes() : SimpleVertexFormat::attributes();
+}
+
+void quantizeVertices(std::vector<Mesh::SimpleVertex> const &vertices,
+                      VertexQuantizer const &quantizer,
+                      std::span<std::byte> destination)
+{
+    for (size_t i = 0; i < vertices.size(); i++)
+    {
+        VertexQuantizer::CompactVertex compactVertex = quantizer.quantize(
+            vertices[i].position, vertices[i].normal, vertices[i].textureCoordinates);
+        std::memcpy(destination.data() + i * sizeof(VertexQuantizer::CompactVertex),
+                    &compactVertex,
+                    sizeof(VertexQuantizer::CompactVertex));
+    }
+}
+
+void quantizePositions(std::vector<Mesh::SimpleVertex> const &vertices,
+                       VertexQuantizer const &quantizer,
+                       std::span<std::byte> destination)
+{
+    for (size_t i = 0; i < vertices.size(); i++)
+    {
+        types::ShortVec4 position = quantizer.quantize(vertices[i].position,
+                                                       vertices[i].normal,
+                                                       vertices[i].textureCoordinates)
+                                        .position;
+        std::memcpy(destination.data() + i * sizeof(types::ShortVec4), &position, sizeof(position));
+    }
+}
+
+/**
+ * All levels of detail are stored in the same element buffer one after another, starting with the
+ * original mesh.
+ */
+std::vector<MeshData::LevelOfDetail>
+levelOfDetailRanges(std::vector<GLuint> const &indices,
+                    std::vector<MeshSimplifier::Result> const &levelsOfDetail)
+{
+    std::vector<MeshData::LevelOfDetail> ranges;
+    ranges.reserve(levelsOfDetail.size() + 1);
+    ranges.push_back({
+        .firstIndex = 0,
+        .indicesCount = gsl::narrow_cast<types::Size>(indices.size()),
+        .error = 0.0F,
+    });
+    for (auto const &levelOfDetail : levelsOfDetail)
+    {
+        ranges.push_back({
+            .firstIndex = ranges.back().firstIndex + ranges.back().indicesCount,
+            .indicesCount = gsl::narrow_cast<types::Size>(levelOfDetail.indices.size()),
+            .error = levelOfDetail.error,
+        });
+    }
+    return ranges;
+}
+
+/**
+ * Smallest type that fits the indices of all levels of detail.
+ */
+types::ValueType indexTypeFor(std::vector<GLuint> const &indices,
+                              std::vector<MeshSimplifier::Result> const &levelsOfDetail)
+{
+    if (indices.empty())
+    {
+        return types::UNSIGNED_INT;
+    }
+
+    types::UInt maxIndex = *std::max_element(indices.begin(), indices.end());
+    for (auto const &levelOfDetail : levelsOfDetail)
+    {
+        if (!levelOfDetail.indices.empty())
+        {
+            maxIndex = std::max(maxIndex,
+                                *std::max_element(levelOfDetail.indices.begin(),
+                                                  levelOfDetail.indices.end()));
+        }
+    }
+    return MeshData::indexTypeFor(maxIndex);
+}
+
+void packLevelsOfDetail(std::vector<GLuint> const &indices,
+                        std::vector<MeshSimplifier::Result> const &levelsOfDetail,
+                        types::ValueType indexType,
+                        std::span<std::byte> destination)
+{
+    auto indexSize = static_cast<size_t>(types::sizeInBytes(indexType));
+    MeshData::packIndices(indices, indexType, destination);
+
+    size_t offset = indices.size() * indexSize;
+    for (auto const &levelOfDetail : levelsOfDetail)
+    {
+        MeshData::packIndices(levelOfDetail.indices, indexType, destination.subspan(offset));
+        offset += levelOfDetail.indices.size() * indexSize;
+    }
+}
+
+} // namespace
+
 Mesh::Mesh(std::shared_ptr<Window> window,
            std::vector<SimpleVertex> const &vertices,
            std::vector<GLuint> const &indices,
            std::vector<std::shared_ptr<Texture>> textures,
-           UsagePattern usagePattern)
+           UsagePattern usagePattern,
+           std::vector<MeshSimplifier::Result> const &levelsOfDetail,
+           VertexCompression vertexCompression)
     : _window(std::move(window))
     , _textures(std::move(textures))
+    , _levelsOfDetail(levelOfDetailRanges(indices, levelsOfDetail))
 {
-    _vertexArray = std::make_shared<VertexArray>(_window);
+    computeBounds(reinterpret_cast<std::byte const *>(vertices.data()) +
+                      offsetof(SimpleVertex, position),
+                  vertices.size(),
+                  sizeof(SimpleVertex),
+                  _boundingBox,
+                  _boundingSphere);
+
+    // Vertices and indices are converted straight into the mapped buffers, without preparing the
+    // whole mesh on the CPU side first
+    types::BinarySize verticesSize = 0;
+    if (vertexCompression == QUANTIZED && !vertices.empty())
+    {
+        VertexQuantizer quantizer(_boundingBox);
+        _dequantizationMatrix = quantizer.dequantizationMatrix();
+
+        verticesSize = gsl::narrow_cast<types::BinarySize>(
+            vertices.size() * sizeof(VertexQuantizer::CompactVertex));
+        _vertexBuffer = std::make_shared<VertexBuffer>(
+            _window,
+            verticesSize,
+            usagePattern,
+            CompactVertexFormat::layout(),
+            [&](std::span<std::byte> destination)
+            { quantizeVertices(vertices, quantizer, destination); });
+
+        auto positionsSize =
+            gsl::narrow_cast<types::BinarySize>(vertices.size() * sizeof(types::ShortVec4));
+        _positionsBuffer = std::make_shared<VertexBuffer>(
+            _window,
+            positionsSize,
+            usagePattern,
+            CompactPositionFormat::layout(),
+            [&](std::span<std::byte> destination)
+            { quantizePositions(vertices, quantizer, destination); });
+        verticesSize += positionsSize;
+    }
+    else
+    {
+        // Already in the uploaded layout, the driver copies it directly
+        pf::util::RawBuffer vertexBytes(vertices.data(), vertices.size());
+        verticesSize = gsl::narrow_cast<types::BinarySize>(vertexBytes.size());
+        _vertexBuffer = std::make_shared<VertexBuffer>(
+            _window, vertexBytes, usagePattern, SimpleVertexFormat::layout());
+    }
+    _vertexArray = VertexArray::shared(_window, _vertexBuffer->layout());
 
-    auto vertexBuffer = std::make_shared<VertexBuffer>(
+    types::ValueType indexType = indexTypeFor(indices, levelsOfDetail);
+    _elementBuffer = std::make_shared<ElementBuffer>(
         _window,
-        pf::util::RawBuffer(vertices),
+        _levelsOfDetail.back().firstIndex + _levelsOfDetail.back().indicesCount,
+        indexType,
         usagePattern,
-        VertexLayout({
-            AttributeEntry(types::FLOAT_VECTOR_3, POSITION),
-            AttributeEntry(types::FLOAT_VECTOR_3, NORMAL),
-            AttributeEntry(types::FLOAT_VECTOR_2, TEXTURE_COORDINATES),
-        }));
-    _vertexArray->addVertexBuffer(vertexBuffer);
-
-    auto elementBuffer = std::make_shared<ElementBuffer>(
-        _window, std::span<const types::UInt>(indices.begin(), indices.end()), usagePattern);
-    _vertexArray->setElementBuffer(elementBuffer);
+        [&](std::span<std::byte> destination)
+        { packLevelsOfDetail(indices, levelsOfDetail, indexType, destination); });
+
+    // The quantized positions are only ever written into the mapped buffer, there is nothing to
+    // extract them from
+    if (_positionsBuffer != nullptr)
+    {
+        _positionsVertexArray = VertexArray::shared(_window, _positionsBuffer->layout());
+    }
+    else
+    {
+        verticesSize += addPositionsStream(
+            SimpleVertexFormat::layout(), std::as_bytes(std::span(vertices)), usagePattern);
+    }
+
+    _sizeInBytes = verticesSize + _elementBuffer->sizeInBytes();
+}
+
+Mesh::Mesh(std::shared_ptr<Window> window,
+           MeshData const &data,
+           std::vector<std::shared_ptr<Texture>> textures,
+           UsagePattern usagePattern)
+    : _window(std::move(window))
+    , _textures(std::move(textures))
+    , _levelsOfDetail(data.levelsOfDetail)
+    , _dequantizationMatrix(data.dequantizationMatrix)
+    , _boundingBox(data.boundingBox)
+    , _boundingSphere(data.boundingSphere)
+{
+    _vertexBuffer = std::make_shared<VertexBuffer>(
+        _window,
+        pf::util::RawBuffer(data.vertices.data(), data.vertices.size()),
+        usagePattern,
+        VertexLayout(data.attributes));
+    _vertexArray = VertexArray::shared(_window, _vertexBuffer->layout());
+    _elementBuffer =
+        std::make_shared<ElementBuffer>(_window, data.indices, data.indexType, usagePattern);
+
+    _sizeInBytes =
+        gsl::narrow_cast<types::BinarySize>(data.vertices.size()) + _elementBuffer->sizeInBytes();
+    _sizeInBytes += addPositionsStream(_vertexBuffer->layout(), data.vertices, usagePattern);
 }
 
 Mesh::Mesh(std::shared_ptr<Window> window,
@@ -61,21 +276,76 @@ Mesh::Mesh(std::shared_ptr<Window> window,
     : _window(std::move(window))
     , _textures(std::move(textures))
 {
-    _vertexArray = std::make_shared<VertexArray>(_window);
-
-    auto vertexBuffer =
-        std::make_shared<VertexBuffer>(_window, vertices, usagePattern, vertexLayout);
-    _vertexArray->addVertexBuffer(vertexBuffer);
-
-    auto elementBuffer = std::make_shared<ElementBuffer>(
+    _vertexBuffer = std::make_shared<VertexBuffer>(_window, vertices, usagePattern, vertexLayout);
+    _vertexArray = VertexArray::shared(_window, vertexLayout);
+    _elementBuffer = std::make_shared<ElementBuffer>(
         _window, std::span<types::UInt>(indices.begin(), indices.size()), usagePattern);
-    _vertexArray->setElementBuffer(elementBuffer);
+
+    _sizeInBytes = gsl::narrow_cast<types::BinarySize>(vertices.size()) +
+                   _elementBuffer->sizeInBytes();
+    _sizeInBytes += addPositionsStream(
+        vertexLayout,
+        std::span(static_cast<std::byte const *>(vertices.pointer()), vertices.size()),
+        usagePattern);
+    _levelsOfDetail.push_back({
+        .firstIndex = 0,
+        .indicesCount = gsl::narrow_cast<types::Size>(indices.size()),
+        .error = 0.0F,
+    });
+
+    types::BinarySize positionOffset = 0;
+    for (auto const &attribute : vertexLayout)
+    {
+        if (attribute.attribute == POSITION && attribute.valueType == types::FLOAT_VECTOR_3)
+        {
+            auto stride = static_cast<size_t>(vertexLayout.stride());
+            computeBounds(static_cast<std::byte const *>(vertices.pointer()) + positionOffset,
+                          vertices.size() / stride,
+                          stride,
+                          _boundingBox,
+                          _boundingSphere);
+            break;
+        }
+        positionOffset += types::sizeInBytes(attribute.valueType);
+    }
 }
 
 void Mesh::render(Shader &shader,
                   DrawingContext3D const &drawingContext,
                   Transform3D const &transform,
-                  Material const &material) const
+                  Material const &material,
+                  types::Size levelOfDetail) const
+{
+    MeshData::LevelOfDetail const &range = _levelsOfDetail.at(levelOfDetail);
+    setUniforms(shader, drawingContext, transform, material);
+    _vertexArray->draw(*_vertexBuffer, *_elementBuffer, range.indicesCount, range.firstIndex);
+}
+
+void Mesh::renderPositions(Shader &shader,
+                           DrawingContext3D const &drawingContext,
+                           Transform3D const &transform,
+                           types::Size levelOfDetail) const
+{
+    MeshData::LevelOfDetail const &range = _levelsOfDetail.at(levelOfDetail);
+    setUniforms(shader, drawingContext, transform, {});
+
+    // Without the positions in the layout there is no separate stream, the attribute locations of
+    // the full one are the same anyway
+    if (_positionsVertexArray != nullptr)
+    {
+        _positionsVertexArray->draw(
+            *_positionsBuffer, *_elementBuffer, range.indicesCount, range.firstIndex);
+    }
+    else
+    {
+        _vertexArray->draw(*_vertexBuffer, *_elementBuffer, range.indicesCount, range.firstIndex);
+    }
+}
+
+void Mesh::setUniforms(Shader &shader,
+                       DrawingContext3D const &drawingContext,
+                       Transform3D const &transform,
+                       Material const &material) const
 {
     shader.use();
 
@@ -117,7 +387,7 @@ void Mesh::render(Shader &shader,
 
         case Uniform::Purpose::MODEL_MATRIX:
         {
-            types::FMat4 modelMatrix = transform.localToWorldMatrix();
+            types::FMat4 modelMatrix = transform.localToWorldMatrix() * _dequantizationMatrix;
             glUniformMatrix4fv(uniform.location,
                                1,
                                GL_FALSE,
@@ -140,6 +410,19 @@ void Mesh::render(Shader &shader,
             break;
         }
 
+        case Uniform::Purpose::DIFFUSE_TEXTURE_ARRAY:
+        {
+            // Bound once for all of the meshes sharing it, only the layer changes between them
+            glUniform1i(uniform.location, TextureArray::TEXTURE_UNIT);
+            break;
+        }
+
+        case Uniform::Purpose::TEXTURE_LAYER:
+        {
+            glUniform1i(uniform.location, _textureLayer);
+            break;
+        }
+
         case Uniform::Purpose::POINT_LIGHT_POSITION:
         case Uniform::Purpose::POINT_LIGHT_AMBIENT:
         case Uniform::Purpose::POINT_LIGHT_DIFFUSE:
@@ -333,7 +616,6 @@ void Mesh::render(Shader &shader,
         }
         }
     }
-    _vertexArray->draw();
 }
 
 void Mesh::render(Shader &shader,
@@ -343,4 +625,131 @@ void Mesh::render(Shader &shader,
     render(shader, drawingContext, EulerTransform3D::IDENTITY, material);
 }
 
+void Mesh::textureArray(std::shared_ptr<TextureArray> textureArray, types::Int layer)
+{
+    _textureArray = std::move(textureArray);
+    _textureLayer = layer;
+}
+
+std::shared_ptr<TextureArray> const &Mesh::textureArray() const
+{
+    return _textureArray;
+}
+
+types::Size Mesh::texturesCount() const
+{
+    return gsl::narrow_cast<types::Size>(_textures.size());
+}
+
+BoundingBox const &Mesh::boundingBox() const
+{
+    return _boundingBox;
+}
+
+BoundingSphere const &Mesh::boundingSphere() const
+{
+    return _boundingSphere;
+}
+
+types::Size Mesh::levelsOfDetailCount() const
+{
+    return gsl::narrow_cast<types::Size>(_levelsOfDetail.size());
+}
+
+types::Size Mesh::trianglesCount(types::Size levelOfDetail) const
+{
+    return _levelsOfDetail.at(levelOfDetail).indicesCount / 3;
+}
+
+types::Float Mesh::error(types::Size levelOfDetail) const
+{
+    return _levelsOfDetail.at(levelOfDetail).error;
+}
+
+types::BinarySize Mesh::sizeInBytes() const
+{
+    return _sizeInBytes;
+}
+
+MeshData Mesh::prepare(std::vector<SimpleVertex> const &vertices,
+                       std::vector<GLuint> const &indices,
+                       std::vector<MeshSimplifier::Result> const &levelsOfDetail,
+                       VertexCompression vertexCompression)
+{
+    struct Storage
+    {
+        std::vector<std::byte> vertices;
+        std::vector<std::byte> indices;
+    };
+    auto storage = std::make_shared<Storage>();
+
+    MeshData data;
+    computeBounds(reinterpret_cast<std::byte const *>(vertices.data()) +
+                      offsetof(SimpleVertex, position),
+                  vertices.size(),
+                  sizeof(SimpleVertex),
+                  data.boundingBox,
+                  data.boundingSphere);
+
+    bool quantized = vertexCompression == QUANTIZED && !vertices.empty();
+    if (quantized)
+    {
+        VertexQuantizer quantizer(data.boundingBox);
+        storage->vertices.resize(vertices.size() * sizeof(VertexQuantizer::CompactVertex));
+        quantizeVertices(vertices, quantizer, storage->vertices);
+        data.dequantizationMatrix = quantizer.dequantizationMatrix();
+    }
+    else
+    {
+        auto vertexBytes = std::as_bytes(std::span(vertices));
+        storage->vertices.assign(vertexBytes.begin(), vertexBytes.end());
+    }
+    data.attributes = vertexAttributes(quantized);
+
+    data.levelsOfDetail = levelOfDetailRanges(indices, levelsOfDetail);
+    data.indexType = indexTypeFor(indices, levelsOfDetail);
+    storage->indices.resize(
+        static_cast<size_t>(data.levelsOfDetail.back().firstIndex +
+                            data.levelsOfDetail.back().indicesCount) *
+        static_cast<size_t>(types::sizeInBytes(data.indexType)));
+    packLevelsOfDetail(indices, levelsOfDetail, data.indexType, storage->indices);
+
+    data.vertices = storage->vertices;
+    data.indices = storage->indices;
+    data.storage = std::move(storage);
+    return data;
+}
+
+types::BinarySize Mesh::addPositionsStream(VertexLayout const &layout,
+                                           std::span<std::byte const> vertices,
+                                           UsagePattern usagePattern)
+{
+    std::vector<std::byte> positions;
+    std::optional<AttributeEntry> positionAttribute =
+        MeshData::extractPositions(layout, vertices, positions);
+    if (!positionAttribute.has_value())
+    {
+        return 0;
+    }
+
+    _positionsBuffer =
+        std::make_shared<VertexBuffer>(_window,
+                                       pf::util::RawBuffer(positions.data(), positions.size()),
+                                       usagePattern,
+                                       VertexLayout({positionAttribute.value()}));
+    _positionsVertexArray = VertexArray::shared(_window, _positionsBuffer->layout());
+    return gsl::narrow_cast<types::BinarySize>(positions.size());
+}
+
+void Mesh::computeBounds(std::byte const *positions,
+                         size_t verticesCount,
+                         size_t stride,
+                         BoundingBox &boundingBox,
+                         BoundingSphere &boundingSphere)
+{
+    StridedPoints points = {.first = positions, .count = verticesCount, .stride = stride};
+    boundingBox = BoundingBox::fromPoints(points);
+    boundingSphere = BoundingSphere::fromPoints(points, boundingBox);
+}
+
 } // namespace pf::gl
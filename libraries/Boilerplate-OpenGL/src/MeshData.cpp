@@ -0,0 +1,98 @@
+#include <pf_gl/MeshData.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <pf_gl/ValueTypes.hpp>
+#include <pf_gl/VertexLayout.hpp>
+
+namespace pf::gl
+{
+
+types::ValueType MeshData::packIndices(std::span<types::UInt const> indices,
+                                       std::vector<std::byte> &packedIndices)
+{
+    types::ValueType indexType =
+        indices.empty() ? types::UNSIGNED_INT
+                        : indexTypeFor(*std::max_element(indices.begin(), indices.end()));
+    packedIndices.resize(indices.size() * static_cast<size_t>(types::sizeInBytes(indexType)));
+    packIndices(indices, indexType, packedIndices);
+    return indexType;
+}
+
+types::ValueType MeshData::indexTypeFor(types::UInt maxIndex)
+{
+    return maxIndex < std::numeric_limits<types::UShort>::max() ? types::UNSIGNED_SHORT
+                                                               : types::UNSIGNED_INT;
+}
+
+void MeshData::packIndices(std::span<types::UInt const> indices,
+                           types::ValueType indexType,
+                           std::span<std::byte> destination)
+{
+    if (indexType != types::UNSIGNED_INT && indexType != types::UNSIGNED_SHORT)
+    {
+        throw std::invalid_argument(
+            fmt::format("Unsupported index type: {}.", types::name(indexType)));
+    }
+    auto indexSize = static_cast<size_t>(types::sizeInBytes(indexType));
+    if (destination.size() < indices.size() * indexSize)
+    {
+        throw std::invalid_argument("The destination is too small for the packed indices.");
+    }
+
+    if (indexType == types::UNSIGNED_INT)
+    {
+        if (!indices.empty())
+        {
+            std::memcpy(destination.data(), indices.data(), indices.size_bytes());
+        }
+        return;
+    }
+
+    for (size_t i = 0; i < indices.size(); i++)
+    {
+        auto index = static_cast<types::UShort>(indices[i]);
+        std::memcpy(destination.data() + i * sizeof(types::UShort), &index, sizeof(index));
+    }
+}
+
+std::optional<AttributeEntry> MeshData::extractPositions(VertexLayout const &layout,
+                                                        std::span<std::byte const> vertices,
+                                                        std::vector<std::byte> &positions)
+{
+    positions.clear();
+
+    auto stride = static_cast<size_t>(layout.stride());
+    size_t offset = 0;
+    for (auto const &attribute : layout)
+    {
+        if (attribute.attribute != POSITION)
+        {
+            offset += static_cast<size_t>(types::sizeInBytes(attribute.valueType));
+            continue;
+        }
+
+        auto positionSize = static_cast<size_t>(types::sizeInBytes(attribute.valueType));
+        size_t verticesCount = stride == 0 ? 0 : vertices.size() / stride;
+        positions.resize(verticesCount * positionSize);
+        for (size_t i = 0; i < verticesCount; i++)
+        {
+            std::memcpy(positions.data() + i * positionSize,
+                        vertices.data() + i * stride + offset,
+                        positionSize);
+        }
+        return attribute;
+    }
+    return std::nullopt;
+}
+
+} // namespace pf::gl
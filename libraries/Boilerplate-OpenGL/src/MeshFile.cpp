@@ -0,0 +1,390 @@
+#include <pf_gl/MeshFile.hpp>
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gsl/util>
+
+#include <pf_gl/MeshData.hpp>
+#include <pf_gl/Texture.hpp>
+#include <pf_gl/VertexLayout.hpp>
+#include <pf_gl/ValueTypes.hpp>
+#include <pf_utils/Lz4.hpp>
+#include <pf_utils/MappedFile.hpp>
+
+namespace pf::gl
+{
+
+namespace
+{
+
+static_assert(std::endian::native == std::endian::little,
+              "Cooked meshes are read by copying the values as they are.");
+
+/**
+ * Everything the spans of the loaded meshes point into.
+ */
+struct Storage
+{
+    explicit Storage(std::filesystem::path const &path)
+        : file(path)
+    {
+    }
+
+    pf::util::MappedFile file;
+    std::vector<std::vector<std::byte>> decompressedBlocks;
+};
+
+struct CompressedBlock
+{
+    std::span<std::byte const> compressed;
+    std::span<std::byte> decompressed;
+};
+
+class Reader
+{
+public:
+    explicit Reader(std::span<std::byte const> bytes)
+        : _bytes(bytes)
+    {
+    }
+
+    template <typename T>
+    T read()
+    {
+        T value;
+        std::memcpy(&value, readBytes(sizeof(T)).data(), sizeof(T));
+        return value;
+    }
+
+    std::span<std::byte const> readBytes(size_t size)
+    {
+        if (size > _bytes.size() - _position)
+        {
+            throw std::runtime_error("Unexpected end of the mesh file.");
+        }
+        auto bytes = _bytes.subspan(_position, size);
+        _position += size;
+        return bytes;
+    }
+
+    void align(size_t alignment)
+    {
+        size_t padding = (alignment - _position % alignment) % alignment;
+        readBytes(padding);
+    }
+
+private:
+    std::span<std::byte const> _bytes;
+    size_t _position = 0;
+};
+
+class Writer
+{
+public:
+    template <typename T>
+    void write(T const &value)
+    {
+        writeBytes(std::as_bytes(std::span(&value, 1)));
+    }
+
+    void writeBytes(std::span<std::byte const> bytes)
+    {
+        _bytes.insert(_bytes.end(), bytes.begin(), bytes.end());
+    }
+
+    void align(size_t alignment)
+    {
+        _bytes.resize((_bytes.size() + alignment - 1) / alignment * alignment);
+    }
+
+    [[nodiscard]] std::vector<std::byte> const &bytes() const
+    {
+        return _bytes;
+    }
+
+private:
+    std::vector<std::byte> _bytes;
+};
+
+void writeBlock(Writer &writer,
+                std::span<std::byte const> block,
+                MeshFile::Compression compression)
+{
+    std::vector<std::byte> compressed;
+    if (compression == MeshFile::LZ4_COMPRESSION)
+    {
+        compressed = pf::util::lz4::compress(block);
+        if (compressed.size() >= block.size())
+        {
+            compression = MeshFile::NO_COMPRESSION;
+        }
+    }
+    std::span<std::byte const> stored =
+        compression == MeshFile::NO_COMPRESSION ? block : std::span<std::byte const>(compressed);
+
+    writer.write(static_cast<types::UInt>(compression));
+    writer.write(types::UInt(0));
+    writer.write(static_cast<std::uint64_t>(block.size()));
+    writer.write(static_cast<std::uint64_t>(stored.size()));
+    writer.align(MeshFile::DATA_ALIGNMENT);
+    writer.writeBytes(stored);
+}
+
+/**
+ * Uncompressed blocks point straight into the mapped file, the compressed ones point into the
+ * buffers which are filled later on.
+ */
+std::span<std::byte const> readBlock(Reader &reader,
+                                     Storage &storage,
+                                     std::vector<CompressedBlock> &compressedBlocks)
+{
+    auto compression = reader.read<types::UInt>();
+    reader.read<types::UInt>();
+    auto size = reader.read<std::uint64_t>();
+    auto storedSize = reader.read<std::uint64_t>();
+    reader.align(MeshFile::DATA_ALIGNMENT);
+    std::span<std::byte const> stored = reader.readBytes(storedSize);
+
+    switch (compression)
+    {
+    case MeshFile::NO_COMPRESSION:
+    {
+        if (storedSize != size)
+        {
+            throw std::runtime_error("Uncompressed mesh data block has a wrong size.");
+        }
+        return stored;
+    }
+    case MeshFile::LZ4_COMPRESSION:
+    {
+        auto &decompressed = storage.decompressedBlocks.emplace_back(size);
+        compressedBlocks.push_back({.compressed = stored, .decompressed = decompressed});
+        return decompressed;
+    }
+    default:
+        throw std::runtime_error(fmt::format("Unknown mesh data compression: {}.", compression));
+    }
+}
+
+} // namespace
+
+MeshFile::MeshFile(std::filesystem::path const &path)
+{
+    auto storage = std::make_shared<Storage>(path);
+    Reader reader(storage->file.bytes());
+
+    if (reader.read<types::UInt>() != MAGIC)
+    {
+        throw std::runtime_error(fmt::format("Not a cooked mesh file: \"{}\".", path.string()));
+    }
+    auto version = reader.read<types::UInt>();
+    if (version != VERSION)
+    {
+        throw std::runtime_error(
+            fmt::format("Mesh file \"{}\" has version {} instead of {}, it has to be cooked again.",
+                        path.string(),
+                        version,
+                        VERSION));
+    }
+    auto meshesCount = reader.read<types::UInt>();
+    reader.read<types::UInt>();
+
+    std::vector<CompressedBlock> compressedBlocks;
+    for (types::UInt meshIndex = 0; meshIndex < meshesCount; meshIndex++)
+    {
+        MeshData data;
+
+        auto attributesCount = reader.read<types::UInt>();
+        for (types::UInt i = 0; i < attributesCount; i++)
+        {
+            auto attribute = reader.read<types::UInt>();
+            auto valueType = reader.read<types::UInt>();
+            auto normalized = reader.read<types::UInt>();
+            if (attribute > COLOR || valueType > types::INT_2_10_10_10_REV)
+            {
+                throw std::runtime_error("Mesh file has an unknown vertex attribute.");
+            }
+            data.attributes.emplace_back(static_cast<types::ValueType>(valueType),
+                                         static_cast<Attribute>(attribute),
+                                         normalized != 0);
+        }
+
+        data.indexType = static_cast<types::ValueType>(reader.read<types::UInt>());
+        if (data.indexType != types::UNSIGNED_INT && data.indexType != types::UNSIGNED_SHORT)
+        {
+            throw std::runtime_error("Mesh file has an unknown index type.");
+        }
+
+        auto levelsOfDetailCount = reader.read<types::UInt>();
+        for (types::UInt i = 0; i < levelsOfDetailCount; i++)
+        {
+            data.levelsOfDetail.push_back({
+                .firstIndex = reader.read<types::Size>(),
+                .indicesCount = reader.read<types::Size>(),
+                .error = reader.read<types::Float>(),
+            });
+        }
+
+        data.boundingBox.min = reader.read<types::FVec3>();
+        data.boundingBox.max = reader.read<types::FVec3>();
+        data.boundingSphere.center = reader.read<types::FVec3>();
+        data.boundingSphere.radius = reader.read<types::Float>();
+        data.dequantizationMatrix = reader.read<types::FMat4>();
+
+        auto texturesCount = reader.read<types::UInt>();
+        for (types::UInt i = 0; i < texturesCount; i++)
+        {
+            auto type = reader.read<types::UInt>();
+            auto pathBytes = reader.readBytes(reader.read<types::UInt>());
+            reader.align(sizeof(types::UInt));
+            if (type > SPECULAR)
+            {
+                throw std::runtime_error("Mesh file has an unknown texture type.");
+            }
+            std::string texturePath(reinterpret_cast<char const *>(pathBytes.data()),
+                                    pathBytes.size());
+            data.textures.push_back({
+                .type = static_cast<TextureType>(type),
+                .path = path.parent_path() / texturePath,
+            });
+        }
+
+        data.vertices = readBlock(reader, *storage, compressedBlocks);
+        data.indices = readBlock(reader, *storage, compressedBlocks);
+
+        VertexLayout layout(data.attributes);
+        auto indicesCount = data.indices.size() / types::sizeInBytes(data.indexType);
+        if (data.vertices.size() % layout.stride() != 0 ||
+            data.indices.size() % types::sizeInBytes(data.indexType) != 0)
+        {
+            throw std::runtime_error("Mesh file has a partial vertex or index.");
+        }
+        for (auto const &levelOfDetail : data.levelsOfDetail)
+        {
+            if (levelOfDetail.firstIndex < 0 || levelOfDetail.indicesCount < 0 ||
+                static_cast<size_t>(levelOfDetail.firstIndex) +
+                        static_cast<size_t>(levelOfDetail.indicesCount) >
+                    indicesCount)
+            {
+                throw std::runtime_error("Mesh file has a level of detail out of the indices.");
+            }
+        }
+
+        data.storage = storage;
+        _meshes.push_back(std::move(data));
+    }
+
+    if (!compressedBlocks.empty())
+    {
+        // Holds the storage, so that the mapping outlives the decompression
+        _decompression = std::async(std::launch::async,
+                                    [storage, compressedBlocks = std::move(compressedBlocks)]()
+                                    {
+                                        for (auto const &block : compressedBlocks)
+                                        {
+                                            pf::util::lz4::decompress(block.compressed,
+                                                                      block.decompressed);
+                                        }
+                                    })
+                             .share();
+    }
+}
+
+size_t MeshFile::meshesCount() const
+{
+    return _meshes.size();
+}
+
+std::vector<MeshData::TextureReference> const &MeshFile::textures(size_t meshIndex) const
+{
+    return _meshes.at(meshIndex).textures;
+}
+
+MeshData const &MeshFile::mesh(size_t meshIndex) const
+{
+    if (_decompression.valid())
+    {
+        _decompression.get();
+    }
+    return _meshes.at(meshIndex);
+}
+
+void MeshFile::write(std::filesystem::path const &path,
+                     std::span<MeshData const> meshes,
+                     Compression compression)
+{
+    Writer writer;
+    writer.write(MAGIC);
+    writer.write(VERSION);
+    writer.write(gsl::narrow_cast<types::UInt>(meshes.size()));
+    writer.write(types::UInt(0));
+
+    for (auto const &mesh : meshes)
+    {
+        writer.write(gsl::narrow_cast<types::UInt>(mesh.attributes.size()));
+        for (auto const &attribute : mesh.attributes)
+        {
+            writer.write(static_cast<types::UInt>(attribute.attribute));
+            writer.write(static_cast<types::UInt>(attribute.valueType));
+            writer.write(static_cast<types::UInt>(attribute.normalized ? 1 : 0));
+        }
+
+        writer.write(static_cast<types::UInt>(mesh.indexType));
+
+        writer.write(gsl::narrow_cast<types::UInt>(mesh.levelsOfDetail.size()));
+        for (auto const &levelOfDetail : mesh.levelsOfDetail)
+        {
+            writer.write(levelOfDetail.firstIndex);
+            writer.write(levelOfDetail.indicesCount);
+            writer.write(levelOfDetail.error);
+        }
+
+        writer.write(mesh.boundingBox.min);
+        writer.write(mesh.boundingBox.max);
+        writer.write(mesh.boundingSphere.center);
+        writer.write(mesh.boundingSphere.radius);
+        writer.write(mesh.dequantizationMatrix);
+
+        writer.write(gsl::narrow_cast<types::UInt>(mesh.textures.size()));
+        for (auto const &texture : mesh.textures)
+        {
+            std::string texturePath = texture.path.generic_string();
+            writer.write(static_cast<types::UInt>(texture.type));
+            writer.write(gsl::narrow_cast<types::UInt>(texturePath.size()));
+            writer.writeBytes(std::as_bytes(std::span(texturePath)));
+            writer.align(sizeof(types::UInt));
+        }
+
+        writeBlock(writer, mesh.vertices, compression);
+        writeBlock(writer, mesh.indices, compression);
+    }
+
+    std::ofstream fileStream;
+    fileStream.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+    try
+    {
+        fileStream.open(path, std::ofstream::out | std::ofstream::binary);
+        fileStream.write(reinterpret_cast<char const *>(writer.bytes().data()),
+                         gsl::narrow_cast<std::streamsize>(writer.bytes().size()));
+    }
+    catch (std::ofstream::failure const &e)
+    {
+        throw std::runtime_error(fmt::format(
+            "Error while writing the mesh file ({}).\nDetails: {}.", path.string(), e.what()));
+    }
+}
+
+} // namespace pf::gl
@@ -0,0 +1,554 @@
+#include <pf_gl/MeshOptimizer.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <fmt/format.h>
+#include <glm/glm.hpp>
+#include <gsl/util>
+
+#include <pf_gl/ValueTypes.hpp>
+
+namespace pf::gl
+{
+
+namespace
+{
+
+// Constants from the Tom Forsyth's "Linear-Speed Vertex Cache Optimisation"
+
+types::Float constexpr CACHE_DECAY_POWER = 1.5F;
+types::Float constexpr LAST_TRIANGLE_SCORE = 0.75F;
+types::Float constexpr VALENCE_BOOST_SCALE = 2.0F;
+types::Float constexpr VALENCE_BOOST_POWER = 0.5F;
+
+types::Float vertexScore(int cachePosition, types::UInt remainingTrianglesCount)
+{
+    if (remainingTrianglesCount == 0)
+    {
+        return -1.0F;
+    }
+
+    types::Float score = 0.0F;
+    if (cachePosition >= 0)
+    {
+        // Vertices of the last triangle are scored lower, so that the strips do not turn back
+        if (cachePosition < 3)
+        {
+            score = LAST_TRIANGLE_SCORE;
+        }
+        else
+        {
+            auto scaler = 1.0F / static_cast<types::Float>(MeshOptimizer::CACHE_SIZE - 3);
+            score = std::pow(1.0F - static_cast<types::Float>(cachePosition - 3) * scaler,
+                             CACHE_DECAY_POWER);
+        }
+    }
+
+    // Vertices with few triangles left are boosted, so that they do not end up as lone triangles
+    score += VALENCE_BOOST_SCALE *
+             std::pow(static_cast<types::Float>(remainingTrianglesCount), -VALENCE_BOOST_POWER);
+    return score;
+}
+
+/**
+ * FIFO cache simulation, a vertex is in the cache in case fewer than cache size vertices were
+ * transformed after it.
+ */
+class FifoCache
+{
+public:
+    FifoCache(size_t verticesCount, size_t cacheSize)
+        : _timestamps(verticesCount, 0)
+        , _cacheSize(cacheSize)
+        , _timestamp(cacheSize + 1)
+    {
+    }
+
+    /**
+     * Returns true in case the vertex had to be transformed.
+     */
+    bool access(types::UInt vertex)
+    {
+        if (_timestamp - _timestamps[vertex] > _cacheSize)
+        {
+            _timestamps[vertex] = _timestamp++;
+            return true;
+        }
+        return false;
+    }
+
+    void clear()
+    {
+        _timestamp += _cacheSize + 1;
+    }
+
+private:
+    std::vector<size_t> _timestamps;
+    size_t _cacheSize;
+    size_t _timestamp;
+};
+
+} // namespace
+
+MeshOptimizer::Report MeshOptimizer::optimize(std::span<std::byte> vertices,
+                                              size_t stride,
+                                              size_t positionOffset,
+                                              std::vector<types::UInt> &indices,
+                                              types::Float weldEpsilon)
+{
+    if (stride == 0 || vertices.size() % stride != 0 ||
+        positionOffset + sizeof(types::FVec3) > stride)
+    {
+        throw std::invalid_argument(fmt::format(
+            "Invalid vertex layout: {} bytes of vertices, stride {}, position offset {}.",
+            vertices.size(),
+            stride,
+            positionOffset));
+    }
+
+    Report report;
+    report.verticesCountBefore = vertices.size() / stride;
+    report.before = analyze(indices, report.verticesCountBefore);
+
+    std::vector<types::UInt> remap;
+    size_t verticesCount = generateWeldRemap(vertices, stride, weldEpsilon, remap);
+    remapIndices(indices, remap);
+    remapVertices(vertices, stride, remap);
+
+    auto weldedVertices = vertices.first(verticesCount * stride);
+    optimizeTriangles(weldedVertices, stride, positionOffset, indices);
+
+    verticesCount = generateVertexFetchRemap(indices, verticesCount, remap);
+    remapIndices(indices, remap);
+    remapVertices(weldedVertices, stride, remap);
+
+    report.verticesCountAfter = verticesCount;
+    report.after = analyze(indices, verticesCount);
+    return report;
+}
+
+void MeshOptimizer::optimizeTriangles(std::span<std::byte const> vertices,
+                                      size_t stride,
+                                      size_t positionOffset,
+                                      std::span<types::UInt> indices)
+{
+    std::vector<types::FVec3> positions = extractPositions(vertices, stride, positionOffset);
+    optimizeVertexCache(indices, positions.size());
+    optimizeOverdraw(indices, positions);
+}
+
+size_t MeshOptimizer::generateWeldRemap(std::span<std::byte const> vertices,
+                                        size_t stride,
+                                        types::Float epsilon,
+                                        std::vector<types::UInt> &remap)
+{
+    size_t verticesCount = vertices.size() / stride;
+    std::vector<types::UInt> sortedVertices(verticesCount);
+    std::iota(sortedVertices.begin(), sortedVertices.end(), 0);
+
+    std::vector<int64_t> keys;
+    size_t componentsCount = stride / sizeof(types::Float);
+
+    if (epsilon > 0.0F)
+    {
+        if (stride % sizeof(types::Float) != 0)
+        {
+            throw std::invalid_argument(
+                fmt::format("Vertices of {} bytes cannot be made only of floats.", stride));
+        }
+
+        keys.resize(verticesCount * componentsCount);
+        for (size_t i = 0; i < keys.size(); i++)
+        {
+            types::Float component = 0.0F;
+            std::memcpy(&component, vertices.data() + i * sizeof(types::Float), sizeof(component));
+            keys[i] = std::llround(static_cast<double>(component) / epsilon);
+        }
+    }
+
+    // Equal vertices end up next to each other, the first one of them represents the whole group
+    auto compare = [&](types::UInt first, types::UInt second)
+    {
+        int comparison = 0;
+        if (keys.empty())
+        {
+            comparison = std::memcmp(vertices.data() + first * stride,
+                                     vertices.data() + second * stride,
+                                     stride);
+        }
+        else
+        {
+            auto firstKey = keys.begin() + first * componentsCount;
+            auto secondKey = keys.begin() + second * componentsCount;
+            auto mismatch = static_cast<size_t>(
+                std::mismatch(firstKey, firstKey + componentsCount, secondKey).first - firstKey);
+            if (mismatch != componentsCount)
+            {
+                comparison = firstKey[mismatch] < secondKey[mismatch] ? -1 : 1;
+            }
+        }
+        return comparison;
+    };
+    std::sort(sortedVertices.begin(),
+              sortedVertices.end(),
+              [&compare](types::UInt first, types::UInt second)
+              {
+                  int comparison = compare(first, second);
+                  return comparison != 0 ? comparison < 0 : first < second;
+              });
+
+    std::vector<types::UInt> representatives(verticesCount);
+    for (size_t i = 0; i < verticesCount; i++)
+    {
+        bool isEqual = i > 0 && compare(sortedVertices[i], sortedVertices[i - 1]) == 0;
+        representatives[sortedVertices[i]] =
+            isEqual ? representatives[sortedVertices[i - 1]] : sortedVertices[i];
+    }
+
+    // New indices go in the order of the first appearance, so the vertices only move backwards
+    remap.assign(verticesCount, NO_VERTEX);
+    types::UInt uniqueVerticesCount = 0;
+    for (size_t vertex = 0; vertex < verticesCount; vertex++)
+    {
+        remap[vertex] = representatives[vertex] == vertex ? uniqueVerticesCount++
+                                                          : remap[representatives[vertex]];
+    }
+    return uniqueVerticesCount;
+}
+
+void MeshOptimizer::optimizeVertexCache(std::span<types::UInt> indices, size_t verticesCount)
+{
+    size_t trianglesCount = indices.size() / 3;
+    if (trianglesCount == 0)
+    {
+        return;
+    }
+
+    // Triangles around each vertex, the ones which are not emitted yet go first
+    std::vector<types::UInt> remainingTrianglesCounts(verticesCount, 0);
+    for (auto index : indices)
+    {
+        remainingTrianglesCounts[index]++;
+    }
+    std::vector<types::UInt> firstTriangles(verticesCount + 1, 0);
+    std::partial_sum(remainingTrianglesCounts.begin(),
+                     remainingTrianglesCounts.end(),
+                     firstTriangles.begin() + 1);
+    std::vector<types::UInt> vertexTriangles(indices.size());
+    {
+        std::vector<types::UInt> offsets(firstTriangles.begin(), firstTriangles.end() - 1);
+        for (size_t i = 0; i < indices.size(); i++)
+        {
+            vertexTriangles[offsets[indices[i]]++] = gsl::narrow_cast<types::UInt>(i / 3);
+        }
+    }
+
+    std::vector<int> cachePositions(verticesCount, -1);
+    std::vector<types::Float> vertexScores(verticesCount);
+    for (size_t vertex = 0; vertex < verticesCount; vertex++)
+    {
+        vertexScores[vertex] = vertexScore(-1, remainingTrianglesCounts[vertex]);
+    }
+
+    std::vector<types::Float> triangleScores(trianglesCount);
+    std::vector<bool> isEmitted(trianglesCount, false);
+    for (size_t triangle = 0; triangle < trianglesCount; triangle++)
+    {
+        triangleScores[triangle] = vertexScores[indices[triangle * 3]] +
+                                   vertexScores[indices[triangle * 3 + 1]] +
+                                   vertexScores[indices[triangle * 3 + 2]];
+    }
+
+    std::vector<types::UInt> result;
+    result.reserve(indices.size());
+    std::vector<types::UInt> cache, newCache;
+    cache.reserve(CACHE_SIZE + 3);
+    newCache.reserve(CACHE_SIZE + 3);
+
+    auto bestTriangle = static_cast<types::UInt>(
+        std::max_element(triangleScores.begin(), triangleScores.end()) - triangleScores.begin());
+
+    while (result.size() < indices.size())
+    {
+        isEmitted[bestTriangle] = true;
+        newCache.clear();
+
+        for (size_t corner = 0; corner < 3; corner++)
+        {
+            types::UInt vertex = indices[bestTriangle * 3 + corner];
+            result.push_back(vertex);
+            newCache.push_back(vertex);
+
+            // Emitted triangle is moved out of the remaining ones of the vertex
+            auto first = vertexTriangles.begin() + firstTriangles[vertex];
+            auto last = first + remainingTrianglesCounts[vertex];
+            std::iter_swap(std::find(first, last, bestTriangle), last - 1);
+            remainingTrianglesCounts[vertex]--;
+        }
+        for (auto vertex : cache)
+        {
+            if (std::find(newCache.begin(), newCache.begin() + 3, vertex) == newCache.begin() + 3)
+            {
+                newCache.push_back(vertex);
+            }
+        }
+
+        // Vertices pushed out of the cache lose their cache score
+        for (size_t i = 0; i < newCache.size(); i++)
+        {
+            types::UInt vertex = newCache[i];
+            cachePositions[vertex] = i < CACHE_SIZE ? static_cast<int>(i) : -1;
+            vertexScores[vertex] =
+                vertexScore(cachePositions[vertex], remainingTrianglesCounts[vertex]);
+        }
+        newCache.resize(std::min(newCache.size(), CACHE_SIZE));
+        std::swap(cache, newCache);
+
+        // Only the triangles around the cached vertices have their scores changed
+        types::Float bestScore = -1.0F;
+        for (auto vertex : cache)
+        {
+            auto first = vertexTriangles.begin() + firstTriangles[vertex];
+            for (auto triangle = first; triangle != first + remainingTrianglesCounts[vertex];
+                 triangle++)
+            {
+                types::Float score = vertexScores[indices[*triangle * 3]] +
+                                     vertexScores[indices[*triangle * 3 + 1]] +
+                                     vertexScores[indices[*triangle * 3 + 2]];
+                triangleScores[*triangle] = score;
+                if (score > bestScore)
+                {
+                    bestScore = score;
+                    bestTriangle = *triangle;
+                }
+            }
+        }
+
+        // Nothing left around the cache, start over from the best triangle in the whole mesh
+        if (bestScore < 0.0F && result.size() < indices.size())
+        {
+            for (size_t triangle = 0; triangle < trianglesCount; triangle++)
+            {
+                if (!isEmitted[triangle] && triangleScores[triangle] > bestScore)
+                {
+                    bestScore = triangleScores[triangle];
+                    bestTriangle = gsl::narrow_cast<types::UInt>(triangle);
+                }
+            }
+        }
+    }
+
+    std::copy(result.begin(), result.end(), indices.begin());
+}
+
+void MeshOptimizer::optimizeOverdraw(std::span<types::UInt> indices,
+                                     std::span<types::FVec3 const> positions,
+                                     types::Float threshold)
+{
+    size_t trianglesCount = indices.size() / 3;
+    if (trianglesCount == 0)
+    {
+        return;
+    }
+
+    FifoCache cache(positions.size(), STATISTICS_CACHE_SIZE);
+    auto transformTriangle = [&cache, indices](size_t triangle)
+    {
+        return static_cast<int>(cache.access(indices[triangle * 3])) +
+               static_cast<int>(cache.access(indices[triangle * 3 + 1])) +
+               static_cast<int>(cache.access(indices[triangle * 3 + 2]));
+    };
+
+    // Hard boundaries: the cache is cold anyway where all of the triangle vertices are missed
+    std::vector<size_t> hardClusters;
+    for (size_t triangle = 0; triangle < trianglesCount; triangle++)
+    {
+        if (transformTriangle(triangle) == 3)
+        {
+            hardClusters.push_back(triangle);
+        }
+    }
+    hardClusters.push_back(trianglesCount);
+
+    // Soft boundaries: hard clusters are split further where restarting with a cold cache costs
+    // little compared to the cache performance of the whole cluster
+    std::vector<size_t> clusters;
+    for (size_t i = 0; i + 1 < hardClusters.size(); i++)
+    {
+        size_t start = hardClusters[i], end = hardClusters[i + 1];
+
+        cache.clear();
+        int clusterMisses = 0;
+        for (size_t triangle = start; triangle < end; triangle++)
+        {
+            clusterMisses += transformTriangle(triangle);
+        }
+        types::Float clusterThreshold = threshold * static_cast<types::Float>(clusterMisses) /
+                                        static_cast<types::Float>(end - start);
+
+        clusters.push_back(start);
+        cache.clear();
+        int misses = 0;
+        for (size_t triangle = start; triangle < end; triangle++)
+        {
+            misses += transformTriangle(triangle);
+            auto missesRatio = static_cast<types::Float>(misses) /
+                               static_cast<types::Float>(triangle + 1 - start);
+            if (triangle + 1 < end && missesRatio <= clusterThreshold)
+            {
+                clusters.push_back(triangle + 1);
+                start = triangle + 1;
+                misses = 0;
+                cache.clear();
+            }
+        }
+    }
+    clusters.push_back(trianglesCount);
+
+    // Clusters facing away from the center of the mesh are likely to occlude the other ones
+    types::FVec3 meshCentroid = types::DEFAULT_VALUE<types::FVec3>;
+    for (auto index : indices)
+    {
+        meshCentroid += positions[index];
+    }
+    meshCentroid /= static_cast<types::Float>(indices.size());
+
+    size_t clustersCount = clusters.size() - 1;
+    std::vector<types::Float> sortKeys(clustersCount);
+    for (size_t cluster = 0; cluster < clustersCount; cluster++)
+    {
+        types::FVec3 centroid = types::DEFAULT_VALUE<types::FVec3>;
+        types::FVec3 normal = types::DEFAULT_VALUE<types::FVec3>;
+        types::Float area = 0.0F;
+
+        for (size_t triangle = clusters[cluster]; triangle < clusters[cluster + 1]; triangle++)
+        {
+            types::FVec3 const &a = positions[indices[triangle * 3]];
+            types::FVec3 const &b = positions[indices[triangle * 3 + 1]];
+            types::FVec3 const &c = positions[indices[triangle * 3 + 2]];
+            types::FVec3 triangleNormal = glm::cross(b - a, c - a);
+            types::Float triangleArea = glm::length(triangleNormal);
+
+            centroid += (a + b + c) * (triangleArea / 3.0F);
+            normal += triangleNormal;
+            area += triangleArea;
+        }
+
+        auto normalLength = glm::length(normal);
+        if (area > 0.0F && normalLength > 0.0F)
+        {
+            sortKeys[cluster] = glm::dot(centroid / area - meshCentroid, normal / normalLength);
+        }
+    }
+
+    std::vector<size_t> order(clustersCount);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(),
+                     order.end(),
+                     [&sortKeys](size_t first, size_t second)
+                     { return sortKeys[first] > sortKeys[second]; });
+
+    std::vector<types::UInt> result;
+    result.reserve(indices.size());
+    for (auto cluster : order)
+    {
+        result.insert(result.end(),
+                      indices.begin() + clusters[cluster] * 3,
+                      indices.begin() + clusters[cluster + 1] * 3);
+    }
+    std::copy(result.begin(), result.end(), indices.begin());
+}
+
+size_t MeshOptimizer::generateVertexFetchRemap(std::span<types::UInt const> indices,
+                                               size_t verticesCount,
+                                               std::vector<types::UInt> &remap)
+{
+    remap.assign(verticesCount, NO_VERTEX);
+    types::UInt usedVerticesCount = 0;
+    for (auto index : indices)
+    {
+        if (remap[index] == NO_VERTEX)
+        {
+            remap[index] = usedVerticesCount++;
+        }
+    }
+    return usedVerticesCount;
+}
+
+void MeshOptimizer::remapVertices(std::span<std::byte> vertices,
+                                  size_t stride,
+                                  std::span<types::UInt const> remap)
+{
+    std::vector<std::byte> copy(vertices.begin(), vertices.end());
+    for (size_t vertex = 0; vertex < remap.size(); vertex++)
+    {
+        if (remap[vertex] != NO_VERTEX)
+        {
+            std::memcpy(vertices.data() + remap[vertex] * stride,
+                        copy.data() + vertex * stride,
+                        stride);
+        }
+    }
+}
+
+void MeshOptimizer::remapIndices(std::span<types::UInt> indices,
+                                 std::span<types::UInt const> remap)
+{
+    for (auto &index : indices)
+    {
+        index = remap[index];
+    }
+}
+
+MeshOptimizer::Statistics MeshOptimizer::analyze(std::span<types::UInt const> indices,
+                                                 size_t verticesCount)
+{
+    if (indices.empty())
+    {
+        return {};
+    }
+
+    FifoCache cache(verticesCount, STATISTICS_CACHE_SIZE);
+    std::vector<bool> isUsed(verticesCount, false);
+    size_t misses = 0;
+    size_t usedVerticesCount = 0;
+
+    for (auto index : indices)
+    {
+        misses += cache.access(index) ? 1 : 0;
+        if (!isUsed[index])
+        {
+            isUsed[index] = true;
+            usedVerticesCount++;
+        }
+    }
+
+    return {
+        .acmr = static_cast<types::Float>(misses) / static_cast<types::Float>(indices.size() / 3),
+        .atvr = static_cast<types::Float>(misses) / static_cast<types::Float>(usedVerticesCount),
+    };
+}
+
+std::vector<types::FVec3> MeshOptimizer::extractPositions(std::span<std::byte const> vertices,
+                                                          size_t stride,
+                                                          size_t positionOffset)
+{
+    std::vector<types::FVec3> positions(vertices.size() / stride);
+    for (size_t vertex = 0; vertex < positions.size(); vertex++)
+    {
+        std::memcpy(&positions[vertex],
+                    vertices.data() + vertex * stride + positionOffset,
+                    sizeof(types::FVec3));
+    }
+    return positions;
+}
+
+} // namespace pf::gl
@@ -0,0 +1,442 @@
+#include <pf_gl/MeshSimplifier.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+#include <glm/glm.hpp>
+#include <gsl/util>
+
+#include <pf_gl/ValueTypes.hpp>
+
+namespace pf::gl
+{
+
+MeshSimplifier::MeshSimplifier(std::span<types::FVec3 const> positions,
+                               std::span<types::UInt const> indices)
+    : _positions(positions)
+    , _indices(indices)
+{
+    if (indices.size() % 3 != 0)
+    {
+        throw std::invalid_argument(
+            fmt::format("Indices count ({}) is not a multiple of three.", indices.size()));
+    }
+    for (auto index : indices)
+    {
+        if (index >= positions.size())
+        {
+            throw std::out_of_range(fmt::format(
+                "Index {} is out of range, there are {} vertices.", index, positions.size()));
+        }
+    }
+
+    // Vertices with equal positions end up next to each other, the first one of them represents
+    // the whole group
+    std::vector<types::UInt> sortedVertices(positions.size());
+    std::iota(sortedVertices.begin(), sortedVertices.end(), 0);
+    std::sort(sortedVertices.begin(),
+              sortedVertices.end(),
+              [positions](types::UInt first, types::UInt second)
+              {
+                  auto const &a = positions[first];
+                  auto const &b = positions[second];
+                  if (a.x != b.x)
+                  {
+                      return a.x < b.x;
+                  }
+                  if (a.y != b.y)
+                  {
+                      return a.y < b.y;
+                  }
+                  if (a.z != b.z)
+                  {
+                      return a.z < b.z;
+                  }
+                  return first < second;
+              });
+
+    _positionIds.resize(positions.size());
+    for (size_t i = 0; i < sortedVertices.size(); i++)
+    {
+        bool samePosition =
+            i > 0 && positions[sortedVertices[i]] == positions[sortedVertices[i - 1]];
+        _positionIds[sortedVertices[i]] =
+            samePosition ? _positionIds[sortedVertices[i - 1]] : sortedVertices[i];
+    }
+
+    classifyVertices();
+    computeQuadrics();
+}
+
+MeshSimplifier::Result
+MeshSimplifier::simplify(size_t targetIndicesCount, types::Float maxError, Seams seams) const
+{
+    std::vector<types::UInt> indices(_indices.begin(), _indices.end());
+    std::vector<Quadric> quadrics = _quadrics;
+
+    auto maxSquaredError = static_cast<double>(maxError) * static_cast<double>(maxError);
+    double resultSquaredError = 0.0;
+
+    std::vector<std::vector<types::UInt>> positionTriangles(_positions.size());
+    std::vector<Collapse> collapses;
+    std::vector<types::UInt> remap(_positions.size());
+    std::vector<bool> touched(_positions.size());
+
+    // Every pass collapses as many of the cheapest edges as possible, an edge is skipped in case
+    // any of the triangles around it have already been changed during the pass
+    while (indices.size() > targetIndicesCount)
+    {
+        for (auto &triangles : positionTriangles)
+        {
+            triangles.clear();
+        }
+        collapses.clear();
+
+        size_t trianglesCount = indices.size() / 3;
+        for (size_t triangle = 0; triangle < trianglesCount; triangle++)
+        {
+            for (size_t corner = 0; corner < 3; corner++)
+            {
+                types::UInt from = _positionIds[indices[triangle * 3 + corner]];
+                types::UInt to = _positionIds[indices[triangle * 3 + (corner + 1) % 3]];
+                positionTriangles[from].push_back(gsl::narrow_cast<types::UInt>(triangle));
+                if (from == to)
+                {
+                    continue;
+                }
+
+                for (auto [a, b] : {std::pair(from, to), std::pair(to, from)})
+                {
+                    if (_kinds[a] == BORDER || (_kinds[a] == COMPLEX && seams == KEEP_SEAMS))
+                    {
+                        continue;
+                    }
+                    Collapse collapse = {.from = a, .to = b, .error = 0.0};
+                    Quadric quadric = quadrics[a];
+                    quadric.add(quadrics[b]);
+                    collapse.error = quadric.error(_positions[b]);
+                    collapses.push_back(collapse);
+                }
+            }
+        }
+        std::sort(collapses.begin(),
+                  collapses.end(),
+                  [](Collapse const &first, Collapse const &second)
+                  { return first.error < second.error; });
+
+        std::iota(remap.begin(), remap.end(), 0);
+        std::fill(touched.begin(), touched.end(), false);
+        size_t removedTrianglesCount = 0;
+        size_t collapsesCount = 0;
+
+        for (auto const &collapse : collapses)
+        {
+            if ((trianglesCount - removedTrianglesCount) * 3 <= targetIndicesCount ||
+                collapse.error > maxSquaredError)
+            {
+                break;
+            }
+            if (touched[collapse.from] || touched[collapse.to] ||
+                flipsTriangles(collapse.from, collapse.to, indices, positionTriangles) ||
+                !remapWedges(
+                    collapse.from, collapse.to, seams, indices, positionTriangles, remap))
+            {
+                continue;
+            }
+
+            // Neighbours stay in place until the end of the pass, so that the flip test above
+            // remains valid
+            for (auto triangle : positionTriangles[collapse.from])
+            {
+                for (size_t corner = 0; corner < 3; corner++)
+                {
+                    types::UInt positionId = _positionIds[indices[triangle * 3 + corner]];
+                    removedTrianglesCount += positionId == collapse.to ? 1 : 0;
+                    touched[positionId] = true;
+                }
+            }
+
+            quadrics[collapse.to].add(quadrics[collapse.from]);
+            resultSquaredError = std::max(resultSquaredError, collapse.error);
+            collapsesCount++;
+        }
+
+        if (collapsesCount == 0)
+        {
+            break;
+        }
+
+        // Triangles around the collapsed edges become degenerate and are removed
+        size_t writtenIndicesCount = 0;
+        for (size_t triangle = 0; triangle < trianglesCount; triangle++)
+        {
+            types::UInt a = remap[indices[triangle * 3 + 0]];
+            types::UInt b = remap[indices[triangle * 3 + 1]];
+            types::UInt c = remap[indices[triangle * 3 + 2]];
+            if (_positionIds[a] == _positionIds[b] || _positionIds[b] == _positionIds[c] ||
+                _positionIds[c] == _positionIds[a])
+            {
+                continue;
+            }
+            indices[writtenIndicesCount++] = a;
+            indices[writtenIndicesCount++] = b;
+            indices[writtenIndicesCount++] = c;
+        }
+        indices.resize(writtenIndicesCount);
+    }
+
+    return {
+        .indices = std::move(indices),
+        .error = static_cast<types::Float>(std::sqrt(resultSquaredError)),
+    };
+}
+
+void MeshSimplifier::classifyVertices()
+{
+    // Edges which do not have exactly two triangles around them are the borders of the mesh
+    std::vector<std::pair<types::UInt, types::UInt>> edges;
+    edges.reserve(_indices.size());
+    for (size_t i = 0; i < _indices.size(); i += 3)
+    {
+        for (size_t corner = 0; corner < 3; corner++)
+        {
+            types::UInt a = _positionIds[_indices[i + corner]];
+            types::UInt b = _positionIds[_indices[i + (corner + 1) % 3]];
+            edges.emplace_back(std::min(a, b), std::max(a, b));
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+
+    std::vector<bool> isBorder(_positions.size(), false);
+    for (size_t first = 0; first < edges.size();)
+    {
+        size_t last = first;
+        while (last < edges.size() && edges[last] == edges[first])
+        {
+            last++;
+        }
+        if (last - first != 2)
+        {
+            isBorder[edges[first].first] = true;
+            isBorder[edges[first].second] = true;
+        }
+        first = last;
+    }
+
+    // Different vertices with the same position are the wedges of a seam
+    std::vector<bool> isReferenced(_positions.size(), false);
+    std::vector<types::UInt> wedgesCounts(_positions.size(), 0);
+    for (auto index : _indices)
+    {
+        if (!isReferenced[index])
+        {
+            isReferenced[index] = true;
+            wedgesCounts[_positionIds[index]]++;
+        }
+    }
+
+    _kinds.resize(_positions.size());
+    for (size_t vertex = 0; vertex < _positions.size(); vertex++)
+    {
+        auto positionId = _positionIds[vertex];
+        if (isBorder[positionId])
+        {
+            _kinds[vertex] = BORDER;
+        }
+        else if (wedgesCounts[positionId] > 2)
+        {
+            _kinds[vertex] = COMPLEX;
+        }
+        else
+        {
+            _kinds[vertex] = wedgesCounts[positionId] == 2 ? SEAM : MANIFOLD;
+        }
+    }
+}
+
+void MeshSimplifier::computeQuadrics()
+{
+    _quadrics.resize(_positions.size());
+    for (size_t i = 0; i < _indices.size(); i += 3)
+    {
+        types::FVec3 const &a = _positions[_indices[i + 0]];
+        types::FVec3 const &b = _positions[_indices[i + 1]];
+        types::FVec3 const &c = _positions[_indices[i + 2]];
+
+        types::FVec3 normal = glm::cross(b - a, c - a);
+        auto length = glm::length(normal);
+        if (length == 0.0F)
+        {
+            continue;
+        }
+        normal /= length;
+
+        // Plane equation: n.x * x + n.y * y + n.z * z + d = 0, weighted by the triangle area
+        double area = 0.5 * length;
+        double x = normal.x, y = normal.y, z = normal.z;
+        double d = -glm::dot(normal, a);
+        Quadric plane = {
+            .a2 = area * x * x, .ab = area * x * y, .ac = area * x * z, .ad = area * x * d,
+            .b2 = area * y * y, .bc = area * y * z, .bd = area * y * d,
+            .c2 = area * z * z, .cd = area * z * d,
+            .d2 = area * d * d,
+            .weight = area,
+        };
+
+        for (size_t corner = 0; corner < 3; corner++)
+        {
+            _quadrics[_positionIds[_indices[i + corner]]].add(plane);
+        }
+    }
+}
+
+bool MeshSimplifier::remapWedges(types::UInt from,
+                                 types::UInt to,
+                                 Seams seams,
+                                 std::vector<types::UInt> const &indices,
+                                 std::vector<std::vector<types::UInt>> const &positionTriangles,
+                                 std::vector<types::UInt> &remap) const
+{
+    // Pairs of a wedge and the vertex it is moved into, the wedge itself until it is found
+    std::vector<std::pair<types::UInt, types::UInt>> wedges;
+    std::optional<types::UInt> anyTarget;
+
+    for (auto triangle : positionTriangles[from])
+    {
+        types::UInt wedge = 0;
+        std::optional<types::UInt> target;
+        for (size_t corner = 0; corner < 3; corner++)
+        {
+            types::UInt vertex = indices[triangle * 3 + corner];
+            if (_positionIds[vertex] == from)
+            {
+                wedge = vertex;
+            }
+            else if (_positionIds[vertex] == to)
+            {
+                target = vertex;
+            }
+        }
+
+        auto found = std::find_if(wedges.begin(),
+                                  wedges.end(),
+                                  [wedge](auto const &entry) { return entry.first == wedge; });
+        if (found == wedges.end())
+        {
+            wedges.emplace_back(wedge, wedge);
+            found = wedges.end() - 1;
+        }
+
+        if (target.has_value())
+        {
+            anyTarget = anyTarget.has_value() ? anyTarget : target;
+            if (found->second == wedge)
+            {
+                found->second = *target;
+            }
+            // The edge separates two UV-islands of the `to` position, but not of the `from` one
+            else if (found->second != *target && seams == KEEP_SEAMS)
+            {
+                return false;
+            }
+        }
+    }
+
+    for (auto &[wedge, target] : wedges)
+    {
+        if (target != wedge)
+        {
+            continue;
+        }
+        // The wedge does not touch the edge, its attributes are replaced with the ones of the
+        // other side of the seam
+        if (seams == KEEP_SEAMS || !anyTarget.has_value())
+        {
+            return false;
+        }
+        target = *anyTarget;
+    }
+
+    // Two sides of a seam must not be glued together
+    if (seams == KEEP_SEAMS && wedges.size() == 2 && wedges[0].second == wedges[1].second)
+    {
+        return false;
+    }
+
+    for (auto const &[wedge, target] : wedges)
+    {
+        remap[wedge] = target;
+    }
+    return true;
+}
+
+bool MeshSimplifier::flipsTriangles(
+    types::UInt from,
+    types::UInt to,
+    std::vector<types::UInt> const &indices,
+    std::vector<std::vector<types::UInt>> const &positionTriangles) const
+{
+    for (auto triangle : positionTriangles[from])
+    {
+        std::array<types::FVec3, 3> corners{};
+        std::array<types::FVec3, 3> movedCorners{};
+        bool isRemoved = false;
+
+        for (size_t corner = 0; corner < 3; corner++)
+        {
+            types::UInt positionId = _positionIds[indices[triangle * 3 + corner]];
+            isRemoved = isRemoved || positionId == to;
+            corners[corner] = _positions[positionId];
+            movedCorners[corner] = positionId == from ? _positions[to] : corners[corner];
+        }
+        if (isRemoved)
+        {
+            continue;
+        }
+
+        types::FVec3 normal = glm::cross(corners[1] - corners[0], corners[2] - corners[0]);
+        types::FVec3 movedNormal =
+            glm::cross(movedCorners[1] - movedCorners[0], movedCorners[2] - movedCorners[0]);
+        // Sharp turns are rejected as well, otherwise a triangle could flip over several passes
+        if (glm::dot(normal, movedNormal) <=
+            0.25F * glm::length(normal) * glm::length(movedNormal))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void MeshSimplifier::Quadric::add(Quadric const &other)
+{
+    a2 += other.a2;
+    ab += other.ab;
+    ac += other.ac;
+    ad += other.ad;
+    b2 += other.b2;
+    bc += other.bc;
+    bd += other.bd;
+    c2 += other.c2;
+    cd += other.cd;
+    d2 += other.d2;
+    weight += other.weight;
+}
+
+double MeshSimplifier::Quadric::error(types::FVec3 const &point) const
+{
+    double x = point.x, y = point.y, z = point.z;
+    double result = a2 * x * x + 2.0 * ab * x * y + 2.0 * ac * x * z + 2.0 * ad * x + b2 * y * y +
+                    2.0 * bc * y * z + 2.0 * bd * y + c2 * z * z + 2.0 * cd * z + d2;
+    return weight > 0.0 ? std::max(result / weight, 0.0) : 0.0;
+}
+
+} // namespace pf::gl
@@ -10,6 +10,8 @@
 #include <glm/ext/matrix_clip_space.hpp>
 #include <glad/glad.h>
 
+#include <pf_gl/BoundingVolumes.hpp>
+#include <pf_gl/Frustum.hpp>
 #include <pf_gl/ValueTypes.hpp>
 #include <pf_utils/VectorMath.hpp>
 
@@ -146,6 +148,24 @@ types::FMat4 const &MinecraftCamera::projectionMatrix() const
     return _projectionMatrix;
 }
 
+types::FMat4 MinecraftCamera::viewProjectionMatrix() const
+{
+    return _projectionMatrix * _viewMatrix;
+}
+
+Frustum MinecraftCamera::frustum() const
+{
+    return Frustum(viewProjectionMatrix());
+}
+
+Ray MinecraftCamera::ray() const
+{
+    // The camera looks along the negative Z axis of the view space, the third row of the view
+    // matrix is that axis expressed in the world space.
+    types::FVec3 forward = -types::FVec3(_viewMatrix[0][2], _viewMatrix[1][2], _viewMatrix[2][2]);
+    return {.origin = _position, .direction = glm::normalize(forward)};
+}
+
 void MinecraftCamera::move(types::FVec3 const &movementInput, types::Float deltaTime)
 {
     if (glm::length(movementInput) != 0.0F)
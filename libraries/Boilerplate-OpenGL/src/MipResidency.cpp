@@ -0,0 +1,223 @@
+#include <pf_gl/MipResidency.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <pf_gl/ValueTypes.hpp>
+
+namespace pf::gl
+{
+
+MipResidency::MipResidency(types::BinarySize budget, types::BinarySize uploadBudget)
+    : _budget(budget)
+    , _uploadBudget(uploadBudget)
+{
+}
+
+types::Size
+MipResidency::levelFor(types::Size textureSize, types::Float screenSize, types::Size levelsCount)
+{
+    if (screenSize <= 0.0F || textureSize <= 0)
+    {
+        return levelsCount - 1;
+    }
+
+    // Rounded down, so that the level is never smaller than the screen size
+    types::Float level = std::floor(std::log2(static_cast<types::Float>(textureSize) / screenSize));
+    return std::clamp(static_cast<types::Size>(level), 0, levelsCount - 1);
+}
+
+types::UInt MipResidency::add(std::vector<types::BinarySize> levelSizes,
+                              types::Size alwaysResidentLevel)
+{
+    if (alwaysResidentLevel < 0 || static_cast<size_t>(alwaysResidentLevel) >= levelSizes.size())
+    {
+        throw std::invalid_argument(fmt::format("Level {} is out of the range of the {} levels.",
+                                                alwaysResidentLevel,
+                                                levelSizes.size()));
+    }
+
+    types::UInt id = _nextId++;
+    _textures.emplace(id,
+                      Texture{
+                          .levelSizes = std::move(levelSizes),
+                          .alwaysResidentLevel = alwaysResidentLevel,
+                          .baseLevel = alwaysResidentLevel,
+                          .requestedLevel = alwaysResidentLevel,
+                      });
+    return id;
+}
+
+void MipResidency::remove(types::UInt id)
+{
+    Texture const &texture = _textures.at(id);
+    _residentBytes -= std::accumulate(texture.levelSizes.begin() + texture.baseLevel,
+                                      texture.levelSizes.begin() + texture.alwaysResidentLevel,
+                                      types::BinarySize(0));
+    _textures.erase(id);
+}
+
+void MipResidency::request(types::UInt id, types::Size level)
+{
+    Texture &texture = _textures.at(id);
+    level = std::clamp(level, 0, texture.alwaysResidentLevel);
+
+    if (texture.lastUse != _currentUse)
+    {
+        texture.lastUse = _currentUse;
+        texture.requestedLevel = level;
+    }
+    else
+    {
+        texture.requestedLevel = std::min(texture.requestedLevel, level);
+    }
+}
+
+std::vector<MipResidency::Change> MipResidency::update()
+{
+    // Previous base levels of the textures which have changed
+    std::unordered_map<types::UInt, types::Size> changes;
+
+    // The budget might have been lowered since the last update
+    makeRoom(0, changes);
+
+    std::vector<types::UInt> requested;
+    for (auto const &[id, texture] : _textures)
+    {
+        if (texture.lastUse == _currentUse && texture.baseLevel > texture.requestedLevel)
+        {
+            requested.push_back(id);
+        }
+    }
+    std::sort(requested.begin(), requested.end());
+
+    // A level at a time for each texture, so that all of them get sharper at the same pace
+    types::BinarySize uploadedBytes = 0;
+    bool loaded = true;
+    while (loaded)
+    {
+        loaded = false;
+        for (auto id : requested)
+        {
+            Texture &texture = _textures.at(id);
+            if (texture.baseLevel <= texture.requestedLevel)
+            {
+                continue;
+            }
+
+            types::BinarySize levelSize = texture.levelSizes[texture.baseLevel - 1];
+            if (uploadedBytes > 0 && uploadedBytes + levelSize > _uploadBudget)
+            {
+                loaded = false;
+                break;
+            }
+            if (!makeRoom(levelSize, changes))
+            {
+                continue;
+            }
+
+            changes.try_emplace(id, texture.baseLevel);
+            texture.baseLevel--;
+            _residentBytes += levelSize;
+            uploadedBytes += levelSize;
+            loaded = true;
+        }
+    }
+
+    std::vector<Change> result;
+    for (auto const &[id, previousBaseLevel] : changes)
+    {
+        types::Size baseLevel = _textures.at(id).baseLevel;
+        if (baseLevel != previousBaseLevel)
+        {
+            result.push_back(
+                {.id = id, .previousBaseLevel = previousBaseLevel, .baseLevel = baseLevel});
+        }
+    }
+    std::sort(result.begin(),
+              result.end(),
+              [](Change const &first, Change const &second) { return first.id < second.id; });
+
+    _currentUse++;
+    return result;
+}
+
+bool MipResidency::makeRoom(types::BinarySize bytes,
+                            std::unordered_map<types::UInt, types::Size> &changes)
+{
+    if (_residentBytes + bytes <= _budget)
+    {
+        return true;
+    }
+
+    std::vector<types::UInt> leastRecentlyUsed;
+    for (auto const &[id, texture] : _textures)
+    {
+        leastRecentlyUsed.push_back(id);
+    }
+    std::sort(leastRecentlyUsed.begin(),
+              leastRecentlyUsed.end(),
+              [this](types::UInt first, types::UInt second)
+              {
+                  auto firstUse = _textures.at(first).lastUse;
+                  auto secondUse = _textures.at(second).lastUse;
+                  return firstUse != secondUse ? firstUse < secondUse : first < second;
+              });
+
+    for (auto id : leastRecentlyUsed)
+    {
+        Texture &texture = _textures.at(id);
+
+        // Textures requested in this update only give up the levels larger than requested
+        types::Size evictableLevel = texture.lastUse == _currentUse ? texture.requestedLevel
+                                                                    : texture.alwaysResidentLevel;
+        while (texture.baseLevel < evictableLevel && _residentBytes + bytes > _budget)
+        {
+            changes.try_emplace(id, texture.baseLevel);
+            _residentBytes -= texture.levelSizes[texture.baseLevel];
+            texture.baseLevel++;
+        }
+        if (_residentBytes + bytes <= _budget)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void MipResidency::budget(types::BinarySize budget)
+{
+    _budget = budget;
+}
+
+types::BinarySize MipResidency::budget() const
+{
+    return _budget;
+}
+
+types::Size MipResidency::baseLevel(types::UInt id) const
+{
+    return _textures.at(id).baseLevel;
+}
+
+types::BinarySize MipResidency::residentBytes(types::UInt id) const
+{
+    Texture const &texture = _textures.at(id);
+    return std::accumulate(texture.levelSizes.begin() + texture.baseLevel,
+                           texture.levelSizes.end(),
+                           types::BinarySize(0));
+}
+
+types::BinarySize MipResidency::residentBytes() const
+{
+    return _residentBytes;
+}
+
+} // namespace pf::gl
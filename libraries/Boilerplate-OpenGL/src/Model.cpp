@@ -1,31 +1,33 @@
-#include <map>
-#include <numeric>
 #include <pf_gl/Model.hpp>
 
-#include <stdexcept>
+#include <cstddef>
 #include <utility>
 #include <memory>
-#include <sstream>
 #include <algorithm>
 #include <filesystem>
 
-#include <assimp/Importer.hpp>
-#include <assimp/scene.h>
-#include <assimp/mesh.h>
-#include <assimp/postprocess.h>
-#include <assimp/material.h>
-#include <assimp/types.h>
 #include <glad/glad.h>
-#include <fmt/format.h>
+#include <glm/glm.hpp>
 
+#include <pf_gl/BoundingVolumes.hpp>
 #include <pf_gl/Mesh.hpp>
 #include <pf_gl/Texture.hpp>
+#include <pf_gl/TextureArray.hpp>
+#include <pf_gl/TextureFile.hpp>
+#include <pf_gl/TextureLoader.hpp>
+#include <pf_gl/TextureStreamer.hpp>
 #include <pf_gl/RenderingOptions.hpp>
 #include <pf_gl/Window.hpp>
 #include <pf_gl/Transform3D.hpp>
 #include <pf_gl/ValueTypes.hpp>
 #include <pf_gl/DrawingContext3D.hpp>
 #include <pf_gl/Material.hpp>
+#include <pf_gl/OcclusionQuery.hpp>
+#include <pf_gl/MeshData.hpp>
+#include <pf_gl/MeshFile.hpp>
+#include <pf_gl/MeshOptimizer.hpp>
+#include <pf_gl/ModelImporter.hpp>
+#include <pf_gl/EulerTransform3D.hpp>
 
 namespace pf::gl
 {
@@ -33,12 +35,20 @@ namespace pf::gl
 Model::Model(std::shared_ptr<Window> window,
              std::filesystem::path const &path,
              std::unique_ptr<Transform3D> &&transform,
-             Material const &material)
+             Material const &material,
+             Mesh::VertexCompression vertexCompression,
+             std::shared_ptr<TextureLoader> textureLoader,
+             std::shared_ptr<TextureStreamer> textureStreamer,
+             bool diffuseTextureArrays)
     : _window(std::move(window))
+    , _textureLoader(std::move(textureLoader))
+    , _textureStreamer(std::move(textureStreamer))
     , _transform(std::move(transform))
     , _material(material)
+    , _vertexCompression(vertexCompression)
 {
-    loadModel(path);
+    loadModel(path, diffuseTextureArrays);
+    computeBoundingBox();
 }
 
 Model::Model(std::shared_ptr<Window> window,
@@ -50,205 +60,406 @@ Model::Model(std::shared_ptr<Window> window,
     , _meshes(std::move(meshes))
     , _material(material)
 {
+    computeBoundingBox();
+    collectTextureArrays();
 }
 
 void Model::render(Shader &shader, DrawingContext3D const &drawingContext) const
 {
-    for (auto const &mesh : _meshes)
+    selectLevelsOfDetail(drawingContext);
+
+    if (_occlusionQuery == nullptr)
+    {
+        renderMeshes(shader, drawingContext);
+        return;
+    }
+
+    _occlusionQuery->pollResult();
+
+    // The previous query is still in flight, stick to the last known visibility
+    if (_occlusionQuery->isPending())
+    {
+        if (_occlusionQuery->anySamplesPassed())
+        {
+            renderMeshes(shader, drawingContext);
+        }
+        else
+        {
+            _occlusionQuery->beginConditionalRender(OcclusionQuery::NO_WAIT);
+            renderMeshes(shader, drawingContext);
+            _occlusionQuery->endConditionalRender();
+        }
+        return;
+    }
+
+    if (_occlusionQuery->anySamplesPassed())
+    {
+        _occlusionQuery->begin();
+        renderMeshes(shader, drawingContext);
+        _occlusionQuery->end();
+    }
+    else
     {
-        mesh->render(shader, drawingContext, *_transform, _material);
+        _occlusionQuery->begin();
+        renderBoundingBox(shader, drawingContext);
+        _occlusionQuery->end();
+
+        // The GPU waits for the query issued just above, the CPU does not
+        _occlusionQuery->beginConditionalRender(OcclusionQuery::WAIT);
+        renderMeshes(shader, drawingContext);
+        _occlusionQuery->endConditionalRender();
     }
 }
 
-void Model::transform(std::unique_ptr<Transform3D> &&transform)
+void Model::renderPositions(Shader &shader, DrawingContext3D const &drawingContext) const
 {
-    _transform = std::move(transform);
+    selectLevelsOfDetail(drawingContext);
+    for (size_t i = 0; i < _meshes.size(); i++)
+    {
+        _meshes[i]->renderPositions(shader, drawingContext, *_transform, _levelsOfDetail[i]);
+    }
 }
 
-Transform3D const &Model::transform() const
+void Model::renderMeshes(Shader &shader, DrawingContext3D const &drawingContext) const
 {
-    return *_transform;
+    for (size_t i = 0; i < _meshes.size(); i++)
+    {
+        _meshes[i]->render(shader, drawingContext, *_transform, _material, _levelsOfDetail[i]);
+    }
 }
 
-
-void Model::loadModel(std::filesystem::path const &modelPath)
+void Model::selectLevelsOfDetail(DrawingContext3D const &drawingContext) const
 {
-    Assimp::Importer importer;
-    aiScene const *scene =
-        importer.ReadFile(modelPath.string(), aiProcess_Triangulate | aiProcess_FlipUVs);
+    _levelsOfDetail.resize(_meshes.size(), 0);
 
-    if (scene == nullptr || (scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE) != 0U ||
-        scene->mRootNode == nullptr)
+    if (!drawingContext.camera.has_value() || !drawingContext.viewportSize.has_value() ||
+        _maxScreenSpaceError <= 0.0F || _boundingBox.isEmpty())
     {
-        throw std::runtime_error(
-            fmt::format("Error while loading model using assimp ({}).", importer.GetErrorString()));
+        std::fill(_levelsOfDetail.begin(), _levelsOfDetail.end(), 0);
+        return;
+    }
+
+    // Errors are measured from the closest point of the bounding sphere, so that they are never
+    // underestimated
+    BoundingSphere sphere = worldBoundingSphere();
+    types::Float distance = glm::length(drawingContext.camera->position() - sphere.center);
+    distance = std::max(distance - sphere.radius, MIN_LEVEL_OF_DETAIL_DISTANCE);
+
+    types::FVec3 scale = glm::abs(_transform->scale());
+    types::Float maxScale = std::max({scale.x, scale.y, scale.z});
+
+    // Size of a unit at the given distance in pixels: the projection matrix scales Y by the
+    // cotangent of the half of the vertical field of view
+    types::Float pixelsPerUnit = drawingContext.camera->projectionMatrix()[1][1] *
+                                 drawingContext.viewportSize->y / (2.0F * distance);
+
+    for (size_t i = 0; i < _meshes.size(); i++)
+    {
+        Mesh const &mesh = *_meshes[i];
+        auto screenSpaceError = [&mesh, maxScale, pixelsPerUnit](types::Size levelOfDetail)
+        { return mesh.error(levelOfDetail) * maxScale * pixelsPerUnit; };
+
+        types::Size &levelOfDetail = _levelsOfDetail[i];
+        levelOfDetail = std::min(levelOfDetail, mesh.levelsOfDetailCount() - 1);
+
+        while (levelOfDetail > 0 && screenSpaceError(levelOfDetail) > _maxScreenSpaceError)
+        {
+            levelOfDetail--;
+        }
+        while (levelOfDetail + 1 < mesh.levelsOfDetailCount() &&
+               screenSpaceError(levelOfDetail + 1) <=
+                   _maxScreenSpaceError * (1.0F - LEVEL_OF_DETAIL_HYSTERESIS))
+        {
+            levelOfDetail++;
+        }
     }
-    processNode(scene->mRootNode, scene, modelPath);
 }
 
-void Model::processNode(aiNode *node, aiScene const *scene, std::filesystem::path const &modelPath)
+void Model::requestTextureLevels(types::Float screenSize) const
 {
-    if (node == nullptr)
+    if (_textureStreamer == nullptr)
     {
-        throw std::invalid_argument("Nullptr passed as a node pointer");
+        return;
     }
-    if (scene == nullptr)
+    for (auto const &texture : _loadedTextures)
     {
-        throw std::invalid_argument("Nullptr passed as a scene pointer");
+        _textureStreamer->request(*texture, screenSize);
     }
+}
 
-    if (node->mMeshes != nullptr)
+void Model::renderBoundingBox(Shader &shader, DrawingContext3D const &drawingContext) const
+{
+    if (_boundingBox.isEmpty())
     {
-        for (types::UInt meshNodeIndex = 0; meshNodeIndex < node->mNumMeshes; meshNodeIndex++)
-        {
-            types::UInt meshSceneIndex = node->mMeshes[meshNodeIndex];
-
-            if (meshSceneIndex >= scene->mNumMeshes)
-            {
-                throw std::logic_error("A node points to the mesh with an invalid index.");
-            }
-
-            aiMesh *assimpMesh = scene->mMeshes[meshSceneIndex];
-            auto mesh = processMesh(assimpMesh, scene, modelPath);
-            if (mesh != nullptr)
-            {
-                _meshes.emplace_back(std::move(mesh));
-            }
-        }
+        return;
     }
 
-    if (node->mChildren != nullptr)
+    // The mesh is a unit cube centered at the origin
+    std::unique_ptr<Transform3D> boxTransform =
+        _transform->combine(*EulerTransform3D::Builder()
+                                 .withShift(_boundingBox.center())
+                                 .withScale(2.0F * _boundingBox.extents())
+                                 .build());
+
+    _window->bindContext();
+
+    // After a depth pre-pass the depth test only passes for the exact depth of the surfaces, the
+    // box is in front of them, so its own test is relaxed
+    GLint depthFunction = GL_LESS;
+    GLboolean depthMask = GL_TRUE;
+    glGetIntegerv(GL_DEPTH_FUNC, &depthFunction);
+    glGetBooleanv(GL_DEPTH_WRITEMASK, &depthMask);
+
+    glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+    glDepthMask(GL_FALSE);
+    glDepthFunc(GL_LEQUAL);
+
+    _boundingBoxMesh->render(shader, drawingContext, *boxTransform, _material);
+
+    glDepthFunc(static_cast<GLenum>(depthFunction));
+    glDepthMask(depthMask);
+    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+}
+
+void Model::transform(std::unique_ptr<Transform3D> &&transform)
+{
+    _transform = std::move(transform);
+}
+
+Transform3D const &Model::transform() const
+{
+    return *_transform;
+}
+
+std::vector<std::shared_ptr<Mesh>> const &Model::meshes() const
+{
+    return _meshes;
+}
+
+std::vector<std::shared_ptr<TextureArray>> const &Model::textureArrays() const
+{
+    return _textureArrays;
+}
+
+void Model::occlusionCulling(bool enabled)
+{
+    if (!enabled)
+    {
+        _occlusionQuery.reset();
+        return;
+    }
+    if (_occlusionQuery != nullptr)
     {
-        for (unsigned int childIndex = 0; childIndex < node->mNumChildren; childIndex++)
+        return;
+    }
+
+    _occlusionQuery = std::make_unique<OcclusionQuery>(_window);
+
+    if (_boundingBoxMesh == nullptr)
+    {
+        std::vector<Mesh::SimpleVertex> vertices;
+        for (types::UInt corner = 0; corner < 8; corner++)
         {
-            processNode(node->mChildren[childIndex], scene, modelPath);
+            vertices.push_back({
+                .position = types::FVec3((corner & 1U) != 0 ? 0.5F : -0.5F,
+                                         (corner & 2U) != 0 ? 0.5F : -0.5F,
+                                         (corner & 4U) != 0 ? 0.5F : -0.5F),
+                .normal = types::DEFAULT_VALUE<types::FVec3>,
+                .textureCoordinates = types::DEFAULT_VALUE<types::FVec2>,
+            });
         }
+
+        // Counter-clockwise when looking from the outside, bits of the index are the X, Y, Z sides
+        std::vector<types::UInt> indices = {
+            0, 2, 3, 0, 3, 1, 4, 5, 7, 4, 7, 6, 0, 1, 5, 0, 5, 4,
+            2, 6, 7, 2, 7, 3, 0, 4, 6, 0, 6, 2, 1, 3, 7, 1, 7, 5,
+        };
+
+        _boundingBoxMesh = std::make_shared<Mesh>(
+            _window, vertices, indices, std::vector<std::shared_ptr<Texture>>(), STATIC_DRAW);
     }
 }
 
-std::unique_ptr<Mesh>
-Model::processMesh(aiMesh *mesh, aiScene const *scene, std::filesystem::path const &modelPath)
+bool Model::occlusionCulling() const
+{
+    return _occlusionQuery != nullptr;
+}
+
+void Model::maxScreenSpaceError(types::Float pixels)
+{
+    _maxScreenSpaceError = pixels;
+}
+
+types::Float Model::maxScreenSpaceError() const
+{
+    return _maxScreenSpaceError;
+}
+
+std::vector<MeshOptimizer::Report> const &Model::optimizationReports() const
 {
-    if (mesh == nullptr)
+    return _optimizationReports;
+}
+
+types::Size Model::trianglesCount() const
+{
+    types::Size trianglesCount = 0;
+    for (size_t i = 0; i < _meshes.size(); i++)
     {
-        throw std::invalid_argument("Nullptr passed as a pointer to mesh.");
+        trianglesCount +=
+            _meshes[i]->trianglesCount(i < _levelsOfDetail.size() ? _levelsOfDetail[i] : 0);
     }
-    if (scene == nullptr)
+    return trianglesCount;
+}
+
+types::BinarySize Model::sizeInBytes() const
+{
+    types::BinarySize sizeInBytes = 0;
+    for (auto const &mesh : _meshes)
     {
-        throw std::invalid_argument("Nullptr passed as a pointer to scene.");
+        sizeInBytes += mesh->sizeInBytes();
     }
+    return sizeInBytes;
+}
 
-    std::vector<Mesh::SimpleVertex> vertices;
-    std::vector<GLuint> indices;
-    std::vector<std::shared_ptr<Texture>> textures;
+BoundingBox const &Model::boundingBox() const
+{
+    return _boundingBox;
+}
 
-    if (mesh->mVertices == nullptr || mesh->mNumVertices == 0)
+BoundingBox Model::worldBoundingBox() const
+{
+    return _boundingBox.transform(_transform->localToWorldMatrix());
+}
+
+BoundingSphere Model::worldBoundingSphere() const
+{
+    if (_boundingBox.isEmpty())
     {
-        return nullptr;
+        return {.center = _transform->shift(), .radius = 0.0F};
     }
 
-    for (types::UInt vertexIndex = 0; vertexIndex < mesh->mNumVertices; vertexIndex++)
-    {
-        Mesh::SimpleVertex vertex{};
-        vertex.position = types::FVec3(mesh->mVertices[vertexIndex].x,
-                                       mesh->mVertices[vertexIndex].y,
-                                       mesh->mVertices[vertexIndex].z);
-
-        vertex.normal = mesh->mNormals != nullptr ? types::FVec3(mesh->mNormals[vertexIndex].x,
-                                                                 mesh->mNormals[vertexIndex].y,
-                                                                 mesh->mNormals[vertexIndex].z)
-                                                  : types::DEFAULT_VALUE<types::FVec3>;
-
-        // Mesh can contain several UV-coordinates, check if the first one is present.
-        if (mesh->mTextureCoords[0] != nullptr)
-        {
-            vertex.textureCoordinates = types::FVec2(mesh->mTextureCoords[0][vertexIndex].x,
-                                                     mesh->mTextureCoords[0][vertexIndex].y);
-        }
-        else
-        {
-            vertex.textureCoordinates = types::DEFAULT_VALUE<types::FVec2>;
-        }
+    BoundingSphere localSphere = {
+        .center = _boundingBox.center(),
+        .radius = glm::length(_boundingBox.extents()),
+    };
+    return localSphere.transform(_transform->localToWorldMatrix());
+}
 
-        vertices.push_back(vertex);
+void Model::computeBoundingBox()
+{
+    _boundingBox = BoundingBox::EMPTY;
+    for (auto const &mesh : _meshes)
+    {
+        _boundingBox = _boundingBox.merge(mesh->boundingBox());
     }
+}
 
-    // Information about indices is stored in the assimp's Face abstraction. In case assimp does not
-    // return any indices, just create a redundant array of numbers from 1 to N.
-    if (mesh->mFaces != nullptr && mesh->mNumFaces != 0)
+void Model::collectTextureArrays()
+{
+    for (auto const &mesh : _meshes)
     {
-        for (types::UInt faceIndex = 0; faceIndex < mesh->mNumFaces; faceIndex++)
+        if (mesh->textureArray() != nullptr &&
+            std::find(_textureArrays.begin(), _textureArrays.end(), mesh->textureArray()) ==
+                _textureArrays.end())
         {
-            aiFace face = mesh->mFaces[faceIndex];
-            for (unsigned int i = 0; i < face.mNumIndices; i++)
-            {
-                indices.push_back(face.mIndices[i]);
-            }
+            _textureArrays.push_back(mesh->textureArray());
         }
     }
-    else
+}
+
+void Model::loadModel(std::filesystem::path const &modelPath, bool diffuseTextureArrays)
+{
+    if (modelPath.extension() == MeshFile::EXTENSION)
     {
-        indices = std::vector<types::UInt>(mesh->mNumVertices);
-        std::iota(indices.begin(), indices.end(), 0);
+        loadCookedModel(modelPath);
+        return;
     }
 
-    // Material loading. Every mesh uses exactly one material, if it's not the case, assimp
-    // automatically splits meshes so that each of them would have a single material.
-    types::UInt materialIndex = mesh->mMaterialIndex;
-    if (materialIndex >= scene->mNumMaterials)
+    ModelImporter importer(modelPath, ModelImporter::NATIVE_PARSER, diffuseTextureArrays);
+    for (auto const &layers : importer.diffuseTextureArrays())
     {
-        throw std::logic_error("Mesh points to the material that does not exist");
+        _textureArrays.push_back(
+            std::make_shared<TextureArray>(_window, layers, TextureType::DIFFUSE));
     }
 
-    aiMaterial *material = scene->mMaterials[materialIndex];
-    if (material == nullptr)
+    for (auto const &mesh : importer.meshes())
     {
-        throw std::logic_error("Scene has a material stored as a nullptr.");
+        auto loadedMesh = std::make_shared<Mesh>(_window,
+                                                 mesh.vertices,
+                                                 mesh.indices,
+                                                 loadTextures(mesh.textures),
+                                                 STATIC_DRAW,
+                                                 mesh.levelsOfDetail,
+                                                 _vertexCompression);
+        if (mesh.diffuseRegion.has_value())
+        {
+            loadedMesh->textureArray(_textureArrays.at(mesh.diffuseRegion->array),
+                                     mesh.diffuseRegion->layer);
+        }
+        _meshes.push_back(std::move(loadedMesh));
+        _optimizationReports.push_back(mesh.optimizationReport);
     }
-
-    // Only diffuse and specular maps are supported for now
-    std::vector<std::shared_ptr<Texture>> diffuseMaps =
-        loadMaterialTextures(material, aiTextureType_DIFFUSE, TextureType::DIFFUSE, modelPath);
-    textures.insert(textures.end(), diffuseMaps.begin(), diffuseMaps.end());
-
-    std::vector<std::shared_ptr<Texture>> specularMaps =
-        loadMaterialTextures(material, aiTextureType_SPECULAR, TextureType::SPECULAR, modelPath);
-    textures.insert(textures.end(), specularMaps.begin(), specularMaps.end());
-
-    return std::make_unique<Mesh>(_window, vertices, indices, textures, STATIC_DRAW);
 }
 
-std::vector<std::shared_ptr<Texture>>
-Model::loadMaterialTextures(aiMaterial *material,
-                            aiTextureType assimpTextureType,
-                            TextureType textureType,
-                            std::filesystem::path const &modelPath)
+void Model::loadCookedModel(std::filesystem::path const &modelPath)
 {
-    if (material == nullptr)
+    MeshFile meshFile(modelPath);
+
+    // Textures are loaded while the vertices are still being decompressed
+    std::vector<std::vector<std::shared_ptr<Texture>>> textures;
+    for (size_t i = 0; i < meshFile.meshesCount(); i++)
+    {
+        textures.push_back(loadTextures(meshFile.textures(i)));
+    }
+    for (size_t i = 0; i < meshFile.meshesCount(); i++)
     {
-        throw std::invalid_argument("Nullptr passed a pointer to the material.");
+        _meshes.push_back(
+            std::make_shared<Mesh>(_window, meshFile.mesh(i), std::move(textures[i]), STATIC_DRAW));
     }
+}
 
+std::vector<std::shared_ptr<Texture>>
+Model::loadTextures(std::vector<MeshData::TextureReference> const &textureReferences)
+{
     std::vector<std::shared_ptr<Texture>> textures;
-    for (types::UInt i = 0; i < material->GetTextureCount(assimpTextureType); i++)
+    for (auto const &textureReference : textureReferences)
     {
-        aiString fileName;
-        material->GetTexture(assimpTextureType, i, &fileName);
-
-        std::filesystem::path textureFilePath = modelPath.parent_path().append(fileName.C_Str());
+        // Cooked version of the texture is picked up when it lies next to the original one
+        std::filesystem::path texturePath = textureReference.path;
+        std::filesystem::path cookedPath =
+            std::filesystem::path(texturePath).replace_extension(TextureFile::EXTENSION);
+        if (std::filesystem::exists(cookedPath))
+        {
+            texturePath = cookedPath;
+        }
 
-        auto textureIsAlreadyLoaded =
+        auto loadedTexture =
             std::find_if(_loadedTextures.begin(),
                          _loadedTextures.end(),
-                         [textureFilePath](std::shared_ptr<Texture> const &loadedTexture)
-                         { return loadedTexture->filePath() == textureFilePath; });
+                         [&texturePath](std::shared_ptr<Texture> const &texture)
+                         { return texture->filePath() == texturePath; });
 
-        if (textureIsAlreadyLoaded == _loadedTextures.end())
+        if (loadedTexture != _loadedTextures.end())
+        {
+            textures.push_back(*loadedTexture);
+            continue;
+        }
+
+        std::shared_ptr<Texture> texture;
+        if (_textureStreamer != nullptr && texturePath.extension() == TextureFile::EXTENSION)
+        {
+            texture = _textureStreamer->load(texturePath, textureReference.type);
+        }
+        else if (_textureLoader != nullptr)
+        {
+            texture = _textureLoader->load(texturePath, textureReference.type);
+        }
+        else
         {
-            std::shared_ptr<Texture> texture =
-                std::make_shared<Texture>(_window, textureFilePath.string(), textureType);
-            textures.push_back(texture);
+            texture = std::make_shared<Texture>(_window, texturePath, textureReference.type);
         }
+        _loadedTextures.push_back(texture);
+        textures.push_back(std::move(texture));
     }
     return textures;
 }
@@ -0,0 +1,380 @@
+#include <pf_gl/ModelImporter.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+#include <assimp/mesh.h>
+#include <assimp/postprocess.h>
+#include <assimp/material.h>
+#include <assimp/types.h>
+#include <fmt/format.h>
+
+#include <pf_gl/Image.hpp>
+#include <pf_gl/Mesh.hpp>
+#include <pf_gl/MeshData.hpp>
+#include <pf_gl/MeshOptimizer.hpp>
+#include <pf_gl/MeshSimplifier.hpp>
+#include <pf_gl/ObjLoader.hpp>
+#include <pf_gl/Texture.hpp>
+#include <pf_gl/TextureArrayBuilder.hpp>
+#include <pf_gl/ValueTypes.hpp>
+
+namespace pf::gl
+{
+
+ModelImporter::ModelImporter(std::filesystem::path const &modelPath,
+                             Parser parser,
+                             bool diffuseTextureArrays)
+    : _meshes(parse(modelPath, parser))
+{
+    for (auto &mesh : _meshes)
+    {
+        optimize(mesh);
+    }
+    if (diffuseTextureArrays)
+    {
+        arrangeDiffuseTextures();
+    }
+}
+
+std::vector<ModelImporter::ImportedMesh> const &ModelImporter::meshes() const
+{
+    return _meshes;
+}
+
+std::vector<std::vector<Image>> const &ModelImporter::diffuseTextureArrays() const
+{
+    return _diffuseTextureArrays;
+}
+
+std::vector<ModelImporter::ImportedMesh>
+ModelImporter::parse(std::filesystem::path const &modelPath, Parser parser)
+{
+    std::vector<ImportedMesh> meshes;
+
+    if (parser == NATIVE_PARSER && modelPath.extension() == ".obj")
+    {
+        for (auto &group : ObjLoader::load(modelPath))
+        {
+            meshes.push_back({
+                .vertices = std::move(group.vertices),
+                .indices = std::move(group.indices),
+                .levelsOfDetail = {},
+                .textures = std::move(group.textures),
+                .optimizationReport = {},
+                .diffuseRegion = std::nullopt,
+            });
+        }
+        return meshes;
+    }
+
+    Assimp::Importer importer;
+    aiScene const *scene =
+        importer.ReadFile(modelPath.string(),
+                          aiProcess_Triangulate | aiProcess_FlipUVs |
+                              aiProcess_JoinIdenticalVertices);
+
+    if (scene == nullptr || (scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE) != 0U ||
+        scene->mRootNode == nullptr)
+    {
+        throw std::runtime_error(
+            fmt::format("Error while loading model using assimp ({}).", importer.GetErrorString()));
+    }
+    processNode(scene->mRootNode, scene, modelPath, meshes);
+    return meshes;
+}
+
+void ModelImporter::processNode(aiNode *node,
+                                aiScene const *scene,
+                                std::filesystem::path const &modelPath,
+                                std::vector<ImportedMesh> &meshes)
+{
+    if (node == nullptr)
+    {
+        throw std::invalid_argument("Nullptr passed as a node pointer");
+    }
+    if (scene == nullptr)
+    {
+        throw std::invalid_argument("Nullptr passed as a scene pointer");
+    }
+
+    if (node->mMeshes != nullptr)
+    {
+        for (types::UInt meshNodeIndex = 0; meshNodeIndex < node->mNumMeshes; meshNodeIndex++)
+        {
+            types::UInt meshSceneIndex = node->mMeshes[meshNodeIndex];
+
+            if (meshSceneIndex >= scene->mNumMeshes)
+            {
+                throw std::logic_error("A node points to the mesh with an invalid index.");
+            }
+            processMesh(scene->mMeshes[meshSceneIndex], scene, modelPath, meshes);
+        }
+    }
+
+    if (node->mChildren != nullptr)
+    {
+        for (unsigned int childIndex = 0; childIndex < node->mNumChildren; childIndex++)
+        {
+            processNode(node->mChildren[childIndex], scene, modelPath, meshes);
+        }
+    }
+}
+
+void ModelImporter::processMesh(aiMesh *mesh,
+                                aiScene const *scene,
+                                std::filesystem::path const &modelPath,
+                                std::vector<ImportedMesh> &meshes)
+{
+    if (mesh == nullptr)
+    {
+        throw std::invalid_argument("Nullptr passed as a pointer to mesh.");
+    }
+    if (scene == nullptr)
+    {
+        throw std::invalid_argument("Nullptr passed as a pointer to scene.");
+    }
+
+    if (mesh->mVertices == nullptr || mesh->mNumVertices == 0)
+    {
+        return;
+    }
+
+    ImportedMesh imported;
+    auto &vertices = imported.vertices;
+    auto &indices = imported.indices;
+
+    vertices.reserve(mesh->mNumVertices);
+    indices.reserve(static_cast<size_t>(mesh->mNumFaces) * 3);
+
+    for (types::UInt vertexIndex = 0; vertexIndex < mesh->mNumVertices; vertexIndex++)
+    {
+        Mesh::SimpleVertex vertex{};
+        vertex.position = types::FVec3(mesh->mVertices[vertexIndex].x,
+                                       mesh->mVertices[vertexIndex].y,
+                                       mesh->mVertices[vertexIndex].z);
+
+        vertex.normal = mesh->mNormals != nullptr ? types::FVec3(mesh->mNormals[vertexIndex].x,
+                                                                 mesh->mNormals[vertexIndex].y,
+                                                                 mesh->mNormals[vertexIndex].z)
+                                                  : types::DEFAULT_VALUE<types::FVec3>;
+
+        // Mesh can contain several UV-coordinates, check if the first one is present.
+        if (mesh->mTextureCoords[0] != nullptr)
+        {
+            vertex.textureCoordinates = types::FVec2(mesh->mTextureCoords[0][vertexIndex].x,
+                                                     mesh->mTextureCoords[0][vertexIndex].y);
+        }
+        else
+        {
+            vertex.textureCoordinates = types::DEFAULT_VALUE<types::FVec2>;
+        }
+
+        vertices.push_back(vertex);
+    }
+
+    // Information about indices is stored in the assimp's Face abstraction. In case assimp does not
+    // return any indices, just create a redundant array of numbers from 1 to N.
+    if (mesh->mFaces != nullptr && mesh->mNumFaces != 0)
+    {
+        for (types::UInt faceIndex = 0; faceIndex < mesh->mNumFaces; faceIndex++)
+        {
+            // Points and lines left after the triangulation are not drawn
+            aiFace face = mesh->mFaces[faceIndex];
+            if (face.mNumIndices != 3)
+            {
+                continue;
+            }
+            for (unsigned int i = 0; i < face.mNumIndices; i++)
+            {
+                indices.push_back(face.mIndices[i]);
+            }
+        }
+    }
+    else
+    {
+        indices = std::vector<types::UInt>(mesh->mNumVertices);
+        std::iota(indices.begin(), indices.end(), 0);
+    }
+
+    // Material loading. Every mesh uses exactly one material, if it's not the case, assimp
+    // automatically splits meshes so that each of them would have a single material.
+    types::UInt materialIndex = mesh->mMaterialIndex;
+    if (materialIndex >= scene->mNumMaterials)
+    {
+        throw std::logic_error("Mesh points to the material that does not exist");
+    }
+
+    aiMaterial *material = scene->mMaterials[materialIndex];
+    if (material == nullptr)
+    {
+        throw std::logic_error("Scene has a material stored as a nullptr.");
+    }
+
+    // Only diffuse and specular maps are supported for now
+    materialTextures(
+        material, aiTextureType_DIFFUSE, TextureType::DIFFUSE, modelPath, imported.textures);
+    materialTextures(
+        material, aiTextureType_SPECULAR, TextureType::SPECULAR, modelPath, imported.textures);
+
+    if (!indices.empty())
+    {
+        meshes.push_back(std::move(imported));
+    }
+}
+
+void ModelImporter::optimize(ImportedMesh &imported)
+{
+    auto &vertices = imported.vertices;
+    auto &indices = imported.indices;
+
+    auto vertexBytes = std::as_writable_bytes(std::span(vertices));
+    imported.optimizationReport = MeshOptimizer::optimize(
+        vertexBytes, sizeof(Mesh::SimpleVertex), offsetof(Mesh::SimpleVertex, position), indices);
+    vertices.resize(imported.optimizationReport.verticesCountAfter);
+
+    // Levels of detail share the vertices, so only their triangles are reordered
+    imported.levelsOfDetail = generateLevelsOfDetail(vertices, indices);
+    for (auto &levelOfDetail : imported.levelsOfDetail)
+    {
+        MeshOptimizer::optimizeTriangles(std::as_bytes(std::span(vertices)),
+                                         sizeof(Mesh::SimpleVertex),
+                                         offsetof(Mesh::SimpleVertex, position),
+                                         levelOfDetail.indices);
+    }
+}
+
+void ModelImporter::arrangeDiffuseTextures()
+{
+    TextureArrayBuilder builder;
+    std::map<std::filesystem::path, types::UInt> pathToImage;
+    std::vector<std::optional<types::UInt>> meshImages(_meshes.size());
+
+    for (size_t i = 0; i < _meshes.size(); i++)
+    {
+        auto &textures = _meshes[i].textures;
+        auto diffuse = std::find_if(textures.begin(),
+                                    textures.end(),
+                                    [](MeshData::TextureReference const &texture)
+                                    { return texture.type == TextureType::DIFFUSE; });
+        if (diffuse == textures.end())
+        {
+            continue;
+        }
+
+        auto [image, inserted] = pathToImage.try_emplace(diffuse->path, 0);
+        if (inserted)
+        {
+            image->second = builder.add(Image(diffuse->path));
+        }
+        meshImages[i] = image->second;
+
+        std::erase_if(textures,
+                      [](MeshData::TextureReference const &texture)
+                      { return texture.type == TextureType::DIFFUSE; });
+    }
+
+    TextureArrayBuilder::Result result = builder.build();
+    for (size_t i = 0; i < _meshes.size(); i++)
+    {
+        if (!meshImages[i].has_value())
+        {
+            continue;
+        }
+
+        // The levels of detail share the vertices, so they are remapped along with them
+        TextureArrayBuilder::Region const &region = result.regions[*meshImages[i]];
+        for (auto &vertex : _meshes[i].vertices)
+        {
+            vertex.textureCoordinates = region.remap(vertex.textureCoordinates);
+        }
+        _meshes[i].diffuseRegion = region;
+    }
+    _diffuseTextureArrays = std::move(result.arrays);
+}
+
+std::vector<MeshSimplifier::Result>
+ModelImporter::generateLevelsOfDetail(std::vector<Mesh::SimpleVertex> const &vertices,
+                                      std::vector<types::UInt> const &indices)
+{
+    std::vector<MeshSimplifier::Result> levelsOfDetail;
+    if (indices.size() / 3 < MIN_SIMPLIFIED_TRIANGLES_COUNT)
+    {
+        return levelsOfDetail;
+    }
+
+    std::vector<types::FVec3> positions;
+    positions.reserve(vertices.size());
+    for (auto const &vertex : vertices)
+    {
+        positions.push_back(vertex.position);
+    }
+
+    MeshSimplifier simplifier(positions, indices);
+    size_t previousIndicesCount = indices.size();
+
+    for (auto ratio : LEVELS_OF_DETAIL_RATIOS)
+    {
+        auto targetIndicesCount =
+            static_cast<size_t>(static_cast<types::Float>(indices.size()) * ratio);
+        auto levelOfDetail = simplifier.simplify(targetIndicesCount);
+
+        // Faceted meshes have seams everywhere and barely simplify while keeping all of them
+        if (levelOfDetail.indices.size() > targetIndicesCount + targetIndicesCount / 2)
+        {
+            levelOfDetail = simplifier.simplify(targetIndicesCount,
+                                                std::numeric_limits<types::Float>::max(),
+                                                MeshSimplifier::COLLAPSE_SEAMS);
+        }
+
+        // Not different enough from the previous level to be worth the memory
+        if (levelOfDetail.indices.size() * 5 > previousIndicesCount * 4)
+        {
+            break;
+        }
+
+        // Each level is simplified from the original mesh, so the errors may be out of order
+        if (!levelsOfDetail.empty())
+        {
+            levelOfDetail.error = std::max(levelOfDetail.error, levelsOfDetail.back().error);
+        }
+        previousIndicesCount = levelOfDetail.indices.size();
+        levelsOfDetail.push_back(std::move(levelOfDetail));
+    }
+    return levelsOfDetail;
+}
+
+void ModelImporter::materialTextures(aiMaterial *material,
+                                     aiTextureType assimpTextureType,
+                                     TextureType textureType,
+                                     std::filesystem::path const &modelPath,
+                                     std::vector<MeshData::TextureReference> &textures)
+{
+    if (material == nullptr)
+    {
+        throw std::invalid_argument("Nullptr passed a pointer to the material.");
+    }
+
+    for (types::UInt i = 0; i < material->GetTextureCount(assimpTextureType); i++)
+    {
+        aiString fileName;
+        material->GetTexture(assimpTextureType, i, &fileName);
+        textures.push_back({
+            .type = textureType,
+            .path = modelPath.parent_path() / fileName.C_Str(),
+        });
+    }
+}
+
+} // namespace pf::gl
@@ -0,0 +1,593 @@
+#include <pf_gl/ObjLoader.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gsl/util>
+
+#include <pf_gl/Mesh.hpp>
+#include <pf_gl/MeshData.hpp>
+#include <pf_gl/Texture.hpp>
+#include <pf_gl/ValueTypes.hpp>
+#include <pf_utils/FileUtils.hpp>
+#include <pf_utils/MappedFile.hpp>
+
+namespace pf::gl
+{
+
+namespace
+{
+
+std::int64_t constexpr ABSENT_INDEX = std::numeric_limits<std::int64_t>::min();
+types::UInt constexpr NO_INDEX = std::numeric_limits<types::UInt>::max();
+
+/**
+ * Zero-based indices of a triangle corner. Negative indices of the file are relative to the end of
+ * the vertices parsed so far, they are stored relative to the beginning of the chunk and resolved
+ * when the chunks are merged.
+ */
+struct Corner
+{
+    std::int64_t position = ABSENT_INDEX;
+    std::int64_t textureCoordinates = ABSENT_INDEX;
+    std::int64_t normal = ABSENT_INDEX;
+    std::uint8_t relativeMask = 0;
+};
+
+std::uint8_t constexpr RELATIVE_POSITION = 1U << 0U;
+std::uint8_t constexpr RELATIVE_TEXTURE_COORDINATES = 1U << 1U;
+std::uint8_t constexpr RELATIVE_NORMAL = 1U << 2U;
+
+struct MaterialSwitch
+{
+    size_t firstTriangle;
+    std::string material;
+};
+
+struct Chunk
+{
+    std::vector<types::FVec3> positions;
+    std::vector<types::FVec2> textureCoordinates;
+    std::vector<types::FVec3> normals;
+
+    /**
+     * Three per triangle.
+     */
+    std::vector<Corner> corners;
+    std::vector<MaterialSwitch> materialSwitches;
+    std::vector<std::string> materialLibraries;
+
+    std::vector<Corner> faceCorners;
+    std::exception_ptr error;
+};
+
+struct MaterialDefinition
+{
+    std::string name;
+    std::vector<MeshData::TextureReference> textures;
+};
+
+template <typename Function>
+void forEachLine(std::string_view text, Function &&function)
+{
+    while (!text.empty())
+    {
+        size_t lineEnd = text.find('\n');
+        std::string_view line = text.substr(0, lineEnd);
+        if (!line.empty() && line.back() == '\r')
+        {
+            line.remove_suffix(1);
+        }
+        function(line);
+
+        text.remove_prefix(lineEnd == std::string_view::npos ? text.size() : lineEnd + 1);
+    }
+}
+
+class LineParser
+{
+public:
+    explicit LineParser(std::string_view line)
+        : _current(line.data())
+        , _end(line.data() + line.size())
+    {
+    }
+
+    bool atEnd()
+    {
+        skipSpaces();
+        return _current == _end;
+    }
+
+    std::string_view word()
+    {
+        skipSpaces();
+        char const *start = _current;
+        while (_current != _end && !isSpace(*_current))
+        {
+            _current++;
+        }
+        return {start, gsl::narrow_cast<size_t>(_current - start)};
+    }
+
+    /**
+     * The rest of the line without the surrounding spaces.
+     */
+    std::string_view rest()
+    {
+        skipSpaces();
+        char const *end = _end;
+        while (end != _current && isSpace(*(end - 1)))
+        {
+            end--;
+        }
+        return {_current, gsl::narrow_cast<size_t>(end - _current)};
+    }
+
+    types::Float readFloat()
+    {
+        skipSpaces();
+        if (_current != _end && *_current == '+')
+        {
+            _current++;
+        }
+        types::Float value = 0.0F;
+        auto [end, error] = std::from_chars(_current, _end, value);
+        if (error != std::errc())
+        {
+            throw std::runtime_error("Malformed number in the OBJ file.");
+        }
+        _current = end;
+        return value;
+    }
+
+    std::int64_t readIndex()
+    {
+        std::int64_t value = 0;
+        auto [end, error] = std::from_chars(_current, _end, value);
+        if (error != std::errc() || value == 0)
+        {
+            throw std::runtime_error("Malformed face index in the OBJ file.");
+        }
+        _current = end;
+        return value;
+    }
+
+    bool skip(char character)
+    {
+        if (_current != _end && *_current == character)
+        {
+            _current++;
+            return true;
+        }
+        return false;
+    }
+
+private:
+    char const *_current;
+    char const *_end;
+
+    static bool isSpace(char character)
+    {
+        return character == ' ' || character == '\t';
+    }
+
+    void skipSpaces()
+    {
+        while (_current != _end && isSpace(*_current))
+        {
+            _current++;
+        }
+    }
+};
+
+/**
+ * Converts a one-based index of the file into a zero-based one.
+ */
+std::int64_t toCornerIndex(std::int64_t index,
+                           size_t parsedCount,
+                           std::uint8_t relativeFlag,
+                           std::uint8_t &relativeMask)
+{
+    if (index > 0)
+    {
+        return index - 1;
+    }
+    relativeMask |= relativeFlag;
+    return static_cast<std::int64_t>(parsedCount) + index;
+}
+
+void parseFace(LineParser &parser, Chunk &chunk)
+{
+    chunk.faceCorners.clear();
+    while (!parser.atEnd())
+    {
+        Corner corner;
+        corner.position = toCornerIndex(
+            parser.readIndex(), chunk.positions.size(), RELATIVE_POSITION, corner.relativeMask);
+
+        if (parser.skip('/'))
+        {
+            if (!parser.skip('/'))
+            {
+                corner.textureCoordinates = toCornerIndex(parser.readIndex(),
+                                                          chunk.textureCoordinates.size(),
+                                                          RELATIVE_TEXTURE_COORDINATES,
+                                                          corner.relativeMask);
+                if (!parser.skip('/'))
+                {
+                    chunk.faceCorners.push_back(corner);
+                    continue;
+                }
+            }
+            corner.normal = toCornerIndex(
+                parser.readIndex(), chunk.normals.size(), RELATIVE_NORMAL, corner.relativeMask);
+        }
+        chunk.faceCorners.push_back(corner);
+    }
+
+    // Triangulated as a fan, same as assimp does for the convex polygons
+    for (size_t i = 2; i < chunk.faceCorners.size(); i++)
+    {
+        chunk.corners.push_back(chunk.faceCorners[0]);
+        chunk.corners.push_back(chunk.faceCorners[i - 1]);
+        chunk.corners.push_back(chunk.faceCorners[i]);
+    }
+}
+
+void parseLine(std::string_view line, Chunk &chunk)
+{
+    LineParser parser(line);
+    std::string_view keyword = parser.word();
+
+    if (keyword == "v")
+    {
+        types::Float x = parser.readFloat();
+        types::Float y = parser.readFloat();
+        types::Float z = parser.readFloat();
+        chunk.positions.emplace_back(x, y, z);
+    }
+    else if (keyword == "vt")
+    {
+        types::Float u = parser.readFloat();
+        types::Float v = parser.atEnd() ? 0.0F : parser.readFloat();
+        chunk.textureCoordinates.emplace_back(u, 1.0F - v);
+    }
+    else if (keyword == "vn")
+    {
+        types::Float x = parser.readFloat();
+        types::Float y = parser.readFloat();
+        types::Float z = parser.readFloat();
+        chunk.normals.emplace_back(x, y, z);
+    }
+    else if (keyword == "f")
+    {
+        parseFace(parser, chunk);
+    }
+    else if (keyword == "usemtl")
+    {
+        chunk.materialSwitches.push_back({
+            .firstTriangle = chunk.corners.size() / 3,
+            .material = std::string(parser.rest()),
+        });
+    }
+    else if (keyword == "mtllib")
+    {
+        chunk.materialLibraries.emplace_back(parser.rest());
+    }
+}
+
+void parseChunk(std::string_view text, Chunk &chunk)
+{
+    try
+    {
+        forEachLine(text, [&chunk](std::string_view line) { parseLine(line, chunk); });
+    }
+    catch (...)
+    {
+        chunk.error = std::current_exception();
+    }
+}
+
+/**
+ * Missing libraries are skipped, the model is still loaded, just without the textures.
+ */
+void loadMaterialLibrary(std::filesystem::path const &path,
+                         std::vector<MaterialDefinition> &materials)
+{
+    if (!std::filesystem::exists(path))
+    {
+        return;
+    }
+
+    std::string text = pf::util::file::readAsText(path);
+    forEachLine(text,
+                [&path, &materials](std::string_view line)
+                {
+                    LineParser parser(line);
+                    std::string_view keyword = parser.word();
+
+                    if (keyword == "newmtl")
+                    {
+                        materials.push_back({.name = std::string(parser.rest()), .textures = {}});
+                        return;
+                    }
+
+                    TextureType textureType = DIFFUSE;
+                    if (keyword == "map_Kd")
+                    {
+                        textureType = DIFFUSE;
+                    }
+                    else if (keyword == "map_Ks")
+                    {
+                        textureType = SPECULAR;
+                    }
+                    else
+                    {
+                        return;
+                    }
+
+                    // The file name goes after the options, if there are any
+                    std::string_view fileName = parser.rest();
+                    size_t lastSpace = fileName.find_last_of(" \t");
+                    if (lastSpace != std::string_view::npos)
+                    {
+                        fileName.remove_prefix(lastSpace + 1);
+                    }
+                    if (!materials.empty() && !fileName.empty())
+                    {
+                        materials.back().textures.push_back({
+                            .type = textureType,
+                            .path = path.parent_path() / fileName,
+                        });
+                    }
+                });
+}
+
+types::UInt resolveIndex(std::int64_t index,
+                         bool relative,
+                         size_t chunkBase,
+                         size_t totalCount,
+                         char const *attributeName)
+{
+    if (relative)
+    {
+        index += static_cast<std::int64_t>(chunkBase);
+    }
+    if (index < 0 || static_cast<size_t>(index) >= totalCount)
+    {
+        throw std::runtime_error(
+            fmt::format("OBJ face refers to a missing {} ({}).", attributeName, index + 1));
+    }
+    return gsl::narrow_cast<types::UInt>(index);
+}
+
+} // namespace
+
+std::vector<ObjLoader::MaterialGroup> ObjLoader::load(std::filesystem::path const &path,
+                                                      types::Size threadsCount)
+{
+    pf::util::MappedFile file(path);
+    auto bytes = file.bytes();
+    return parse(std::string_view(reinterpret_cast<char const *>(bytes.data()), bytes.size()),
+                 path.parent_path(),
+                 threadsCount);
+}
+
+std::vector<ObjLoader::MaterialGroup> ObjLoader::parse(std::string_view text,
+                                                       std::filesystem::path const &directory,
+                                                       types::Size threadsCount,
+                                                       size_t minChunkSize)
+{
+    if (threadsCount < 0)
+    {
+        throw std::invalid_argument("Threads count must not be negative.");
+    }
+    if (threadsCount == 0)
+    {
+        threadsCount =
+            std::max(1, gsl::narrow_cast<types::Size>(std::thread::hardware_concurrency()));
+    }
+
+    // Chunks end right after a line break, so that no line is split between them
+    size_t chunksCount = std::clamp(text.size() / std::max<size_t>(minChunkSize, 1),
+                                    size_t(1),
+                                    static_cast<size_t>(threadsCount));
+    std::vector<size_t> chunkStarts = {0};
+    for (size_t i = 1; i < chunksCount; i++)
+    {
+        size_t start = std::max(text.size() * i / chunksCount, chunkStarts.back());
+        size_t lineEnd = text.find('\n', start);
+        chunkStarts.push_back(lineEnd == std::string_view::npos ? text.size() : lineEnd + 1);
+    }
+    chunkStarts.push_back(text.size());
+
+    std::vector<Chunk> chunks(chunksCount);
+    {
+        auto worker = [&text, &chunkStarts, &chunks](size_t chunkIndex)
+        {
+            parseChunk(text.substr(chunkStarts[chunkIndex],
+                                   chunkStarts[chunkIndex + 1] - chunkStarts[chunkIndex]),
+                       chunks[chunkIndex]);
+        };
+
+        // The calling thread takes part in the work too
+        std::vector<std::jthread> threads;
+        for (size_t i = 1; i < chunksCount; i++)
+        {
+            threads.emplace_back(worker, i);
+        }
+        worker(0);
+    }
+
+    std::vector<types::FVec3> positions;
+    std::vector<types::FVec2> textureCoordinates;
+    std::vector<types::FVec3> normals;
+    std::vector<MaterialDefinition> materials;
+    for (auto const &chunk : chunks)
+    {
+        if (chunk.error != nullptr)
+        {
+            std::rethrow_exception(chunk.error);
+        }
+        positions.insert(positions.end(), chunk.positions.begin(), chunk.positions.end());
+        textureCoordinates.insert(textureCoordinates.end(),
+                                  chunk.textureCoordinates.begin(),
+                                  chunk.textureCoordinates.end());
+        normals.insert(normals.end(), chunk.normals.begin(), chunk.normals.end());
+
+        for (auto const &library : chunk.materialLibraries)
+        {
+            loadMaterialLibrary(directory / library, materials);
+        }
+    }
+
+    std::vector<MaterialGroup> groups;
+    auto findGroup = [&groups, &materials](std::string const &material)
+    {
+        auto group = std::find_if(groups.begin(),
+                                  groups.end(),
+                                  [&material](MaterialGroup const &group)
+                                  { return group.material == material; });
+        if (group != groups.end())
+        {
+            return gsl::narrow_cast<types::UInt>(group - groups.begin());
+        }
+
+        auto definition = std::find_if(materials.begin(),
+                                       materials.end(),
+                                       [&material](MaterialDefinition const &definition)
+                                       { return definition.name == material; });
+        groups.push_back({
+            .material = material,
+            .vertices = {},
+            .indices = {},
+            .textures = definition != materials.end() ? definition->textures
+                                                      : std::vector<MeshData::TextureReference>(),
+        });
+        return gsl::narrow_cast<types::UInt>(groups.size() - 1);
+    };
+
+    // Vertices sharing a position are chained, so that the welding needs no hashing
+    struct WeldedVertex
+    {
+        types::UInt textureCoordinates;
+        types::UInt normal;
+        types::UInt group;
+        types::UInt vertex;
+        types::UInt next;
+    };
+    std::vector<types::UInt> firstWeldedVertex(positions.size(), NO_INDEX);
+    std::vector<WeldedVertex> weldedVertices;
+
+    size_t positionsBase = 0;
+    size_t textureCoordinatesBase = 0;
+    size_t normalsBase = 0;
+    types::UInt currentGroup = NO_INDEX;
+
+    for (auto const &chunk : chunks)
+    {
+        auto materialSwitch = chunk.materialSwitches.begin();
+        for (size_t corner = 0; corner < chunk.corners.size(); corner++)
+        {
+            while (materialSwitch != chunk.materialSwitches.end() &&
+                   materialSwitch->firstTriangle * 3 <= corner)
+            {
+                currentGroup = findGroup(materialSwitch->material);
+                materialSwitch++;
+            }
+            if (currentGroup == NO_INDEX)
+            {
+                currentGroup = findGroup("");
+            }
+
+            Corner const &indices = chunk.corners[corner];
+            types::UInt position = resolveIndex(indices.position,
+                                                (indices.relativeMask & RELATIVE_POSITION) != 0,
+                                                positionsBase,
+                                                positions.size(),
+                                                "position");
+            types::UInt textureCoordinate =
+                indices.textureCoordinates == ABSENT_INDEX
+                    ? NO_INDEX
+                    : resolveIndex(indices.textureCoordinates,
+                                   (indices.relativeMask & RELATIVE_TEXTURE_COORDINATES) != 0,
+                                   textureCoordinatesBase,
+                                   textureCoordinates.size(),
+                                   "texture coordinate");
+            types::UInt normal = indices.normal == ABSENT_INDEX
+                                     ? NO_INDEX
+                                     : resolveIndex(indices.normal,
+                                                    (indices.relativeMask & RELATIVE_NORMAL) != 0,
+                                                    normalsBase,
+                                                    normals.size(),
+                                                    "normal");
+
+            MaterialGroup &group = groups[currentGroup];
+            types::UInt vertex = NO_INDEX;
+            for (types::UInt welded = firstWeldedVertex[position]; welded != NO_INDEX;
+                 welded = weldedVertices[welded].next)
+            {
+                WeldedVertex const &candidate = weldedVertices[welded];
+                if (candidate.textureCoordinates == textureCoordinate &&
+                    candidate.normal == normal && candidate.group == currentGroup)
+                {
+                    vertex = candidate.vertex;
+                    break;
+                }
+            }
+
+            if (vertex == NO_INDEX)
+            {
+                vertex = gsl::narrow_cast<types::UInt>(group.vertices.size());
+                group.vertices.push_back({
+                    .position = positions[position],
+                    .normal = normal != NO_INDEX ? normals[normal]
+                                                  : types::DEFAULT_VALUE<types::FVec3>,
+                    .textureCoordinates = textureCoordinate != NO_INDEX
+                                              ? textureCoordinates[textureCoordinate]
+                                              : types::DEFAULT_VALUE<types::FVec2>,
+                });
+                weldedVertices.push_back({
+                    .textureCoordinates = textureCoordinate,
+                    .normal = normal,
+                    .group = currentGroup,
+                    .vertex = vertex,
+                    .next = firstWeldedVertex[position],
+                });
+                firstWeldedVertex[position] =
+                    gsl::narrow_cast<types::UInt>(weldedVertices.size() - 1);
+            }
+            group.indices.push_back(vertex);
+        }
+
+        // Switches after the last face of the chunk still apply to the next chunks
+        for (; materialSwitch != chunk.materialSwitches.end(); materialSwitch++)
+        {
+            currentGroup = findGroup(materialSwitch->material);
+        }
+
+        positionsBase += chunk.positions.size();
+        textureCoordinatesBase += chunk.textureCoordinates.size();
+        normalsBase += chunk.normals.size();
+    }
+
+    std::erase_if(groups, [](MaterialGroup const &group) { return group.indices.empty(); });
+    return groups;
+}
+
+} // namespace pf::gl
@@ -0,0 +1,430 @@
+#include <pf_gl/OcclusionCuller.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <fmt/format.h>
+#include <glm/glm.hpp>
+#include <gsl/util>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define PF_GL_OCCLUSION_CULLER_SSE
+#include <xmmintrin.h>
+#endif
+
+#include <pf_gl/BoundingVolumes.hpp>
+#include <pf_gl/ValueTypes.hpp>
+#include <pf_utils/WorkerPool.hpp>
+
+namespace pf::gl
+{
+
+// Vertices closer than that (in clip space w) are treated as crossing the near plane
+types::Float const NEAR_W_EPSILON = 1e-4F;
+types::Float const CLEAR_DEPTH = 1.0F;
+
+OcclusionCuller::OcclusionCuller(types::Size width, types::Size height, types::Size threadsCount)
+    : _width(width)
+    , _height(height)
+    , _tilesX(width / TILE_WIDTH)
+    , _tilesY(height / TILE_HEIGHT)
+{
+    if (_width <= 0 || _height <= 0 || _width % TILE_WIDTH != 0 || _height % TILE_HEIGHT != 0)
+    {
+        throw std::invalid_argument(
+            fmt::format("Occlusion buffer size must be a positive multiple of {}x{}, got {}x{}.",
+                        TILE_WIDTH,
+                        TILE_HEIGHT,
+                        _width,
+                        _height));
+    }
+    if (threadsCount < 0)
+    {
+        throw std::invalid_argument("Threads count must not be negative.");
+    }
+    if (threadsCount == 0)
+    {
+        threadsCount =
+            std::max(1, gsl::narrow_cast<types::Size>(std::thread::hardware_concurrency()));
+    }
+    _workers = std::make_unique<pf::util::WorkerPool>(
+        static_cast<size_t>(std::min(threadsCount, _tilesX * _tilesY)));
+
+    _depth.resize(gsl::narrow_cast<size_t>(_width * _height), CLEAR_DEPTH);
+    _blocksMaxDepth.resize(gsl::narrow_cast<size_t>((_width / BLOCK_SIZE) * (_height / BLOCK_SIZE)),
+                           CLEAR_DEPTH);
+    _tileBins.resize(gsl::narrow_cast<size_t>(_tilesX * _tilesY));
+}
+
+void OcclusionCuller::beginFrame(types::FMat4 const &viewProjectionMatrix)
+{
+    _viewProjectionMatrix = viewProjectionMatrix;
+    _triangles.clear();
+    for (auto &bin : _tileBins)
+    {
+        bin.clear();
+    }
+    std::fill(_depth.begin(), _depth.end(), CLEAR_DEPTH);
+    std::fill(_blocksMaxDepth.begin(), _blocksMaxDepth.end(), CLEAR_DEPTH);
+}
+
+void OcclusionCuller::addOccluder(std::span<types::FVec3 const> vertices,
+                                  std::span<types::UInt const> indices,
+                                  types::FMat4 const &modelMatrix)
+{
+    if (indices.size() % 3 != 0)
+    {
+        throw std::invalid_argument("Occluder indices count must be a multiple of 3.");
+    }
+
+    types::FMat4 modelViewProjection = _viewProjectionMatrix * modelMatrix;
+    auto width = static_cast<types::Float>(_width);
+    auto height = static_cast<types::Float>(_height);
+
+    // Positions in pixels (x, y) and depth in [0; 1] (z), or w <= 0 for the clipped vertices
+    std::vector<types::FVec4> screenVertices;
+    screenVertices.reserve(vertices.size());
+    for (auto const &vertex : vertices)
+    {
+        types::FVec4 clip = modelViewProjection * types::FVec4(vertex, 1.0F);
+        if (clip.w <= NEAR_W_EPSILON)
+        {
+            screenVertices.emplace_back(0.0F, 0.0F, 0.0F, -1.0F);
+            continue;
+        }
+        types::FVec3 ndc = types::FVec3(clip) / clip.w;
+        screenVertices.emplace_back((ndc.x * 0.5F + 0.5F) * width,
+                                    (ndc.y * 0.5F + 0.5F) * height,
+                                    ndc.z * 0.5F + 0.5F,
+                                    1.0F);
+    }
+
+    for (size_t i = 0; i < indices.size(); i += 3)
+    {
+        std::array<types::FVec4, 3> triangle{};
+        bool clipped = false;
+        for (size_t corner = 0; corner < 3; corner++)
+        {
+            types::UInt index = indices[i + corner];
+            if (index >= screenVertices.size())
+            {
+                throw std::out_of_range(fmt::format("Occluder index {} is out of range.", index));
+            }
+            triangle.at(corner) = screenVertices[index];
+            clipped = clipped || triangle.at(corner).w <= 0.0F || triangle.at(corner).z < 0.0F;
+        }
+        if (clipped)
+        {
+            continue;
+        }
+
+        types::FVec4 const &v0 = triangle[0];
+        types::FVec4 const &v1 = triangle[1];
+        types::FVec4 const &v2 = triangle[2];
+
+        // Doubled signed area, positive for the counter-clockwise front faces
+        types::Float area = (v1.x - v0.x) * (v2.y - v0.y) - (v1.y - v0.y) * (v2.x - v0.x);
+        if (area <= 0.0F)
+        {
+            continue;
+        }
+
+        ScreenTriangle screenTriangle{};
+        screenTriangle.min = types::IntVec2(
+            std::max(0, static_cast<types::Int>(std::floor(std::min({v0.x, v1.x, v2.x})))),
+            std::max(0, static_cast<types::Int>(std::floor(std::min({v0.y, v1.y, v2.y})))));
+        screenTriangle.max = types::IntVec2(
+            std::min(_width - 1, static_cast<types::Int>(std::ceil(std::max({v0.x, v1.x, v2.x})))),
+            std::min(_height - 1,
+                     static_cast<types::Int>(std::ceil(std::max({v0.y, v1.y, v2.y})))));
+        if (screenTriangle.min.x > screenTriangle.max.x ||
+            screenTriangle.min.y > screenTriangle.max.y)
+        {
+            continue;
+        }
+
+        // Edge i is opposite to the vertex i, it is positive inside of the triangle and its value
+        // divided by the area is the barycentric coordinate of the vertex i
+        auto edge = [](types::FVec4 const &from, types::FVec4 const &to)
+        {
+            types::Float a = from.y - to.y;
+            types::Float b = to.x - from.x;
+            return types::FVec3(a, b, -(a * from.x + b * from.y));
+        };
+        screenTriangle.edges[0] = edge(v1, v2);
+        screenTriangle.edges[1] = edge(v2, v0);
+        screenTriangle.edges[2] = edge(v0, v1);
+
+        screenTriangle.depthPlane = (screenTriangle.edges[0] * v0.z +
+                                     screenTriangle.edges[1] * v1.z +
+                                     screenTriangle.edges[2] * v2.z) /
+                                    area;
+
+        auto triangleIndex = gsl::narrow_cast<types::UInt>(_triangles.size());
+        _triangles.push_back(screenTriangle);
+
+        for (types::Int tileY = screenTriangle.min.y / TILE_HEIGHT;
+             tileY <= screenTriangle.max.y / TILE_HEIGHT;
+             tileY++)
+        {
+            for (types::Int tileX = screenTriangle.min.x / TILE_WIDTH;
+                 tileX <= screenTriangle.max.x / TILE_WIDTH;
+                 tileX++)
+            {
+                _tileBins.at(gsl::narrow_cast<size_t>(tileY * _tilesX + tileX))
+                    .push_back(triangleIndex);
+            }
+        }
+    }
+}
+
+void OcclusionCuller::rasterize()
+{
+    _workers->run(static_cast<size_t>(_tilesX * _tilesY),
+                  [this](size_t tile)
+                  {
+                      rasterizeTile(gsl::narrow_cast<types::Size>(tile));
+                      updateBlocksDepth(gsl::narrow_cast<types::Size>(tile));
+                  });
+
+    _statistics.rasterizedTrianglesCount += gsl::narrow_cast<types::Size>(_triangles.size());
+}
+
+void OcclusionCuller::rasterizeTile(types::Size tileIndex)
+{
+    types::Int tileMinX = (tileIndex % _tilesX) * TILE_WIDTH;
+    types::Int tileMinY = (tileIndex / _tilesX) * TILE_HEIGHT;
+    types::Int tileMaxX = tileMinX + TILE_WIDTH - 1;
+    types::Int tileMaxY = tileMinY + TILE_HEIGHT - 1;
+
+    for (auto triangleIndex : _tileBins.at(gsl::narrow_cast<size_t>(tileIndex)))
+    {
+        ScreenTriangle const &triangle = _triangles[triangleIndex];
+
+        types::Int minX = std::max(triangle.min.x, tileMinX);
+        types::Int maxX = std::min(triangle.max.x, tileMaxX);
+        types::Int minY = std::max(triangle.min.y, tileMinY);
+        types::Int maxY = std::min(triangle.max.y, tileMaxY);
+
+        // Tile width is a multiple of 4, so the aligned groups never leave the tile
+        types::Int groupMinX = minX & ~3;
+
+        for (types::Int y = minY; y <= maxY; y++)
+        {
+            types::Float *row = &_depth[gsl::narrow_cast<size_t>(y * _width)];
+            auto pixelY = static_cast<types::Float>(y) + 0.5F;
+
+            for (types::Int x = groupMinX; x <= maxX; x += 4)
+            {
+                auto pixelX = static_cast<types::Float>(x) + 0.5F;
+
+#ifdef PF_GL_OCCLUSION_CULLER_SSE
+                __m128 xs = _mm_add_ps(_mm_set1_ps(pixelX), _mm_setr_ps(0.0F, 1.0F, 2.0F, 3.0F));
+                __m128 ys = _mm_set1_ps(pixelY);
+
+                // Pixels of the group outside of the clamped range are masked out as well
+                __m128 inside = _mm_and_ps(
+                    _mm_cmpge_ps(xs, _mm_set1_ps(static_cast<types::Float>(minX))),
+                    _mm_cmple_ps(xs, _mm_set1_ps(static_cast<types::Float>(maxX) + 1.0F)));
+
+                for (auto const &edge : triangle.edges)
+                {
+                    __m128 value = _mm_add_ps(
+                        _mm_add_ps(_mm_mul_ps(_mm_set1_ps(edge.x), xs),
+                                   _mm_mul_ps(_mm_set1_ps(edge.y), ys)),
+                        _mm_set1_ps(edge.z));
+                    inside = _mm_and_ps(inside, _mm_cmpge_ps(value, _mm_setzero_ps()));
+                }
+                if (_mm_movemask_ps(inside) == 0)
+                {
+                    continue;
+                }
+
+                __m128 depth = _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(_mm_set1_ps(triangle.depthPlane.x), xs),
+                               _mm_mul_ps(_mm_set1_ps(triangle.depthPlane.y), ys)),
+                    _mm_set1_ps(triangle.depthPlane.z));
+
+                __m128 oldDepth = _mm_loadu_ps(row + x);
+                __m128 newDepth = _mm_min_ps(oldDepth, depth);
+                _mm_storeu_ps(row + x,
+                              _mm_or_ps(_mm_and_ps(inside, newDepth),
+                                        _mm_andnot_ps(inside, oldDepth)));
+#else
+                for (types::Int lane = 0; lane < 4; lane++)
+                {
+                    types::Int pixel = x + lane;
+                    if (pixel < minX || pixel > maxX)
+                    {
+                        continue;
+                    }
+                    types::FVec3 position(pixelX + static_cast<types::Float>(lane), pixelY, 1.0F);
+                    if (glm::dot(triangle.edges[0], position) < 0.0F ||
+                        glm::dot(triangle.edges[1], position) < 0.0F ||
+                        glm::dot(triangle.edges[2], position) < 0.0F)
+                    {
+                        continue;
+                    }
+                    row[pixel] = std::min(row[pixel], glm::dot(triangle.depthPlane, position));
+                }
+#endif
+            }
+        }
+    }
+}
+
+void OcclusionCuller::updateBlocksDepth(types::Size tileIndex)
+{
+    types::Int tileMinX = (tileIndex % _tilesX) * TILE_WIDTH;
+    types::Int tileMinY = (tileIndex / _tilesX) * TILE_HEIGHT;
+    types::Size blocksPerRow = _width / BLOCK_SIZE;
+
+    for (types::Int blockY = tileMinY; blockY < tileMinY + TILE_HEIGHT; blockY += BLOCK_SIZE)
+    {
+        for (types::Int blockX = tileMinX; blockX < tileMinX + TILE_WIDTH; blockX += BLOCK_SIZE)
+        {
+            types::Float maxDepth = 0.0F;
+            for (types::Int y = blockY; y < blockY + BLOCK_SIZE; y++)
+            {
+                auto rowBegin = _depth.begin() + y * _width + blockX;
+                maxDepth = std::max(maxDepth, *std::max_element(rowBegin, rowBegin + BLOCK_SIZE));
+            }
+            _blocksMaxDepth[gsl::narrow_cast<size_t>((blockY / BLOCK_SIZE) * blocksPerRow +
+                                                     blockX / BLOCK_SIZE)] = maxDepth;
+        }
+    }
+}
+
+bool OcclusionCuller::isVisible(BoundingBox const &worldBox) const
+{
+    if (worldBox.isEmpty())
+    {
+        return false;
+    }
+
+    auto width = static_cast<types::Float>(_width);
+    auto height = static_cast<types::Float>(_height);
+
+    types::FVec2 screenMin(std::numeric_limits<types::Float>::max());
+    types::FVec2 screenMax(std::numeric_limits<types::Float>::lowest());
+    types::Float minDepth = std::numeric_limits<types::Float>::max();
+
+    for (types::UInt corner = 0; corner < 8; corner++)
+    {
+        types::FVec3 position((corner & 1U) != 0 ? worldBox.max.x : worldBox.min.x,
+                              (corner & 2U) != 0 ? worldBox.max.y : worldBox.min.y,
+                              (corner & 4U) != 0 ? worldBox.max.z : worldBox.min.z);
+        types::FVec4 clip = _viewProjectionMatrix * types::FVec4(position, 1.0F);
+
+        // The box crosses the near plane, nothing can be in front of it
+        if (clip.w <= NEAR_W_EPSILON)
+        {
+            return true;
+        }
+
+        types::FVec3 ndc = types::FVec3(clip) / clip.w;
+        types::FVec2 screen((ndc.x * 0.5F + 0.5F) * width, (ndc.y * 0.5F + 0.5F) * height);
+        screenMin = glm::min(screenMin, screen);
+        screenMax = glm::max(screenMax, screen);
+        minDepth = std::min(minDepth, ndc.z * 0.5F + 0.5F);
+    }
+
+    if (screenMax.x < 0.0F || screenMax.y < 0.0F || screenMin.x >= width ||
+        screenMin.y >= height || minDepth > 1.0F)
+    {
+        return false;
+    }
+
+    types::Int minX = std::max(0, static_cast<types::Int>(std::floor(screenMin.x)));
+    types::Int minY = std::max(0, static_cast<types::Int>(std::floor(screenMin.y)));
+    types::Int maxX = std::min(_width - 1, static_cast<types::Int>(std::floor(screenMax.x)));
+    types::Int maxY = std::min(_height - 1, static_cast<types::Int>(std::floor(screenMax.y)));
+
+    types::Size blocksPerRow = _width / BLOCK_SIZE;
+
+    for (types::Int blockY = minY / BLOCK_SIZE; blockY <= maxY / BLOCK_SIZE; blockY++)
+    {
+        for (types::Int blockX = minX / BLOCK_SIZE; blockX <= maxX / BLOCK_SIZE; blockX++)
+        {
+            // Everything in the block is closer than the box
+            auto blockIndex = gsl::narrow_cast<size_t>(blockY * blocksPerRow + blockX);
+            if (minDepth > _blocksMaxDepth[blockIndex])
+            {
+                continue;
+            }
+
+            types::Int fromX = std::max(minX, blockX * BLOCK_SIZE);
+            types::Int toX = std::min(maxX, blockX * BLOCK_SIZE + BLOCK_SIZE - 1);
+            types::Int fromY = std::max(minY, blockY * BLOCK_SIZE);
+            types::Int toY = std::min(maxY, blockY * BLOCK_SIZE + BLOCK_SIZE - 1);
+
+            for (types::Int y = fromY; y <= toY; y++)
+            {
+                for (types::Int x = fromX; x <= toX; x++)
+                {
+                    if (minDepth <= _depth[gsl::narrow_cast<size_t>(y * _width + x)])
+                    {
+                        return true;
+                    }
+                }
+            }
+        }
+    }
+    return false;
+}
+
+void OcclusionCuller::cull(std::span<BoundingBox const> worldBoxes,
+                           std::vector<types::UInt> &indices)
+{
+    auto visibleEnd = std::remove_if(indices.begin(),
+                                     indices.end(),
+                                     [this, &worldBoxes](types::UInt index)
+                                     { return !isVisible(worldBoxes[index]); });
+
+    auto visibleCount = gsl::narrow_cast<types::Size>(std::distance(indices.begin(), visibleEnd));
+    _statistics.visibleCount += visibleCount;
+    _statistics.occludedCount += gsl::narrow_cast<types::Size>(indices.size()) - visibleCount;
+
+    indices.erase(visibleEnd, indices.end());
+}
+
+types::Float OcclusionCuller::depth(types::Size x, types::Size y) const
+{
+    if (x < 0 || y < 0 || x >= _width || y >= _height)
+    {
+        throw std::out_of_range(
+            fmt::format("Pixel ({}, {}) is outside of the depth buffer.", x, y));
+    }
+    return _depth[gsl::narrow_cast<size_t>(y * _width + x)];
+}
+
+types::Size OcclusionCuller::width() const
+{
+    return _width;
+}
+
+types::Size OcclusionCuller::height() const
+{
+    return _height;
+}
+
+OcclusionCuller::Statistics const &OcclusionCuller::statistics() const
+{
+    return _statistics;
+}
+
+void OcclusionCuller::resetStatistics()
+{
+    _statistics = {};
+}
+
+} // namespace pf::gl
@@ -0,0 +1,94 @@
+#include <pf_gl/OcclusionQuery.hpp>
+
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include <glad/glad.h>
+
+#include <pf_gl/Window.hpp>
+#include <pf_gl/ValueTypes.hpp>
+
+namespace pf::gl
+{
+
+OcclusionQuery::OcclusionQuery(std::shared_ptr<Window> window)
+    : _window(std::move(window))
+    , _id(0)
+    , _target(GLAD_GL_VERSION_4_3 != 0 ? GL_ANY_SAMPLES_PASSED_CONSERVATIVE
+                                       : GL_ANY_SAMPLES_PASSED)
+{
+    _window->bindContext();
+
+    glGenQueries(1, &_id);
+    if (_id == 0)
+    {
+        throw std::runtime_error("Failed to generate an occlusion query.");
+    }
+}
+
+OcclusionQuery::~OcclusionQuery()
+{
+    _window->bindContext();
+    glDeleteQueries(1, &_id);
+}
+
+void OcclusionQuery::begin()
+{
+    _window->bindContext();
+    glBeginQuery(_target, _id);
+}
+
+void OcclusionQuery::end()
+{
+    _window->bindContext();
+    glEndQuery(_target);
+    _pending = true;
+}
+
+bool OcclusionQuery::pollResult()
+{
+    if (!_pending)
+    {
+        return false;
+    }
+
+    _window->bindContext();
+
+    types::UInt available = GL_FALSE;
+    glGetQueryObjectuiv(_id, GL_QUERY_RESULT_AVAILABLE, &available);
+    if (available == GL_FALSE)
+    {
+        return false;
+    }
+
+    types::UInt result = GL_FALSE;
+    glGetQueryObjectuiv(_id, GL_QUERY_RESULT, &result);
+    _anySamplesPassed = result != GL_FALSE;
+    _pending = false;
+    return true;
+}
+
+bool OcclusionQuery::isPending() const
+{
+    return _pending;
+}
+
+bool OcclusionQuery::anySamplesPassed() const
+{
+    return _anySamplesPassed;
+}
+
+void OcclusionQuery::beginConditionalRender(ConditionalRenderMode mode) const
+{
+    _window->bindContext();
+    glBeginConditionalRender(_id, mode == WAIT ? GL_QUERY_WAIT : GL_QUERY_NO_WAIT);
+}
+
+void OcclusionQuery::endConditionalRender() const
+{
+    _window->bindContext();
+    glEndConditionalRender();
+}
+
+} // namespace pf::gl
@@ -8,36 +8,32 @@
 #include <filesystem>
 #include <cassert>
 #include <iterator>
-#include <regex>
 #include <span>
 #include <ranges>
 #include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <cstddef>
+#include <string_view>
+#include <cstdint>
+#include <optional>
 
 #include <glad/glad.h>
 #include <fmt/format.h>
-#include <sparsepp/spp.h>
 #include <gsl/util>
 
+#include <pf_gl/ShaderCache.hpp>
+#include <pf_gl/ShaderPreprocessor.hpp>
+#include <pf_gl/ShaderStage.hpp>
 #include <pf_gl/Window.hpp>
 #include <pf_gl/ValueTypes.hpp>
-#include <pf_utils/FileUtils.hpp>
 #include <pf_utils/Hashing.hpp>
+#include <pf_utils/PerfectHash.hpp>
 
 namespace pf::gl
 {
 
-spp::sparse_hash_map<Shader::Type, GLenum> const FROM_SHADER_TYPE_TO_GL_ENUM{
-    {Shader::VERTEX_SHADER, GL_VERTEX_SHADER},
-    {Shader::FRAGMENT_SHADER, GL_FRAGMENT_SHADER},
-    {Shader::COMPUTE_SHADER, GL_COMPUTE_SHADER},
-};
-
-spp::sparse_hash_map<Shader::Type, std::string> const FROM_SHADER_TYPE_TO_HUMAN_STRING{
-    {Shader::VERTEX_SHADER, "vertex shader"},
-    {Shader::FRAGMENT_SHADER, "fragment shader"},
-    {Shader::COMPUTE_SHADER, "compute shader"},
-};
-
 types::UInt compileShader(char const *shaderSource, Shader::Type shaderType);
 
 types::UInt linkProgram(std::vector<types::UInt> const &shaderIds);
@@ -49,37 +45,73 @@ Shader::Shader()
 
 Shader::Shader(std::shared_ptr<Window> window,
                std::filesystem::path const &vertexShaderPath,
-               std::filesystem::path const &fragmentShaderPath)
+               std::filesystem::path const &fragmentShaderPath,
+               std::shared_ptr<ShaderCache> const &cache)
     : _window(std::move(window))
 {
-    _window->bindContext();
+    createProgram({{VERTEX_SHADER, readSource(vertexShaderPath)},
+                   {FRAGMENT_SHADER, readSource(fragmentShaderPath)}},
+                  cache.get());
+}
 
-    std::string vertexShaderSource = pf::util::file::readAsText(vertexShaderPath);
-    std::string fragmentShaderSource = pf::util::file::readAsText(fragmentShaderPath);
-    types::UInt vertexShader = compileShader(vertexShaderSource.c_str(), VERTEX_SHADER);
-    types::UInt fragmentShader = compileShader(fragmentShaderSource.c_str(), FRAGMENT_SHADER);
-    _id = linkProgram({vertexShader, fragmentShader});
+Shader::Shader(Shader &&other) noexcept
+    : _id(std::exchange(other._id, 0))
+    , _window(std::move(other._window))
+    , _uniforms(std::move(other._uniforms))
+    , _uniformBlocks(std::move(other._uniformBlocks))
+    , _storageBlocks(std::move(other._storageBlocks))
+    , _vertexInputs(std::move(other._vertexInputs))
+{
+}
+
+Shader &Shader::operator=(Shader &&other) noexcept
+{
+    if (this == &other)
+    {
+        return *this;
+    }
 
-    retrieveUniforms();
+    if (_id != 0)
+    {
+        _window->bindContext();
+        glDeleteProgram(_id);
+    }
+    _id = std::exchange(other._id, 0);
+    _window = std::move(other._window);
+    _uniforms = std::move(other._uniforms);
+    _uniformBlocks = std::move(other._uniformBlocks);
+    _storageBlocks = std::move(other._storageBlocks);
+    _vertexInputs = std::move(other._vertexInputs);
+    return *this;
 }
 
 Shader::Shader(std::shared_ptr<Window> window,
                std::filesystem::path const &shaderPath,
-               Type shaderType)
+               Type shaderType,
+               std::shared_ptr<ShaderCache> const &cache)
     : _window(std::move(window))
 {
-    if (FROM_SHADER_TYPE_TO_GL_ENUM.find(shaderType) == FROM_SHADER_TYPE_TO_GL_ENUM.end())
+    if (!isSupported(shaderType))
     {
         throw std::invalid_argument("Specified shader type is not supported.");
     }
 
-    _window->bindContext();
-
-    std::string shaderSource = pf::util::file::readAsText(shaderPath);
-    types::UInt shader = compileShader(shaderSource.c_str(), shaderType);
-    _id = linkProgram({shader});
+    createProgram({{shaderType, readSource(shaderPath)}}, cache.get());
+}
 
-    retrieveUniforms();
+Shader Shader::depthOnly(std::shared_ptr<Window> window,
+                         std::filesystem::path const &vertexShaderPath,
+                         std::shared_ptr<ShaderCache> const &cache)
+{
+    std::string vertexShaderSource = readSource(vertexShaderPath);
+    std::string fragmentShaderSource = depthOnlyFragmentSource(vertexShaderSource);
+
+    Shader shader;
+    shader._window = std::move(window);
+    shader.createProgram({{VERTEX_SHADER, std::move(vertexShaderSource)},
+                          {FRAGMENT_SHADER, std::move(fragmentShaderSource)}},
+                         cache.get());
+    return shader;
 }
 
 void Shader::use() const
@@ -155,131 +187,440 @@ types::Int Shader::getUniformLocation(char const *name)
     return uniformLocation;
 }
 
-spp::sparse_hash_map<std::string, Uniform::Purpose> const Uniform::NAME_TO_PURPOSE{
-    {"u_time", ELAPSED_TIME_SECONDS},
-    {"u_resolution", VIEWPORT_SIZE},
-    {"u_model", MODEL_MATRIX},
-    {"u_view", VIEW_MATRIX},
-    {"u_projection", PROJECTION_MATRIX},
-    {"u_diffuseTexture", DIFFUSE_TEXTURE},
-    {"u_specularTexture", SPECULAR_TEXTURE},
-    {"u_shininess", SHININESS},
-    {"u_spotLight", SPOT_LIGHT},
-    {"u_spotLightEnabled", SPOT_LIGHT_ENABLED},
-    {"u_directionalLight", DIRECTIONAL_LIGHT},
-    {"u_directionalLightEnabled", DIRECTIONAL_LIGHT_ENABLED},
-    {"u_pointLights", POINT_LIGHT},
-    {"u_pointLightsCount", POINT_LIGHTS_COUNT},
-    {"u_color", COLOR},
+namespace
+{
+
+using PurposeContext = std::pair<Uniform::Purpose, std::string_view>;
+
+struct PurposeContextHash
+{
+    std::uint64_t constexpr operator()(PurposeContext const &key, std::uint64_t seed) const
+    {
+        return pf::util::fnv1a(key.second, seed ^ (key.first * pf::util::FNV1A_PRIME));
+    }
 };
 
-spp::sparse_hash_map<std::pair<Uniform::Purpose, std::string>,
-                     Uniform::Purpose,
-                     pf::util::PairHash> const Uniform::CONTEXT_NAME_TO_PURPOSE{
-    {{SPOT_LIGHT, "position"}, SPOT_LIGHT_POSITION},
-    {{SPOT_LIGHT, "direction"}, SPOT_LIGHT_DIRECTION},
-    {{SPOT_LIGHT, "cosCutOff"}, SPOT_LIGHT_CUTOFF},
-    {{SPOT_LIGHT, "cosOuterCutOff"}, SPOT_LIGHT_OUTER_CUTOFF},
-    {{SPOT_LIGHT, "ambient"}, SPOT_LIGHT_AMBIENT},
-    {{SPOT_LIGHT, "diffuse"}, SPOT_LIGHT_DIFFUSE},
-    {{SPOT_LIGHT, "specular"}, SPOT_LIGHT_SPECULAR},
-    {{SPOT_LIGHT, "constantFactor"}, SPOT_LIGHT_CONSTANT_FACTOR},
-    {{SPOT_LIGHT, "linearFactor"}, SPOT_LIGHT_LINEAR_FACTOR},
-    {{SPOT_LIGHT, "quadraticFactor"}, SPOT_LIGHT_QUADRATIC_FACTOR},
-
-    {{DIRECTIONAL_LIGHT, "direction"}, DIRECTIONAL_LIGHT_DIRECTION},
-    {{DIRECTIONAL_LIGHT, "ambient"}, DIRECTIONAL_LIGHT_AMBIENT},
-    {{DIRECTIONAL_LIGHT, "diffuse"}, DIRECTIONAL_LIGHT_DIFFUSE},
-    {{DIRECTIONAL_LIGHT, "specular"}, DIRECTIONAL_LIGHT_SPECULAR},
-
-    {{POINT_LIGHT, "position"}, POINT_LIGHT_POSITION},
-    {{POINT_LIGHT, "ambient"}, POINT_LIGHT_AMBIENT},
-    {{POINT_LIGHT, "diffuse"}, POINT_LIGHT_DIFFUSE},
-    {{POINT_LIGHT, "specular"}, POINT_LIGHT_SPECULAR},
-    {{POINT_LIGHT, "constantFactor"}, POINT_LIGHT_CONSTANT_FACTOR},
-    {{POINT_LIGHT, "linearFactor"}, POINT_LIGHT_LINEAR_FACTOR},
-    {{POINT_LIGHT, "quadraticFactor"}, POINT_LIGHT_QUADRATIC_FACTOR},
+pf::util::PerfectHashMap constexpr NAME_TO_PURPOSE(
+    std::to_array<std::pair<std::string_view, Uniform::Purpose>>({
+        {"u_time", Uniform::ELAPSED_TIME_SECONDS},
+        {"u_resolution", Uniform::VIEWPORT_SIZE},
+        {"u_model", Uniform::MODEL_MATRIX},
+        {"u_view", Uniform::VIEW_MATRIX},
+        {"u_projection", Uniform::PROJECTION_MATRIX},
+        {"u_diffuseTexture", Uniform::DIFFUSE_TEXTURE},
+        {"u_specularTexture", Uniform::SPECULAR_TEXTURE},
+        {"u_diffuseTextureArray", Uniform::DIFFUSE_TEXTURE_ARRAY},
+        {"u_textureLayer", Uniform::TEXTURE_LAYER},
+        {"u_shininess", Uniform::SHININESS},
+        {"u_spotLight", Uniform::SPOT_LIGHT},
+        {"u_spotLightEnabled", Uniform::SPOT_LIGHT_ENABLED},
+        {"u_directionalLight", Uniform::DIRECTIONAL_LIGHT},
+        {"u_directionalLightEnabled", Uniform::DIRECTIONAL_LIGHT_ENABLED},
+        {"u_pointLights", Uniform::POINT_LIGHT},
+        {"u_pointLightsCount", Uniform::POINT_LIGHTS_COUNT},
+        {"u_color", Uniform::COLOR},
+    }));
+
+pf::util::PerfectHashMap<PurposeContext, Uniform::Purpose, 21, PurposeContextHash> constexpr
+    CONTEXT_NAME_TO_PURPOSE(std::to_array<std::pair<PurposeContext, Uniform::Purpose>>({
+        {{Uniform::SPOT_LIGHT, "position"}, Uniform::SPOT_LIGHT_POSITION},
+        {{Uniform::SPOT_LIGHT, "direction"}, Uniform::SPOT_LIGHT_DIRECTION},
+        {{Uniform::SPOT_LIGHT, "cosCutOff"}, Uniform::SPOT_LIGHT_CUTOFF},
+        {{Uniform::SPOT_LIGHT, "cosOuterCutOff"}, Uniform::SPOT_LIGHT_OUTER_CUTOFF},
+        {{Uniform::SPOT_LIGHT, "ambient"}, Uniform::SPOT_LIGHT_AMBIENT},
+        {{Uniform::SPOT_LIGHT, "diffuse"}, Uniform::SPOT_LIGHT_DIFFUSE},
+        {{Uniform::SPOT_LIGHT, "specular"}, Uniform::SPOT_LIGHT_SPECULAR},
+        {{Uniform::SPOT_LIGHT, "constantFactor"}, Uniform::SPOT_LIGHT_CONSTANT_FACTOR},
+        {{Uniform::SPOT_LIGHT, "linearFactor"}, Uniform::SPOT_LIGHT_LINEAR_FACTOR},
+        {{Uniform::SPOT_LIGHT, "quadraticFactor"}, Uniform::SPOT_LIGHT_QUADRATIC_FACTOR},
+
+        {{Uniform::DIRECTIONAL_LIGHT, "direction"}, Uniform::DIRECTIONAL_LIGHT_DIRECTION},
+        {{Uniform::DIRECTIONAL_LIGHT, "ambient"}, Uniform::DIRECTIONAL_LIGHT_AMBIENT},
+        {{Uniform::DIRECTIONAL_LIGHT, "diffuse"}, Uniform::DIRECTIONAL_LIGHT_DIFFUSE},
+        {{Uniform::DIRECTIONAL_LIGHT, "specular"}, Uniform::DIRECTIONAL_LIGHT_SPECULAR},
+
+        {{Uniform::POINT_LIGHT, "position"}, Uniform::POINT_LIGHT_POSITION},
+        {{Uniform::POINT_LIGHT, "ambient"}, Uniform::POINT_LIGHT_AMBIENT},
+        {{Uniform::POINT_LIGHT, "diffuse"}, Uniform::POINT_LIGHT_DIFFUSE},
+        {{Uniform::POINT_LIGHT, "specular"}, Uniform::POINT_LIGHT_SPECULAR},
+        {{Uniform::POINT_LIGHT, "constantFactor"}, Uniform::POINT_LIGHT_CONSTANT_FACTOR},
+        {{Uniform::POINT_LIGHT, "linearFactor"}, Uniform::POINT_LIGHT_LINEAR_FACTOR},
+        {{Uniform::POINT_LIGHT, "quadraticFactor"}, Uniform::POINT_LIGHT_QUADRATIC_FACTOR},
+    }));
+
+bool isWord(std::string_view text)
+{
+    auto isWordCharacter = [](char c)
+    { return std::isalnum(static_cast<unsigned char>(c)) != 0 || c == '_'; };
+    return !text.empty() && std::ranges::all_of(text, isWordCharacter);
+}
+
+bool isNumber(std::string_view text)
+{
+    auto isDigit = [](char c) { return std::isdigit(static_cast<unsigned char>(c)) != 0; };
+    return !text.empty() && std::ranges::all_of(text, isDigit);
+}
+
+/**
+ * Calls the function with the name and the queried properties of every active resource of the
+ * interface, the properties are fetched all at once per resource.
+ */
+template <std::size_t PROPERTIES_COUNT, typename Function>
+void forEachResource(GLuint program,
+                     GLenum programInterface,
+                     std::array<GLenum, PROPERTIES_COUNT> const &properties,
+                     Function &&function)
+{
+    types::Int resourcesCount = 0;
+    types::Int maxNameLength = 0;
+    glGetProgramInterfaceiv(program, programInterface, GL_ACTIVE_RESOURCES, &resourcesCount);
+    glGetProgramInterfaceiv(program, programInterface, GL_MAX_NAME_LENGTH, &maxNameLength);
+
+    std::string name(maxNameLength, '\0');
+    std::array<types::Int, PROPERTIES_COUNT> values{};
+    for (types::Int index = 0; index < resourcesCount; index++)
+    {
+        glGetProgramResourceiv(program,
+                               programInterface,
+                               index,
+                               gsl::narrow_cast<GLsizei>(properties.size()),
+                               properties.data(),
+                               gsl::narrow_cast<GLsizei>(values.size()),
+                               nullptr,
+                               values.data());
+        GLsizei nameLength = 0;
+        glGetProgramResourceName(
+            program, programInterface, index, maxNameLength, &nameLength, name.data());
+        function(std::string_view(name.data(), nameLength), values);
+    }
+}
+
+std::vector<ShaderBlock> retrieveBlocks(GLuint program, GLenum programInterface)
+{
+    std::vector<ShaderBlock> blocks;
+    forEachResource(program,
+                    programInterface,
+                    std::array<GLenum, 2>{GL_BUFFER_BINDING, GL_BUFFER_DATA_SIZE},
+                    [&blocks](std::string_view name, auto const &values)
+                    {
+                        blocks.push_back({
+                            .name = std::string(name),
+                            .binding = values[0],
+                            .dataSize = values[1],
+                        });
+                    });
+    return blocks;
+}
+
+/**
+ * Uniform types set with a single integer.
+ */
+std::array<GLenum, 20> constexpr INTEGER_UNIFORM_TYPES = {
+    GL_INT,
+    GL_BOOL,
+    GL_SAMPLER_1D,
+    GL_SAMPLER_2D,
+    GL_SAMPLER_3D,
+    GL_SAMPLER_CUBE,
+    GL_SAMPLER_1D_ARRAY,
+    GL_SAMPLER_2D_ARRAY,
+    GL_SAMPLER_CUBE_MAP_ARRAY,
+    GL_SAMPLER_2D_SHADOW,
+    GL_SAMPLER_2D_ARRAY_SHADOW,
+    GL_SAMPLER_CUBE_SHADOW,
+    GL_SAMPLER_2D_MULTISAMPLE,
+    GL_SAMPLER_BUFFER,
+    GL_INT_SAMPLER_2D,
+    GL_UNSIGNED_INT_SAMPLER_2D,
+    GL_IMAGE_2D,
+    GL_IMAGE_2D_ARRAY,
+    GL_IMAGE_3D,
+    GL_IMAGE_CUBE,
 };
 
-std::regex const IS_ARRAY(R"(^(\w+)\[(\d+)\]$)");
-std::regex const SPLIT_BY_PERIOD(R"(\.)");
+template <UniformValue T>
+bool isSetWith(GLenum uniformType)
+{
+    if constexpr (std::same_as<T, types::Float>)
+    {
+        return uniformType == GL_FLOAT;
+    }
+    else if constexpr (std::same_as<T, types::FVec2>)
+    {
+        return uniformType == GL_FLOAT_VEC2;
+    }
+    else if constexpr (std::same_as<T, types::FVec3>)
+    {
+        return uniformType == GL_FLOAT_VEC3;
+    }
+    else if constexpr (std::same_as<T, types::FVec4>)
+    {
+        return uniformType == GL_FLOAT_VEC4;
+    }
+    else if constexpr (std::same_as<T, types::FMat4>)
+    {
+        return uniformType == GL_FLOAT_MAT4;
+    }
+    else if constexpr (std::same_as<T, types::Int>)
+    {
+        return std::ranges::find(INTEGER_UNIFORM_TYPES, uniformType) !=
+               INTEGER_UNIFORM_TYPES.end();
+    }
+    else if constexpr (std::same_as<T, types::IntVec2>)
+    {
+        return uniformType == GL_INT_VEC2;
+    }
+    else
+    {
+        return uniformType == GL_BOOL;
+    }
+}
+
+} // namespace
 
-void Shader::retrieveUniforms()
+Uniform Uniform::fromName(std::string_view fullName)
 {
-    assert(_id != 0 && _window != nullptr);
+    // "first[2].second.third" is split into "first", 2 and "second.third", the secondary name of
+    // "first[2]" is the whole name
+    std::string_view::size_type firstPeriod = fullName.find('.');
+    std::string_view baseName = fullName.substr(0, firstPeriod);
+    std::string_view secondaryName =
+        firstPeriod == std::string_view::npos ? fullName : fullName.substr(firstPeriod + 1);
+
+    types::Int arrayIndex = -1;
+    std::string_view::size_type bracket = baseName.find('[');
+    if (bracket != std::string_view::npos && baseName.back() == ']' &&
+        isWord(baseName.substr(0, bracket)) &&
+        isNumber(baseName.substr(bracket + 1, baseName.size() - bracket - 2)))
+    {
+        std::string_view index = baseName.substr(bracket + 1, baseName.size() - bracket - 2);
+        std::from_chars(index.data(), index.data() + index.size(), arrayIndex);
+        baseName = baseName.substr(0, bracket);
+    }
 
-    types::Int uniformsCount = 0;
-    glGetProgramiv(_id, GL_ACTIVE_UNIFORMS, &uniformsCount);
+    Uniform uniform = {
+        .fullName = std::string(fullName),
+        .baseName = std::string(baseName),
+        .secondaryName = std::string(secondaryName),
+        .arrayIndex = arrayIndex,
+    };
+
+    uniform.purpose = NAME_TO_PURPOSE.find(uniform.baseName).value_or(GENERIC);
+    uniform.purpose = CONTEXT_NAME_TO_PURPOSE.find({uniform.purpose, uniform.secondaryName})
+                          .value_or(uniform.purpose);
+    return uniform;
+}
 
-    for (types::Int uniformIndex = 0; uniformIndex < uniformsCount; uniformIndex++)
+template <UniformValue T>
+UniformHandle<T> Shader::uniformHandle(std::string_view name) const
+{
+    if (_id == 0)
     {
-        std::string rawUniformName(GL_ACTIVE_UNIFORM_MAX_LENGTH, ' ');
-        GLenum uniformType = 0;
-        types::Int uniformSize = 0;
-
-        glGetActiveUniform(_id,
-                           uniformIndex,
-                           gsl::narrow_cast<types::Size>(rawUniformName.size()),
-                           nullptr,
-                           &uniformSize,
-                           &uniformType,
-                           &rawUniformName[0]);
-
-        // if rawUniformName = "first.second.last" iterates over "first", "second", "last"
-        std::sregex_token_iterator periodSeparatedFirst{
-            rawUniformName.begin(), rawUniformName.end(), SPLIT_BY_PERIOD, -1};
-        std::string rawBaseName = periodSeparatedFirst->str().c_str();
-
-        // Extract the secondary name
-        std::string uniformSecondaryName;
-        std::string::size_type firstPeriodPosition = rawUniformName.find('.', 0);
-        if (firstPeriodPosition == std::string::npos)
-        {
-            uniformSecondaryName = rawUniformName.c_str();
-        }
-        else
+        throw std::runtime_error("Cannot find the uniform of the dummy shader.");
+    }
+
+    // Arrays are reported with the index of the first element
+    auto uniform = std::ranges::find_if(
+        _uniforms,
+        [name](Uniform const &uniform)
         {
-            uniformSecondaryName = &rawUniformName[firstPeriodPosition + 1];
-        }
+            return uniform.fullName == name ||
+                   (uniform.fullName.size() == name.size() + 3 &&
+                    uniform.fullName.starts_with(name) && uniform.fullName.ends_with("[0]"));
+        });
+    if (uniform == _uniforms.end())
+    {
+        throw std::invalid_argument(fmt::format("Cannot find uniform \"{}\".", name));
+    }
+    if (!isSetWith<T>(uniform->type))
+    {
+        throw std::invalid_argument(fmt::format(
+            "Uniform \"{}\" of type 0x{:x} cannot be set with the requested type.",
+            name,
+            uniform->type));
+    }
+    return {_id, uniform->location};
+}
 
-        // Extract the base name and the array index
-        std::string uniformBaseName;
-        types::Int uniformArrayIndex = -1;
+template UniformHandle<types::Float> Shader::uniformHandle(std::string_view name) const;
+template UniformHandle<types::FVec2> Shader::uniformHandle(std::string_view name) const;
+template UniformHandle<types::FVec3> Shader::uniformHandle(std::string_view name) const;
+template UniformHandle<types::FVec4> Shader::uniformHandle(std::string_view name) const;
+template UniformHandle<types::FMat4> Shader::uniformHandle(std::string_view name) const;
+template UniformHandle<types::Int> Shader::uniformHandle(std::string_view name) const;
+template UniformHandle<types::IntVec2> Shader::uniformHandle(std::string_view name) const;
+template UniformHandle<types::Bool> Shader::uniformHandle(std::string_view name) const;
 
-        std::smatch isArrayMatch;
-        if (std::regex_search(rawBaseName, isArrayMatch, IS_ARRAY))
-        {
-            uniformBaseName = isArrayMatch.str(1);
-            uniformArrayIndex = std::stoi(isArrayMatch.str(2));
-        }
-        else
-        {
-            uniformBaseName = rawBaseName;
-            uniformArrayIndex = -1;
-        }
+void Shader::prepareUniforms() const
+{
+    if (_id == 0)
+    {
+        throw std::runtime_error("Cannot set the uniform value for the dummy shader.");
+    }
+
+    _window->bindContext();
+    if (GLAD_GL_VERSION_4_1 == 0)
+    {
+        glUseProgram(_id);
+    }
+}
+
+void Shader::uploadUniform(types::Int location, types::Float value) const
+{
+    if (GLAD_GL_VERSION_4_1 != 0)
+    {
+        glProgramUniform1f(_id, location, value);
+        return;
+    }
+    glUniform1f(location, value);
+}
 
-        // Derive the purpose of the uniform
-        Uniform::Purpose uniformPurpose = Uniform::GENERIC;
-        if (Uniform::NAME_TO_PURPOSE.find(uniformBaseName) != Uniform::NAME_TO_PURPOSE.end())
+void Shader::uploadUniform(types::Int location, types::FVec2 const &value) const
+{
+    if (GLAD_GL_VERSION_4_1 != 0)
+    {
+        glProgramUniform2f(_id, location, value.x, value.y);
+        return;
+    }
+    glUniform2f(location, value.x, value.y);
+}
+
+void Shader::uploadUniform(types::Int location, types::FVec3 const &value) const
+{
+    if (GLAD_GL_VERSION_4_1 != 0)
+    {
+        glProgramUniform3f(_id, location, value.x, value.y, value.z);
+        return;
+    }
+    glUniform3f(location, value.x, value.y, value.z);
+}
+
+void Shader::uploadUniform(types::Int location, types::FVec4 const &value) const
+{
+    if (GLAD_GL_VERSION_4_1 != 0)
+    {
+        glProgramUniform4f(_id, location, value.x, value.y, value.z, value.w);
+        return;
+    }
+    glUniform4f(location, value.x, value.y, value.z, value.w);
+}
+
+void Shader::uploadUniform(types::Int location, types::FMat4 const &value) const
+{
+    if (GLAD_GL_VERSION_4_1 != 0)
+    {
+        glProgramUniformMatrix4fv(_id, location, 1, GL_FALSE, &value[0][0]);
+        return;
+    }
+    glUniformMatrix4fv(location, 1, GL_FALSE, &value[0][0]);
+}
+
+void Shader::uploadUniform(types::Int location, types::Int value) const
+{
+    if (GLAD_GL_VERSION_4_1 != 0)
+    {
+        glProgramUniform1i(_id, location, value);
+        return;
+    }
+    glUniform1i(location, value);
+}
+
+void Shader::uploadUniform(types::Int location, types::IntVec2 const &value) const
+{
+    if (GLAD_GL_VERSION_4_1 != 0)
+    {
+        glProgramUniform2i(_id, location, value.x, value.y);
+        return;
+    }
+    glUniform2i(location, value.x, value.y);
+}
+
+void Shader::uploadUniform(types::Int location, types::Bool value) const
+{
+    uploadUniform(location, types::Int(value));
+}
+
+void Shader::introspect()
+{
+    assert(_id != 0 && _window != nullptr);
+
+    _uniforms.clear();
+    _uniformBlocks.clear();
+    _storageBlocks.clear();
+    _vertexInputs.clear();
+
+    if (GLAD_GL_VERSION_4_3 == 0)
+    {
+        introspectUniformsWithoutInterfaceQuery();
+        return;
+    }
+
+    forEachResource(
+        _id,
+        GL_UNIFORM,
+        std::array<GLenum, 4>{GL_TYPE, GL_ARRAY_SIZE, GL_LOCATION, GL_BLOCK_INDEX},
+        [this](std::string_view name, auto const &values)
         {
-            uniformPurpose = Uniform::NAME_TO_PURPOSE.at(uniformBaseName);
-        }
+            // Members of the uniform blocks are set through the buffers
+            if (values[3] != -1)
+            {
+                return;
+            }
+            Uniform uniform = Uniform::fromName(name);
+            uniform.type = gsl::narrow_cast<GLenum>(values[0]);
+            uniform.arraySize = values[1];
+            uniform.location = values[2];
+            _uniforms.push_back(std::move(uniform));
+        });
+
+    _uniformBlocks = retrieveBlocks(_id, GL_UNIFORM_BLOCK);
+    _storageBlocks = retrieveBlocks(_id, GL_SHADER_STORAGE_BLOCK);
+
+    // The inputs of the first stage, for a compute program there are none
+    forEachResource(_id,
+                    GL_PROGRAM_INPUT,
+                    std::array<GLenum, 3>{GL_TYPE, GL_ARRAY_SIZE, GL_LOCATION},
+                    [this](std::string_view name, auto const &values)
+                    {
+                        // Built-in inputs such as gl_VertexID have no location
+                        if (values[2] == -1)
+                        {
+                            return;
+                        }
+                        _vertexInputs.push_back({
+                            .name = std::string(name),
+                            .location = values[2],
+                            .type = gsl::narrow_cast<GLenum>(values[0]),
+                            .arraySize = values[1],
+                        });
+                    });
+}
+
+void Shader::introspectUniformsWithoutInterfaceQuery()
+{
+    types::Int uniformsCount = 0;
+    types::Int maxNameLength = 0;
+    glGetProgramiv(_id, GL_ACTIVE_UNIFORMS, &uniformsCount);
+    glGetProgramiv(_id, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
 
-        auto contextedPurpose = Uniform::CONTEXT_NAME_TO_PURPOSE.find(
-            std::pair<Uniform::Purpose, std::string>{uniformPurpose, uniformSecondaryName});
-        if (contextedPurpose != Uniform::CONTEXT_NAME_TO_PURPOSE.end())
+    std::string name(maxNameLength, '\0');
+    for (types::Int uniformIndex = 0; uniformIndex < uniformsCount; uniformIndex++)
+    {
+        GLsizei nameLength = 0;
+        types::Int arraySize = 0;
+        GLenum type = 0;
+        glGetActiveUniform(
+            _id, uniformIndex, maxNameLength, &nameLength, &arraySize, &type, name.data());
+
+        types::Int location = glGetUniformLocation(_id, name.c_str());
+        if (location == -1)
         {
-            uniformPurpose = contextedPurpose->second;
+            continue;
         }
-
-        Uniform uniform = {
-            .fullName = rawUniformName.c_str(),
-            .baseName = uniformBaseName,
-            .secondaryName = uniformSecondaryName,
-            .arrayIndex = uniformArrayIndex,
-            .location = getUniformLocation(rawUniformName.c_str()),
-            .purpose = uniformPurpose,
-        };
+        Uniform uniform = Uniform::fromName(std::string_view(name.data(), nameLength));
+        uniform.type = type;
+        uniform.arraySize = arraySize;
+        uniform.location = location;
         _uniforms.push_back(std::move(uniform));
     }
 }
@@ -305,6 +646,21 @@ void Shader::unbind() const
     return _uniforms;
 }
 
+std::span<ShaderBlock const> Shader::uniformBlocks() const
+{
+    return _uniformBlocks;
+}
+
+std::span<ShaderBlock const> Shader::storageBlocks() const
+{
+    return _storageBlocks;
+}
+
+std::span<VertexInput const> Shader::vertexInputs() const
+{
+    return _vertexInputs;
+}
+
 Shader::~Shader()
 {
     if (_id == 0)
@@ -316,9 +672,78 @@ Shader::~Shader()
     glDeleteProgram(_id);
 }
 
+Shader::Shader(std::shared_ptr<Window> window, types::UInt programId)
+    : _id(programId)
+    , _window(std::move(window))
+{
+    _window->bindContext();
+    introspect();
+}
+
+std::string Shader::readSource(std::filesystem::path const &shaderPath)
+{
+    return ShaderPreprocessor().process(shaderPath).source;
+}
+
+std::string Shader::depthOnlyFragmentSource(std::string const &vertexShaderSource)
+{
+    // The fragment shader must be of the same version as the vertex one
+    std::string::size_type versionStart = vertexShaderSource.find("#version");
+    if (versionStart == std::string::npos)
+    {
+        throw std::invalid_argument("Vertex shader has no version directive.");
+    }
+    std::string::size_type versionEnd = vertexShaderSource.find('\n', versionStart);
+    return vertexShaderSource.substr(versionStart, versionEnd - versionStart) +
+           "\n\nvoid main()\n{\n}\n";
+}
+
+std::uint64_t Shader::cacheKey(std::vector<std::pair<Type, std::string>> const &stages)
+{
+    std::vector<std::string> sources;
+    for (auto const &[type, source] : stages)
+    {
+        sources.push_back(std::string(SHADER_STAGES[type].humanName));
+        sources.push_back(source);
+    }
+    return ShaderCache::key(sources, {}, ShaderCache::driverIdentity());
+}
+
+void Shader::createProgram(std::vector<std::pair<Type, std::string>> const &stages,
+                           ShaderCache *cache)
+{
+    _window->bindContext();
+
+    std::uint64_t programCacheKey = 0;
+    if (cache != nullptr)
+    {
+        programCacheKey = cacheKey(stages);
+        std::optional<types::UInt> cachedProgram = cache->loadProgram(programCacheKey);
+        if (cachedProgram.has_value())
+        {
+            _id = cachedProgram.value();
+            introspect();
+            return;
+        }
+    }
+
+    std::vector<types::UInt> shaderIds;
+    for (auto const &[type, source] : stages)
+    {
+        shaderIds.push_back(compileShader(source.c_str(), type));
+    }
+    _id = linkProgram(shaderIds, cache != nullptr);
+
+    if (cache != nullptr)
+    {
+        cache->storeProgram(programCacheKey, _id);
+    }
+    introspect();
+}
+
 GLuint Shader::compileShader(char const *shaderSource, Type shaderType)
 {
-    types::UInt shaderId = glCreateShader(FROM_SHADER_TYPE_TO_GL_ENUM.at(shaderType));
+    types::UInt shaderId = glCreateShader(SHADER_STAGES.at(shaderType).glEnum);
     if (shaderId == 0)
     {
         throw std::runtime_error("Failed to create a shader.");
@@ -339,13 +764,13 @@ GLuint Shader::compileShader(char const *shaderSource, Type shaderType)
         glDeleteShader(shaderId);
 
         throw std::runtime_error(fmt::format(
-            "{} compilation error: {}.", FROM_SHADER_TYPE_TO_HUMAN_STRING.at(shaderType), infoLog));
+            "{} compilation error: {}.", SHADER_STAGES[shaderType].humanName, infoLog));
     }
 
     return shaderId;
 }
 
-GLuint Shader::linkProgram(std::vector<types::UInt> const &shaderIds)
+GLuint Shader::linkProgram(std::vector<types::UInt> const &shaderIds, bool retrievable)
 {
     GLuint programId = glCreateProgram();
     if (programId == 0)
@@ -353,6 +778,11 @@ GLuint Shader::linkProgram(std::vector<types::UInt> const &shaderIds)
         throw std::runtime_error("Failed to create a program");
     }
 
+    if (retrievable && GLAD_GL_VERSION_4_1 != 0)
+    {
+        glProgramParameteri(programId, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+
     for (types::UInt shader : shaderIds)
     {
         glAttachShader(programId, shader);
@@ -0,0 +1,295 @@
+#include <pf_gl/ShaderBuilder.hpp>
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <glad/glad.h>
+#include <fmt/format.h>
+
+#include <pf_gl/Shader.hpp>
+#include <pf_gl/ShaderCache.hpp>
+#include <pf_gl/ShaderStage.hpp>
+#include <pf_gl/ValueTypes.hpp>
+#include <pf_gl/Window.hpp>
+
+namespace pf::gl
+{
+
+namespace
+{
+
+// The parallel compilation is not a part of the loaded functions, both variants of the extension
+// share the values
+GLenum constexpr COMPLETION_STATUS = 0x91B1;
+GLuint constexpr MAX_COMPILER_THREADS = 0xFFFFFFFF;
+
+using MaxShaderCompilerThreads = void(APIENTRY *)(GLuint count);
+
+struct ParallelCompileExtension
+{
+    char const *name;
+    char const *maxShaderCompilerThreads;
+};
+
+std::array<ParallelCompileExtension, 2> constexpr PARALLEL_COMPILE_EXTENSIONS = {{
+    {.name = "GL_KHR_parallel_shader_compile",
+     .maxShaderCompilerThreads = "glMaxShaderCompilerThreadsKHR"},
+    {.name = "GL_ARB_parallel_shader_compile",
+     .maxShaderCompilerThreads = "glMaxShaderCompilerThreadsARB"},
+}};
+
+} // namespace
+
+ShaderBuilder::ShaderBuilder(std::shared_ptr<Window> window, std::shared_ptr<ShaderCache> cache)
+    : _window(std::move(window))
+    , _cache(std::move(cache))
+{
+    for (auto const &extension : PARALLEL_COMPILE_EXTENSIONS)
+    {
+        if (!_window->isExtensionSupported(extension.name))
+        {
+            continue;
+        }
+
+        // By default the driver may pick a single thread
+        _parallel = true;
+        auto maxShaderCompilerThreads = reinterpret_cast<MaxShaderCompilerThreads>(
+            _window->procAddress(extension.maxShaderCompilerThreads));
+        if (maxShaderCompilerThreads != nullptr)
+        {
+            maxShaderCompilerThreads(MAX_COMPILER_THREADS);
+        }
+        break;
+    }
+}
+
+ShaderBuilder::~ShaderBuilder()
+{
+    _window->bindContext();
+    for (auto &program : _programs)
+    {
+        for (auto [shaderId, type] : program.shaders)
+        {
+            glDeleteShader(shaderId);
+        }
+        if (program.state != TAKEN)
+        {
+            glDeleteProgram(program.id);
+        }
+    }
+}
+
+ShaderBuilder::Handle ShaderBuilder::add(std::filesystem::path const &vertexShaderPath,
+                                         std::filesystem::path const &fragmentShaderPath)
+{
+    return add(fmt::format("{} + {}", vertexShaderPath.string(), fragmentShaderPath.string()),
+               {{Shader::VERTEX_SHADER, Shader::readSource(vertexShaderPath)},
+                {Shader::FRAGMENT_SHADER, Shader::readSource(fragmentShaderPath)}});
+}
+
+ShaderBuilder::Handle ShaderBuilder::add(std::filesystem::path const &shaderPath,
+                                         Shader::Type shaderType)
+{
+    if (!isSupported(shaderType))
+    {
+        throw std::invalid_argument("Specified shader type is not supported.");
+    }
+    return add(shaderPath.string(), {{shaderType, Shader::readSource(shaderPath)}});
+}
+
+ShaderBuilder::Handle ShaderBuilder::addDepthOnly(std::filesystem::path const &vertexShaderPath)
+{
+    std::string vertexShaderSource = Shader::readSource(vertexShaderPath);
+    std::string fragmentShaderSource = Shader::depthOnlyFragmentSource(vertexShaderSource);
+    return add(fmt::format("{} (depth only)", vertexShaderPath.string()),
+               {{Shader::VERTEX_SHADER, std::move(vertexShaderSource)},
+                {Shader::FRAGMENT_SHADER, std::move(fragmentShaderSource)}});
+}
+
+ShaderBuilder::Handle
+ShaderBuilder::add(std::string name,
+                   std::vector<std::pair<Shader::Type, std::string>> const &stages)
+{
+    _window->bindContext();
+
+    Program program = {.name = std::move(name)};
+    if (_cache != nullptr)
+    {
+        program.cacheKey = Shader::cacheKey(stages);
+        std::optional<types::UInt> cachedProgram = _cache->loadProgram(program.cacheKey);
+        if (cachedProgram.has_value())
+        {
+            program.id = cachedProgram.value();
+            program.state = READY;
+            _programs.push_back(std::move(program));
+            return _programs.size() - 1;
+        }
+    }
+
+    // Nothing is checked here, any query of the status would wait for the driver
+    program.id = glCreateProgram();
+    if (program.id == 0)
+    {
+        throw std::runtime_error("Failed to create a program");
+    }
+    for (auto const &[type, source] : stages)
+    {
+        types::UInt shaderId = glCreateShader(SHADER_STAGES.at(type).glEnum);
+        if (shaderId == 0)
+        {
+            glDeleteProgram(program.id);
+            throw std::runtime_error("Failed to create a shader.");
+        }
+        char const *sourcePointer = source.c_str();
+        glShaderSource(shaderId, 1, &sourcePointer, nullptr);
+        glCompileShader(shaderId);
+        glAttachShader(program.id, shaderId);
+        program.shaders.emplace_back(shaderId, type);
+    }
+    if (_cache != nullptr && GLAD_GL_VERSION_4_1 != 0)
+    {
+        glProgramParameteri(program.id, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+    glLinkProgram(program.id);
+
+    _programs.push_back(std::move(program));
+    _pendingCount++;
+    return _programs.size() - 1;
+}
+
+bool ShaderBuilder::poll()
+{
+    _window->bindContext();
+
+    for (auto &program : _programs)
+    {
+        if (program.state != PENDING || !isCompleted(program))
+        {
+            continue;
+        }
+
+        complete(program);
+        if (!_parallel)
+        {
+            break;
+        }
+    }
+    return _pendingCount == 0;
+}
+
+void ShaderBuilder::finish()
+{
+    _window->bindContext();
+
+    for (auto &program : _programs)
+    {
+        if (program.state == PENDING)
+        {
+            complete(program);
+        }
+    }
+}
+
+bool ShaderBuilder::isReady(Handle handle) const
+{
+    return _programs.at(handle).state != PENDING;
+}
+
+Shader ShaderBuilder::take(Handle handle)
+{
+    Program &program = _programs.at(handle);
+    switch (program.state)
+    {
+    case PENDING:
+        throw std::logic_error(fmt::format("Program {} is not ready yet.", program.name));
+    case TAKEN:
+        throw std::logic_error(fmt::format("Program {} has already been taken.", program.name));
+    case FAILED:
+        throw std::runtime_error(program.error);
+    case READY:
+        break;
+    }
+
+    program.state = TAKEN;
+    return {_window, program.id};
+}
+
+types::Size ShaderBuilder::pendingCount() const
+{
+    return _pendingCount;
+}
+
+bool ShaderBuilder::isParallel() const
+{
+    return _parallel;
+}
+
+bool ShaderBuilder::isCompleted(Program const &program) const
+{
+    if (!_parallel)
+    {
+        return true;
+    }
+
+    types::Int completed = GL_FALSE;
+    glGetProgramiv(program.id, COMPLETION_STATUS, &completed);
+    return completed != GL_FALSE;
+}
+
+void ShaderBuilder::complete(Program &program)
+{
+    for (auto [shaderId, type] : program.shaders)
+    {
+        types::Int hasCompiled = GL_FALSE;
+        glGetShaderiv(shaderId, GL_COMPILE_STATUS, &hasCompiled);
+        if (hasCompiled == GL_FALSE && program.error.empty())
+        {
+            types::Int infoLogLength = 0;
+            glGetShaderiv(shaderId, GL_INFO_LOG_LENGTH, &infoLogLength);
+            std::string infoLog(infoLogLength, ' ');
+            glGetShaderInfoLog(shaderId, infoLogLength, nullptr, infoLog.data());
+            program.error = fmt::format("{} ({}) compilation error: {}.",
+                                        SHADER_STAGES.at(type).humanName,
+                                        program.name,
+                                        infoLog);
+        }
+        glDetachShader(program.id, shaderId);
+        glDeleteShader(shaderId);
+    }
+    program.shaders.clear();
+
+    types::Int hasLinked = GL_FALSE;
+    glGetProgramiv(program.id, GL_LINK_STATUS, &hasLinked);
+    if (hasLinked == GL_FALSE && program.error.empty())
+    {
+        types::Int infoLogLength = 0;
+        glGetProgramiv(program.id, GL_INFO_LOG_LENGTH, &infoLogLength);
+        std::string infoLog(infoLogLength, ' ');
+        glGetProgramInfoLog(program.id, infoLogLength, nullptr, infoLog.data());
+        program.error = fmt::format("Program linking error ({}): {}.", program.name, infoLog);
+    }
+
+    _pendingCount--;
+    if (!program.error.empty())
+    {
+        glDeleteProgram(program.id);
+        program.id = 0;
+        program.state = FAILED;
+        return;
+    }
+
+    if (_cache != nullptr)
+    {
+        _cache->storeProgram(program.cacheKey, program.id);
+    }
+    program.state = READY;
+}
+
+} // namespace pf::gl
@@ -0,0 +1,262 @@
+#include <pf_gl/ShaderCache.hpp>
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <glad/glad.h>
+#include <fmt/format.h>
+#include <gsl/util>
+
+#include <pf_gl/ValueTypes.hpp>
+#include <pf_utils/Hashing.hpp>
+#include <pf_utils/MappedFile.hpp>
+
+namespace pf::gl
+{
+
+namespace
+{
+
+static_assert(std::endian::native == std::endian::little,
+              "Cached programs are read by copying the values as they are.");
+
+struct Header
+{
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint64_t key;
+    std::uint32_t binaryFormat;
+    std::uint32_t reserved;
+    std::uint64_t binarySize;
+};
+
+/**
+ * Separates the strings, so that moving the characters from one to another changes the key.
+ */
+std::uint64_t hashString(std::string_view string, std::uint64_t seed)
+{
+    std::uint64_t size = string.size();
+    std::uint64_t hash = pf::util::fnv1a(
+        std::string_view(reinterpret_cast<char const *>(&size), sizeof(size)), seed);
+    return pf::util::fnv1a(string, hash);
+}
+
+std::string glString(GLenum name)
+{
+    auto const *value = reinterpret_cast<char const *>(glGetString(name));
+    return value == nullptr ? std::string() : std::string(value);
+}
+
+} // namespace
+
+ShaderCache::ShaderCache(std::filesystem::path directory)
+    : _directory(std::move(directory))
+{
+    std::filesystem::create_directories(_directory);
+}
+
+std::uint64_t ShaderCache::key(std::span<std::string const> sources,
+                               std::span<std::string const> definitions,
+                               std::string_view driverIdentity)
+{
+    std::uint64_t hash = hashString(driverIdentity, pf::util::FNV1A_OFFSET_BASIS);
+    for (auto const &list : {sources, definitions})
+    {
+        std::uint64_t count = list.size();
+        hash = pf::util::fnv1a(
+            std::string_view(reinterpret_cast<char const *>(&count), sizeof(count)), hash);
+        for (auto const &string : list)
+        {
+            hash = hashString(string, hash);
+        }
+    }
+    return hash;
+}
+
+std::string ShaderCache::driverIdentity()
+{
+    return fmt::format("{}\n{}\n{}\n{}",
+                       glString(GL_VENDOR),
+                       glString(GL_RENDERER),
+                       glString(GL_VERSION),
+                       glString(GL_SHADING_LANGUAGE_VERSION));
+}
+
+bool ShaderCache::isSupported()
+{
+    if (GLAD_GL_VERSION_4_1 == 0)
+    {
+        return false;
+    }
+    GLint formatsCount = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatsCount);
+    return formatsCount > 0;
+}
+
+std::optional<ShaderCache::Entry> ShaderCache::load(std::uint64_t key) const
+{
+    std::filesystem::path path = entryPath(key);
+    std::error_code error;
+    if (!std::filesystem::is_regular_file(path, error))
+    {
+        return std::nullopt;
+    }
+
+    try
+    {
+        pf::util::MappedFile file(path);
+        std::span<std::byte const> bytes = file.bytes();
+
+        Header header = {};
+        if (bytes.size() < sizeof(Header))
+        {
+            return std::nullopt;
+        }
+        std::memcpy(&header, bytes.data(), sizeof(Header));
+        if (header.magic != MAGIC || header.version != VERSION || header.key != key ||
+            header.binarySize != bytes.size() - sizeof(Header))
+        {
+            return std::nullopt;
+        }
+
+        std::span<std::byte const> binary = bytes.subspan(sizeof(Header));
+        return Entry{
+            .binaryFormat = header.binaryFormat,
+            .binary = std::vector<std::byte>(binary.begin(), binary.end()),
+        };
+    }
+    catch (std::runtime_error const &)
+    {
+        return std::nullopt;
+    }
+}
+
+void ShaderCache::store(std::uint64_t key, Entry const &entry) const
+{
+    Header header = {
+        .magic = MAGIC,
+        .version = VERSION,
+        .key = key,
+        .binaryFormat = entry.binaryFormat,
+        .reserved = 0,
+        .binarySize = entry.binary.size(),
+    };
+
+    std::filesystem::path path = entryPath(key);
+    std::filesystem::path temporaryPath = path;
+    temporaryPath += ".tmp";
+
+    std::ofstream fileStream;
+    fileStream.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+    try
+    {
+        fileStream.open(temporaryPath, std::ofstream::out | std::ofstream::binary);
+        fileStream.write(reinterpret_cast<char const *>(&header), sizeof(Header));
+        fileStream.write(reinterpret_cast<char const *>(entry.binary.data()),
+                         gsl::narrow_cast<std::streamsize>(entry.binary.size()));
+        fileStream.close();
+        std::filesystem::rename(temporaryPath, path);
+    }
+    catch (std::exception const &e)
+    {
+        std::error_code error;
+        std::filesystem::remove(temporaryPath, error);
+        throw std::runtime_error(
+            fmt::format("Error while writing the cached program ({}).\nDetails: {}.",
+                        path.string(),
+                        e.what()));
+    }
+}
+
+std::optional<types::UInt> ShaderCache::loadProgram(std::uint64_t key)
+{
+    std::optional<Entry> entry = isSupported() ? load(key) : std::nullopt;
+    if (!entry.has_value())
+    {
+        _statistics.misses++;
+        return std::nullopt;
+    }
+
+    types::UInt program = glCreateProgram();
+    if (program == 0)
+    {
+        throw std::runtime_error("Failed to create a program");
+    }
+    glProgramBinary(program,
+                    entry->binaryFormat,
+                    entry->binary.data(),
+                    gsl::narrow_cast<GLsizei>(entry->binary.size()));
+
+    // Drivers reject the binaries of their previous versions, they are simply compiled again
+    types::Int hasLinked = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &hasLinked);
+    if (hasLinked == GL_FALSE)
+    {
+        glDeleteProgram(program);
+        _statistics.misses++;
+        _statistics.rejected++;
+        return std::nullopt;
+    }
+
+    _statistics.hits++;
+    return program;
+}
+
+bool ShaderCache::storeProgram(std::uint64_t key, types::UInt program)
+{
+    if (!isSupported())
+    {
+        return false;
+    }
+
+    types::Int binarySize = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &binarySize);
+    if (binarySize <= 0)
+    {
+        return false;
+    }
+
+    Entry entry;
+    entry.binary.resize(static_cast<size_t>(binarySize));
+    GLsizei writtenSize = 0;
+    glGetProgramBinary(program, binarySize, &writtenSize, &entry.binaryFormat, entry.binary.data());
+    entry.binary.resize(static_cast<size_t>(writtenSize));
+
+    try
+    {
+        store(key, entry);
+    }
+    catch (std::runtime_error const &)
+    {
+        return false;
+    }
+    return true;
+}
+
+std::filesystem::path const &ShaderCache::directory() const
+{
+    return _directory;
+}
+
+ShaderCache::Statistics const &ShaderCache::statistics() const
+{
+    return _statistics;
+}
+
+std::filesystem::path ShaderCache::entryPath(std::uint64_t key) const
+{
+    return _directory / fmt::format("{:016x}{}", key, EXTENSION);
+}
+
+} // namespace pf::gl
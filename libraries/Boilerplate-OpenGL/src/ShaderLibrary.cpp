@@ -0,0 +1,93 @@
+#include <pf_gl/ShaderLibrary.hpp>
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gsl/util>
+
+#include <pf_gl/Shader.hpp>
+#include <pf_gl/ShaderCache.hpp>
+#include <pf_gl/ShaderPreprocessor.hpp>
+#include <pf_gl/ValueTypes.hpp>
+#include <pf_gl/Window.hpp>
+
+namespace pf::gl
+{
+
+ShaderLibrary::ShaderLibrary(std::shared_ptr<Window> window,
+                             std::filesystem::path const &vertexShaderPath,
+                             std::filesystem::path const &fragmentShaderPath,
+                             std::vector<std::string> featureNames,
+                             std::vector<ShaderDefinition> constants,
+                             std::shared_ptr<ShaderCache> cache,
+                             ShaderPreprocessor const &preprocessor)
+    : _window(std::move(window))
+    , _cache(std::move(cache))
+    , _vertexShaderSource(preprocessor.process(vertexShaderPath).source)
+    , _fragmentShaderSource(preprocessor.process(fragmentShaderPath).source)
+    , _featureNames(std::move(featureNames))
+    , _constants(std::move(constants))
+{
+    if (_featureNames.size() > MAX_FEATURES_COUNT)
+    {
+        throw std::invalid_argument(fmt::format("At most {} features are supported, got {}.",
+                                                MAX_FEATURES_COUNT,
+                                                _featureNames.size()));
+    }
+}
+
+Shader &ShaderLibrary::get(Features features)
+{
+    auto permutation = _permutations.find(features);
+    if (permutation != _permutations.end())
+    {
+        return *permutation->second;
+    }
+
+    std::vector<ShaderDefinition> featureDefinitions = definitions(features);
+    auto shader = std::make_unique<Shader>();
+    shader->_window = _window;
+    shader->createProgram({{Shader::VERTEX_SHADER,
+                            ShaderPreprocessor::define(_vertexShaderSource, featureDefinitions)},
+                           {Shader::FRAGMENT_SHADER,
+                            ShaderPreprocessor::define(_fragmentShaderSource, featureDefinitions)}},
+                          _cache.get());
+
+    Shader &created = *shader;
+    _permutations.emplace(features, std::move(shader));
+    return created;
+}
+
+std::vector<ShaderDefinition> ShaderLibrary::definitions(Features features) const
+{
+    if (_featureNames.size() < MAX_FEATURES_COUNT && (features >> _featureNames.size()) != 0)
+    {
+        throw std::invalid_argument(
+            fmt::format("Features 0x{:x} include unknown ones, there are only {}.",
+                        features,
+                        _featureNames.size()));
+    }
+
+    std::vector<ShaderDefinition> result = _constants;
+    for (std::size_t feature = 0; feature < _featureNames.size(); feature++)
+    {
+        if ((features & (Features(1) << feature)) != 0)
+        {
+            result.push_back({.name = _featureNames[feature], .value = ""});
+        }
+    }
+    return result;
+}
+
+types::Size ShaderLibrary::permutationsCount() const
+{
+    return gsl::narrow_cast<types::Size>(_permutations.size());
+}
+
+} // namespace pf::gl
@@ -0,0 +1,189 @@
+#include <pf_gl/ShaderPreprocessor.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <pf_utils/FileUtils.hpp>
+
+namespace pf::gl
+{
+
+namespace
+{
+
+std::string_view constexpr WHITESPACE = " \t\r\v\f";
+std::string_view constexpr INCLUDE_KEYWORD = "include";
+
+struct IncludeDirective
+{
+    std::string_view name;
+    bool quoted;
+};
+
+std::string_view trimFront(std::string_view text)
+{
+    auto start = text.find_first_not_of(WHITESPACE);
+    return start == std::string_view::npos ? std::string_view() : text.substr(start);
+}
+
+/**
+ * Recognizes `#include "name"` and `#include <name>` lines. Whitespace is allowed around the hash
+ * sign and the name, and the line may end with a `//` comment.
+ */
+std::optional<IncludeDirective> parseInclude(std::string_view line)
+{
+    line = trimFront(line);
+    if (!line.starts_with('#'))
+    {
+        return std::nullopt;
+    }
+    line = trimFront(line.substr(1));
+    if (!line.starts_with(INCLUDE_KEYWORD))
+    {
+        return std::nullopt;
+    }
+    line = trimFront(line.substr(INCLUDE_KEYWORD.size()));
+    if (line.empty() || (line.front() != '"' && line.front() != '<'))
+    {
+        return std::nullopt;
+    }
+
+    bool quoted = line.front() == '"';
+    auto nameEnd = line.find(quoted ? '"' : '>', 1);
+    if (nameEnd == std::string_view::npos || nameEnd == 1)
+    {
+        return std::nullopt;
+    }
+
+    std::string_view rest = trimFront(line.substr(nameEnd + 1));
+    if (!rest.empty() && !rest.starts_with("//"))
+    {
+        return std::nullopt;
+    }
+    return IncludeDirective{.name = line.substr(1, nameEnd - 1), .quoted = quoted};
+}
+
+} // namespace
+
+ShaderPreprocessor::ShaderPreprocessor(std::vector<std::filesystem::path> includeDirectories)
+    : _includeDirectories(std::move(includeDirectories))
+{
+}
+
+ShaderPreprocessor::Result
+ShaderPreprocessor::process(std::filesystem::path const &shaderPath) const
+{
+    Result result;
+    processFile(shaderPath, result);
+    return result;
+}
+
+std::string ShaderPreprocessor::define(std::string const &source,
+                                       std::span<ShaderDefinition const> definitions)
+{
+    std::string::size_type versionStart = source.find("#version");
+    if (versionStart == std::string::npos)
+    {
+        throw std::invalid_argument("Shader has no version directive.");
+    }
+    if (definitions.empty())
+    {
+        return source;
+    }
+
+    std::string::size_type versionEnd = source.find('\n', versionStart);
+    std::string::size_type insertAt =
+        versionEnd == std::string::npos ? source.size() : versionEnd + 1;
+    auto versionLine = std::count(source.begin(), source.begin() + versionStart, '\n') + 1;
+
+    std::string defined = source.substr(0, insertAt);
+    if (versionEnd == std::string::npos)
+    {
+        defined += '\n';
+    }
+    for (auto const &definition : definitions)
+    {
+        if (definition.name.empty())
+        {
+            throw std::invalid_argument("Definition has no name.");
+        }
+        defined += fmt::format("#define {} {}\n", definition.name, definition.value);
+    }
+    // Errors in the rest of the source are still reported at the lines of the file
+    defined += fmt::format("#line {}\n", versionLine + 1);
+    defined.append(source, insertAt);
+    return defined;
+}
+
+std::span<std::filesystem::path const> ShaderPreprocessor::includeDirectories() const
+{
+    return _includeDirectories;
+}
+
+void ShaderPreprocessor::processFile(std::filesystem::path const &path, Result &result) const
+{
+    auto sourceIndex = result.files.size();
+    result.files.push_back(std::filesystem::weakly_canonical(path));
+
+    std::istringstream input(pf::util::file::readAsText(path));
+    std::string line;
+    for (size_t lineNumber = 1; std::getline(input, line); lineNumber++)
+    {
+        std::optional<IncludeDirective> include = parseInclude(line);
+        if (!include.has_value())
+        {
+            result.source += line;
+            result.source += '\n';
+            continue;
+        }
+
+        std::filesystem::path includedPath = std::filesystem::weakly_canonical(
+            resolve(std::string(include->name), include->quoted, path));
+        if (std::find(result.files.begin(), result.files.end(), includedPath) != result.files.end())
+        {
+            // Already pasted, the empty line keeps the numbering
+            result.source += '\n';
+            continue;
+        }
+
+        result.source += fmt::format("#line 1 {}\n", result.files.size());
+        processFile(includedPath, result);
+        result.source += fmt::format("#line {} {}\n", lineNumber + 1, sourceIndex);
+    }
+}
+
+std::filesystem::path ShaderPreprocessor::resolve(std::string const &includedName,
+                                                  bool quoted,
+                                                  std::filesystem::path const &includingPath) const
+{
+    if (quoted)
+    {
+        std::filesystem::path nextToIncluding = includingPath.parent_path() / includedName;
+        if (std::filesystem::exists(nextToIncluding))
+        {
+            return nextToIncluding;
+        }
+    }
+    for (auto const &directory : _includeDirectories)
+    {
+        std::filesystem::path inDirectory = directory / includedName;
+        if (std::filesystem::exists(inDirectory))
+        {
+            return inDirectory;
+        }
+    }
+    throw std::runtime_error(fmt::format(
+        "Cannot find \"{}\" included from \"{}\".", includedName, includingPath.string()));
+}
+
+} // namespace pf::gl
@@ -0,0 +1,127 @@
+#include <pf_gl/SkylinePacker.hpp>
+
+#include <algorithm>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <pf_gl/ValueTypes.hpp>
+
+namespace pf::gl
+{
+
+SkylinePacker::SkylinePacker(types::Size width, types::Size height)
+    : _width(width)
+    , _height(height)
+{
+    if (_width <= 0 || _height <= 0)
+    {
+        throw std::invalid_argument(fmt::format("Bin of {}x{} is empty.", _width, _height));
+    }
+    _skyline.push_back({.x = 0, .y = 0, .width = _width});
+}
+
+std::optional<SkylinePacker::Rectangle> SkylinePacker::insert(types::Size width,
+                                                              types::Size height)
+{
+    if (width <= 0 || height <= 0)
+    {
+        return std::nullopt;
+    }
+
+    // Bottom-left: the lowest top edge, then the narrowest segment to waste less of the skyline
+    std::optional<size_t> bestSegment;
+    types::Size bestY = 0;
+    for (size_t i = 0; i < _skyline.size(); i++)
+    {
+        auto y = fit(i, width, height);
+        if (!y.has_value())
+        {
+            continue;
+        }
+        if (!bestSegment.has_value() || *y < bestY ||
+            (*y == bestY && _skyline[i].width < _skyline[*bestSegment].width))
+        {
+            bestSegment = i;
+            bestY = *y;
+        }
+    }
+    if (!bestSegment.has_value())
+    {
+        return std::nullopt;
+    }
+
+    Rectangle rectangle = {
+        .x = _skyline[*bestSegment].x, .y = bestY, .width = width, .height = height};
+
+    // The new segment covers the rectangle, the segments under it are shrunk or removed
+    _skyline.insert(_skyline.begin() + static_cast<long>(*bestSegment),
+                    {.x = rectangle.x, .y = rectangle.y + height, .width = width});
+    for (size_t i = *bestSegment + 1; i < _skyline.size();)
+    {
+        Segment const &previous = _skyline[i - 1];
+        Segment &segment = _skyline[i];
+        types::Size overlap = previous.x + previous.width - segment.x;
+        if (overlap <= 0)
+        {
+            break;
+        }
+        if (segment.width > overlap)
+        {
+            segment.x += overlap;
+            segment.width -= overlap;
+            break;
+        }
+        _skyline.erase(_skyline.begin() + static_cast<long>(i));
+    }
+
+    // Neighbors at the same height make a single segment
+    for (size_t i = 1; i < _skyline.size();)
+    {
+        if (_skyline[i - 1].y == _skyline[i].y)
+        {
+            _skyline[i - 1].width += _skyline[i].width;
+            _skyline.erase(_skyline.begin() + static_cast<long>(i));
+        }
+        else
+        {
+            i++;
+        }
+    }
+
+    _usedArea += static_cast<types::BinarySize>(width) * height;
+    return rectangle;
+}
+
+types::Float SkylinePacker::occupancy() const
+{
+    return static_cast<types::Float>(_usedArea) /
+           (static_cast<types::Float>(_width) * static_cast<types::Float>(_height));
+}
+
+std::optional<types::Size>
+SkylinePacker::fit(size_t segmentIndex, types::Size width, types::Size height) const
+{
+    if (_skyline[segmentIndex].x + width > _width)
+    {
+        return std::nullopt;
+    }
+
+    // The rectangle rests on the highest of the segments it spans
+    types::Size y = 0;
+    types::Size widthLeft = width;
+    for (size_t i = segmentIndex; widthLeft > 0; i++)
+    {
+        y = std::max(y, _skyline[i].y);
+        widthLeft -= _skyline[i].width;
+    }
+    if (y + height > _height)
+    {
+        return std::nullopt;
+    }
+    return y;
+}
+
+} // namespace pf::gl
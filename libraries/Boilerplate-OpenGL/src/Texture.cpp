@@ -1,21 +1,55 @@
 #include <pf_gl/Texture.hpp>
 
+#include <algorithm>
 #include <stdexcept>
 #include <memory>
 #include <utility>
 #include <string>
 #include <filesystem>
 
-#define STB_IMAGE_IMPLEMENTATION
-#include <stb/stb_image.h>
+#include <fmt/format.h>
+#include <gsl/util>
 
+#include <pf_gl/BlockCompressor.hpp>
+#include <pf_gl/Image.hpp>
+#include <pf_gl/TextureFile.hpp>
 #include <pf_gl/Window.hpp>
 #include <pf_gl/ValueTypes.hpp>
-#include <pf_utils/Math.hpp>
 
 namespace pf::gl
 {
 
+namespace
+{
+
+/**
+ * S3TC formats come from the EXT_texture_compression_s3tc extension, which is not in the core
+ * profile headers, though every desktop driver supports it.
+ */
+GLenum constexpr COMPRESSED_RGB_S3TC_DXT1 = 0x83F0;
+GLenum constexpr COMPRESSED_RGBA_S3TC_DXT5 = 0x83F3;
+GLenum constexpr COMPRESSED_SRGB_S3TC_DXT1 = 0x8C4C;
+GLenum constexpr COMPRESSED_SRGB_ALPHA_S3TC_DXT5 = 0x8C4F;
+
+GLenum compressedFormatToGLenum(BlockCompressor::Format format, bool srgb)
+{
+    switch (format)
+    {
+    case BlockCompressor::BC1:
+        return srgb ? COMPRESSED_SRGB_S3TC_DXT1 : COMPRESSED_RGB_S3TC_DXT1;
+    case BlockCompressor::BC3:
+        return srgb ? COMPRESSED_SRGB_ALPHA_S3TC_DXT5 : COMPRESSED_RGBA_S3TC_DXT5;
+    case BlockCompressor::BC5:
+        return GL_COMPRESSED_RG_RGTC2;
+    case BlockCompressor::BC7:
+        return srgb ? GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM : GL_COMPRESSED_RGBA_BPTC_UNORM;
+    default:
+        throw std::invalid_argument("Unknown block compression format.");
+    }
+}
+
+} // namespace
+
 Texture::Texture(std::shared_ptr<Window> window,
                  std::filesystem::path const &filePath,
                  TextureType textureType,
@@ -28,31 +62,90 @@ Texture::Texture(std::shared_ptr<Window> window,
     , _textureType(textureType)
     , _filePath(filePath)
 {
-    stbi_set_flip_vertically_on_load(flipVertically ? 1 : 0);
+    generate(wrapS, wrapT, minFilter, magFilter);
 
-    int channelsCount = 0;
-    unsigned char *data =
-        stbi_load(filePath.string().c_str(), &_width, &_height, &channelsCount, 0);
-    if (data == nullptr)
+    try
     {
-        throw std::runtime_error("Could not load the image " + filePath.string() + ".");
+        if (filePath.extension() == TextureFile::EXTENSION)
+        {
+            loadCompressed();
+        }
+        else
+        {
+            loadImage(flipVertically);
+        }
     }
-
-    types::Int format = 0;
-    if (channelsCount == 1)
-    {
-        format = GL_RED;
-    }
-    else if (channelsCount == 3)
-    {
-        format = GL_RGB;
-    }
-    else if (channelsCount == 4)
+    catch (...)
     {
-        format = GL_RGBA;
+        glDeleteTextures(1, &_texture);
+        throw;
     }
+    _loaded = true;
+}
 
+Texture::Texture(std::shared_ptr<Window> window,
+                 std::filesystem::path filePath,
+                 TextureType textureType,
+                 types::Int wrapS,
+                 types::Int wrapT,
+                 types::Int minFilter,
+                 types::Int magFilter)
+    : _window(std::move(window))
+    , _textureType(textureType)
+    , _filePath(std::move(filePath))
+{
+    generate(wrapS, wrapT, minFilter, magFilter);
+}
+
+Texture::~Texture()
+{
     _window->bindContext();
+    glDeleteTextures(1, &_texture);
+}
+
+void Texture::bind() const
+{
+    _window->bindContext();
+    glBindTexture(GL_TEXTURE_2D, _texture);
+}
+
+TextureType Texture::type() const
+{
+    return _textureType;
+}
+
+std::filesystem::path Texture::filePath() const
+{
+    return _filePath;
+}
+
+void Texture::unbind() const
+{
+    _window->bindContext();
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+bool Texture::isLoaded() const
+{
+    return _loaded;
+}
+
+void Texture::generate(types::Int wrapS,
+                       types::Int wrapT,
+                       types::Int minFilter,
+                       types::Int magFilter)
+{
+    _window->bindContext();
+
+    if (GLAD_GL_VERSION_4_5 != 0)
+    {
+        glCreateTextures(GL_TEXTURE_2D, 1, &_texture);
+        glTextureParameteri(_texture, GL_TEXTURE_WRAP_S, wrapS);
+        glTextureParameteri(_texture, GL_TEXTURE_WRAP_T, wrapT);
+        glTextureParameteri(_texture, GL_TEXTURE_MIN_FILTER, minFilter);
+        glTextureParameteri(_texture, GL_TEXTURE_MAG_FILTER, magFilter);
+        return;
+    }
 
     glGenTextures(1, &_texture);
     glBindTexture(GL_TEXTURE_2D, _texture);
@@ -61,43 +154,220 @@ Texture::Texture(std::shared_ptr<Window> window,
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrapT);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, magFilter);
-    if (!pf::util::math::isPoT(_width) || !util::math::isPoT(_height))
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void Texture::allocateStorage(types::Size width,
+                              types::Size height,
+                              GLenum internalFormat,
+                              types::Size levelsCount)
+{
+    _width = width;
+    _height = height;
+
+    if (GLAD_GL_VERSION_4_5 != 0)
     {
-        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTextureStorage2D(_texture, levelsCount, internalFormat, _width, _height);
+        return;
     }
 
-    glTexImage2D(GL_TEXTURE_2D, 0, format, _width, _height, 0, format, GL_UNSIGNED_BYTE, data);
-    glGenerateMipmap(GL_TEXTURE_2D);
-
-    stbi_image_free(data);
+    glBindTexture(GL_TEXTURE_2D, _texture);
+    if (GLAD_GL_VERSION_4_2 != 0)
+    {
+        glTexStorage2D(GL_TEXTURE_2D, levelsCount, internalFormat, _width, _height);
+    }
+    else
+    {
+        // Same as the immutable storage, as long as nobody respecifies the levels
+        for (types::Size level = 0; level < levelsCount; level++)
+        {
+            glTexImage2D(GL_TEXTURE_2D,
+                         level,
+                         gsl::narrow_cast<types::Int>(internalFormat),
+                         std::max(1, _width >> level),
+                         std::max(1, _height >> level),
+                         0,
+                         GL_RGBA,
+                         GL_UNSIGNED_BYTE,
+                         nullptr);
+        }
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levelsCount - 1);
+    }
     glBindTexture(GL_TEXTURE_2D, 0);
 }
 
-Texture::~Texture()
+void Texture::uploadPixels(types::Int firstRow, types::Size rowsCount, void const *pixels)
 {
-    _window->bindContext();
-    glDeleteTextures(1, &_texture);
+    if (GLAD_GL_VERSION_4_5 != 0)
+    {
+        glTextureSubImage2D(
+            _texture, 0, 0, firstRow, _width, rowsCount, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+        return;
+    }
+
+    glBindTexture(GL_TEXTURE_2D, _texture);
+    glTexSubImage2D(
+        GL_TEXTURE_2D, 0, 0, firstRow, _width, rowsCount, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+    glBindTexture(GL_TEXTURE_2D, 0);
 }
 
-void Texture::bind() const
+void Texture::generateMipmap()
 {
-    _window->bindContext();
+    if (GLAD_GL_VERSION_4_5 != 0)
+    {
+        glGenerateTextureMipmap(_texture);
+        return;
+    }
+
     glBindTexture(GL_TEXTURE_2D, _texture);
+    glGenerateMipmap(GL_TEXTURE_2D);
+    glBindTexture(GL_TEXTURE_2D, 0);
 }
 
-TextureType Texture::type() const
+void Texture::loadImage(bool flipVertically)
 {
-    return _textureType;
+    Image image(_filePath, flipVertically);
+    allocateStorage(image.width(), image.height(), GL_RGBA8, image.levelsCount());
+
+    // Rows of RGBA8 pixels are always aligned to 4 bytes, which is the default
+    uploadPixels(0, _height, image.pixels().data());
+    generateMipmap();
 }
 
-std::filesystem::path Texture::filePath() const
+void Texture::loadCompressed()
 {
-    return _filePath;
+    TextureFile file(_filePath);
+    _width = file.width();
+    _height = file.height();
+    GLenum internalFormat = compressedFormatToGLenum(file.format(), file.srgb());
+    bool immutable = GLAD_GL_VERSION_4_2 != 0;
+    bool directStateAccess = GLAD_GL_VERSION_4_5 != 0;
+
+    // Only the errors of the upload itself are checked below
+    while (glGetError() != GL_NO_ERROR)
+    {
+    }
+
+    if (immutable)
+    {
+        allocateStorage(_width, _height, internalFormat, file.levelsCount());
+    }
+    if (!directStateAccess)
+    {
+        glBindTexture(GL_TEXTURE_2D, _texture);
+    }
+
+    // Levels are uploaded straight from the mapped file
+    for (types::Size level = 0; level < file.levelsCount(); level++)
+    {
+        auto data = file.level(level);
+        types::Size levelWidth = std::max(1, _width >> level);
+        types::Size levelHeight = std::max(1, _height >> level);
+        auto dataSize = gsl::narrow_cast<types::Size>(data.size());
+
+        if (directStateAccess)
+        {
+            glCompressedTextureSubImage2D(_texture,
+                                          level,
+                                          0,
+                                          0,
+                                          levelWidth,
+                                          levelHeight,
+                                          internalFormat,
+                                          dataSize,
+                                          data.data());
+        }
+        else if (immutable)
+        {
+            glCompressedTexSubImage2D(GL_TEXTURE_2D,
+                                      level,
+                                      0,
+                                      0,
+                                      levelWidth,
+                                      levelHeight,
+                                      internalFormat,
+                                      dataSize,
+                                      data.data());
+        }
+        else
+        {
+            glCompressedTexImage2D(GL_TEXTURE_2D,
+                                   level,
+                                   internalFormat,
+                                   levelWidth,
+                                   levelHeight,
+                                   0,
+                                   dataSize,
+                                   data.data());
+        }
+    }
+    if (!immutable)
+    {
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, file.levelsCount() - 1);
+    }
+    if (!directStateAccess)
+    {
+        glBindTexture(GL_TEXTURE_2D, 0);
+    }
+
+    if (glGetError() != GL_NO_ERROR)
+    {
+        throw std::runtime_error(
+            fmt::format("Failed to upload the compressed texture {}, the format might not be "
+                        "supported by the driver.",
+                        _filePath.string()));
+    }
 }
 
-void Texture::unbind() const
+void Texture::uploadLevel(TextureFile const &file, types::Size level)
+{
+    auto data = file.level(level);
+
+    // There is no Direct State Access counterpart for respecifying a mutable level
+    _window->bindContext();
+    glBindTexture(GL_TEXTURE_2D, _texture);
+    glCompressedTexImage2D(GL_TEXTURE_2D,
+                           level,
+                           compressedFormatToGLenum(file.format(), file.srgb()),
+                           std::max(1, _width >> level),
+                           std::max(1, _height >> level),
+                           0,
+                           gsl::narrow_cast<types::Size>(data.size()),
+                           data.data());
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void Texture::releaseLevel(TextureFile const &file, types::Size level)
+{
+    // An empty image frees the memory of the level
+    _window->bindContext();
+    glBindTexture(GL_TEXTURE_2D, _texture);
+    glCompressedTexImage2D(GL_TEXTURE_2D,
+                           level,
+                           compressedFormatToGLenum(file.format(), file.srgb()),
+                           0,
+                           0,
+                           0,
+                           0,
+                           nullptr);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void Texture::residentLevels(types::Size baseLevel, types::Size levelsCount)
 {
     _window->bindContext();
+    if (GLAD_GL_VERSION_4_5 != 0)
+    {
+        glTextureParameteri(_texture, GL_TEXTURE_BASE_LEVEL, baseLevel);
+        glTextureParameteri(_texture, GL_TEXTURE_MAX_LEVEL, levelsCount - 1);
+        return;
+    }
+
+    glBindTexture(GL_TEXTURE_2D, _texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, baseLevel);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levelsCount - 1);
     glBindTexture(GL_TEXTURE_2D, 0);
 }
 
@@ -0,0 +1,180 @@
+#include <pf_gl/TextureArray.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <utility>
+
+#include <glad/glad.h>
+#include <fmt/format.h>
+#include <gsl/util>
+
+#include <pf_gl/Image.hpp>
+#include <pf_gl/Texture.hpp>
+#include <pf_gl/ValueTypes.hpp>
+#include <pf_gl/Window.hpp>
+
+namespace pf::gl
+{
+
+TextureArray::TextureArray(std::shared_ptr<Window> window,
+                           std::span<Image const> layers,
+                           TextureType textureType,
+                           types::Int wrapS,
+                           types::Int wrapT,
+                           types::Int minFilter,
+                           types::Int magFilter)
+    : _window(std::move(window))
+    , _textureType(textureType)
+    , _layersCount(gsl::narrow_cast<types::Size>(layers.size()))
+{
+    if (layers.empty())
+    {
+        throw std::invalid_argument("Texture array needs at least one layer.");
+    }
+    _width = layers.front().width();
+    _height = layers.front().height();
+    for (auto const &layer : layers)
+    {
+        if (layer.width() != _width || layer.height() != _height)
+        {
+            throw std::invalid_argument(fmt::format("Layer of {}x{} in an array of {}x{} layers.",
+                                                    layer.width(),
+                                                    layer.height(),
+                                                    _width,
+                                                    _height));
+        }
+    }
+
+    _window->bindContext();
+    types::Size levelsCount = layers.front().levelsCount();
+    if (GLAD_GL_VERSION_4_5 != 0)
+    {
+        glCreateTextures(GL_TEXTURE_2D_ARRAY, 1, &_texture);
+        glTextureParameteri(_texture, GL_TEXTURE_WRAP_S, wrapS);
+        glTextureParameteri(_texture, GL_TEXTURE_WRAP_T, wrapT);
+        glTextureParameteri(_texture, GL_TEXTURE_MIN_FILTER, minFilter);
+        glTextureParameteri(_texture, GL_TEXTURE_MAG_FILTER, magFilter);
+
+        glTextureStorage3D(_texture, levelsCount, GL_RGBA8, _width, _height, _layersCount);
+        for (types::Size layer = 0; layer < _layersCount; layer++)
+        {
+            glTextureSubImage3D(_texture,
+                                0,
+                                0,
+                                0,
+                                layer,
+                                _width,
+                                _height,
+                                1,
+                                GL_RGBA,
+                                GL_UNSIGNED_BYTE,
+                                layers[static_cast<size_t>(layer)].pixels().data());
+        }
+        glGenerateTextureMipmap(_texture);
+        return;
+    }
+
+    glGenTextures(1, &_texture);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, _texture);
+
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, wrapS);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, wrapT);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, minFilter);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, magFilter);
+
+    if (GLAD_GL_VERSION_4_2 != 0)
+    {
+        glTexStorage3D(GL_TEXTURE_2D_ARRAY, levelsCount, GL_RGBA8, _width, _height, _layersCount);
+    }
+    else
+    {
+        for (types::Size level = 0; level < levelsCount; level++)
+        {
+            glTexImage3D(GL_TEXTURE_2D_ARRAY,
+                         level,
+                         GL_RGBA8,
+                         std::max(1, _width >> level),
+                         std::max(1, _height >> level),
+                         _layersCount,
+                         0,
+                         GL_RGBA,
+                         GL_UNSIGNED_BYTE,
+                         nullptr);
+        }
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_BASE_LEVEL, 0);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, levelsCount - 1);
+    }
+
+    for (types::Size layer = 0; layer < _layersCount; layer++)
+    {
+        glTexSubImage3D(GL_TEXTURE_2D_ARRAY,
+                        0,
+                        0,
+                        0,
+                        layer,
+                        _width,
+                        _height,
+                        1,
+                        GL_RGBA,
+                        GL_UNSIGNED_BYTE,
+                        layers[static_cast<size_t>(layer)].pixels().data());
+    }
+    glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+}
+
+TextureArray::~TextureArray()
+{
+    _window->bindContext();
+    glDeleteTextures(1, &_texture);
+}
+
+void TextureArray::bind() const
+{
+    _window->bindContext();
+    if (GLAD_GL_VERSION_4_5 != 0)
+    {
+        glBindTextureUnit(TEXTURE_UNIT, _texture);
+        return;
+    }
+    glActiveTexture(GL_TEXTURE0 + TEXTURE_UNIT);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, _texture);
+    glActiveTexture(GL_TEXTURE0);
+}
+
+void TextureArray::unbind() const
+{
+    _window->bindContext();
+    if (GLAD_GL_VERSION_4_5 != 0)
+    {
+        glBindTextureUnit(TEXTURE_UNIT, 0);
+        return;
+    }
+    glActiveTexture(GL_TEXTURE0 + TEXTURE_UNIT);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    glActiveTexture(GL_TEXTURE0);
+}
+
+TextureType TextureArray::type() const
+{
+    return _textureType;
+}
+
+types::Size TextureArray::width() const
+{
+    return _width;
+}
+
+types::Size TextureArray::height() const
+{
+    return _height;
+}
+
+types::Size TextureArray::layersCount() const
+{
+    return _layersCount;
+}
+
+} // namespace pf::gl
@@ -0,0 +1,165 @@
+#include <pf_gl/TextureArrayBuilder.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gsl/util>
+
+#include <pf_gl/Image.hpp>
+#include <pf_gl/SkylinePacker.hpp>
+#include <pf_gl/ValueTypes.hpp>
+
+namespace pf::gl
+{
+
+types::FVec2 TextureArrayBuilder::Region::remap(types::FVec2 textureCoordinates) const
+{
+    return {offset.x + textureCoordinates.x * scale.x, offset.y + textureCoordinates.y * scale.y};
+}
+
+TextureArrayBuilder::TextureArrayBuilder(types::Size atlasSize,
+                                         types::Size maxPackedSize,
+                                         types::Size padding)
+    : _atlasSize(atlasSize)
+    , _maxPackedSize(maxPackedSize)
+    , _padding(padding)
+{
+    if (_maxPackedSize < 0 || _padding < 0 || _maxPackedSize + 2 * _padding > _atlasSize)
+    {
+        throw std::invalid_argument(
+            fmt::format("Images of {} pixels with the padding of {} do not fit into {} pixels.",
+                        _maxPackedSize,
+                        _padding,
+                        _atlasSize));
+    }
+}
+
+types::UInt TextureArrayBuilder::add(Image image)
+{
+    _images.push_back(std::move(image));
+    return gsl::narrow_cast<types::UInt>(_images.size() - 1);
+}
+
+TextureArrayBuilder::Result TextureArrayBuilder::build()
+{
+    Result result;
+    result.regions.resize(_images.size());
+
+    std::vector<types::UInt> packed;
+    std::vector<types::UInt> grouped;
+    for (types::UInt i = 0; i < _images.size(); i++)
+    {
+        bool small = _images[i].width() <= _maxPackedSize && _images[i].height() <= _maxPackedSize;
+        (small ? packed : grouped).push_back(i);
+    }
+    pack(packed, result);
+    group(grouped, result);
+
+    _images.clear();
+    return result;
+}
+
+void TextureArrayBuilder::pack(std::vector<types::UInt> const &imageIndices, Result &result)
+{
+    if (imageIndices.empty())
+    {
+        return;
+    }
+
+    // Tallest first, the skyline stays flatter that way
+    std::vector<types::UInt> order = imageIndices;
+    std::stable_sort(order.begin(),
+                     order.end(),
+                     [this](types::UInt first, types::UInt second)
+                     { return _images[first].height() > _images[second].height(); });
+
+    auto arrayIndex = gsl::narrow_cast<types::Size>(result.arrays.size());
+    std::vector<std::vector<std::uint8_t>> pages;
+    std::vector<SkylinePacker> packers;
+    auto atlasSideSize = static_cast<size_t>(_atlasSize);
+
+    for (auto imageIndex : order)
+    {
+        Image const &image = _images[imageIndex];
+        types::Size paddedWidth = image.width() + 2 * _padding;
+        types::Size paddedHeight = image.height() + 2 * _padding;
+
+        // First fit, a new page is only started when none of the previous ones has the room
+        std::optional<SkylinePacker::Rectangle> rectangle;
+        size_t page = 0;
+        for (; page < packers.size() && !rectangle.has_value(); page++)
+        {
+            rectangle = packers[page].insert(paddedWidth, paddedHeight);
+        }
+        if (!rectangle.has_value())
+        {
+            packers.emplace_back(_atlasSize, _atlasSize);
+            pages.emplace_back(atlasSideSize * atlasSideSize * Image::CHANNELS_COUNT);
+            rectangle = packers.back().insert(paddedWidth, paddedHeight);
+            page = packers.size();
+        }
+        page--;
+
+        // The padding repeats the edge pixels
+        std::vector<std::uint8_t> &pixels = pages[page];
+        for (types::Int y = 0; y < paddedHeight; y++)
+        {
+            for (types::Int x = 0; x < paddedWidth; x++)
+            {
+                std::uint8_t const *source = image.pixel(x - _padding, y - _padding);
+                auto destination =
+                    (static_cast<size_t>(rectangle->y + y) * atlasSideSize + rectangle->x + x) *
+                    Image::CHANNELS_COUNT;
+                std::copy_n(source, Image::CHANNELS_COUNT, pixels.data() + destination);
+            }
+        }
+
+        auto atlasSize = static_cast<types::Float>(_atlasSize);
+        result.regions[imageIndex] = {
+            .array = arrayIndex,
+            .layer = gsl::narrow_cast<types::Size>(page),
+            .offset = types::FVec2(static_cast<types::Float>(rectangle->x + _padding) / atlasSize,
+                                   static_cast<types::Float>(rectangle->y + _padding) / atlasSize),
+            .scale = types::FVec2(static_cast<types::Float>(image.width()) / atlasSize,
+                                  static_cast<types::Float>(image.height()) / atlasSize),
+        };
+    }
+
+    std::vector<Image> &layers = result.arrays.emplace_back();
+    for (auto &pixels : pages)
+    {
+        layers.emplace_back(_atlasSize, _atlasSize, std::move(pixels));
+    }
+}
+
+void TextureArrayBuilder::group(std::vector<types::UInt> const &imageIndices, Result &result)
+{
+    std::map<std::pair<types::Size, types::Size>, types::Size> sizeToArray;
+    for (auto imageIndex : imageIndices)
+    {
+        Image &image = _images[imageIndex];
+        auto [array, inserted] = sizeToArray.try_emplace(
+            {image.width(), image.height()}, gsl::narrow_cast<types::Size>(result.arrays.size()));
+        if (inserted)
+        {
+            result.arrays.emplace_back();
+        }
+
+        std::vector<Image> &layers = result.arrays[array->second];
+        result.regions[imageIndex] = {
+            .array = array->second,
+            .layer = gsl::narrow_cast<types::Size>(layers.size()),
+            .offset = types::FVec2(0.0F, 0.0F),
+            .scale = types::FVec2(1.0F, 1.0F),
+        };
+        layers.push_back(std::move(image));
+    }
+}
+
+} // namespace pf::gl
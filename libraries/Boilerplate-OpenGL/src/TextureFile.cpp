@@ -0,0 +1,352 @@
+#include <pf_gl/TextureFile.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gsl/util>
+
+#include <pf_gl/BlockCompressor.hpp>
+#include <pf_gl/ValueTypes.hpp>
+#include <pf_utils/MappedFile.hpp>
+
+namespace pf::gl
+{
+
+namespace
+{
+
+static_assert(std::endian::native == std::endian::little,
+              "KTX2 files are read by copying the values as they are.");
+
+/**
+ * Identifier, then 9 header fields and 4 index fields of 4 bytes each, then 2 index fields of
+ * 8 bytes each.
+ */
+size_t constexpr HEADER_SIZE = 80;
+size_t constexpr LEVEL_INDEX_ENTRY_SIZE = 24;
+
+/**
+ * Values from the Khronos Data Format specification, the descriptor is required by KTX2.
+ */
+types::UInt constexpr DESCRIPTOR_VERSION = 2;
+types::UInt constexpr DESCRIPTOR_HEADER_SIZE = 24;
+types::UInt constexpr DESCRIPTOR_SAMPLE_SIZE = 16;
+types::UInt constexpr COLOR_PRIMARIES_BT709 = 1;
+types::UInt constexpr TRANSFER_FUNCTION_LINEAR = 1;
+types::UInt constexpr TRANSFER_FUNCTION_SRGB = 2;
+types::UInt constexpr SAMPLE_DATATYPE_LINEAR = 0x10;
+
+struct Sample
+{
+    types::UInt bitOffset;
+    types::UInt bitLength;
+    types::UInt channel;
+};
+
+struct FormatDescription
+{
+    BlockCompressor::Format format;
+    bool srgb;
+    types::UInt vulkanFormat;
+    types::UInt colorModel;
+    std::vector<Sample> samples;
+};
+
+std::vector<FormatDescription> const FORMATS = {
+    {BlockCompressor::BC1, false, 131, 128, {{0, 64, 0}}},
+    {BlockCompressor::BC1, true, 132, 128, {{0, 64, 0}}},
+    {BlockCompressor::BC3, false, 137, 130, {{0, 64, 15}, {64, 64, 0}}},
+    {BlockCompressor::BC3, true, 138, 130, {{0, 64, 15 | SAMPLE_DATATYPE_LINEAR}, {64, 64, 0}}},
+    {BlockCompressor::BC5, false, 141, 132, {{0, 64, 0}, {64, 64, 1}}},
+    {BlockCompressor::BC7, false, 145, 134, {{0, 128, 0}}},
+    {BlockCompressor::BC7, true, 146, 134, {{0, 128, 0}}},
+};
+
+std::string_view constexpr WRITER_KEY = "KTXwriter";
+std::string_view constexpr WRITER_NAME = "Learn-OpenGL Asset-Cooker";
+
+template <typename T>
+T readValue(std::span<std::byte const> bytes, size_t offset)
+{
+    if (offset > bytes.size() || sizeof(T) > bytes.size() - offset)
+    {
+        throw std::runtime_error("Unexpected end of the texture file.");
+    }
+    T value;
+    std::memcpy(&value, bytes.data() + offset, sizeof(T));
+    return value;
+}
+
+template <typename T>
+void writeValue(std::vector<std::byte> &bytes, T value)
+{
+    auto valueBytes = std::as_bytes(std::span(&value, 1));
+    bytes.insert(bytes.end(), valueBytes.begin(), valueBytes.end());
+}
+
+void align(std::vector<std::byte> &bytes, size_t alignment)
+{
+    bytes.resize((bytes.size() + alignment - 1) / alignment * alignment);
+}
+
+size_t levelSize(BlockCompressor::Format format,
+                 types::Size width,
+                 types::Size height,
+                 types::Size levelIndex)
+{
+    return BlockCompressor::compressedSize(
+        format, std::max(1, width >> levelIndex), std::max(1, height >> levelIndex));
+}
+
+} // namespace
+
+TextureFile::TextureFile(std::filesystem::path const &path)
+    : _file(path)
+{
+    auto bytes = _file.bytes();
+    if (bytes.size() < HEADER_SIZE ||
+        !std::equal(IDENTIFIER.begin(),
+                    IDENTIFIER.end(),
+                    bytes.begin(),
+                    [](std::uint8_t expected, std::byte actual)
+                    { return std::byte{expected} == actual; }))
+    {
+        throw std::runtime_error(fmt::format("Not a KTX2 file: \"{}\".", path.string()));
+    }
+
+    auto vulkanFormat = readValue<types::UInt>(bytes, 12);
+    auto typeSize = readValue<types::UInt>(bytes, 16);
+    auto width = readValue<types::UInt>(bytes, 20);
+    auto height = readValue<types::UInt>(bytes, 24);
+    auto depth = readValue<types::UInt>(bytes, 28);
+    auto layersCount = readValue<types::UInt>(bytes, 32);
+    auto facesCount = readValue<types::UInt>(bytes, 36);
+    auto levelsCount = readValue<types::UInt>(bytes, 40);
+    auto supercompression = readValue<types::UInt>(bytes, 44);
+
+    auto format = std::find_if(FORMATS.begin(),
+                               FORMATS.end(),
+                               [vulkanFormat](FormatDescription const &description)
+                               { return description.vulkanFormat == vulkanFormat; });
+    if (format == FORMATS.end() || typeSize != 1)
+    {
+        throw std::runtime_error(fmt::format(
+            "Texture file \"{}\" has an unsupported format: {}.", path.string(), vulkanFormat));
+    }
+    if (depth != 0 || layersCount != 0 || facesCount != 1 || supercompression != 0)
+    {
+        throw std::runtime_error(fmt::format(
+            "Texture file \"{}\" is not a plain 2D texture without supercompression.",
+            path.string()));
+    }
+
+    _format = format->format;
+    _srgb = format->srgb;
+    _width = gsl::narrow_cast<types::Size>(width);
+    _height = gsl::narrow_cast<types::Size>(height);
+    if (width == 0 || height == 0 || _width <= 0 || _height <= 0 || levelsCount == 0 ||
+        levelsCount > std::bit_width(std::max(width, height)))
+    {
+        throw std::runtime_error(fmt::format(
+            "Texture file \"{}\" has a wrong size or levels count.", path.string()));
+    }
+
+    for (types::UInt i = 0; i < levelsCount; i++)
+    {
+        size_t entryOffset = HEADER_SIZE + i * LEVEL_INDEX_ENTRY_SIZE;
+        auto offset = readValue<std::uint64_t>(bytes, entryOffset);
+        auto size = readValue<std::uint64_t>(bytes, entryOffset + 8);
+
+        auto levelIndex = gsl::narrow_cast<types::Size>(i);
+        if (offset > bytes.size() || size > bytes.size() - offset ||
+            size != levelSize(_format, _width, _height, levelIndex))
+        {
+            throw std::runtime_error(fmt::format(
+                "Texture file \"{}\" has the level {} out of the file or of a wrong size.",
+                path.string(),
+                i));
+        }
+        _levels.push_back(bytes.subspan(offset, size));
+    }
+}
+
+BlockCompressor::Format TextureFile::format() const
+{
+    return _format;
+}
+
+bool TextureFile::srgb() const
+{
+    return _srgb;
+}
+
+types::Size TextureFile::width() const
+{
+    return _width;
+}
+
+types::Size TextureFile::height() const
+{
+    return _height;
+}
+
+types::Size TextureFile::levelsCount() const
+{
+    return gsl::narrow_cast<types::Size>(_levels.size());
+}
+
+std::span<std::byte const> TextureFile::level(types::Size levelIndex) const
+{
+    return _levels.at(static_cast<size_t>(levelIndex));
+}
+
+void TextureFile::write(std::filesystem::path const &path,
+                        BlockCompressor::Format format,
+                        bool srgb,
+                        types::Size width,
+                        types::Size height,
+                        std::span<std::vector<std::byte> const> levels)
+{
+    auto description = std::find_if(FORMATS.begin(),
+                                     FORMATS.end(),
+                                     [format, srgb](FormatDescription const &formatDescription)
+                                     {
+                                         return formatDescription.format == format &&
+                                                formatDescription.srgb == srgb;
+                                     });
+    if (description == FORMATS.end())
+    {
+        throw std::invalid_argument(fmt::format("No KTX2 format for the block compression {}{}.",
+                                                static_cast<types::UInt>(format),
+                                                srgb ? " in sRGB" : ""));
+    }
+    if (width <= 0 || height <= 0 || levels.empty())
+    {
+        throw std::invalid_argument("Texture must have a positive size and at least one level.");
+    }
+    for (size_t i = 0; i < levels.size(); i++)
+    {
+        auto levelIndex = gsl::narrow_cast<types::Size>(i);
+        if (levels[i].size() != levelSize(format, width, height, levelIndex))
+        {
+            throw std::invalid_argument(
+                fmt::format("Level {} does not match the size of the texture.", i));
+        }
+    }
+
+    // Data format descriptor
+    std::vector<std::byte> descriptor;
+    auto samplesCount = gsl::narrow_cast<types::UInt>(description->samples.size());
+    types::UInt blockSize = DESCRIPTOR_HEADER_SIZE + samplesCount * DESCRIPTOR_SAMPLE_SIZE;
+    writeValue<types::UInt>(descriptor, sizeof(types::UInt) + blockSize);
+    writeValue<types::UInt>(descriptor, 0);
+    writeValue<types::UInt>(descriptor, DESCRIPTOR_VERSION | (blockSize << 16U));
+    writeValue<types::UInt>(
+        descriptor,
+        description->colorModel | (COLOR_PRIMARIES_BT709 << 8U) |
+            ((srgb ? TRANSFER_FUNCTION_SRGB : TRANSFER_FUNCTION_LINEAR) << 16U));
+    auto blockWidth = static_cast<types::UInt>(BlockCompressor::BLOCK_WIDTH);
+    auto blockHeight = static_cast<types::UInt>(BlockCompressor::BLOCK_HEIGHT);
+    writeValue<types::UInt>(descriptor, (blockWidth - 1) | ((blockHeight - 1) << 8U));
+    writeValue<types::UInt>(descriptor,
+                            gsl::narrow_cast<types::UInt>(BlockCompressor::blockSize(format)));
+    writeValue<types::UInt>(descriptor, 0);
+    for (auto const &sample : description->samples)
+    {
+        writeValue<types::UInt>(descriptor,
+                                sample.bitOffset | ((sample.bitLength - 1) << 16U) |
+                                    (sample.channel << 24U));
+        writeValue<types::UInt>(descriptor, 0);
+        writeValue<types::UInt>(descriptor, 0);
+        writeValue<types::UInt>(descriptor, 0xFFFFFFFFU);
+    }
+
+    // Key/value data, only the name of the writer
+    std::vector<std::byte> keyValueData;
+    auto keyValueSize = WRITER_KEY.size() + WRITER_NAME.size() + 2;
+    writeValue<types::UInt>(keyValueData, gsl::narrow_cast<types::UInt>(keyValueSize));
+    for (auto text : {WRITER_KEY, WRITER_NAME})
+    {
+        auto textBytes = std::as_bytes(std::span(text));
+        keyValueData.insert(keyValueData.end(), textBytes.begin(), textBytes.end());
+        keyValueData.push_back(std::byte{0});
+    }
+    align(keyValueData, sizeof(types::UInt));
+
+    size_t descriptorOffset = HEADER_SIZE + levels.size() * LEVEL_INDEX_ENTRY_SIZE;
+    size_t keyValueDataOffset = descriptorOffset + descriptor.size();
+
+    // Levels are stored from the smallest one, each aligned to the block size
+    size_t levelAlignment = BlockCompressor::blockSize(format);
+    std::vector<size_t> levelOffsets(levels.size());
+    size_t fileSize = keyValueDataOffset + keyValueData.size();
+    for (size_t i = levels.size(); i-- > 0;)
+    {
+        levelOffsets[i] = (fileSize + levelAlignment - 1) / levelAlignment * levelAlignment;
+        fileSize = levelOffsets[i] + levels[i].size();
+    }
+
+    std::vector<std::byte> bytes;
+    bytes.reserve(fileSize);
+    for (auto identifierByte : IDENTIFIER)
+    {
+        bytes.push_back(std::byte{identifierByte});
+    }
+    writeValue<types::UInt>(bytes, description->vulkanFormat);
+    writeValue<types::UInt>(bytes, 1);
+    writeValue<types::UInt>(bytes, static_cast<types::UInt>(width));
+    writeValue<types::UInt>(bytes, static_cast<types::UInt>(height));
+    writeValue<types::UInt>(bytes, 0);
+    writeValue<types::UInt>(bytes, 0);
+    writeValue<types::UInt>(bytes, 1);
+    writeValue<types::UInt>(bytes, gsl::narrow_cast<types::UInt>(levels.size()));
+    writeValue<types::UInt>(bytes, 0);
+
+    writeValue<types::UInt>(bytes, gsl::narrow_cast<types::UInt>(descriptorOffset));
+    writeValue<types::UInt>(bytes, gsl::narrow_cast<types::UInt>(descriptor.size()));
+    writeValue<types::UInt>(bytes, gsl::narrow_cast<types::UInt>(keyValueDataOffset));
+    writeValue<types::UInt>(bytes, gsl::narrow_cast<types::UInt>(keyValueData.size()));
+    writeValue<std::uint64_t>(bytes, 0);
+    writeValue<std::uint64_t>(bytes, 0);
+
+    for (size_t i = 0; i < levels.size(); i++)
+    {
+        writeValue<std::uint64_t>(bytes, levelOffsets[i]);
+        writeValue<std::uint64_t>(bytes, levels[i].size());
+        writeValue<std::uint64_t>(bytes, levels[i].size());
+    }
+    bytes.insert(bytes.end(), descriptor.begin(), descriptor.end());
+    bytes.insert(bytes.end(), keyValueData.begin(), keyValueData.end());
+    for (size_t i = levels.size(); i-- > 0;)
+    {
+        align(bytes, levelAlignment);
+        bytes.insert(bytes.end(), levels[i].begin(), levels[i].end());
+    }
+
+    std::ofstream fileStream;
+    fileStream.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+    try
+    {
+        fileStream.open(path, std::ofstream::out | std::ofstream::binary);
+        fileStream.write(reinterpret_cast<char const *>(bytes.data()),
+                         gsl::narrow_cast<std::streamsize>(bytes.size()));
+    }
+    catch (std::ofstream::failure const &e)
+    {
+        throw std::runtime_error(fmt::format(
+            "Error while writing the texture file ({}).\nDetails: {}.", path.string(), e.what()));
+    }
+}
+
+} // namespace pf::gl
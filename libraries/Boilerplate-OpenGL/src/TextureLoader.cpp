@@ -0,0 +1,346 @@
+#include <pf_gl/TextureLoader.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <stop_token>
+#include <thread>
+#include <utility>
+
+#include <glad/glad.h>
+#include <fmt/format.h>
+#include <gsl/util>
+
+#include <pf_gl/Image.hpp>
+#include <pf_gl/Texture.hpp>
+#include <pf_gl/TextureFile.hpp>
+#include <pf_gl/ValueTypes.hpp>
+#include <pf_gl/Window.hpp>
+
+namespace pf::gl
+{
+
+namespace
+{
+
+/**
+ * `finish` waits for the pixel buffers in short steps, flushing the commands each time, otherwise
+ * the fences might never get signaled.
+ */
+GLuint64 constexpr FENCE_WAIT_TIMEOUT =
+    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::milliseconds(1)).count();
+
+} // namespace
+
+TextureLoader::TextureLoader(std::shared_ptr<Window> window,
+                             types::Size threadsCount,
+                             types::Size pixelBuffersCount,
+                             types::BinarySize pixelBufferSize)
+    : _window(std::move(window))
+    , _pixelBufferSize(pixelBufferSize)
+{
+    if (threadsCount < 0)
+    {
+        throw std::invalid_argument("Threads count must not be negative.");
+    }
+    if (pixelBuffersCount <= 0 || pixelBufferSize <= 0)
+    {
+        throw std::invalid_argument(fmt::format("Ring of {} pixel buffers of {} bytes is empty.",
+                                                pixelBuffersCount,
+                                                pixelBufferSize));
+    }
+    if (threadsCount == 0)
+    {
+        threadsCount =
+            std::max(1, gsl::narrow_cast<types::Size>(std::thread::hardware_concurrency()));
+    }
+
+    _window->bindContext();
+    _pixelBuffers.resize(static_cast<size_t>(pixelBuffersCount));
+    if (GLAD_GL_VERSION_4_5 != 0)
+    {
+        // The buffers are never respecified, so the storage can be immutable
+        for (auto &pixelBuffer : _pixelBuffers)
+        {
+            glCreateBuffers(1, &pixelBuffer.buffer);
+            glNamedBufferStorage(pixelBuffer.buffer, _pixelBufferSize, nullptr, GL_MAP_WRITE_BIT);
+        }
+    }
+    else
+    {
+        for (auto &pixelBuffer : _pixelBuffers)
+        {
+            glGenBuffers(1, &pixelBuffer.buffer);
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pixelBuffer.buffer);
+            glBufferData(GL_PIXEL_UNPACK_BUFFER, _pixelBufferSize, nullptr, GL_STREAM_DRAW);
+        }
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    }
+
+    for (types::Size i = 0; i < threadsCount; i++)
+    {
+        _threads.emplace_back([this](std::stop_token const &stopToken) { decode(stopToken); });
+    }
+}
+
+TextureLoader::~TextureLoader()
+{
+    for (auto &thread : _threads)
+    {
+        thread.request_stop();
+    }
+    _threads.clear();
+
+    _window->bindContext();
+    for (auto &pixelBuffer : _pixelBuffers)
+    {
+        if (pixelBuffer.fence != nullptr)
+        {
+            glDeleteSync(pixelBuffer.fence);
+        }
+        glDeleteBuffers(1, &pixelBuffer.buffer);
+    }
+}
+
+std::shared_ptr<Texture> TextureLoader::load(std::filesystem::path const &path,
+                                             TextureType textureType,
+                                             bool flipVertically)
+{
+    auto loadedTexture = _textures.find(path);
+    if (loadedTexture != _textures.end())
+    {
+        if (auto texture = loadedTexture->second.lock())
+        {
+            return texture;
+        }
+    }
+
+    std::shared_ptr<Texture> texture;
+    if (path.extension() == TextureFile::EXTENSION)
+    {
+        texture = std::make_shared<Texture>(_window, path, textureType);
+    }
+    else
+    {
+        // Only the loader can make a texture without the storage
+        texture = std::shared_ptr<Texture>(new Texture(_window,
+                                                       path,
+                                                       textureType,
+                                                       GL_CLAMP_TO_EDGE,
+                                                       GL_CLAMP_TO_EDGE,
+                                                       GL_LINEAR_MIPMAP_LINEAR,
+                                                       GL_LINEAR));
+
+        types::UInt id = _nextId++;
+        _pendingTextures.emplace(id, texture);
+        {
+            std::scoped_lock lock(_mutex);
+            _requests.push_back({.id = id, .path = path, .flipVertically = flipVertically});
+        }
+        _requestAdded.notify_one();
+    }
+
+    _textures.insert_or_assign(path, texture);
+    return texture;
+}
+
+void TextureLoader::update()
+{
+    upload(false);
+}
+
+void TextureLoader::finish()
+{
+    while (!_pendingTextures.empty())
+    {
+        if (_uploads.empty())
+        {
+            std::unique_lock lock(_mutex);
+            _imageDecoded.wait(lock, [this] { return !_decodedImages.empty(); });
+        }
+        upload(true);
+    }
+}
+
+types::Size TextureLoader::pendingCount() const
+{
+    return gsl::narrow_cast<types::Size>(_pendingTextures.size());
+}
+
+void TextureLoader::decode(std::stop_token const &stopToken)
+{
+    while (true)
+    {
+        Request request;
+        {
+            std::unique_lock lock(_mutex);
+            if (!_requestAdded.wait(lock, stopToken, [this] { return !_requests.empty(); }))
+            {
+                return;
+            }
+            request = std::move(_requests.front());
+            _requests.pop_front();
+        }
+
+        DecodedImage decodedImage = {.id = request.id, .image = std::nullopt, .error = nullptr};
+        try
+        {
+            decodedImage.image.emplace(request.path, request.flipVertically);
+        }
+        catch (...)
+        {
+            decodedImage.error = std::current_exception();
+        }
+
+        {
+            std::scoped_lock lock(_mutex);
+            _decodedImages.push_back(std::move(decodedImage));
+        }
+        _imageDecoded.notify_all();
+    }
+}
+
+void TextureLoader::collectDecodedImages()
+{
+    std::vector<DecodedImage> decodedImages;
+    {
+        std::scoped_lock lock(_mutex);
+        decodedImages.swap(_decodedImages);
+    }
+
+    std::exception_ptr error;
+    for (auto &decodedImage : decodedImages)
+    {
+        auto pendingTexture = _pendingTextures.find(decodedImage.id);
+        if (decodedImage.error != nullptr)
+        {
+            _textures.erase(pendingTexture->second->filePath());
+            _pendingTextures.erase(pendingTexture);
+            error = error != nullptr ? error : decodedImage.error;
+            continue;
+        }
+        Texture &texture = *pendingTexture->second;
+        Image const &image = *decodedImage.image;
+        texture.allocateStorage(image.width(), image.height(), GL_RGBA8, image.levelsCount());
+
+        _uploads.push_back({.id = decodedImage.id,
+                            .texture = pendingTexture->second,
+                            .image = std::move(*decodedImage.image),
+                            .uploadedRows = 0});
+    }
+
+    // The rest of the images are queued for the upload by now, so none of them are lost
+    if (error != nullptr)
+    {
+        std::rethrow_exception(error);
+    }
+}
+
+void TextureLoader::upload(bool wait)
+{
+    _window->bindContext();
+    collectDecodedImages();
+
+    for (size_t buffersUsed = 0; !_uploads.empty() && (wait || buffersUsed < _pixelBuffers.size());
+         buffersUsed++)
+    {
+        PixelBuffer &pixelBuffer = _pixelBuffers[_nextPixelBuffer];
+        if (pixelBuffer.fence != nullptr)
+        {
+            GLenum status = glClientWaitSync(pixelBuffer.fence,
+                                             wait ? GL_SYNC_FLUSH_COMMANDS_BIT : 0,
+                                             wait ? FENCE_WAIT_TIMEOUT : 0);
+            if (status == GL_TIMEOUT_EXPIRED && wait)
+            {
+                continue;
+            }
+            if (status == GL_TIMEOUT_EXPIRED)
+            {
+                return;
+            }
+            if (status == GL_WAIT_FAILED)
+            {
+                throw std::runtime_error(
+                    fmt::format("Failed to wait for a pixel buffer (error 0x{:x}).", glGetError()));
+            }
+            glDeleteSync(pixelBuffer.fence);
+            pixelBuffer.fence = nullptr;
+        }
+
+        Upload &upload = _uploads.front();
+        uploadRows(upload, pixelBuffer);
+        _nextPixelBuffer = (_nextPixelBuffer + 1) % _pixelBuffers.size();
+
+        if (upload.uploadedRows == upload.image.height())
+        {
+            upload.texture->generateMipmap();
+
+            upload.texture->_loaded = true;
+            _pendingTextures.erase(upload.id);
+            _uploads.pop_front();
+        }
+    }
+}
+
+void TextureLoader::uploadRows(Upload &upload, PixelBuffer &pixelBuffer)
+{
+    Image const &image = upload.image;
+    Texture &texture = *upload.texture;
+
+    auto rowSize = static_cast<types::BinarySize>(image.width()) *
+                   static_cast<types::BinarySize>(Image::CHANNELS_COUNT);
+    auto rowsCount = gsl::narrow_cast<types::Size>(
+        std::min<types::BinarySize>(image.height() - upload.uploadedRows,
+                                    _pixelBufferSize / rowSize));
+    auto rowsBytes = image.pixels().subspan(static_cast<size_t>(upload.uploadedRows * rowSize),
+                                            static_cast<size_t>(rowsCount * rowSize));
+
+    // A row wider than the pixel buffer has to go the slow way, straight from the memory
+    if (rowsCount == 0)
+    {
+        texture.uploadPixels(0, image.height(), image.pixels().data());
+        upload.uploadedRows = image.height();
+        return;
+    }
+
+    // The fence guarantees that the GPU is done with the buffer, no need to synchronize the mapping
+    bool directStateAccess = GLAD_GL_VERSION_4_5 != 0;
+    auto mappedSize = gsl::narrow_cast<types::BinarySize>(rowsBytes.size());
+    GLbitfield access = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT;
+    if (!directStateAccess)
+    {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pixelBuffer.buffer);
+    }
+    void *pointer = directStateAccess
+                        ? glMapNamedBufferRange(pixelBuffer.buffer, 0, mappedSize, access)
+                        : glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, mappedSize, access);
+    if (pointer == nullptr)
+    {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        throw std::runtime_error(
+            fmt::format("Failed to map a pixel buffer (error 0x{:x}).", glGetError()));
+    }
+    std::memcpy(pointer, rowsBytes.data(), rowsBytes.size());
+
+    // The contents got lost, the same rows are uploaded through the next buffer
+    bool intact = (directStateAccess ? glUnmapNamedBuffer(pixelBuffer.buffer)
+                                     : glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER)) == GL_TRUE;
+    if (intact)
+    {
+        // The texture reads the pixels from the bound unpack buffer even with Direct State Access
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pixelBuffer.buffer);
+        texture.uploadPixels(upload.uploadedRows, rowsCount, nullptr);
+        pixelBuffer.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        upload.uploadedRows += rowsCount;
+    }
+
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
+
+} // namespace pf::gl
@@ -0,0 +1,174 @@
+#include <pf_gl/TextureStreamer.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <glad/glad.h>
+#include <fmt/format.h>
+
+#include <pf_gl/MipResidency.hpp>
+#include <pf_gl/Texture.hpp>
+#include <pf_gl/TextureFile.hpp>
+#include <pf_gl/ValueTypes.hpp>
+#include <pf_gl/Window.hpp>
+
+namespace pf::gl
+{
+
+TextureStreamer::TextureStreamer(std::shared_ptr<Window> window,
+                                 types::BinarySize budget,
+                                 types::BinarySize uploadBudget)
+    : _window(std::move(window))
+    , _residency(budget, uploadBudget)
+{
+}
+
+std::shared_ptr<Texture> TextureStreamer::load(std::filesystem::path const &path,
+                                               TextureType textureType)
+{
+    if (path.extension() != TextureFile::EXTENSION)
+    {
+        throw std::invalid_argument(
+            fmt::format("Only the cooked textures can be streamed, got {}.", path.string()));
+    }
+
+    for (auto const &[id, streamedTexture] : _textures)
+    {
+        if (streamedTexture.texture->filePath() == path)
+        {
+            return streamedTexture.texture;
+        }
+    }
+
+    TextureFile file(path);
+    auto texture = std::shared_ptr<Texture>(new Texture(_window,
+                                                        path,
+                                                        textureType,
+                                                        GL_CLAMP_TO_EDGE,
+                                                        GL_CLAMP_TO_EDGE,
+                                                        GL_LINEAR_MIPMAP_LINEAR,
+                                                        GL_LINEAR));
+    texture->_width = file.width();
+    texture->_height = file.height();
+
+    types::Size alwaysResidentLevel = 0;
+    while (alwaysResidentLevel + 1 < file.levelsCount() &&
+           (std::max(file.width(), file.height()) >> alwaysResidentLevel) > ALWAYS_RESIDENT_SIZE)
+    {
+        alwaysResidentLevel++;
+    }
+
+    std::vector<types::BinarySize> levelSizes;
+    for (types::Size level = 0; level < file.levelsCount(); level++)
+    {
+        levelSizes.push_back(static_cast<types::BinarySize>(file.level(level).size()));
+    }
+    for (types::Size level = alwaysResidentLevel; level < file.levelsCount(); level++)
+    {
+        texture->uploadLevel(file, level);
+    }
+    texture->residentLevels(alwaysResidentLevel, file.levelsCount());
+    texture->_loaded = true;
+
+    types::UInt id = _residency.add(std::move(levelSizes), alwaysResidentLevel);
+    _residencyIds.emplace(texture.get(), id);
+    _textures.emplace(id, StreamedTexture{.texture = texture, .file = std::move(file)});
+    return texture;
+}
+
+void TextureStreamer::request(Texture const &texture, types::Float screenSize)
+{
+    auto id = _residencyIds.find(&texture);
+    if (id == _residencyIds.end())
+    {
+        return;
+    }
+
+    TextureFile const &file = _textures.at(id->second).file;
+    _residency.request(id->second,
+                       MipResidency::levelFor(std::max(file.width(), file.height()),
+                                              screenSize,
+                                              file.levelsCount()));
+}
+
+void TextureStreamer::update()
+{
+    // Nobody else holds the texture, so there is no one to request it ever again
+    std::erase_if(_textures,
+                  [this](auto const &streamedTexture)
+                  {
+                      if (streamedTexture.second.texture.use_count() > 1)
+                      {
+                          return false;
+                      }
+                      _residency.remove(streamedTexture.first);
+                      _residencyIds.erase(streamedTexture.second.texture.get());
+                      return true;
+                  });
+
+    for (auto const &change : _residency.update())
+    {
+        StreamedTexture &streamedTexture = _textures.at(change.id);
+        Texture &texture = *streamedTexture.texture;
+        TextureFile const &file = streamedTexture.file;
+
+        // The base level always points to the levels which are there
+        if (change.baseLevel < change.previousBaseLevel)
+        {
+            for (types::Size level = change.previousBaseLevel - 1; level >= change.baseLevel;
+                 level--)
+            {
+                texture.uploadLevel(file, level);
+            }
+            texture.residentLevels(change.baseLevel, file.levelsCount());
+        }
+        else
+        {
+            texture.residentLevels(change.baseLevel, file.levelsCount());
+            for (types::Size level = change.previousBaseLevel; level < change.baseLevel; level++)
+            {
+                texture.releaseLevel(file, level);
+            }
+        }
+    }
+}
+
+void TextureStreamer::budget(types::BinarySize budget)
+{
+    _residency.budget(budget);
+}
+
+types::BinarySize TextureStreamer::budget() const
+{
+    return _residency.budget();
+}
+
+types::BinarySize TextureStreamer::residentBytes() const
+{
+    return _residency.residentBytes();
+}
+
+std::vector<TextureStreamer::TextureStatistics> TextureStreamer::statistics() const
+{
+    std::vector<TextureStatistics> statistics;
+    for (auto const &[id, streamedTexture] : _textures)
+    {
+        statistics.push_back({
+            .path = streamedTexture.texture->filePath(),
+            .baseLevel = _residency.baseLevel(id),
+            .levelsCount = streamedTexture.file.levelsCount(),
+            .residentBytes = _residency.residentBytes(id),
+        });
+    }
+    std::sort(statistics.begin(),
+              statistics.end(),
+              [](TextureStatistics const &first, TextureStatistics const &second)
+              { return first.path < second.path; });
+    return statistics;
+}
+
+} // namespace pf::gl
@@ -1,31 +1,93 @@
 #include <pf_gl/VertexArray.hpp>
 
+#include <algorithm>
+#include <cstddef>
 #include <memory>
 #include <utility>
 #include <stdexcept>
+#include <vector>
 
 #include <glad/glad.h>
 #include <gsl/narrow>
 
+#include <pf_gl/VertexLayout.hpp>
 #include <pf_gl/ValueTypes.hpp>
 #include <pf_gl/Window.hpp>
 
 namespace pf::gl
 {
 
-VertexArray::VertexArray(std::shared_ptr<Window> window)
+namespace
+{
+
+/**
+ * Every attribute is read from the same interleaved buffer.
+ */
+types::UInt constexpr VERTEX_BUFFER_BINDING = 0;
+
+struct SharedVertexArray
+{
+    Window const *window;
+    std::weak_ptr<VertexArray> vertexArray;
+};
+
+std::vector<SharedVertexArray> &sharedVertexArrays()
+{
+    static std::vector<SharedVertexArray> vertexArrays;
+    return vertexArrays;
+}
+
+bool isDirectStateAccessSupported()
+{
+    return GLAD_GL_VERSION_4_5 != 0;
+}
+
+} // namespace
+
+VertexArray::VertexArray(std::shared_ptr<Window> window, VertexLayout layout)
     : _window(std::move(window))
     , _id(0)
+    , _layout(std::move(layout))
 {
     _window->bindContext();
 
-    glGenVertexArrays(1, &_id);
+    if (!isDirectStateAccessSupported())
+    {
+        glGenVertexArrays(1, &_id);
+        if (_id == 0)
+        {
+            throw std::runtime_error("Failed to generate a vertex array.");
+        }
+
+        // The formats are specified along with the buffer on every attachment
+        glBindVertexArray(_id);
+        for (types::UInt attributeIndex = 0; attributeIndex < _layout.size(); attributeIndex++)
+        {
+            glEnableVertexAttribArray(attributeIndex);
+        }
+        glBindVertexArray(0);
+        return;
+    }
+
+    glCreateVertexArrays(1, &_id);
     if (_id == 0)
     {
         throw std::runtime_error("Failed to generate a vertex array.");
     }
 
-    glBindVertexArray(0);
+    types::UInt attributeIndex = 0;
+    for (auto const &attribute : _layout)
+    {
+        glEnableVertexArrayAttrib(_id, attributeIndex);
+        glVertexArrayAttribFormat(_id,
+                                  attributeIndex,
+                                  types::scalarCount(attribute.valueType),
+                                  types::openglScalar(attribute.valueType),
+                                  attribute.normalized ? GL_TRUE : GL_FALSE,
+                                  gsl::narrow_cast<types::UInt>(_layout.offset(attributeIndex)));
+        glVertexArrayAttribBinding(_id, attributeIndex, VERTEX_BUFFER_BINDING);
+        attributeIndex++;
+    }
 }
 
 VertexArray::~VertexArray()
@@ -34,59 +96,53 @@ VertexArray::~VertexArray()
     glDeleteVertexArrays(1, &_id);
 }
 
-void VertexArray::bind() const
+std::shared_ptr<VertexArray> VertexArray::shared(std::shared_ptr<Window> const &window,
+                                                 VertexLayout const &layout)
 {
-    _window->bindContext();
-    glBindVertexArray(_id);
-}
-
-void VertexArray::addVertexBuffer(std::shared_ptr<VertexBuffer> const &vertexBuffer)
-{
-    _window->bindContext();
+    auto &vertexArrays = sharedVertexArrays();
+    std::erase_if(vertexArrays,
+                  [](SharedVertexArray const &shared) { return shared.vertexArray.expired(); });
 
-    _vertexBuffers.push_back(vertexBuffer);
-
-    this->bind();
-    vertexBuffer->bind();
-
-    types::UInt attributeIndex = 0;
-    types::BinarySize currentOffset = 0;
-    VertexLayout const &vertexLayout = vertexBuffer->layout();
-
-    for (auto const &attribute : vertexLayout)
+    for (auto const &shared : vertexArrays)
     {
-        glVertexAttribPointer(attributeIndex,
-                              types::scalarCount(attribute.valueType),
-                              types::openglScalar(attribute.valueType),
-                              attribute.normalized ? GL_TRUE : GL_FALSE,
-                              gsl::narrow_cast<types::Size>(vertexLayout.stride()),
-                              reinterpret_cast<GLvoid const *>(currentOffset));
-        glEnableVertexAttribArray(attributeIndex);
-
-        currentOffset += types::sizeInBytes(attribute.valueType);
-        attributeIndex++;
+        std::shared_ptr<VertexArray> vertexArray = shared.vertexArray.lock();
+        if (shared.window == window.get() && vertexArray->layout() == layout)
+        {
+            return vertexArray;
+        }
     }
 
-    this->unbind();
-    vertexBuffer->unbind();
+    auto vertexArray = std::make_shared<VertexArray>(window, layout);
+    vertexArrays.push_back({.window = window.get(), .vertexArray = vertexArray});
+    return vertexArray;
 }
 
-void VertexArray::setElementBuffer(std::shared_ptr<ElementBuffer> const &elementBuffer)
+VertexLayout const &VertexArray::layout() const
 {
-    _window->bindContext();
-
-    _elementBuffer = elementBuffer;
+    return _layout;
+}
 
-    this->bind();
-    elementBuffer->bind();
-    this->unbind();
-    elementBuffer->unbind();
+void VertexArray::bind() const
+{
+    _window->bindContext();
+    glBindVertexArray(_id);
 }
 
-void VertexArray::draw()
+void VertexArray::draw(VertexBuffer const &vertexBuffer,
+                       ElementBuffer const &elementBuffer,
+                       types::Size indicesCount,
+                       types::Size firstIndex)
 {
+    types::ValueType indexType = elementBuffer.indexType();
+    auto offset = static_cast<size_t>(firstIndex) *
+                  static_cast<size_t>(types::sizeInBytes(indexType));
+
+    attachBuffers(vertexBuffer, elementBuffer);
     bind();
-    glDrawElements(GL_TRIANGLES, _elementBuffer->count(), GL_UNSIGNED_INT, nullptr);
+    glDrawElements(GL_TRIANGLES,
+                   indicesCount,
+                   types::openglScalar(indexType),
+                   reinterpret_cast<GLvoid const *>(offset));
 }
 
 void VertexArray::unbind() const
@@ -95,4 +151,36 @@ void VertexArray::unbind() const
     glBindVertexArray(0);
 }
 
+void VertexArray::attachBuffers(VertexBuffer const &vertexBuffer,
+                                ElementBuffer const &elementBuffer)
+{
+    _window->bindContext();
+
+    auto stride = gsl::narrow_cast<types::Size>(_layout.stride());
+    if (isDirectStateAccessSupported())
+    {
+        glVertexArrayVertexBuffer(_id, VERTEX_BUFFER_BINDING, vertexBuffer.id(), 0, stride);
+        glVertexArrayElementBuffer(_id, elementBuffer.id());
+        return;
+    }
+
+    // The attribute pointers capture the buffer bound at the moment, so they are specified anew
+    glBindVertexArray(_id);
+    glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer.id());
+    types::UInt attributeIndex = 0;
+    for (auto const &attribute : _layout)
+    {
+        glVertexAttribPointer(
+            attributeIndex,
+            types::scalarCount(attribute.valueType),
+            types::openglScalar(attribute.valueType),
+            attribute.normalized ? GL_TRUE : GL_FALSE,
+            stride,
+            reinterpret_cast<GLvoid const *>(_layout.offset(attributeIndex)));
+        attributeIndex++;
+    }
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, elementBuffer.id());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
 } // namespace pf::gl
@@ -1,11 +1,14 @@
 #include <pf_gl/VertexBuffer.hpp>
 
+#include <cstddef>
 #include <stdexcept>
 #include <utility>
 #include <memory>
+#include <span>
 
-#include <gsl/util>
+#include <glad/glad.h>
 
+#include <pf_gl/BufferMapping.hpp>
 #include <pf_gl/RenderingOptions.hpp>
 #include <pf_gl/Window.hpp>
 #include <pf_utils/RawBuffer.hpp>
@@ -21,21 +24,23 @@ VertexBuffer::VertexBuffer(std::shared_ptr<Window> window,
     , _layout(std::move(layout))
     , _id(0)
 {
-    _window->bindContext();
-
-    glGenBuffers(1, &_id);
-    if (_id == 0)
-    {
-        throw std::runtime_error("Failed to generate a vertex buffer.");
-    }
-    glBindBuffer(GL_ARRAY_BUFFER, _id);
+    generate();
+    uploadBufferStorage(_id,
+                        std::span(static_cast<std::byte const *>(data.pointer()), data.size()),
+                        usagePatternToGLenum(usagePattern));
+}
 
-    GLenum glUsagePattern = usagePatternToGLenum(usagePattern);
-    glBufferData(GL_ARRAY_BUFFER,
-                 gsl::narrow_cast<types::Size>(data.size()),
-                 data.pointer(),
-                 glUsagePattern);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+VertexBuffer::VertexBuffer(std::shared_ptr<Window> window,
+                           types::BinarySize size,
+                           UsagePattern usagePattern,
+                           VertexLayout layout,
+                           BufferWriter const &write)
+    : _window(std::move(window))
+    , _layout(std::move(layout))
+    , _id(0)
+{
+    generate();
+    writeMappedBufferStorage(_id, size, usagePatternToGLenum(usagePattern), write);
 }
 
 VertexBuffer::~VertexBuffer()
@@ -50,7 +55,12 @@ void VertexBuffer::bind() const
     glBindBuffer(GL_ARRAY_BUFFER, _id);
 }
 
-VertexLayout VertexBuffer::layout() const
+types::UInt VertexBuffer::id() const
+{
+    return _id;
+}
+
+VertexLayout const &VertexBuffer::layout() const
 {
     return _layout;
 }
@@ -61,4 +71,22 @@ void VertexBuffer::unbind() const
     glBindBuffer(GL_ARRAY_BUFFER, 0);
 }
 
+void VertexBuffer::generate()
+{
+    _window->bindContext();
+
+    if (GLAD_GL_VERSION_4_5 != 0)
+    {
+        glCreateBuffers(1, &_id);
+    }
+    else
+    {
+        glGenBuffers(1, &_id);
+    }
+    if (_id == 0)
+    {
+        throw std::runtime_error("Failed to generate a vertex buffer.");
+    }
+}
+
 } // namespace pf::gl
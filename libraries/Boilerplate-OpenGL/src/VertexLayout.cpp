@@ -1,5 +1,6 @@
 #include <pf_gl/VertexLayout.hpp>
 
+#include <cstddef>
 #include <string>
 
 #include <sparsepp/spp.h>
@@ -16,19 +17,14 @@ spp::sparse_hash_map<Attribute, std::string> const ATTRIBUTES_NAMES{
     {COLOR, "Color"},
 };
 
-AttributeEntry::AttributeEntry(types::ValueType valueType, Attribute attribute, bool normalized)
-    : valueType(valueType)
-    , attribute(attribute)
-    , normalized(normalized)
-{
-}
-
 VertexLayout::VertexLayout(std::vector<AttributeEntry> const &attributes)
     : _attributes(attributes)
 {
     _stride = 0;
+    _offsets.reserve(attributes.size());
     for (auto const &attribute : attributes)
     {
+        _offsets.push_back(_stride);
         _stride += types::sizeInBytes(attribute.valueType);
     }
 }
@@ -43,11 +39,26 @@ std::vector<AttributeEntry>::const_iterator VertexLayout::end() const noexcept
     return _attributes.cend();
 }
 
+std::size_t VertexLayout::size() const noexcept
+{
+    return _attributes.size();
+}
+
 types::BinarySize VertexLayout::stride() const
 {
     return _stride;
 }
 
+types::BinarySize VertexLayout::offset(std::size_t attributeIndex) const
+{
+    return _offsets.at(attributeIndex);
+}
+
+bool VertexLayout::operator==(VertexLayout const &other) const
+{
+    return _attributes == other._attributes;
+}
+
 std::string attributeName(Attribute attribute)
 {
     return ATTRIBUTES_NAMES.at(attribute);
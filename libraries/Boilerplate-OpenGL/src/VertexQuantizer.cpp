@@ -0,0 +1,155 @@
+#include <pf_gl/VertexQuantizer.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+
+#include <glm/glm.hpp>
+
+#include <pf_gl/BoundingVolumes.hpp>
+#include <pf_gl/ValueTypes.hpp>
+
+namespace pf::gl
+{
+
+VertexQuantizer::VertexQuantizer(BoundingBox const &boundingBox)
+    : _center(boundingBox.center())
+    , _scale(boundingBox.extents())
+    , _dequantizationMatrix(types::DEFAULT_VALUE<types::FMat4>)
+{
+    if (boundingBox.isEmpty())
+    {
+        throw std::invalid_argument("Cannot quantize the vertices within an empty box.");
+    }
+
+    for (glm::length_t axis = 0; axis < 3; axis++)
+    {
+        if (_scale[axis] <= 0.0F)
+        {
+            _scale[axis] = 1.0F;
+        }
+        _dequantizationMatrix[axis][axis] = _scale[axis];
+    }
+    _dequantizationMatrix[3] = types::FVec4(_center, 1.0F);
+}
+
+VertexQuantizer::CompactVertex
+VertexQuantizer::quantize(types::FVec3 const &position,
+                          types::FVec3 const &normal,
+                          types::FVec2 const &textureCoordinates) const
+{
+    CompactVertex vertex{};
+
+    types::FVec3 relativePosition = (position - _center) / _scale;
+    vertex.position = types::ShortVec4(toSnorm16(relativePosition.x),
+                                       toSnorm16(relativePosition.y),
+                                       toSnorm16(relativePosition.z),
+                                       toSnorm16(1.0F));
+
+    // The dequantization scale turns into its inverse in the normal matrix, so it is compensated
+    // here in advance
+    types::FVec3 scaledNormal = normal * _scale;
+    types::Float length = glm::length(scaledNormal);
+    vertex.normal = toSnorm10(length > 0.0F ? scaledNormal / length : scaledNormal);
+
+    vertex.textureCoordinates =
+        types::HalfVec2(toHalfFloat(textureCoordinates.x), toHalfFloat(textureCoordinates.y));
+
+    return vertex;
+}
+
+types::FVec3 VertexQuantizer::dequantizePosition(types::ShortVec4 const &position) const
+{
+    types::FVec3 relativePosition(
+        fromSnorm16(position.x), fromSnorm16(position.y), fromSnorm16(position.z));
+    return _center + relativePosition * _scale;
+}
+
+types::FMat4 const &VertexQuantizer::dequantizationMatrix() const
+{
+    return _dequantizationMatrix;
+}
+
+types::Short VertexQuantizer::toSnorm16(types::Float value)
+{
+    return static_cast<types::Short>(std::lround(std::clamp(value, -1.0F, 1.0F) * MAX_SNORM_16));
+}
+
+types::Float VertexQuantizer::fromSnorm16(types::Short value)
+{
+    // The same rule as OpenGL uses: both -32768 and -32767 map to -1
+    return std::max(static_cast<types::Float>(value) / MAX_SNORM_16, -1.0F);
+}
+
+types::UInt VertexQuantizer::toSnorm10(types::FVec3 const &vector)
+{
+    types::UInt packed = 0;
+    for (glm::length_t axis = 0; axis < 3; axis++)
+    {
+        auto component = std::lround(std::clamp(vector[axis], -1.0F, 1.0F) * MAX_SNORM_10);
+        packed |= (static_cast<types::UInt>(component) & 0x3FFU) << (10 * axis);
+    }
+    return packed;
+}
+
+types::FVec3 VertexQuantizer::fromSnorm10(types::UInt packed)
+{
+    types::FVec3 vector;
+    for (glm::length_t axis = 0; axis < 3; axis++)
+    {
+        auto bits = static_cast<std::int32_t>((packed >> (10 * axis)) & 0x3FFU);
+        auto component = bits >= 512 ? bits - 1024 : bits;
+        vector[axis] = std::max(static_cast<types::Float>(component) / MAX_SNORM_10, -1.0F);
+    }
+    return vector;
+}
+
+GLhalf VertexQuantizer::toHalfFloat(types::Float value)
+{
+    auto bits = std::bit_cast<std::uint32_t>(value);
+    auto sign = static_cast<std::uint32_t>((bits >> 16) & 0x8000U);
+    std::uint32_t magnitude = bits & 0x7FFFFFFFU;
+
+    // Infinities and NaNs, NaNs stay quiet
+    if (magnitude >= 0x7F800000U)
+    {
+        return static_cast<GLhalf>(sign | 0x7C00U | (magnitude > 0x7F800000U ? 0x200U : 0U));
+    }
+    // 65520 and above round to the infinity
+    if (magnitude >= 0x477FF000U)
+    {
+        return static_cast<GLhalf>(sign | 0x7C00U);
+    }
+    // Below the smallest normal half float the mantissa is just the value in units of 2^-24
+    if (magnitude < 0x38800000U)
+    {
+        auto subnormal = std::lrint(std::bit_cast<types::Float>(magnitude) * 16777216.0F);
+        return static_cast<GLhalf>(sign | static_cast<std::uint32_t>(subnormal));
+    }
+
+    // Rounds to the nearest even, then rebiases the exponent from 127 to 15
+    std::uint32_t rounded = magnitude + 0xFFFU + ((magnitude >> 13) & 1U);
+    return static_cast<GLhalf>(sign | ((rounded - 0x38000000U) >> 13));
+}
+
+types::Float VertexQuantizer::fromHalfFloat(GLhalf value)
+{
+    auto sign = static_cast<std::uint32_t>(value & 0x8000U) << 16;
+    std::uint32_t exponent = (value >> 10) & 0x1FU;
+    std::uint32_t mantissa = value & 0x3FFU;
+
+    if (exponent == 0)
+    {
+        types::Float magnitude = static_cast<types::Float>(mantissa) / 16777216.0F;
+        return sign != 0 ? -magnitude : magnitude;
+    }
+    if (exponent == 0x1FU)
+    {
+        return std::bit_cast<types::Float>(sign | 0x7F800000U | (mantissa << 13));
+    }
+    return std::bit_cast<types::Float>(sign | ((exponent + 112) << 23) | (mantissa << 13));
+}
+
+} // namespace pf::gl
@@ -56,6 +56,28 @@ void Window::bindContext()
     _api->bindContext(_context);
 }
 
+bool Window::isExtensionSupported(char const *name)
+{
+    lazyInitialize();
+    if (!isOpen())
+    {
+        return false;
+    }
+
+    return _api->isExtensionSupported(_context, name);
+}
+
+GLFWglproc Window::procAddress(char const *name)
+{
+    lazyInitialize();
+    if (!isOpen())
+    {
+        return nullptr;
+    }
+
+    return _api->procAddress(_context, name);
+}
+
 void Window::swapBuffers()
 {
     lazyInitialize();
@@ -0,0 +1,295 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <pf_gl/BlockCompressor.hpp>
+#include <pf_gl/Image.hpp>
+#include <pf_gl/ValueTypes.hpp>
+
+using pf::gl::BlockCompressor;
+using pf::gl::Image;
+using Block = BlockCompressor::Block;
+
+/**
+ * Little-endian bit fields, same as they are read by the GPU.
+ */
+class BitReader
+{
+public:
+    explicit BitReader(std::span<std::byte const> bytes)
+        : _bytes(bytes)
+    {
+    }
+
+    unsigned read(size_t bitsCount)
+    {
+        unsigned value = 0;
+        for (size_t bit = 0; bit < bitsCount; bit++, _position++)
+        {
+            auto byte = std::to_integer<unsigned>(_bytes[_position / 8]);
+            value |= ((byte >> (_position % 8)) & 1U) << bit;
+        }
+        return value;
+    }
+
+private:
+    std::span<std::byte const> _bytes;
+    size_t _position = 0;
+};
+
+void decodeColorBlock(std::span<std::byte const> bytes, Block &texels)
+{
+    BitReader reader(bytes);
+    std::array<unsigned, 2> endpoints = {reader.read(16), reader.read(16)};
+
+    std::array<std::array<int, 3>, 4> palette{};
+    for (size_t i = 0; i < 2; i++)
+    {
+        unsigned red = endpoints[i] >> 11U;
+        unsigned green = (endpoints[i] >> 5U) & 0x3FU;
+        unsigned blue = endpoints[i] & 0x1FU;
+        palette[i] = {static_cast<int>((red << 3U) | (red >> 2U)),
+                      static_cast<int>((green << 2U) | (green >> 4U)),
+                      static_cast<int>((blue << 3U) | (blue >> 2U))};
+    }
+    for (size_t channel = 0; channel < 3; channel++)
+    {
+        if (endpoints[0] > endpoints[1])
+        {
+            palette[2][channel] = (2 * palette[0][channel] + palette[1][channel]) / 3;
+            palette[3][channel] = (palette[0][channel] + 2 * palette[1][channel]) / 3;
+        }
+        else
+        {
+            palette[2][channel] = (palette[0][channel] + palette[1][channel]) / 2;
+            palette[3][channel] = 0;
+        }
+    }
+
+    for (size_t i = 0; i < 16; i++)
+    {
+        auto const &color = palette[reader.read(2)];
+        for (size_t channel = 0; channel < 3; channel++)
+        {
+            texels[i * 4 + channel] = static_cast<std::uint8_t>(color[channel]);
+        }
+    }
+}
+
+void decodeChannelBlock(std::span<std::byte const> bytes, size_t channel, Block &texels)
+{
+    BitReader reader(bytes);
+    std::array<int, 8> palette{};
+    palette[0] = static_cast<int>(reader.read(8));
+    palette[1] = static_cast<int>(reader.read(8));
+    if (palette[0] > palette[1])
+    {
+        for (int i = 2; i < 8; i++)
+        {
+            palette[i] = ((8 - i) * palette[0] + (i - 1) * palette[1]) / 7;
+        }
+    }
+    else
+    {
+        for (int i = 2; i < 6; i++)
+        {
+            palette[i] = ((6 - i) * palette[0] + (i - 1) * palette[1]) / 5;
+        }
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+
+    for (size_t i = 0; i < 16; i++)
+    {
+        texels[i * 4 + channel] = static_cast<std::uint8_t>(palette[reader.read(3)]);
+    }
+}
+
+/**
+ * Only the mode 6 is supported, since it is the only one written by the encoder.
+ */
+void decodeMode6Block(std::span<std::byte const> bytes, Block &texels)
+{
+    BitReader reader(bytes);
+    ASSERT_EQ(reader.read(7), 1U << 6U);
+
+    std::array<std::array<int, 4>, 2> endpoints{};
+    for (size_t channel = 0; channel < 4; channel++)
+    {
+        endpoints[0][channel] = static_cast<int>(reader.read(7) << 1U);
+        endpoints[1][channel] = static_cast<int>(reader.read(7) << 1U);
+    }
+    for (auto &endpoint : endpoints)
+    {
+        unsigned pBit = reader.read(1);
+        for (auto &value : endpoint)
+        {
+            value |= static_cast<int>(pBit);
+        }
+    }
+
+    std::array<int, 16> weights = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+    for (size_t i = 0; i < 16; i++)
+    {
+        unsigned index = reader.read(i == 0 ? 3 : 4);
+        for (size_t channel = 0; channel < 4; channel++)
+        {
+            texels[i * 4 + channel] = static_cast<std::uint8_t>(
+                ((64 - weights[index]) * endpoints[0][channel] +
+                 weights[index] * endpoints[1][channel] + 32) >>
+                6);
+        }
+    }
+}
+
+Block decode(std::span<std::byte const> bytes, BlockCompressor::Format format)
+{
+    Block texels{};
+    switch (format)
+    {
+    case BlockCompressor::BC1:
+        decodeColorBlock(bytes, texels);
+        break;
+    case BlockCompressor::BC3:
+        decodeChannelBlock(bytes, 3, texels);
+        decodeColorBlock(bytes.subspan(8), texels);
+        break;
+    case BlockCompressor::BC5:
+        decodeChannelBlock(bytes, 0, texels);
+        decodeChannelBlock(bytes.subspan(8), 1, texels);
+        break;
+    case BlockCompressor::BC7:
+        decodeMode6Block(bytes, texels);
+        break;
+    }
+    return texels;
+}
+
+int maxError(Block const &expected, Block const &actual, std::vector<size_t> const &channels)
+{
+    int error = 0;
+    for (size_t i = 0; i < 16; i++)
+    {
+        for (auto channel : channels)
+        {
+            error = std::max(error, std::abs(expected[i * 4 + channel] - actual[i * 4 + channel]));
+        }
+    }
+    return error;
+}
+
+Block roundTrip(Block const &texels, BlockCompressor::Format format)
+{
+    std::vector<std::byte> compressed(BlockCompressor::blockSize(format));
+    BlockCompressor::compressBlock(texels, format, compressed);
+    return decode(compressed, format);
+}
+
+/**
+ * Goes from one color to the other along the diagonal of the block, the brightest texel is the
+ * first one.
+ */
+Block gradientBlock(std::array<int, 4> const &from, std::array<int, 4> const &to)
+{
+    Block texels{};
+    for (size_t y = 0; y < 4; y++)
+    {
+        for (size_t x = 0; x < 4; x++)
+        {
+            for (size_t channel = 0; channel < 4; channel++)
+            {
+                auto step = static_cast<int>(x + y);
+                texels[(y * 4 + x) * 4 + channel] = static_cast<std::uint8_t>(
+                    from[channel] + (to[channel] - from[channel]) * step / 6);
+            }
+        }
+    }
+    return texels;
+}
+
+// NOLINTNEXTLINE
+TEST(BlockCompressor_CompressBlock, SolidColor_IsKeptWithinTheEndpointPrecision)
+{
+    Block texels = gradientBlock({200, 100, 30, 128}, {200, 100, 30, 128});
+
+    EXPECT_LE(maxError(texels, roundTrip(texels, BlockCompressor::BC1), {0, 1, 2}), 4);
+    EXPECT_LE(maxError(texels, roundTrip(texels, BlockCompressor::BC3), {0, 1, 2}), 4);
+    EXPECT_EQ(maxError(texels, roundTrip(texels, BlockCompressor::BC3), {3}), 0);
+    EXPECT_EQ(maxError(texels, roundTrip(texels, BlockCompressor::BC5), {0, 1}), 0);
+    EXPECT_LE(maxError(texels, roundTrip(texels, BlockCompressor::BC7), {0, 1, 2, 3}), 1);
+}
+
+// NOLINTNEXTLINE
+TEST(BlockCompressor_CompressBlock, Gradient_IsCloseToTheOriginal)
+{
+    Block texels = gradientBlock({250, 180, 90, 255}, {20, 60, 10, 40});
+
+    // Half the distance between the palette entries, plus the rounding
+    EXPECT_LE(maxError(texels, roundTrip(texels, BlockCompressor::BC1), {0, 1, 2}), 230 / 6 + 4);
+    EXPECT_LE(maxError(texels, roundTrip(texels, BlockCompressor::BC3), {3}), 215 / 14 + 1);
+    EXPECT_LE(maxError(texels, roundTrip(texels, BlockCompressor::BC5), {0, 1}), 230 / 14 + 1);
+    EXPECT_LE(maxError(texels, roundTrip(texels, BlockCompressor::BC7), {0, 1, 2, 3}),
+              230 / 30 + 1);
+}
+
+// NOLINTNEXTLINE
+TEST(BlockCompressor_CompressBlock, BlackAndWhite_LoseAtMostThePBit)
+{
+    Block texels{};
+    for (size_t i = 0; i < 16; i++)
+    {
+        std::uint8_t value = i % 3 == 0 ? 0 : 255;
+        std::fill_n(texels.begin() + static_cast<long>(i * 4), 3, value);
+        texels[i * 4 + 3] = 255;
+    }
+
+    // Opaque black needs different p-bits for the colors and for the alpha
+    EXPECT_LE(maxError(texels, roundTrip(texels, BlockCompressor::BC7), {0, 1, 2, 3}), 1);
+    EXPECT_EQ(maxError(texels, roundTrip(texels, BlockCompressor::BC1), {0, 1, 2}), 0);
+}
+
+// NOLINTNEXTLINE
+TEST(BlockCompressor_CompressBlock, SmallDestination_Throws)
+{
+    Block texels{};
+    std::vector<std::byte> destination(8);
+
+    EXPECT_NO_THROW(BlockCompressor::compressBlock(texels, BlockCompressor::BC1, destination));
+    EXPECT_THROW(BlockCompressor::compressBlock(texels, BlockCompressor::BC7, destination),
+                 std::invalid_argument);
+}
+
+// NOLINTNEXTLINE
+TEST(BlockCompressor_Compress, SeveralThreads_GiveTheSameResultAsOne)
+{
+    // Not a multiple of the block size, so the edges are padded
+    pf::gl::types::Size width = 37;
+    pf::gl::types::Size height = 23;
+    std::vector<std::uint8_t> pixels(static_cast<size_t>(width * height) * 4);
+    for (size_t i = 0; i < pixels.size(); i++)
+    {
+        pixels[i] = static_cast<std::uint8_t>((i * 7919U) % 251U);
+    }
+    Image image(width, height, std::move(pixels));
+
+    for (auto format : {BlockCompressor::BC1, BlockCompressor::BC3, BlockCompressor::BC7})
+    {
+        auto single = BlockCompressor::compress(image, format, 1);
+        auto threaded = BlockCompressor::compress(image, format, 4);
+
+        EXPECT_EQ(single.size(), BlockCompressor::compressedSize(format, width, height));
+        EXPECT_EQ(single.size(), 10 * 6 * BlockCompressor::blockSize(format));
+        EXPECT_EQ(single, threaded);
+    }
+    EXPECT_THROW(std::ignore = BlockCompressor::compress(image, BlockCompressor::BC1, -1),
+                 std::invalid_argument);
+}
@@ -0,0 +1,228 @@
+#include <algorithm>
+#include <cstddef>
+#include <numbers>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <glm/glm.hpp>
+#include <glm/ext/matrix_clip_space.hpp>
+#include <glm/ext/matrix_transform.hpp>
+
+#include <pf_gl/BoundingVolumeHierarchy.hpp>
+#include <pf_gl/BoundingVolumes.hpp>
+#include <pf_gl/Frustum.hpp>
+#include <pf_gl/ValueTypes.hpp>
+
+using pf::gl::BoundingBox;
+using pf::gl::BoundingSphere;
+using pf::gl::BoundingVolumeHierarchy;
+using pf::gl::Frustum;
+using pf::gl::Ray;
+using pf::gl::types::Float;
+using pf::gl::types::FVec3;
+using pf::gl::types::UInt;
+
+size_t const RANDOM_OBJECTS_COUNT = 500;
+
+class BoundingVolumeHierarchyTest : public ::testing::Test
+{
+protected:
+    std::mt19937 randomEngine{42};
+    std::vector<BoundingBox> boxes;
+    std::vector<UInt> proxies;
+    BoundingVolumeHierarchy tree;
+
+    BoundingBox randomBox()
+    {
+        std::uniform_real_distribution<Float> position(-50.0F, 50.0F);
+        std::uniform_real_distribution<Float> size(0.1F, 3.0F);
+        FVec3 min(position(randomEngine), position(randomEngine), position(randomEngine));
+        return {.min = min, .max = min + FVec3(size(randomEngine))};
+    }
+
+    void insertRandomBoxes(size_t count)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            boxes.push_back(randomBox());
+            proxies.push_back(tree.insert(boxes.back(), static_cast<UInt>(boxes.size() - 1)));
+        }
+    }
+
+    static Frustum createFrustum()
+    {
+        auto projection = glm::perspective(std::numbers::pi_v<float> / 3.0F, 1.5F, 0.1F, 60.0F);
+        auto view = glm::lookAt(FVec3(5.0F, 3.0F, 40.0F), FVec3(0.0F), FVec3(0.0F, 1.0F, 0.0F));
+        return Frustum(projection * view);
+    }
+
+    void expectFrustumQueryMatchesBruteForce()
+    {
+        Frustum frustum = createFrustum();
+        std::vector<UInt> result;
+        tree.queryFrustum(frustum, result);
+        std::sort(result.begin(), result.end());
+
+        std::vector<UInt> expected;
+        for (size_t i = 0; i < boxes.size(); i++)
+        {
+            if (frustum.intersects(boxes[i]))
+            {
+                expected.push_back(static_cast<UInt>(i));
+            }
+        }
+
+        EXPECT_FALSE(expected.empty());
+        EXPECT_EQ(result, expected);
+    }
+};
+
+// NOLINTNEXTLINE
+TEST_F(BoundingVolumeHierarchyTest, QueryFrustum_AfterInsertion_SameAsBruteForce)
+{
+    insertRandomBoxes(RANDOM_OBJECTS_COUNT);
+
+    expectFrustumQueryMatchesBruteForce();
+}
+
+// NOLINTNEXTLINE
+TEST_F(BoundingVolumeHierarchyTest, QueryFrustum_AfterRebuild_SameAsBruteForce)
+{
+    insertRandomBoxes(RANDOM_OBJECTS_COUNT);
+
+    tree.rebuild();
+
+    expectFrustumQueryMatchesBruteForce();
+}
+
+// NOLINTNEXTLINE
+TEST_F(BoundingVolumeHierarchyTest, QueryFrustum_AfterMovesAndRemovals_SameAsBruteForce)
+{
+    insertRandomBoxes(RANDOM_OBJECTS_COUNT);
+
+    std::uniform_real_distribution<Float> offset(-2.0F, 2.0F);
+    for (size_t i = 0; i < boxes.size(); i++)
+    {
+        FVec3 shift(offset(randomEngine), offset(randomEngine), offset(randomEngine));
+        boxes[i] = {.min = boxes[i].min + shift, .max = boxes[i].max + shift};
+        tree.move(proxies[i], boxes[i]);
+    }
+    // Removed boxes are replaced with the empty ones, so that the brute force skips them
+    for (size_t i = 0; i < boxes.size(); i += 3)
+    {
+        tree.remove(proxies[i]);
+        boxes[i] = BoundingBox::EMPTY;
+    }
+
+    expectFrustumQueryMatchesBruteForce();
+}
+
+// NOLINTNEXTLINE
+TEST_F(BoundingVolumeHierarchyTest, Insert_ManyObjects_TreeStaysBalanced)
+{
+    // Boxes inserted along a line would degenerate the tree into a list without the rotations
+    for (size_t i = 0; i < 1024; i++)
+    {
+        auto x = static_cast<Float>(i);
+        tree.insert({.min = FVec3(x, 0.0F, 0.0F), .max = FVec3(x + 0.5F, 1.0F, 1.0F)},
+                    static_cast<UInt>(i));
+    }
+
+    EXPECT_EQ(tree.size(), 1024);
+    EXPECT_LT(tree.height(), 25);
+}
+
+// NOLINTNEXTLINE
+TEST_F(BoundingVolumeHierarchyTest, Move_InsideFatBox_DoesNotReinsert)
+{
+    UInt proxy = tree.insert({.min = FVec3(0.0F), .max = FVec3(1.0F)}, 7);
+
+    bool reinserted = tree.move(proxy, {.min = FVec3(0.05F), .max = FVec3(1.05F)});
+
+    EXPECT_FALSE(reinserted);
+    EXPECT_EQ(tree.userData(proxy), 7);
+    EXPECT_EQ(tree.boundingBox(proxy).min, FVec3(0.05F));
+}
+
+// NOLINTNEXTLINE
+TEST_F(BoundingVolumeHierarchyTest, Move_OutsideFatBox_Reinserts)
+{
+    UInt proxy = tree.insert({.min = FVec3(0.0F), .max = FVec3(1.0F)}, 7);
+
+    bool reinserted = tree.move(proxy, {.min = FVec3(10.0F), .max = FVec3(11.0F)});
+
+    EXPECT_TRUE(reinserted);
+    EXPECT_TRUE(tree.fatBoundingBox(proxy).contains(FVec3(10.5F)));
+}
+
+// NOLINTNEXTLINE
+TEST_F(BoundingVolumeHierarchyTest, QuerySphere_RandomBoxes_SameAsBruteForce)
+{
+    insertRandomBoxes(RANDOM_OBJECTS_COUNT);
+    BoundingSphere sphere = {.center = FVec3(3.0F, -4.0F, 10.0F), .radius = 15.0F};
+
+    std::vector<UInt> result;
+    tree.querySphere(sphere, result);
+    std::sort(result.begin(), result.end());
+
+    std::vector<UInt> expected;
+    for (size_t i = 0; i < boxes.size(); i++)
+    {
+        if (sphere.intersects(boxes[i]))
+        {
+            expected.push_back(static_cast<UInt>(i));
+        }
+    }
+    EXPECT_FALSE(expected.empty());
+    EXPECT_EQ(result, expected);
+}
+
+// NOLINTNEXTLINE
+TEST_F(BoundingVolumeHierarchyTest, Raycast_RandomBoxes_ReturnsClosestHit)
+{
+    insertRandomBoxes(RANDOM_OBJECTS_COUNT);
+    // Make sure there is something to hit
+    for (Float x : {10.0F, -20.0F})
+    {
+        boxes.push_back({.min = FVec3(x, -1.0F, -1.0F), .max = FVec3(x + 2.0F, 2.0F, 2.0F)});
+        proxies.push_back(tree.insert(boxes.back(), static_cast<UInt>(boxes.size() - 1)));
+    }
+    tree.rebuild();
+    Ray ray = {.origin = FVec3(-60.0F, 0.5F, 0.5F), .direction = FVec3(1.0F, 0.02F, 0.01F)};
+
+    std::optional<Float> expectedDistance;
+    for (auto const &box : boxes)
+    {
+        auto distance = ray.intersect(box);
+        if (distance.has_value() &&
+            (!expectedDistance.has_value() || *distance < *expectedDistance))
+        {
+            expectedDistance = distance;
+        }
+    }
+    auto hit = tree.raycast(ray);
+
+    ASSERT_TRUE(expectedDistance.has_value());
+    ASSERT_TRUE(hit.has_value());
+    EXPECT_FLOAT_EQ(hit->distance, *expectedDistance);
+    EXPECT_EQ(ray.intersect(boxes.at(hit->userData)), expectedDistance);
+}
+
+// NOLINTNEXTLINE
+TEST_F(BoundingVolumeHierarchyTest, Raycast_PointingAway_ReturnsNothing)
+{
+    tree.insert({.min = FVec3(0.0F), .max = FVec3(1.0F)}, 0);
+
+    auto hit = tree.raycast({.origin = FVec3(5.0F), .direction = FVec3(1.0F, 0.0F, 0.0F)});
+
+    EXPECT_FALSE(hit.has_value());
+}
+
+// NOLINTNEXTLINE
+TEST_F(BoundingVolumeHierarchyTest, Remove_InvalidProxy_Throws)
+{
+    EXPECT_THROW(tree.remove(12), std::invalid_argument);
+}
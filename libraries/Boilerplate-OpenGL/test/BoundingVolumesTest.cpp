@@ -0,0 +1,62 @@
+#include <cstddef>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <pf_gl/BoundingVolumes.hpp>
+#include <pf_gl/ValueTypes.hpp>
+
+using pf::gl::BoundingBox;
+using pf::gl::BoundingSphere;
+using pf::gl::StridedPoints;
+using pf::gl::types::FVec2;
+using pf::gl::types::FVec3;
+
+namespace
+{
+
+/**
+ * Position followed by an attribute, like in the interleaved vertex buffers.
+ */
+struct Vertex
+{
+    FVec3 position;
+    FVec2 textureCoordinates;
+};
+
+} // namespace
+
+// NOLINTNEXTLINE
+TEST(BoundingBox_FromPoints, InterleavedPositions_SameAsPacked)
+{
+    std::vector<FVec3> positions = {FVec3(1.0F, -2.0F, 0.5F),
+                                    FVec3(-3.0F, 4.0F, 2.0F),
+                                    FVec3(0.0F, 1.0F, -6.0F)};
+    std::vector<Vertex> vertices;
+    for (auto const &position : positions)
+    {
+        vertices.push_back({.position = position, .textureCoordinates = FVec2(7.0F)});
+    }
+    StridedPoints strided = {.first = reinterpret_cast<std::byte const *>(vertices.data()),
+                             .count = vertices.size(),
+                             .stride = sizeof(Vertex)};
+
+    BoundingBox box = BoundingBox::fromPoints(strided);
+    EXPECT_EQ(box.min, FVec3(-3.0F, -2.0F, -6.0F));
+    EXPECT_EQ(box.max, FVec3(1.0F, 4.0F, 2.0F));
+    EXPECT_EQ(BoundingBox::fromPoints(positions).min, box.min);
+    EXPECT_EQ(BoundingBox::fromPoints(positions).max, box.max);
+
+    BoundingSphere sphere = BoundingSphere::fromPoints(strided, box);
+    EXPECT_EQ(sphere.center, box.center());
+    EXPECT_FLOAT_EQ(sphere.radius, BoundingSphere::fromPoints(positions, box).radius);
+}
+
+// NOLINTNEXTLINE
+TEST(BoundingBox_FromPoints, NoPoints_Empty)
+{
+    StridedPoints strided = {.first = nullptr, .count = 0, .stride = sizeof(Vertex)};
+
+    EXPECT_TRUE(BoundingBox::fromPoints(strided).isEmpty());
+    EXPECT_TRUE(BoundingBox::fromPoints(std::vector<FVec3>()).isEmpty());
+}
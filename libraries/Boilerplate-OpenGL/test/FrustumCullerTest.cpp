@@ -0,0 +1,199 @@
+#include <cmath>
+#include <cstddef>
+#include <numbers>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <glm/glm.hpp>
+#include <glm/ext/matrix_clip_space.hpp>
+#include <glm/ext/matrix_transform.hpp>
+
+#include <pf_gl/BoundingVolumes.hpp>
+#include <pf_gl/Frustum.hpp>
+#include <pf_gl/FrustumCuller.hpp>
+#include <pf_gl/ValueTypes.hpp>
+
+using pf::gl::BoundingBox;
+using pf::gl::Frustum;
+using pf::gl::FrustumCuller;
+using pf::gl::types::Float;
+using pf::gl::types::FVec3;
+using pf::gl::types::UInt;
+
+/**
+ * Camera at the origin looking down the negative Z axis, 90 degrees vertical FOV.
+ */
+Frustum createTestFrustum()
+{
+    auto projection = glm::perspective(std::numbers::pi_v<float> / 2.0F, 1.0F, 0.1F, 100.0F);
+    auto view = glm::lookAt(FVec3(0.0F), FVec3(0.0F, 0.0F, -1.0F), FVec3(0.0F, 1.0F, 0.0F));
+    return Frustum(projection * view);
+}
+
+BoundingBox unitBoxAt(FVec3 const &center)
+{
+    return {.min = center - FVec3(0.5F), .max = center + FVec3(0.5F)};
+}
+
+// * Frustum *
+
+// NOLINTNEXTLINE
+TEST(Frustum_Intersects, BoxInFrontOfCamera_ReturnsTrue)
+{
+    EXPECT_TRUE(createTestFrustum().intersects(unitBoxAt(FVec3(0.0F, 0.0F, -5.0F))));
+}
+
+// NOLINTNEXTLINE
+TEST(Frustum_Intersects, BoxBehindCamera_ReturnsFalse)
+{
+    EXPECT_FALSE(createTestFrustum().intersects(unitBoxAt(FVec3(0.0F, 0.0F, 5.0F))));
+}
+
+// NOLINTNEXTLINE
+TEST(Frustum_Intersects, BoxBeyondFarPlane_ReturnsFalse)
+{
+    EXPECT_FALSE(createTestFrustum().intersects(unitBoxAt(FVec3(0.0F, 0.0F, -200.0F))));
+}
+
+// NOLINTNEXTLINE
+TEST(Frustum_Intersects, BoxCrossingSidePlane_ReturnsTrue)
+{
+    // The left plane passes through (-5, 0, -5), half of the box is inside
+    EXPECT_TRUE(createTestFrustum().intersects(unitBoxAt(FVec3(-5.0F, 0.0F, -5.0F))));
+}
+
+// NOLINTNEXTLINE
+TEST(Frustum_Intersects, UnboundedBox_ReturnsTrue)
+{
+    EXPECT_TRUE(createTestFrustum().intersects(BoundingBox::UNBOUNDED));
+}
+
+// * FrustumCuller *
+
+// NOLINTNEXTLINE
+TEST(FrustumCuller_Cull, MixedBoxes_ReturnsVisibleIndicesInOrder)
+{
+    std::vector<BoundingBox> boxes = {
+        unitBoxAt(FVec3(0.0F, 0.0F, -5.0F)),
+        unitBoxAt(FVec3(0.0F, 0.0F, 5.0F)),
+        unitBoxAt(FVec3(20.0F, 0.0F, -5.0F)),
+        unitBoxAt(FVec3(1.0F, 1.0F, -10.0F)),
+        unitBoxAt(FVec3(0.0F, -30.0F, -3.0F)),
+        unitBoxAt(FVec3(-2.0F, 0.0F, -50.0F)),
+    };
+    FrustumCuller culler;
+    std::vector<UInt> visibleIndices;
+
+    culler.cull(createTestFrustum(), boxes, visibleIndices);
+
+    EXPECT_EQ(visibleIndices, std::vector<UInt>({0, 3, 5}));
+    EXPECT_EQ(culler.statistics().visibleCount, 3);
+    EXPECT_EQ(culler.statistics().culledCount, 3);
+}
+
+// NOLINTNEXTLINE
+TEST(FrustumCuller_Cull, ManyBoxes_SameResultAsSingleBoxTest)
+{
+    Frustum frustum = createTestFrustum();
+    std::vector<BoundingBox> boxes;
+    for (int x = -20; x <= 20; x += 3)
+    {
+        for (int z = -120; z <= 20; z += 7)
+        {
+            boxes.push_back(unitBoxAt(FVec3(static_cast<float>(x), 0.5F, static_cast<float>(z))));
+        }
+    }
+    FrustumCuller culler;
+    std::vector<UInt> visibleIndices;
+
+    culler.cull(frustum, boxes, visibleIndices);
+
+    std::vector<UInt> expectedIndices;
+    for (size_t i = 0; i < boxes.size(); i++)
+    {
+        if (frustum.intersects(boxes[i]))
+        {
+            expectedIndices.push_back(static_cast<UInt>(i));
+        }
+    }
+    EXPECT_EQ(visibleIndices, expectedIndices);
+}
+
+// NOLINTNEXTLINE
+TEST(FrustumCuller_Cull, CalledTwice_AccumulatesStatisticsUntilReset)
+{
+    std::vector<BoundingBox> boxes = {
+        unitBoxAt(FVec3(0.0F, 0.0F, -5.0F)),
+        unitBoxAt(FVec3(0.0F, 0.0F, 5.0F)),
+    };
+    FrustumCuller culler;
+    std::vector<UInt> visibleIndices;
+
+    culler.cull(createTestFrustum(), boxes, visibleIndices);
+    culler.cull(createTestFrustum(), boxes, visibleIndices);
+
+    EXPECT_EQ(visibleIndices.size(), 1);
+    EXPECT_EQ(culler.statistics().visibleCount, 2);
+    EXPECT_EQ(culler.statistics().culledCount, 2);
+
+    culler.resetStatistics();
+
+    EXPECT_EQ(culler.statistics().visibleCount, 0);
+    EXPECT_EQ(culler.statistics().culledCount, 0);
+}
+
+// NOLINTNEXTLINE
+TEST(FrustumCuller_ScreenSizes, VisibleBoxes_ShrinkWithDistance)
+{
+    std::vector<BoundingBox> boxes = {
+        unitBoxAt(FVec3(0.0F, 0.0F, -5.0F)),
+        unitBoxAt(FVec3(0.0F, 0.0F, 5.0F)),
+        unitBoxAt(FVec3(0.0F, 0.0F, -20.0F)),
+        unitBoxAt(FVec3(0.0F)),
+    };
+    FrustumCuller culler;
+    std::vector<UInt> visibleIndices;
+    std::vector<Float> screenSizes;
+
+    culler.cull(createTestFrustum(), boxes, visibleIndices);
+    culler.screenSizes(FVec3(0.0F), 100.0F, visibleIndices, screenSizes);
+
+    // Diameter over the distance to the sphere around the box, scaled to pixels
+    auto radius = std::sqrt(0.75F);
+    ASSERT_EQ(visibleIndices, std::vector<UInt>({0, 2, 3}));
+    ASSERT_EQ(screenSizes.size(), 3);
+    EXPECT_FLOAT_EQ(screenSizes[0], 100.0F * radius / (5.0F - radius));
+    EXPECT_FLOAT_EQ(screenSizes[1], 100.0F * radius / (20.0F - radius));
+    EXPECT_FLOAT_EQ(screenSizes[2], 100.0F * radius / FrustumCuller::MIN_SCREEN_SIZE_DISTANCE);
+}
+
+// * BoundingBox *
+
+// NOLINTNEXTLINE
+TEST(BoundingBox_Transform, TranslatedAndScaled_ReturnsTransformedBounds)
+{
+    BoundingBox box = unitBoxAt(FVec3(0.0F));
+    auto matrix = glm::scale(glm::translate(glm::mat4(1.0F), FVec3(1.0F, 2.0F, 3.0F)),
+                             FVec3(2.0F, 2.0F, 2.0F));
+
+    BoundingBox transformed = box.transform(matrix);
+
+    EXPECT_FLOAT_EQ(transformed.min.x, 0.0F);
+    EXPECT_FLOAT_EQ(transformed.min.y, 1.0F);
+    EXPECT_FLOAT_EQ(transformed.min.z, 2.0F);
+    EXPECT_FLOAT_EQ(transformed.max.x, 2.0F);
+    EXPECT_FLOAT_EQ(transformed.max.y, 3.0F);
+    EXPECT_FLOAT_EQ(transformed.max.z, 4.0F);
+}
+
+// NOLINTNEXTLINE
+TEST(BoundingBox_Merge, EmptyAndNonEmpty_ReturnsNonEmpty)
+{
+    BoundingBox box = unitBoxAt(FVec3(1.0F));
+
+    BoundingBox merged = BoundingBox::EMPTY.merge(box);
+
+    EXPECT_FALSE(merged.isEmpty());
+    EXPECT_EQ(merged.min, box.min);
+    EXPECT_EQ(merged.max, box.max);
+}
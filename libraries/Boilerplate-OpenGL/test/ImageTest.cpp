@@ -0,0 +1,55 @@
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <pf_gl/Image.hpp>
+
+using pf::gl::Image;
+
+// NOLINTNEXTLINE
+TEST(Image_Downsample, OddSize_IsRoundedDown)
+{
+    Image image(5, 1, std::vector<std::uint8_t>(5 * 4, 10));
+
+    Image downsampled = image.downsample();
+    EXPECT_EQ(downsampled.width(), 2);
+    EXPECT_EQ(downsampled.height(), 1);
+    EXPECT_EQ(image.levelsCount(), 3);
+    EXPECT_EQ(downsampled.downsample().downsample().width(), 1);
+}
+
+// NOLINTNEXTLINE
+TEST(Image_Downsample, Srgb_IsAveragedInLinearSpace)
+{
+    // Black and white pixels, the alpha is averaged as is
+    Image image(2, 1, {0, 0, 0, 0, 255, 255, 255, 255});
+
+    Image linear = image.downsample(false);
+    EXPECT_EQ(linear.pixels()[0], 128);
+    EXPECT_EQ(linear.pixels()[3], 128);
+
+    Image srgb = image.downsample(true);
+    EXPECT_EQ(srgb.pixels()[0], 188);
+    EXPECT_EQ(srgb.pixels()[3], 128);
+}
+
+// NOLINTNEXTLINE
+TEST(Image_Constructor, WrongPixelsCount_Throws)
+{
+    EXPECT_THROW(Image(2, 2, std::vector<std::uint8_t>(15)), std::invalid_argument);
+    EXPECT_THROW(Image(0, 2, {}), std::invalid_argument);
+}
+
+// NOLINTNEXTLINE
+TEST(Image_FlipVertically, OddHeight_KeepsTheMiddleRow)
+{
+    Image image(1, 3, {1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3});
+
+    image.flipVertically();
+    EXPECT_EQ(image.pixel(0, 0)[0], 3);
+    EXPECT_EQ(image.pixel(0, 1)[0], 2);
+    EXPECT_EQ(image.pixel(0, 2)[0], 1);
+}
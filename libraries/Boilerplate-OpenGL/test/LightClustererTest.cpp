@@ -0,0 +1,119 @@
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <glm/glm.hpp>
+#include <glm/ext/matrix_clip_space.hpp>
+
+#include <pf_gl/BoundingVolumes.hpp>
+#include <pf_gl/DrawingContext3D.hpp>
+#include <pf_gl/LightClusterer.hpp>
+#include <pf_gl/ValueTypes.hpp>
+
+using pf::gl::BoundingSphere;
+using pf::gl::LightClusterer;
+using pf::gl::PointLight;
+using pf::gl::types::FMat4;
+using pf::gl::types::FVec3;
+using pf::gl::types::FVec4;
+using pf::gl::types::Size;
+using pf::gl::types::UInt;
+
+FMat4 createProjection()
+{
+    return glm::perspective(std::numbers::pi_v<float> / 2.0F, 16.0F / 9.0F, 0.1F, 100.0F);
+}
+
+// NOLINTNEXTLINE
+TEST(LightClusterer_Radius, QuadraticFalloff_DropsToCutoffAtRadius)
+{
+    PointLight light = {
+        .position = FVec3(0.0F),
+        .color = {.ambient = FVec3(0.1F),
+                  .diffuse = FVec3(0.8F, 0.5F, 0.2F),
+                  .specular = FVec3(0.5F)},
+        .falloff = {.constant = 1.0F, .linear = 0.09F, .quadratic = 0.032F},
+    };
+    float radius = LightClusterer::radius(light);
+    float attenuation = 1.0F / (light.falloff.constant + light.falloff.linear * radius +
+                                light.falloff.quadratic * radius * radius);
+
+    EXPECT_NEAR(0.8F * attenuation, LightClusterer::DEFAULT_CUTOFF, 1e-6F);
+    EXPECT_TRUE(std::isinf(LightClusterer::radius({.color = {.diffuse = FVec3(1.0F)},
+                                                   .falloff = {.constant = 1.0F}})));
+}
+
+// NOLINTNEXTLINE
+TEST(LightClusterer_Assign, PointInsideFrustum_IsInsideItsClusterBounds)
+{
+    LightClusterer clusterer(16, 9, 24, 1);
+    FMat4 projection = createProjection();
+    clusterer.assign(projection, {});
+
+    for (FVec3 point : {FVec3(0.3F, -0.2F, -0.5F), FVec3(-4.0F, 2.0F, -10.0F),
+                        FVec3(30.0F, -10.0F, -90.0F)})
+    {
+        FVec4 clip = projection * FVec4(point, 1.0F);
+        auto tileX = static_cast<Size>((clip.x / clip.w * 0.5F + 0.5F) * 16.0F);
+        auto tileY = static_cast<Size>((clip.y / clip.w * 0.5F + 0.5F) * 9.0F);
+        Size slice = clusterer.depthSlice(-point.z);
+
+        EXPECT_TRUE(clusterer.bounds(clusterer.clusterIndex(tileX, tileY, slice)).contains(point));
+    }
+    EXPECT_EQ(clusterer.depthSlice(0.1F), 0);
+    EXPECT_EQ(clusterer.depthSlice(99.9F), 23);
+}
+
+// NOLINTNEXTLINE
+TEST(LightClusterer_Assign, RandomLights_MatchBruteForce)
+{
+    LightClusterer clusterer(8, 4, 16, 3);
+    FMat4 projection = createProjection();
+
+    std::mt19937 randomEngine{42};
+    std::uniform_real_distribution<float> horizontal(-60.0F, 60.0F);
+    std::uniform_real_distribution<float> depth(-110.0F, 5.0F);
+    std::uniform_real_distribution<float> radius(0.1F, 8.0F);
+    std::vector<FVec4> lights;
+    for (size_t i = 0; i < 301; i++)
+    {
+        lights.emplace_back(horizontal(randomEngine),
+                            horizontal(randomEngine) / 2.0F,
+                            depth(randomEngine),
+                            radius(randomEngine));
+    }
+
+    // Twice, so that the scratch buffers are reused
+    for (size_t pass = 0; pass < 2; pass++)
+    {
+        clusterer.assign(projection, lights);
+        ASSERT_EQ(clusterer.clusters().size(), clusterer.clustersCount());
+
+        for (Size cluster = 0; cluster < clusterer.clustersCount(); cluster++)
+        {
+            std::vector<UInt> expected;
+            for (size_t i = 0; i < lights.size(); i++)
+            {
+                BoundingSphere sphere = {.center = FVec3(lights[i]), .radius = lights[i].w};
+                if (sphere.intersects(clusterer.bounds(cluster)))
+                {
+                    expected.push_back(static_cast<UInt>(i));
+                }
+            }
+
+            auto range = clusterer.clusters()[static_cast<size_t>(cluster)];
+            std::vector<UInt> actual(clusterer.lightIndices().begin() + range.offset,
+                                     clusterer.lightIndices().begin() + range.offset + range.count);
+            EXPECT_EQ(actual, expected);
+        }
+        lights.resize(lights.size() / 2);
+    }
+
+    clusterer.assign(projection, {});
+    EXPECT_TRUE(clusterer.lightIndices().empty());
+    EXPECT_THROW(LightClusterer(0, 1, 1), std::invalid_argument);
+}
@@ -0,0 +1,67 @@
+#include <cmath>
+#include <numbers>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+#include <glm/glm.hpp>
+
+#include <pf_gl/LightVolume.hpp>
+#include <pf_gl/ValueTypes.hpp>
+
+using pf::gl::LightVolume;
+using pf::gl::types::FVec3;
+
+/**
+ * Plane of the triangle with the normal facing the side it is counter-clockwise from.
+ */
+struct Face
+{
+    FVec3 normal;
+    float distance;
+};
+
+Face face(LightVolume const &volume, size_t triangle)
+{
+    FVec3 first = volume.vertices[volume.indices[triangle * 3]].position;
+    FVec3 second = volume.vertices[volume.indices[triangle * 3 + 1]].position;
+    FVec3 third = volume.vertices[volume.indices[triangle * 3 + 2]].position;
+    FVec3 normal = glm::normalize(glm::cross(second - first, third - first));
+    return {.normal = normal, .distance = glm::dot(normal, first)};
+}
+
+// NOLINTNEXTLINE
+TEST(LightVolume_Sphere, AllFaces_FaceOutwardsAndEncloseUnitSphere)
+{
+    LightVolume volume = LightVolume::sphere(12, 6);
+    ASSERT_EQ(volume.indices.size() % 3, 0);
+
+    for (size_t triangle = 0; triangle < volume.indices.size() / 3; triangle++)
+    {
+        // Facing away from the center, and not closer to it than the radius
+        EXPECT_GE(face(volume, triangle).distance, 1.0F - 1e-5F);
+    }
+    EXPECT_THROW(LightVolume::sphere(2, 6), std::invalid_argument);
+}
+
+// NOLINTNEXTLINE
+TEST(LightVolume_Cone, AllFaces_FaceOutwardsAndEncloseCone)
+{
+    LightVolume volume = LightVolume::cone(8);
+    FVec3 inside(0.0F, 0.0F, -0.5F);
+
+    for (size_t triangle = 0; triangle < volume.indices.size() / 3; triangle++)
+    {
+        Face plane = face(volume, triangle);
+        EXPECT_GT(plane.distance - glm::dot(plane.normal, inside), 0.0F);
+
+        // The apex and the circle of the base are never outside
+        EXPECT_LE(glm::dot(plane.normal, FVec3(0.0F)) - plane.distance, 1e-5F);
+        for (int step = 0; step < 64; step++)
+        {
+            float angle = 2.0F * std::numbers::pi_v<float> * static_cast<float>(step) / 64.0F;
+            FVec3 point(std::cos(angle), std::sin(angle), -1.0F);
+            EXPECT_LE(glm::dot(plane.normal, point) - plane.distance, 1e-5F);
+        }
+    }
+    EXPECT_THROW(LightVolume::cone(2), std::invalid_argument);
+}
@@ -0,0 +1,72 @@
+#include <cstddef>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <pf_gl/MeshData.hpp>
+#include <pf_gl/VertexLayout.hpp>
+#include <pf_gl/ValueTypes.hpp>
+
+using pf::gl::AttributeEntry;
+using pf::gl::MeshData;
+using pf::gl::VertexLayout;
+using pf::gl::types::FVec2;
+using pf::gl::types::FVec3;
+
+struct Vertex
+{
+    FVec2 textureCoordinates;
+    FVec3 position;
+    FVec3 normal;
+};
+
+// NOLINTNEXTLINE
+TEST(MeshData_ExtractPositions, InterleavedVertices_PositionsInOrder)
+{
+    std::vector<Vertex> vertices;
+    for (size_t i = 0; i < 5; i++)
+    {
+        auto value = static_cast<float>(i);
+        vertices.push_back({
+            .textureCoordinates = FVec2(-value),
+            .position = FVec3(value, 2.0F * value, 3.0F * value),
+            .normal = FVec3(0.0F, 1.0F, 0.0F),
+        });
+    }
+    VertexLayout layout({
+        {pf::gl::types::FLOAT_VECTOR_2, pf::gl::TEXTURE_COORDINATES},
+        {pf::gl::types::FLOAT_VECTOR_3, pf::gl::POSITION},
+        {pf::gl::types::FLOAT_VECTOR_3, pf::gl::NORMAL},
+    });
+
+    std::vector<std::byte> positions;
+    std::optional<AttributeEntry> attribute =
+        MeshData::extractPositions(layout, std::as_bytes(std::span(vertices)), positions);
+
+    ASSERT_TRUE(attribute.has_value());
+    ASSERT_EQ(attribute->valueType, pf::gl::types::FLOAT_VECTOR_3);
+    ASSERT_EQ(positions.size(), vertices.size() * sizeof(FVec3));
+    for (size_t i = 0; i < vertices.size(); i++)
+    {
+        FVec3 position;
+        std::memcpy(&position, positions.data() + i * sizeof(FVec3), sizeof(FVec3));
+        ASSERT_EQ(position, vertices[i].position);
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(MeshData_ExtractPositions, NoPositions_Nothing)
+{
+    std::vector<FVec3> normals(4, FVec3(0.0F, 0.0F, 1.0F));
+    VertexLayout layout({{pf::gl::types::FLOAT_VECTOR_3, pf::gl::NORMAL}});
+
+    std::vector<std::byte> positions(16);
+    std::optional<AttributeEntry> attribute =
+        MeshData::extractPositions(layout, std::as_bytes(std::span(normals)), positions);
+
+    ASSERT_FALSE(attribute.has_value());
+    ASSERT_TRUE(positions.empty());
+}
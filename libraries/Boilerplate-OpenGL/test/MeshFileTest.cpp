@@ -0,0 +1,219 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <pf_gl/MeshData.hpp>
+#include <pf_gl/MeshFile.hpp>
+#include <pf_gl/Texture.hpp>
+#include <pf_gl/VertexLayout.hpp>
+#include <pf_gl/ValueTypes.hpp>
+
+using pf::gl::MeshData;
+using pf::gl::MeshFile;
+using pf::gl::types::FVec3;
+using pf::gl::types::UInt;
+
+struct TestMesh
+{
+    std::vector<FVec3> positions;
+    std::vector<std::byte> indices;
+    MeshData data;
+};
+
+/**
+ * A strip of quads, repetitive enough for the compression to pay off. The second level of detail
+ * is the second quad, so there have to be at least two of them.
+ */
+TestMesh createTestMesh(size_t quadsCount)
+{
+    TestMesh mesh;
+    std::vector<UInt> indices;
+    for (size_t i = 0; i <= quadsCount; i++)
+    {
+        mesh.positions.emplace_back(static_cast<float>(i), 0.0F, 0.0F);
+        mesh.positions.emplace_back(static_cast<float>(i), 1.0F, 0.0F);
+    }
+    for (UInt i = 0; i < quadsCount; i++)
+    {
+        indices.insert(indices.end(),
+                       {2 * i, 2 * i + 2, 2 * i + 1, 2 * i + 1, 2 * i + 2, 2 * i + 3});
+    }
+
+    mesh.data.attributes = {{pf::gl::types::FLOAT_VECTOR_3, pf::gl::POSITION}};
+    mesh.data.vertices = std::as_bytes(std::span(mesh.positions));
+    mesh.data.indexType = MeshData::packIndices(indices, mesh.indices);
+    mesh.data.indices = mesh.indices;
+    mesh.data.levelsOfDetail = {
+        {.firstIndex = 0,
+         .indicesCount = static_cast<pf::gl::types::Size>(indices.size()),
+         .error = 0.0F},
+        {.firstIndex = 6, .indicesCount = 6, .error = 0.5F},
+    };
+    mesh.data.boundingBox = {.min = FVec3(0.0F), .max = FVec3(quadsCount, 1.0F, 0.0F)};
+    mesh.data.textures = {{.type = pf::gl::DIFFUSE, .path = "textures/diffuse.png"}};
+    return mesh;
+}
+
+void expectSameMeshes(MeshData const &expected, MeshData const &actual)
+{
+    ASSERT_EQ(actual.attributes.size(), expected.attributes.size());
+    EXPECT_EQ(actual.attributes[0].attribute, expected.attributes[0].attribute);
+    EXPECT_EQ(actual.attributes[0].valueType, expected.attributes[0].valueType);
+    EXPECT_EQ(actual.indexType, expected.indexType);
+
+    ASSERT_EQ(actual.vertices.size(), expected.vertices.size());
+    EXPECT_TRUE(
+        std::equal(actual.vertices.begin(), actual.vertices.end(), expected.vertices.begin()));
+    ASSERT_EQ(actual.indices.size(), expected.indices.size());
+    EXPECT_TRUE(
+        std::equal(actual.indices.begin(), actual.indices.end(), expected.indices.begin()));
+
+    ASSERT_EQ(actual.levelsOfDetail.size(), expected.levelsOfDetail.size());
+    EXPECT_EQ(actual.levelsOfDetail[1].firstIndex, expected.levelsOfDetail[1].firstIndex);
+    EXPECT_EQ(actual.levelsOfDetail[1].indicesCount, expected.levelsOfDetail[1].indicesCount);
+    EXPECT_EQ(actual.levelsOfDetail[1].error, expected.levelsOfDetail[1].error);
+    EXPECT_EQ(actual.boundingBox.max, expected.boundingBox.max);
+}
+
+// NOLINTNEXTLINE
+TEST(MeshFile_Write, Uncompressed_ReadsBackTheSameMesh)
+{
+    auto path = std::filesystem::temp_directory_path() / "pf-gl-mesh-file.pfmesh";
+    TestMesh mesh = createTestMesh(4);
+
+    MeshFile::write(path, std::span(&mesh.data, 1));
+    MeshFile file(path);
+
+    ASSERT_EQ(file.meshesCount(), 1);
+    expectSameMeshes(mesh.data, file.mesh(0));
+    std::filesystem::remove(path);
+}
+
+// NOLINTNEXTLINE
+TEST(MeshFile_Write, Compressed_ReadsBackTheSameMeshInLessSpace)
+{
+    auto uncompressedPath = std::filesystem::temp_directory_path() / "pf-gl-mesh-file-raw.pfmesh";
+    auto compressedPath = std::filesystem::temp_directory_path() / "pf-gl-mesh-file-lz4.pfmesh";
+    TestMesh mesh = createTestMesh(1000);
+
+    MeshFile::write(uncompressedPath, std::span(&mesh.data, 1));
+    MeshFile::write(compressedPath, std::span(&mesh.data, 1), MeshFile::LZ4_COMPRESSION);
+
+    EXPECT_LT(std::filesystem::file_size(compressedPath),
+              std::filesystem::file_size(uncompressedPath));
+    {
+        MeshFile file(compressedPath);
+        expectSameMeshes(mesh.data, file.mesh(0));
+    }
+    std::filesystem::remove(uncompressedPath);
+    std::filesystem::remove(compressedPath);
+}
+
+// NOLINTNEXTLINE
+TEST(MeshFile_Textures, RelativePath_IsResolvedAgainstTheFile)
+{
+    auto path = std::filesystem::temp_directory_path() / "pf-gl-mesh-file-textures.pfmesh";
+    TestMesh mesh = createTestMesh(2);
+
+    MeshFile::write(path, std::span(&mesh.data, 1));
+    MeshFile file(path);
+
+    ASSERT_EQ(file.textures(0).size(), 1);
+    EXPECT_EQ(file.textures(0)[0].type, pf::gl::DIFFUSE);
+    EXPECT_EQ(file.textures(0)[0].path, path.parent_path() / "textures/diffuse.png");
+    std::filesystem::remove(path);
+}
+
+// NOLINTNEXTLINE
+TEST(MeshFile_Mesh, OutlivesTheFileObject)
+{
+    auto path = std::filesystem::temp_directory_path() / "pf-gl-mesh-file-lifetime.pfmesh";
+    TestMesh mesh = createTestMesh(100);
+    MeshFile::write(path, std::span(&mesh.data, 1), MeshFile::LZ4_COMPRESSION);
+
+    MeshData data;
+    {
+        MeshFile file(path);
+        data = file.mesh(0);
+    }
+
+    expectSameMeshes(mesh.data, data);
+    std::filesystem::remove(path);
+}
+
+// NOLINTNEXTLINE
+TEST(MeshFile_Constructor, WrongMagic_Throws)
+{
+    auto path = std::filesystem::temp_directory_path() / "pf-gl-mesh-file-garbage.pfmesh";
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << "definitely not a cooked mesh";
+    }
+
+    EXPECT_THROW(MeshFile file(path), std::runtime_error);
+    std::filesystem::remove(path);
+}
+
+// NOLINTNEXTLINE
+TEST(MeshFile_Constructor, OtherVersion_Throws)
+{
+    auto path = std::filesystem::temp_directory_path() / "pf-gl-mesh-file-version.pfmesh";
+    TestMesh mesh = createTestMesh(2);
+    MeshFile::write(path, std::span(&mesh.data, 1));
+    {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(sizeof(UInt));
+        UInt version = MeshFile::VERSION + 1;
+        file.write(reinterpret_cast<char const *>(&version), sizeof(version));
+    }
+
+    EXPECT_THROW(MeshFile file(path), std::runtime_error);
+    std::filesystem::remove(path);
+}
+
+// NOLINTNEXTLINE
+TEST(MeshFile_Constructor, TruncatedFile_Throws)
+{
+    auto path = std::filesystem::temp_directory_path() / "pf-gl-mesh-file-truncated.pfmesh";
+    TestMesh mesh = createTestMesh(10);
+    MeshFile::write(path, std::span(&mesh.data, 1));
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 8);
+
+    EXPECT_THROW(MeshFile file(path), std::runtime_error);
+    std::filesystem::remove(path);
+}
+
+// NOLINTNEXTLINE
+TEST(MeshData_PackIndices, IntoDestination_KeepsTheRestOfItUntouched)
+{
+    std::vector<UInt> indices = {0, 65534, 7};
+    std::vector<std::byte> destination(4 * sizeof(pf::gl::types::UShort), std::byte{0xFF});
+
+    ASSERT_EQ(MeshData::indexTypeFor(65534), pf::gl::types::UNSIGNED_SHORT);
+    ASSERT_EQ(MeshData::indexTypeFor(65535), pf::gl::types::UNSIGNED_INT);
+    MeshData::packIndices(indices, pf::gl::types::UNSIGNED_SHORT, destination);
+
+    std::vector<pf::gl::types::UShort> packed(4);
+    std::memcpy(packed.data(), destination.data(), destination.size());
+    EXPECT_EQ(packed, std::vector<pf::gl::types::UShort>({0, 65534, 7, 0xFFFF}));
+}
+
+// NOLINTNEXTLINE
+TEST(MeshData_PackIndices, SmallDestination_Throws)
+{
+    std::vector<UInt> indices = {0, 1, 2};
+    std::vector<std::byte> destination(2 * sizeof(UInt));
+
+    EXPECT_THROW(MeshData::packIndices(indices, pf::gl::types::UNSIGNED_INT, destination),
+                 std::invalid_argument);
+    EXPECT_THROW(MeshData::packIndices(indices, pf::gl::types::FLOAT, destination),
+                 std::invalid_argument);
+}
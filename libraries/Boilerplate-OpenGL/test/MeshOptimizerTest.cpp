@@ -0,0 +1,266 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <glm/glm.hpp>
+
+#include <pf_gl/MeshOptimizer.hpp>
+#include <pf_gl/ValueTypes.hpp>
+
+using pf::gl::MeshOptimizer;
+using pf::gl::types::Float;
+using pf::gl::types::FVec2;
+using pf::gl::types::FVec3;
+using pf::gl::types::UInt;
+
+struct TestVertex
+{
+    FVec3 position;
+    FVec2 textureCoordinates;
+
+    bool operator==(TestVertex const &) const = default;
+};
+
+/**
+ * Square grid with the triangles shuffled, the worst case for the vertex cache.
+ */
+void createShuffledGrid(UInt quadsCount,
+                        std::vector<TestVertex> &vertices,
+                        std::vector<UInt> &indices)
+{
+    for (UInt y = 0; y <= quadsCount; y++)
+    {
+        for (UInt x = 0; x <= quadsCount; x++)
+        {
+            FVec2 coordinates(static_cast<Float>(x), static_cast<Float>(y));
+            vertices.push_back({FVec3(coordinates, 0.0F), coordinates});
+        }
+    }
+
+    std::vector<std::array<UInt, 3>> triangles;
+    for (UInt y = 0; y < quadsCount; y++)
+    {
+        for (UInt x = 0; x < quadsCount; x++)
+        {
+            UInt corner = y * (quadsCount + 1) + x;
+            UInt above = corner + quadsCount + 1;
+            triangles.push_back({corner, corner + 1, above + 1});
+            triangles.push_back({corner, above + 1, above});
+        }
+    }
+    std::mt19937 randomEngine(42);
+    std::shuffle(triangles.begin(), triangles.end(), randomEngine);
+    for (auto const &triangle : triangles)
+    {
+        indices.insert(indices.end(), triangle.begin(), triangle.end());
+    }
+}
+
+std::span<std::byte> asBytes(std::vector<TestVertex> &vertices)
+{
+    return std::as_writable_bytes(std::span(vertices));
+}
+
+/**
+ * Triangles as vertex values, rotated so that the smallest index goes first, and sorted.
+ */
+std::vector<std::array<TestVertex, 3>> sortedTriangles(std::vector<TestVertex> const &vertices,
+                                                       std::vector<UInt> const &indices)
+{
+    std::vector<std::array<TestVertex, 3>> triangles;
+    for (size_t i = 0; i < indices.size(); i += 3)
+    {
+        std::array<TestVertex, 3> triangle = {
+            vertices[indices[i]], vertices[indices[i + 1]], vertices[indices[i + 2]]};
+        auto less = [](TestVertex const &a, TestVertex const &b)
+        {
+            return std::tie(a.position.x, a.position.y, a.position.z) <
+                   std::tie(b.position.x, b.position.y, b.position.z);
+        };
+        std::rotate(triangle.begin(),
+                    std::min_element(triangle.begin(), triangle.end(), less),
+                    triangle.end());
+        triangles.push_back(triangle);
+    }
+    std::sort(triangles.begin(),
+              triangles.end(),
+              [](auto const &a, auto const &b)
+              {
+                  for (size_t i = 0; i < 3; i++)
+                  {
+                      auto const &pa = a[i].position, &pb = b[i].position;
+                      if (pa != pb)
+                      {
+                          return std::tie(pa.x, pa.y, pa.z) < std::tie(pb.x, pb.y, pb.z);
+                      }
+                  }
+                  return false;
+              });
+    return triangles;
+}
+
+// NOLINTNEXTLINE
+TEST(MeshOptimizer_GenerateWeldRemap, DuplicatedVertices_AreMerged)
+{
+    std::vector<TestVertex> vertices = {
+        {FVec3(0.0F), FVec2(0.0F)},
+        {FVec3(1.0F), FVec2(0.0F)},
+        {FVec3(0.0F), FVec2(0.0F)},
+        {FVec3(1.0F), FVec2(1.0F)},
+        {FVec3(1.0F), FVec2(0.0F)},
+    };
+    std::vector<UInt> remap;
+
+    auto uniqueCount =
+        MeshOptimizer::generateWeldRemap(asBytes(vertices), sizeof(TestVertex), 0.0F, remap);
+
+    EXPECT_EQ(uniqueCount, 3);
+    EXPECT_EQ(remap, std::vector<UInt>({0, 1, 0, 2, 1}));
+}
+
+// NOLINTNEXTLINE
+TEST(MeshOptimizer_GenerateWeldRemap, WithEpsilon_MergesCloseVertices)
+{
+    std::vector<TestVertex> vertices = {
+        {FVec3(0.0F), FVec2(0.0F)},
+        {FVec3(1e-5F), FVec2(0.0F)},
+        {FVec3(0.5F), FVec2(0.0F)},
+    };
+    std::vector<UInt> exactRemap, remap;
+
+    auto exactCount =
+        MeshOptimizer::generateWeldRemap(asBytes(vertices), sizeof(TestVertex), 0.0F, exactRemap);
+    auto count =
+        MeshOptimizer::generateWeldRemap(asBytes(vertices), sizeof(TestVertex), 1e-3F, remap);
+
+    EXPECT_EQ(exactCount, 3);
+    EXPECT_EQ(count, 2);
+    EXPECT_EQ(remap, std::vector<UInt>({0, 0, 1}));
+}
+
+// NOLINTNEXTLINE
+TEST(MeshOptimizer_OptimizeVertexCache, ShuffledGrid_ImprovesCacheMissRatio)
+{
+    std::vector<TestVertex> vertices;
+    std::vector<UInt> indices;
+    createShuffledGrid(32, vertices, indices);
+    auto before = MeshOptimizer::analyze(indices, vertices.size());
+
+    MeshOptimizer::optimizeVertexCache(indices, vertices.size());
+    auto after = MeshOptimizer::analyze(indices, vertices.size());
+
+    EXPECT_GT(before.acmr, 2.0F);
+    EXPECT_LT(after.acmr, 0.8F);
+    EXPECT_LT(after.atvr, 1.5F);
+}
+
+// NOLINTNEXTLINE
+TEST(MeshOptimizer_Optimize, ShuffledGrid_KeepsTheSameTriangles)
+{
+    std::vector<TestVertex> vertices;
+    std::vector<UInt> indices;
+    createShuffledGrid(16, vertices, indices);
+    auto expectedTriangles = sortedTriangles(vertices, indices);
+
+    auto report = MeshOptimizer::optimize(
+        asBytes(vertices), sizeof(TestVertex), offsetof(TestVertex, position), indices);
+    vertices.resize(report.verticesCountAfter);
+
+    EXPECT_EQ(sortedTriangles(vertices, indices), expectedTriangles);
+    EXPECT_LT(report.after.acmr, report.before.acmr);
+}
+
+// NOLINTNEXTLINE
+TEST(MeshOptimizer_Optimize, UnweldedTriangles_AreWeldedAndFetchedInOrder)
+{
+    // Two triangles of a quad with every corner stored separately, plus an unused vertex
+    std::vector<TestVertex> vertices = {
+        {FVec3(0.0F, 0.0F, 0.0F), FVec2(0.0F)},
+        {FVec3(1.0F, 0.0F, 0.0F), FVec2(0.0F)},
+        {FVec3(1.0F, 1.0F, 0.0F), FVec2(0.0F)},
+        {FVec3(5.0F, 5.0F, 5.0F), FVec2(0.0F)},
+        {FVec3(0.0F, 0.0F, 0.0F), FVec2(0.0F)},
+        {FVec3(1.0F, 1.0F, 0.0F), FVec2(0.0F)},
+        {FVec3(0.0F, 1.0F, 0.0F), FVec2(0.0F)},
+    };
+    std::vector<UInt> indices = {0, 1, 2, 4, 5, 6};
+
+    auto report = MeshOptimizer::optimize(
+        asBytes(vertices), sizeof(TestVertex), offsetof(TestVertex, position), indices);
+
+    EXPECT_EQ(report.verticesCountBefore, 7);
+    EXPECT_EQ(report.verticesCountAfter, 4);
+    EXPECT_FLOAT_EQ(report.before.atvr, 1.0F);
+    EXPECT_FLOAT_EQ(report.after.acmr, 2.0F);
+
+    // The first use of every vertex comes in order
+    UInt nextVertex = 0;
+    for (auto index : indices)
+    {
+        ASSERT_LE(index, nextVertex);
+        nextVertex = std::max(nextVertex, index + 1);
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(MeshOptimizer_OptimizeOverdraw, TwoWalls_KeepsTheSameTriangles)
+{
+    // Two separate grids facing each other, like the opposite walls of a room
+    std::vector<TestVertex> vertices;
+    std::vector<UInt> indices;
+    createShuffledGrid(8, vertices, indices);
+    auto firstWallSize = static_cast<UInt>(vertices.size());
+    auto firstWallIndicesCount = indices.size();
+    for (size_t i = 0; i < firstWallSize; i++)
+    {
+        vertices.push_back({vertices[i].position + FVec3(0.0F, 0.0F, 4.0F), FVec2(1.0F)});
+    }
+    for (size_t i = 0; i < firstWallIndicesCount; i += 3)
+    {
+        indices.insert(indices.end(),
+                       {indices[i] + firstWallSize,
+                        indices[i + 2] + firstWallSize,
+                        indices[i + 1] + firstWallSize});
+    }
+    auto expectedTriangles = sortedTriangles(vertices, indices);
+    std::vector<FVec3> positions;
+    for (auto const &vertex : vertices)
+    {
+        positions.push_back(vertex.position);
+    }
+
+    MeshOptimizer::optimizeVertexCache(indices, vertices.size());
+    auto beforeOverdraw = MeshOptimizer::analyze(indices, vertices.size());
+    MeshOptimizer::optimizeOverdraw(indices, positions);
+    auto afterOverdraw = MeshOptimizer::analyze(indices, vertices.size());
+
+    EXPECT_EQ(sortedTriangles(vertices, indices), expectedTriangles);
+    EXPECT_LT(afterOverdraw.acmr,
+              beforeOverdraw.acmr * MeshOptimizer::DEFAULT_OVERDRAW_THRESHOLD + 0.1F);
+}
+
+// NOLINTNEXTLINE
+TEST(MeshOptimizer_Analyze, SingleTriangle_EveryVertexIsTransformedOnce)
+{
+    std::vector<UInt> indices = {0, 1, 2};
+
+    auto statistics = MeshOptimizer::analyze(indices, 3);
+
+    EXPECT_FLOAT_EQ(statistics.acmr, 3.0F);
+    EXPECT_FLOAT_EQ(statistics.atvr, 1.0F);
+}
+
+// NOLINTNEXTLINE
+TEST(MeshOptimizer_Optimize, StrideNotMatchingBuffer_Throws)
+{
+    std::vector<std::byte> vertices(10);
+    std::vector<UInt> indices;
+
+    EXPECT_THROW(MeshOptimizer::optimize(vertices, 12, 0, indices), std::invalid_argument);
+}
@@ -0,0 +1,284 @@
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <numbers>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <glm/glm.hpp>
+
+#include <pf_gl/MeshSimplifier.hpp>
+#include <pf_gl/ValueTypes.hpp>
+
+using pf::gl::MeshSimplifier;
+using pf::gl::types::Float;
+using pf::gl::types::FVec3;
+using pf::gl::types::UInt;
+
+struct TestMesh
+{
+    std::vector<FVec3> positions;
+    std::vector<UInt> indices;
+};
+
+/**
+ * Flat square grid in the XY plane with the given number of quads along each side, facing +Z.
+ */
+TestMesh createGrid(UInt quadsCount)
+{
+    TestMesh mesh;
+    for (UInt y = 0; y <= quadsCount; y++)
+    {
+        for (UInt x = 0; x <= quadsCount; x++)
+        {
+            mesh.positions.emplace_back(static_cast<Float>(x), static_cast<Float>(y), 0.0F);
+        }
+    }
+    for (UInt y = 0; y < quadsCount; y++)
+    {
+        for (UInt x = 0; x < quadsCount; x++)
+        {
+            UInt corner = y * (quadsCount + 1) + x;
+            UInt above = corner + quadsCount + 1;
+            mesh.indices.insert(mesh.indices.end(),
+                                {corner, corner + 1, above + 1, corner, above + 1, above});
+        }
+    }
+    return mesh;
+}
+
+/**
+ * Cube made of six separate grids, like a cube with a separate UV-island on each side would be.
+ */
+TestMesh createCube(UInt quadsCount)
+{
+    TestMesh grid = createGrid(quadsCount);
+    TestMesh cube;
+    auto half = static_cast<Float>(quadsCount) / 2.0F;
+
+    for (UInt side = 0; side < 6; side++)
+    {
+        auto firstVertex = static_cast<UInt>(cube.positions.size());
+        for (auto const &position : grid.positions)
+        {
+            FVec3 local(position.x - half, position.y - half, half);
+            std::array<FVec3, 6> rotated = {
+                local,
+                FVec3(-local.x, local.y, -local.z),
+                FVec3(local.z, local.y, -local.x),
+                FVec3(-local.z, local.y, local.x),
+                FVec3(local.x, local.z, -local.y),
+                FVec3(local.x, -local.z, local.y),
+            };
+            cube.positions.push_back(rotated[side]);
+        }
+        for (auto index : grid.indices)
+        {
+            cube.indices.push_back(firstVertex + index);
+        }
+    }
+    return cube;
+}
+
+/**
+ * Unit UV-sphere without seams: the poles and the meridian are shared vertices.
+ */
+TestMesh createSphere(UInt rings, UInt segments)
+{
+    TestMesh mesh;
+    auto pi = std::numbers::pi_v<Float>;
+    mesh.positions.emplace_back(0.0F, 1.0F, 0.0F);
+    for (UInt ring = 1; ring < rings; ring++)
+    {
+        Float theta = pi * static_cast<Float>(ring) / static_cast<Float>(rings);
+        for (UInt segment = 0; segment < segments; segment++)
+        {
+            Float phi = 2.0F * pi * static_cast<Float>(segment) / static_cast<Float>(segments);
+            mesh.positions.emplace_back(std::sin(theta) * std::cos(phi),
+                                        std::cos(theta),
+                                        -std::sin(theta) * std::sin(phi));
+        }
+    }
+    mesh.positions.emplace_back(0.0F, -1.0F, 0.0F);
+    auto bottom = static_cast<UInt>(mesh.positions.size() - 1);
+
+    auto ringVertex = [segments](UInt ring, UInt segment)
+    { return 1 + (ring - 1) * segments + segment % segments; };
+
+    for (UInt segment = 0; segment < segments; segment++)
+    {
+        mesh.indices.insert(mesh.indices.end(),
+                            {0, ringVertex(1, segment), ringVertex(1, segment + 1)});
+        mesh.indices.insert(
+            mesh.indices.end(),
+            {bottom, ringVertex(rings - 1, segment + 1), ringVertex(rings - 1, segment)});
+    }
+    for (UInt ring = 1; ring + 1 < rings; ring++)
+    {
+        for (UInt segment = 0; segment < segments; segment++)
+        {
+            UInt a = ringVertex(ring, segment), b = ringVertex(ring, segment + 1);
+            UInt c = ringVertex(ring + 1, segment), d = ringVertex(ring + 1, segment + 1);
+            mesh.indices.insert(mesh.indices.end(), {a, c, d, a, d, b});
+        }
+    }
+    return mesh;
+}
+
+/**
+ * Folded over triangles have a negative volume, so they make the total volume smaller.
+ */
+Float signedVolume(std::vector<FVec3> const &positions, std::vector<UInt> const &indices)
+{
+    Float volume = 0.0F;
+    for (size_t i = 0; i < indices.size(); i += 3)
+    {
+        FVec3 const &a = positions[indices[i + 0]];
+        FVec3 const &b = positions[indices[i + 1]];
+        FVec3 const &c = positions[indices[i + 2]];
+        volume += glm::dot(a, glm::cross(b, c)) / 6.0F;
+    }
+    return volume;
+}
+
+// NOLINTNEXTLINE
+TEST(MeshSimplifier_Simplify, FlatCube_CollapsesToFewTrianglesWithoutError)
+{
+    TestMesh cube = createCube(8);
+    MeshSimplifier simplifier(cube.positions, cube.indices);
+
+    auto result = simplifier.simplify(cube.indices.size() / 10);
+
+    EXPECT_LE(result.indices.size(), cube.indices.size() / 10);
+    EXPECT_NEAR(result.error, 0.0F, 1e-3F);
+}
+
+// NOLINTNEXTLINE
+TEST(MeshSimplifier_Simplify, FlatCube_SidesAreNotGluedTogether)
+{
+    TestMesh cube = createCube(8);
+    auto verticesPerSide = static_cast<UInt>(cube.positions.size() / 6);
+    MeshSimplifier simplifier(cube.positions, cube.indices);
+
+    auto result = simplifier.simplify(cube.indices.size() / 10);
+
+    for (size_t i = 0; i < result.indices.size(); i += 3)
+    {
+        UInt side = result.indices[i] / verticesPerSide;
+        EXPECT_EQ(result.indices[i + 1] / verticesPerSide, side);
+        EXPECT_EQ(result.indices[i + 2] / verticesPerSide, side);
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(MeshSimplifier_Simplify, Sphere_KeepsVolume)
+{
+    TestMesh sphere = createSphere(24, 48);
+    MeshSimplifier simplifier(sphere.positions, sphere.indices);
+
+    auto result = simplifier.simplify(sphere.indices.size() / 8);
+
+    Float originalVolume = signedVolume(sphere.positions, sphere.indices);
+    ASSERT_LE(result.indices.size(), sphere.indices.size() / 8);
+    EXPECT_NEAR(
+        signedVolume(sphere.positions, result.indices), originalVolume, originalVolume * 0.1F);
+}
+
+// NOLINTNEXTLINE
+TEST(MeshSimplifier_Simplify, Sphere_ErrorGrowsWithSimplification)
+{
+    TestMesh sphere = createSphere(24, 48);
+    MeshSimplifier simplifier(sphere.positions, sphere.indices);
+
+    auto half = simplifier.simplify(sphere.indices.size() / 2);
+    auto eighth = simplifier.simplify(sphere.indices.size() / 8);
+
+    EXPECT_GT(half.error, 0.0F);
+    EXPECT_LE(half.error, eighth.error);
+    EXPECT_LT(eighth.error, 0.5F);
+}
+
+// NOLINTNEXTLINE
+TEST(MeshSimplifier_Simplify, ZeroMaxError_KeepsCurvedMesh)
+{
+    TestMesh sphere = createSphere(8, 16);
+    MeshSimplifier simplifier(sphere.positions, sphere.indices);
+
+    auto result = simplifier.simplify(0, 0.0F);
+
+    EXPECT_EQ(result.indices, sphere.indices);
+    EXPECT_EQ(result.error, 0.0F);
+}
+
+// NOLINTNEXTLINE
+TEST(MeshSimplifier_Simplify, OpenGrid_KeepsBorderVertices)
+{
+    TestMesh grid = createGrid(6);
+    MeshSimplifier simplifier(grid.positions, grid.indices);
+
+    auto result = simplifier.simplify(0);
+    std::set<UInt> usedVertices(result.indices.begin(), result.indices.end());
+
+    EXPECT_LT(result.indices.size(), grid.indices.size());
+    for (UInt i = 0; i <= 6; i++)
+    {
+        EXPECT_TRUE(usedVertices.contains(i));
+        EXPECT_TRUE(usedVertices.contains(6 * 7 + i));
+        EXPECT_TRUE(usedVertices.contains(i * 7));
+        EXPECT_TRUE(usedVertices.contains(i * 7 + 6));
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(MeshSimplifier_Simplify, TargetAboveIndicesCount_ReturnsOriginal)
+{
+    TestMesh sphere = createSphere(8, 16);
+    MeshSimplifier simplifier(sphere.positions, sphere.indices);
+
+    auto result = simplifier.simplify(sphere.indices.size());
+
+    EXPECT_EQ(result.indices, sphere.indices);
+}
+
+// NOLINTNEXTLINE
+TEST(MeshSimplifier_Constructor, IndexOutOfRange_Throws)
+{
+    std::vector<FVec3> positions = {FVec3(0.0F), FVec3(1.0F), FVec3(2.0F)};
+    std::vector<UInt> indices = {0, 1, 3};
+
+    EXPECT_THROW(MeshSimplifier(positions, indices), std::out_of_range);
+}
+
+// NOLINTNEXTLINE
+TEST(MeshSimplifier_Constructor, IndicesNotMultipleOfThree_Throws)
+{
+    std::vector<FVec3> positions = {FVec3(0.0F), FVec3(1.0F), FVec3(2.0F)};
+    std::vector<UInt> indices = {0, 1};
+
+    EXPECT_THROW(MeshSimplifier(positions, indices), std::invalid_argument);
+}
+
+// NOLINTNEXTLINE
+TEST(MeshSimplifier_Simplify, FacetedSphere_SimplifiesOnlyWithCollapsedSeams)
+{
+    // Every triangle has its own vertices, as if the sphere was flat shaded
+    TestMesh smoothSphere = createSphere(16, 32);
+    TestMesh sphere;
+    for (auto index : smoothSphere.indices)
+    {
+        sphere.indices.push_back(static_cast<UInt>(sphere.positions.size()));
+        sphere.positions.push_back(smoothSphere.positions[index]);
+    }
+    MeshSimplifier simplifier(sphere.positions, sphere.indices);
+
+    auto withSeams = simplifier.simplify(sphere.indices.size() / 4);
+    auto withoutSeams = simplifier.simplify(sphere.indices.size() / 4,
+                                            std::numeric_limits<Float>::max(),
+                                            MeshSimplifier::COLLAPSE_SEAMS);
+
+    EXPECT_EQ(withSeams.indices.size(), sphere.indices.size());
+    EXPECT_LE(withoutSeams.indices.size(), sphere.indices.size() / 4);
+}
@@ -0,0 +1,103 @@
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <pf_gl/MipResidency.hpp>
+#include <pf_gl/ValueTypes.hpp>
+
+using pf::gl::MipResidency;
+using pf::gl::types::BinarySize;
+
+/**
+ * 8x8 texture with a byte per texel, the levels down to 2x2 are always resident.
+ */
+std::vector<BinarySize> const LEVEL_SIZES = {64, 16, 4, 1};
+pf::gl::types::Size constexpr ALWAYS_RESIDENT_LEVEL = 2;
+
+// NOLINTNEXTLINE
+TEST(MipResidency_LevelFor, ScreenSize_PicksTheSmallestLevelNotSmallerThanTheScreen)
+{
+    EXPECT_EQ(MipResidency::levelFor(1024, 1024.0F, 11), 0);
+    EXPECT_EQ(MipResidency::levelFor(1024, 300.0F, 11), 1);
+    EXPECT_EQ(MipResidency::levelFor(1024, 4000.0F, 11), 0);
+    EXPECT_EQ(MipResidency::levelFor(1024, 0.5F, 11), 10);
+    EXPECT_EQ(MipResidency::levelFor(1024, 0.0F, 11), 10);
+}
+
+// NOLINTNEXTLINE
+TEST(MipResidency_Update, Request_LoadsLevelsWithinTheUploadBudget)
+{
+    MipResidency residency(1000, 20);
+    auto id = residency.add(LEVEL_SIZES, ALWAYS_RESIDENT_LEVEL);
+    EXPECT_EQ(residency.residentBytes(), 0);
+    EXPECT_EQ(residency.residentBytes(id), 5);
+
+    residency.request(id, 0);
+    auto changes = residency.update();
+    ASSERT_EQ(changes.size(), 1);
+    EXPECT_EQ(changes[0].previousBaseLevel, 2);
+    EXPECT_EQ(changes[0].baseLevel, 1);
+
+    // The largest level is loaded even though it exceeds the upload budget on its own
+    residency.request(id, 0);
+    changes = residency.update();
+    ASSERT_EQ(changes.size(), 1);
+    EXPECT_EQ(changes[0].baseLevel, 0);
+    EXPECT_EQ(residency.residentBytes(), 80);
+    EXPECT_EQ(residency.residentBytes(id), 85);
+}
+
+// NOLINTNEXTLINE
+TEST(MipResidency_Update, FullBudget_EvictsTheLeastRecentlyUsed)
+{
+    MipResidency residency(100, 1000);
+    auto first = residency.add(LEVEL_SIZES, ALWAYS_RESIDENT_LEVEL);
+    auto second = residency.add(LEVEL_SIZES, ALWAYS_RESIDENT_LEVEL);
+
+    residency.request(first, 0);
+    residency.update();
+    EXPECT_EQ(residency.baseLevel(first), 0);
+
+    // Only the second texture is requested, the first one gives up its largest level
+    residency.request(second, 0);
+    auto changes = residency.update();
+    EXPECT_EQ(residency.baseLevel(first), 1);
+    EXPECT_EQ(residency.baseLevel(second), 0);
+    EXPECT_EQ(changes.size(), 2);
+    EXPECT_EQ(residency.residentBytes(), 96);
+}
+
+// NOLINTNEXTLINE
+TEST(MipResidency_Update, RequestedTextures_AreNotEvictedForEachOther)
+{
+    MipResidency residency(90, 1000);
+    auto first = residency.add(LEVEL_SIZES, ALWAYS_RESIDENT_LEVEL);
+    auto second = residency.add(LEVEL_SIZES, ALWAYS_RESIDENT_LEVEL);
+
+    residency.request(first, 0);
+    residency.request(second, 0);
+    residency.update();
+
+    // Both got the level 1, the level 0 of either one does not fit anymore
+    EXPECT_EQ(residency.baseLevel(first), 1);
+    EXPECT_EQ(residency.baseLevel(second), 1);
+    EXPECT_EQ(residency.residentBytes(), 32);
+}
+
+// NOLINTNEXTLINE
+TEST(MipResidency_Update, LoweredBudget_EvictsUnusedLevels)
+{
+    MipResidency residency(1000, 1000);
+    auto id = residency.add(LEVEL_SIZES, ALWAYS_RESIDENT_LEVEL);
+    residency.request(id, 0);
+    residency.update();
+
+    residency.budget(20);
+    auto changes = residency.update();
+    ASSERT_EQ(changes.size(), 1);
+    EXPECT_EQ(changes[0].baseLevel, 1);
+    EXPECT_EQ(residency.residentBytes(), 16);
+
+    residency.remove(id);
+    EXPECT_EQ(residency.residentBytes(), 0);
+}
@@ -0,0 +1,301 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <glm/glm.hpp>
+
+#include <pf_gl/Mesh.hpp>
+#include <pf_gl/MeshData.hpp>
+#include <pf_gl/ModelImporter.hpp>
+#include <pf_gl/ObjLoader.hpp>
+#include <pf_gl/Texture.hpp>
+#include <pf_gl/ValueTypes.hpp>
+
+using pf::gl::ModelImporter;
+using pf::gl::ObjLoader;
+using pf::gl::types::FVec2;
+using pf::gl::types::FVec3;
+using pf::gl::types::UInt;
+
+std::filesystem::path const MODELS_DIRECTORY =
+    std::filesystem::path(__FILE__).parent_path() / "../../../projects/Learn-OpenGL/res/models";
+
+/**
+ * Triangle corners rounded to a fixed precision, so that the triangles read by different parsers
+ * can be compared regardless of the order of the vertices and the triangles.
+ */
+using TriangleKey = std::array<long, 24>;
+
+TriangleKey triangleKey(std::vector<pf::gl::Mesh::SimpleVertex> const &vertices,
+                        UInt const *triangle)
+{
+    // The first corner is the smallest one, the winding order is kept
+    std::array<std::array<long, 8>, 3> corners{};
+    for (size_t i = 0; i < 3; i++)
+    {
+        auto const &vertex = vertices[triangle[i]];
+        std::array<float, 8> values = {vertex.position.x,
+                                       vertex.position.y,
+                                       vertex.position.z,
+                                       vertex.normal.x,
+                                       vertex.normal.y,
+                                       vertex.normal.z,
+                                       vertex.textureCoordinates.x,
+                                       vertex.textureCoordinates.y};
+        for (size_t j = 0; j < values.size(); j++)
+        {
+            corners[i][j] = std::lround(values[j] * 10'000.0F);
+        }
+    }
+    std::rotate(corners.begin(), std::min_element(corners.begin(), corners.end()), corners.end());
+
+    TriangleKey key{};
+    for (size_t i = 0; i < 3; i++)
+    {
+        std::copy(corners[i].begin(), corners[i].end(), key.begin() + static_cast<long>(i * 8));
+    }
+    return key;
+}
+
+std::vector<std::tuple<std::string, TriangleKey>>
+trianglesOf(std::vector<ModelImporter::ImportedMesh> const &meshes)
+{
+    std::vector<std::tuple<std::string, TriangleKey>> triangles;
+    for (auto const &mesh : meshes)
+    {
+        std::string texturesKey;
+        for (auto const &texture : mesh.textures)
+        {
+            texturesKey += std::to_string(texture.type) + texture.path.lexically_normal().string();
+        }
+        for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3)
+        {
+            triangles.emplace_back(texturesKey, triangleKey(mesh.vertices, &mesh.indices[i]));
+        }
+    }
+    std::sort(triangles.begin(), triangles.end());
+    return triangles;
+}
+
+// NOLINTNEXTLINE
+TEST(ObjLoader_Parse, Quad_IsTriangulatedAsFan)
+{
+    auto groups = ObjLoader::parse("v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\nvt 0 0\nvt 1 0.25\n"
+                                   "f 1/1 2/2 3/1 4/2\n",
+                                   ".");
+
+    ASSERT_EQ(groups.size(), 1);
+    EXPECT_EQ(groups[0].indices, std::vector<UInt>({0, 1, 2, 0, 2, 3}));
+    ASSERT_EQ(groups[0].vertices.size(), 4);
+    EXPECT_EQ(groups[0].vertices[2].position, FVec3(1.0F, 1.0F, 0.0F));
+
+    // Flipped vertically, same as with the assimp import
+    EXPECT_EQ(groups[0].vertices[1].textureCoordinates, FVec2(1.0F, 0.75F));
+}
+
+// NOLINTNEXTLINE
+TEST(ObjLoader_Parse, NegativeIndices_AreRelativeToTheLastVertex)
+{
+    std::string vertices = "v 0 0 0\nv 1 0 0\nv 0 1 0\nvn 0 0 1\n";
+    auto absolute = ObjLoader::parse(vertices + "f 1//1 2//1 3//1\n", ".");
+    auto relative = ObjLoader::parse(vertices + "f -3//-1 -2//-1 -1//-1\n", ".");
+
+    ASSERT_EQ(relative.size(), 1);
+    EXPECT_EQ(relative[0].indices, absolute[0].indices);
+    for (size_t i = 0; i < 3; i++)
+    {
+        EXPECT_EQ(relative[0].vertices[i].position, absolute[0].vertices[i].position);
+        EXPECT_EQ(relative[0].vertices[i].normal, FVec3(0.0F, 0.0F, 1.0F));
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(ObjLoader_Parse, MissingAttributes_AreZeroed)
+{
+    auto groups = ObjLoader::parse("v 1 2 3\nv 4 5 6\nv 7 8 9\nf 1 2 3\n", ".");
+
+    ASSERT_EQ(groups.size(), 1);
+    for (auto const &vertex : groups[0].vertices)
+    {
+        EXPECT_EQ(vertex.normal, FVec3(0.0F));
+        EXPECT_EQ(vertex.textureCoordinates, FVec2(0.0F));
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(ObjLoader_Parse, SharedCorners_AreWeldedOnlyWhenAllIndicesMatch)
+{
+    auto groups = ObjLoader::parse("v 0 0 0\nv 1 0 0\nv 0 1 0\nv 1 1 0\nvn 0 0 1\nvn 0 0 -1\n"
+                                   "f 1//1 2//1 3//1\nf 3//1 2//1 4//1\nf 1//2 3//2 2//2\n",
+                                   ".");
+
+    ASSERT_EQ(groups.size(), 1);
+    EXPECT_EQ(groups[0].vertices.size(), 7);
+    EXPECT_EQ(groups[0].indices, std::vector<UInt>({0, 1, 2, 2, 1, 3, 4, 5, 6}));
+}
+
+// NOLINTNEXTLINE
+TEST(ObjLoader_Parse, Materials_SplitTheFacesAndReferenceTextures)
+{
+    auto directory = std::filesystem::temp_directory_path();
+    {
+        std::ofstream library(directory / "pf-gl-obj-loader.mtl");
+        library << "newmtl first\nmap_Kd first.png\nmap_Ks -bm 1.0 first-specular.png\n"
+                << "newmtl second\nKd 1 1 1\n";
+    }
+
+    auto groups = ObjLoader::parse("mtllib pf-gl-obj-loader.mtl\nv 0 0 0\nv 1 0 0\nv 0 1 0\n"
+                                   "usemtl first\nf 1 2 3\nusemtl second\nf 3 2 1\n"
+                                   "usemtl unused\nusemtl first\nf 2 1 3\n",
+                                   directory);
+
+    ASSERT_EQ(groups.size(), 2);
+    EXPECT_EQ(groups[0].material, "first");
+    EXPECT_EQ(groups[0].indices.size(), 6);
+    ASSERT_EQ(groups[0].textures.size(), 2);
+    EXPECT_EQ(groups[0].textures[0].type, pf::gl::DIFFUSE);
+    EXPECT_EQ(groups[0].textures[0].path, directory / "first.png");
+    EXPECT_EQ(groups[0].textures[1].type, pf::gl::SPECULAR);
+    EXPECT_EQ(groups[0].textures[1].path, directory / "first-specular.png");
+
+    EXPECT_EQ(groups[1].material, "second");
+    EXPECT_EQ(groups[1].indices.size(), 3);
+    EXPECT_TRUE(groups[1].textures.empty());
+    std::filesystem::remove(directory / "pf-gl-obj-loader.mtl");
+}
+
+// NOLINTNEXTLINE
+TEST(ObjLoader_Parse, SeveralChunks_GiveTheSameResultAsOne)
+{
+    // Relative indices and material switches across the chunk boundaries included
+    std::string text;
+    UInt size = 40;
+    for (UInt y = 0; y <= size; y++)
+    {
+        for (UInt x = 0; x <= size; x++)
+        {
+            text += "v " + std::to_string(x) + " " + std::to_string(y) + " 0\n";
+            text += "vt " + std::to_string(x * 0.025F) + " " + std::to_string(y * 0.025F) + "\n";
+        }
+    }
+    auto index = [](UInt value) { return std::to_string(value); };
+    for (UInt y = 0; y < size; y++)
+    {
+        text += y % 7 == 0 ? "usemtl even\n" : "";
+        text += y % 7 == 3 ? "usemtl odd\n" : "";
+        for (UInt x = 0; x < size; x++)
+        {
+            UInt first = y * (size + 1) + x + 1;
+            std::array<UInt, 4> quad = {first, first + 1, first + size + 2, first + size + 1};
+            if (x % 2 == 0)
+            {
+                text += "f";
+                for (UInt corner : quad)
+                {
+                    text += " " + index(corner) + "/" + index(corner);
+                }
+                text += "\n";
+            }
+            else
+            {
+                text += "v 0.5 0.5 1\nf -1 " + index(quad[0]) + " " + index(quad[1]) + "\n";
+            }
+        }
+    }
+
+    auto single = ObjLoader::parse(text, ".", 1);
+    auto chunked = ObjLoader::parse(text, ".", 8, 1024);
+
+    ASSERT_EQ(chunked.size(), single.size());
+    for (size_t i = 0; i < single.size(); i++)
+    {
+        EXPECT_EQ(chunked[i].material, single[i].material);
+        EXPECT_EQ(chunked[i].indices, single[i].indices);
+        ASSERT_EQ(chunked[i].vertices.size(), single[i].vertices.size());
+        for (size_t j = 0; j < single[i].vertices.size(); j++)
+        {
+            EXPECT_EQ(chunked[i].vertices[j].position, single[i].vertices[j].position);
+            EXPECT_EQ(chunked[i].vertices[j].textureCoordinates,
+                      single[i].vertices[j].textureCoordinates);
+        }
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(ObjLoader_Parse, MissingVertex_Throws)
+{
+    EXPECT_THROW(std::ignore = ObjLoader::parse("v 0 0 0\nv 1 0 0\nf 1 2 3\n", "."),
+                 std::runtime_error);
+    EXPECT_THROW(std::ignore = ObjLoader::parse("v 0 0 0\nv 1 0 0\nf 1 2 -3\n", "."),
+                 std::runtime_error);
+}
+
+// NOLINTNEXTLINE
+TEST(ObjLoader_Parse, MalformedNumber_Throws)
+{
+    EXPECT_THROW(std::ignore = ObjLoader::parse("v 0 zero 0\n", "."), std::runtime_error);
+    EXPECT_THROW(std::ignore = ObjLoader::parse("v 0 0 0\nf 1 a 1\n", "."), std::runtime_error);
+}
+
+class ObjLoader_BundledModels : public testing::TestWithParam<char const *>
+{
+};
+
+// NOLINTNEXTLINE
+TEST_P(ObjLoader_BundledModels, GivenModel_MatchesAssimp)
+{
+    std::filesystem::path path = MODELS_DIRECTORY / GetParam();
+
+    auto native = trianglesOf(ModelImporter::parse(path, ModelImporter::NATIVE_PARSER));
+    auto assimp = trianglesOf(ModelImporter::parse(path, ModelImporter::ASSIMP_PARSER));
+
+    EXPECT_FALSE(native.empty());
+    EXPECT_EQ(native, assimp);
+}
+
+// NOLINTNEXTLINE
+INSTANTIATE_TEST_SUITE_P(ObjLoader,
+                         ObjLoader_BundledModels,
+                         testing::Values("barrel.obj", "astolfo-plushie.obj"));
+
+// NOLINTNEXTLINE
+TEST(ModelImporter_DiffuseTextureArrays, Barrel_DiffuseTextureMovesIntoArray)
+{
+    std::filesystem::path path = MODELS_DIRECTORY / "barrel.obj";
+    ModelImporter separate(path);
+    ModelImporter arranged(path, ModelImporter::NATIVE_PARSER, true);
+
+    EXPECT_TRUE(separate.diffuseTextureArrays().empty());
+    ASSERT_EQ(arranged.diffuseTextureArrays().size(), 1);
+    ASSERT_EQ(arranged.diffuseTextureArrays().front().size(), 1);
+    ASSERT_EQ(arranged.meshes().size(), separate.meshes().size());
+
+    for (size_t i = 0; i < arranged.meshes().size(); i++)
+    {
+        auto const &mesh = arranged.meshes()[i];
+        ASSERT_TRUE(mesh.diffuseRegion.has_value());
+        EXPECT_EQ(mesh.diffuseRegion->array, 0);
+        EXPECT_EQ(mesh.diffuseRegion->layer, 0);
+        EXPECT_TRUE(std::none_of(mesh.textures.begin(),
+                                 mesh.textures.end(),
+                                 [](pf::gl::MeshData::TextureReference const &texture)
+                                 { return texture.type == pf::gl::TextureType::DIFFUSE; }));
+        EXPECT_EQ(mesh.textures.size() + 1, separate.meshes()[i].textures.size());
+
+        // The texture is too large to be packed, it takes the whole layer
+        ASSERT_EQ(mesh.vertices.size(), separate.meshes()[i].vertices.size());
+        for (size_t j = 0; j < mesh.vertices.size(); j++)
+        {
+            EXPECT_EQ(mesh.vertices[j].textureCoordinates,
+                      separate.meshes()[i].vertices[j].textureCoordinates);
+        }
+    }
+}
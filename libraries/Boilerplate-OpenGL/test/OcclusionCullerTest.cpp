@@ -0,0 +1,186 @@
+#include <array>
+#include <numbers>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <glm/glm.hpp>
+#include <glm/ext/matrix_clip_space.hpp>
+#include <glm/ext/matrix_transform.hpp>
+
+#include <pf_gl/BoundingVolumes.hpp>
+#include <pf_gl/OcclusionCuller.hpp>
+#include <pf_gl/ValueTypes.hpp>
+
+using pf::gl::BoundingBox;
+using pf::gl::OcclusionCuller;
+using pf::gl::types::FMat4;
+using pf::gl::types::FVec3;
+using pf::gl::types::UInt;
+
+/**
+ * Camera at the origin looking down the negative Z axis.
+ */
+FMat4 createViewProjection()
+{
+    auto projection = glm::perspective(std::numbers::pi_v<float> / 2.0F, 2.0F, 0.1F, 100.0F);
+    auto view = glm::lookAt(FVec3(0.0F), FVec3(0.0F, 0.0F, -1.0F), FVec3(0.0F, 1.0F, 0.0F));
+    return projection * view;
+}
+
+/**
+ * Square wall of the given half size at the given distance in front of the camera.
+ */
+void addWall(OcclusionCuller &culler, float distance, float halfSize, bool facingCamera = true)
+{
+    std::array<FVec3, 4> vertices = {
+        FVec3(-halfSize, -halfSize, -distance),
+        FVec3(halfSize, -halfSize, -distance),
+        FVec3(halfSize, halfSize, -distance),
+        FVec3(-halfSize, halfSize, -distance),
+    };
+    std::array<UInt, 6> frontIndices = {0, 1, 2, 0, 2, 3};
+    std::array<UInt, 6> backIndices = {0, 2, 1, 0, 3, 2};
+
+    culler.addOccluder(vertices, facingCamera ? frontIndices : backIndices, FMat4(1.0F));
+}
+
+BoundingBox boxAt(FVec3 const &center, float halfSize)
+{
+    return {.min = center - FVec3(halfSize), .max = center + FVec3(halfSize)};
+}
+
+// NOLINTNEXTLINE
+TEST(OcclusionCuller_IsVisible, NoOccluders_BoxInFrontIsVisible)
+{
+    OcclusionCuller culler(256, 128, 1);
+    culler.beginFrame(createViewProjection());
+    culler.rasterize();
+
+    EXPECT_TRUE(culler.isVisible(boxAt(FVec3(0.0F, 0.0F, -20.0F), 1.0F)));
+}
+
+// NOLINTNEXTLINE
+TEST(OcclusionCuller_IsVisible, BoxBehindWall_IsOccluded)
+{
+    OcclusionCuller culler;
+    culler.beginFrame(createViewProjection());
+    addWall(culler, 5.0F, 3.0F);
+    culler.rasterize();
+
+    EXPECT_FALSE(culler.isVisible(boxAt(FVec3(0.0F, 0.0F, -10.0F), 1.0F)));
+}
+
+// NOLINTNEXTLINE
+TEST(OcclusionCuller_IsVisible, BoxInFrontOfWall_IsVisible)
+{
+    OcclusionCuller culler;
+    culler.beginFrame(createViewProjection());
+    addWall(culler, 5.0F, 3.0F);
+    culler.rasterize();
+
+    EXPECT_TRUE(culler.isVisible(boxAt(FVec3(0.0F, 0.0F, -3.0F), 0.5F)));
+}
+
+// NOLINTNEXTLINE
+TEST(OcclusionCuller_IsVisible, BoxBehindWallPeekingOut_IsVisible)
+{
+    OcclusionCuller culler;
+    culler.beginFrame(createViewProjection());
+    addWall(culler, 5.0F, 3.0F);
+    culler.rasterize();
+
+    // The box is far enough to the side to stick out from behind the wall
+    EXPECT_TRUE(culler.isVisible(boxAt(FVec3(6.5F, 0.0F, -10.0F), 1.0F)));
+}
+
+// NOLINTNEXTLINE
+TEST(OcclusionCuller_IsVisible, BoxCrossingNearPlane_IsVisible)
+{
+    OcclusionCuller culler;
+    culler.beginFrame(createViewProjection());
+    addWall(culler, 5.0F, 3.0F);
+    culler.rasterize();
+
+    EXPECT_TRUE(culler.isVisible(boxAt(FVec3(0.0F, 0.0F, 0.0F), 1.0F)));
+}
+
+// NOLINTNEXTLINE
+TEST(OcclusionCuller_IsVisible, BackFacingWall_DoesNotOcclude)
+{
+    OcclusionCuller culler;
+    culler.beginFrame(createViewProjection());
+    addWall(culler, 5.0F, 3.0F, false);
+    culler.rasterize();
+
+    EXPECT_TRUE(culler.isVisible(boxAt(FVec3(0.0F, 0.0F, -10.0F), 1.0F)));
+    EXPECT_EQ(culler.depth(128, 64), 1.0F);
+}
+
+// NOLINTNEXTLINE
+TEST(OcclusionCuller_Rasterize, Wall_WritesItsDepthOnlyInsideOfIt)
+{
+    OcclusionCuller culler;
+    culler.beginFrame(createViewProjection());
+    addWall(culler, 5.0F, 3.0F);
+    culler.rasterize();
+
+    float expectedDepth = createViewProjection()[2][2] * -5.0F + createViewProjection()[3][2];
+    expectedDepth = (expectedDepth / 5.0F) * 0.5F + 0.5F;
+
+    EXPECT_NEAR(culler.depth(128, 64), expectedDepth, 1e-4F);
+    EXPECT_EQ(culler.depth(2, 2), 1.0F);
+    EXPECT_EQ(culler.depth(253, 125), 1.0F);
+}
+
+// NOLINTNEXTLINE
+TEST(OcclusionCuller_Rasterize, MultipleThreads_SameDepthAsSingleThread)
+{
+    OcclusionCuller singleThreaded(256, 128, 1);
+    OcclusionCuller multiThreaded(256, 128, 8);
+
+    for (auto *culler : {&singleThreaded, &multiThreaded})
+    {
+        culler->beginFrame(createViewProjection());
+        addWall(*culler, 5.0F, 3.0F);
+        addWall(*culler, 3.0F, 1.0F);
+        culler->rasterize();
+    }
+
+    for (int y = 0; y < 128; y++)
+    {
+        for (int x = 0; x < 256; x++)
+        {
+            ASSERT_EQ(singleThreaded.depth(x, y), multiThreaded.depth(x, y));
+        }
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(OcclusionCuller_Cull, MixedBoxes_KeepsVisibleIndicesInOrder)
+{
+    OcclusionCuller culler;
+    culler.beginFrame(createViewProjection());
+    addWall(culler, 5.0F, 3.0F);
+    culler.rasterize();
+
+    std::vector<BoundingBox> boxes = {
+        boxAt(FVec3(0.0F, 0.0F, -10.0F), 1.0F),
+        boxAt(FVec3(0.0F, 0.0F, -3.0F), 0.5F),
+        boxAt(FVec3(1.0F, 1.0F, -20.0F), 1.0F),
+        boxAt(FVec3(6.5F, 0.0F, -10.0F), 1.0F),
+    };
+    std::vector<UInt> indices = {0, 1, 2, 3};
+
+    culler.cull(boxes, indices);
+
+    EXPECT_EQ(indices, std::vector<UInt>({1, 3}));
+    EXPECT_EQ(culler.statistics().visibleCount, 2);
+    EXPECT_EQ(culler.statistics().occludedCount, 2);
+}
+
+// NOLINTNEXTLINE
+TEST(OcclusionCuller_Constructor, SizeNotMultipleOfTileSize_Throws)
+{
+    EXPECT_THROW(OcclusionCuller(100, 128), std::invalid_argument);
+}
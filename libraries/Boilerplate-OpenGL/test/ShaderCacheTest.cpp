@@ -0,0 +1,68 @@
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <pf_gl/ShaderCache.hpp>
+
+using pf::gl::ShaderCache;
+
+// NOLINTNEXTLINE
+TEST(ShaderCache_Key, DifferentInputs_DifferentKeys)
+{
+    std::vector<std::string> sources = {"void main() {}", "void main() { discard; }"};
+    std::vector<std::string> joinedSources = {sources[0] + sources[1]};
+    std::vector<std::string> definitions = {"SHADOWS"};
+    std::uint64_t key = ShaderCache::key(sources, {}, "driver 1.0");
+
+    EXPECT_EQ(key, ShaderCache::key(sources, {}, "driver 1.0"));
+    EXPECT_NE(key, ShaderCache::key(sources, {}, "driver 1.1"));
+    EXPECT_NE(key, ShaderCache::key(sources, definitions, "driver 1.0"));
+    EXPECT_NE(key, ShaderCache::key(joinedSources, {}, "driver 1.0"));
+}
+
+// NOLINTNEXTLINE
+TEST(ShaderCache_Store, StoredEntry_LoadsTheSameEntry)
+{
+    auto directory = std::filesystem::temp_directory_path() / "pf-gl-shader-cache";
+    std::filesystem::remove_all(directory);
+    ShaderCache cache(directory);
+
+    ShaderCache::Entry entry = {.binaryFormat = 0x1234, .binary = {}};
+    for (size_t i = 0; i < 1000; i++)
+    {
+        entry.binary.push_back(static_cast<std::byte>(i * 7));
+    }
+    cache.store(42, entry);
+
+    std::optional<ShaderCache::Entry> loaded = cache.load(42);
+    ASSERT_TRUE(loaded.has_value());
+    EXPECT_EQ(loaded->binaryFormat, entry.binaryFormat);
+    EXPECT_EQ(loaded->binary, entry.binary);
+    EXPECT_FALSE(cache.load(43).has_value());
+
+    std::filesystem::remove_all(directory);
+}
+
+// NOLINTNEXTLINE
+TEST(ShaderCache_Load, TruncatedEntry_Nothing)
+{
+    auto directory = std::filesystem::temp_directory_path() / "pf-gl-shader-cache-truncated";
+    std::filesystem::remove_all(directory);
+    ShaderCache cache(directory);
+    cache.store(7, {.binaryFormat = 1, .binary = std::vector<std::byte>(64, std::byte{1})});
+
+    for (auto const &file : std::filesystem::directory_iterator(directory))
+    {
+        std::filesystem::resize_file(file.path(), std::filesystem::file_size(file.path()) - 1);
+    }
+
+    EXPECT_FALSE(cache.load(7).has_value());
+
+    std::filesystem::remove_all(directory);
+}
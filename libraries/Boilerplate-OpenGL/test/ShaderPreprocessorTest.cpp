@@ -0,0 +1,119 @@
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <pf_gl/ShaderPreprocessor.hpp>
+
+using pf::gl::ShaderDefinition;
+using pf::gl::ShaderPreprocessor;
+
+namespace
+{
+
+void writeFile(std::filesystem::path const &path, std::string const &text)
+{
+    std::filesystem::create_directories(path.parent_path());
+    std::ofstream(path, std::ios::binary) << text;
+}
+
+} // namespace
+
+// NOLINTNEXTLINE
+TEST(ShaderPreprocessor_Process, NestedIncludes_PastedOnceWithLineDirectives)
+{
+    auto directory = std::filesystem::temp_directory_path() / "pf-gl-shader-preprocessor";
+    std::filesystem::remove_all(directory);
+    writeFile(directory / "main.fs",
+              "#version 430\n#include \"common.glsl\"\n#include <lights.glsl>\nvoid main() {}\n");
+    writeFile(directory / "common.glsl", "float common;\n");
+    writeFile(directory / "include" / "lights.glsl",
+              "#include \"../common.glsl\"\n"
+              "  #  include \"lights.glsl\" // itself\n"
+              "float light;\n");
+
+    ShaderPreprocessor preprocessor({directory / "include"});
+    ShaderPreprocessor::Result result = preprocessor.process(directory / "main.fs");
+
+    EXPECT_EQ(result.source,
+              "#version 430\n"
+              "#line 1 1\n"
+              "float common;\n"
+              "#line 3 0\n"
+              "#line 1 2\n"
+              "\n"
+              "\n"
+              "float light;\n"
+              "#line 4 0\n"
+              "void main() {}\n");
+    ASSERT_EQ(result.files.size(), 3);
+    EXPECT_EQ(result.files[1].filename(), "common.glsl");
+    EXPECT_EQ(result.files[2].filename(), "lights.glsl");
+
+    std::filesystem::remove_all(directory);
+}
+
+// NOLINTNEXTLINE
+TEST(ShaderPreprocessor_Process, MissingInclude_Throws)
+{
+    auto directory = std::filesystem::temp_directory_path() / "pf-gl-shader-preprocessor-missing";
+    std::filesystem::remove_all(directory);
+    writeFile(directory / "main.fs", "#version 430\n#include <missing.glsl>\n");
+
+    // Angled includes are not looked up next to the including file
+    writeFile(directory / "missing.glsl", "float missing;\n");
+
+    EXPECT_THROW(static_cast<void>(ShaderPreprocessor().process(directory / "main.fs")),
+                 std::runtime_error);
+
+    std::filesystem::remove_all(directory);
+}
+
+// NOLINTNEXTLINE
+TEST(ShaderPreprocessor_Process, MalformedIncludes_KeptAsTheyAre)
+{
+    auto directory = std::filesystem::temp_directory_path() / "pf-gl-shader-preprocessor-malformed";
+    std::filesystem::remove_all(directory);
+    writeFile(directory / "main.fs",
+              "#version 430\r\n"
+              "#include \"common.glsl\"\r\n"
+              "#include \"common.glsl\" float after;\n"
+              "#include \"\"\n"
+              "#include <common.glsl\n"
+              "// #include \"common.glsl\"\n"
+              "#included \"common.glsl\"\n");
+    writeFile(directory / "common.glsl", "float common;\n");
+
+    ShaderPreprocessor::Result result = ShaderPreprocessor().process(directory / "main.fs");
+
+    EXPECT_EQ(result.source,
+              "#version 430\r\n"
+              "#line 1 1\n"
+              "float common;\n"
+              "#line 3 0\n"
+              "#include \"common.glsl\" float after;\n"
+              "#include \"\"\n"
+              "#include <common.glsl\n"
+              "// #include \"common.glsl\"\n"
+              "#included \"common.glsl\"\n");
+
+    std::filesystem::remove_all(directory);
+}
+
+// NOLINTNEXTLINE
+TEST(ShaderPreprocessor_Define, Definitions_InsertedAfterVersion)
+{
+    std::vector<ShaderDefinition> definitions = {{.name = "SHADOWS", .value = ""},
+                                                 {.name = "MAX_LIGHTS", .value = "4"}};
+
+    EXPECT_EQ(ShaderPreprocessor::define("// header\n#version 430\nvoid main() {}\n", definitions),
+              "// header\n#version 430\n#define SHADOWS \n#define MAX_LIGHTS 4\n#line 3\n"
+              "void main() {}\n");
+    EXPECT_EQ(ShaderPreprocessor::define("#version 430\nvoid main() {}\n", {}),
+              "#version 430\nvoid main() {}\n");
+    EXPECT_THROW(static_cast<void>(ShaderPreprocessor::define("void main() {}\n", definitions)),
+                 std::invalid_argument);
+}
@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+
+#include <pf_gl/Shader.hpp>
+
+using pf::gl::Uniform;
+
+// NOLINTNEXTLINE
+TEST(Uniform_FromName, PlainName_WholeNameEverywhere)
+{
+    Uniform uniform = Uniform::fromName("u_model");
+
+    EXPECT_EQ(uniform.fullName, "u_model");
+    EXPECT_EQ(uniform.baseName, "u_model");
+    EXPECT_EQ(uniform.secondaryName, "u_model");
+    EXPECT_EQ(uniform.arrayIndex, -1);
+    EXPECT_EQ(uniform.purpose, Uniform::MODEL_MATRIX);
+}
+
+// NOLINTNEXTLINE
+TEST(Uniform_FromName, ArrayOfStructures_SplitIntoParts)
+{
+    Uniform uniform = Uniform::fromName("u_pointLights[12].position");
+
+    EXPECT_EQ(uniform.baseName, "u_pointLights");
+    EXPECT_EQ(uniform.secondaryName, "position");
+    EXPECT_EQ(uniform.arrayIndex, 12);
+    EXPECT_EQ(uniform.purpose, Uniform::POINT_LIGHT_POSITION);
+
+    Uniform texture = Uniform::fromName("u_diffuseTexture[0]");
+    EXPECT_EQ(texture.baseName, "u_diffuseTexture");
+    EXPECT_EQ(texture.arrayIndex, 0);
+    EXPECT_EQ(texture.purpose, Uniform::DIFFUSE_TEXTURE);
+}
+
+// NOLINTNEXTLINE
+TEST(Uniform_FromName, MalformedIndex_KeptInBaseName)
+{
+    for (char const *name : {"u_matrices[1][2]", "u_values[]", "u_values[x]", "[3]"})
+    {
+        Uniform uniform = Uniform::fromName(name);
+        EXPECT_EQ(uniform.baseName, name);
+        EXPECT_EQ(uniform.arrayIndex, -1);
+        EXPECT_EQ(uniform.purpose, Uniform::GENERIC);
+    }
+}
+
+static_assert(pf::gl::UniformValue<pf::gl::types::FVec3>);
+static_assert(!pf::gl::UniformValue<pf::gl::types::Double>);
+static_assert(!pf::gl::UniformValue<pf::gl::types::FMat3>);
+
+// NOLINTNEXTLINE
+TEST(UniformHandle_With, DefaultHandle_NoLocation)
+{
+    pf::gl::UniformHandle<pf::gl::types::FVec3> handle;
+    auto assignment = handle.with(pf::gl::types::FVec3(1.0F, 2.0F, 3.0F));
+
+    EXPECT_EQ(handle.location(), -1);
+    EXPECT_EQ(assignment.handle.location(), -1);
+    EXPECT_EQ(assignment.value, pf::gl::types::FVec3(1.0F, 2.0F, 3.0F));
+}
@@ -0,0 +1,131 @@
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <pf_gl/Image.hpp>
+#include <pf_gl/SkylinePacker.hpp>
+#include <pf_gl/TextureArrayBuilder.hpp>
+#include <pf_gl/ValueTypes.hpp>
+
+using pf::gl::Image;
+using pf::gl::SkylinePacker;
+using pf::gl::TextureArrayBuilder;
+using pf::gl::types::Size;
+
+bool overlap(SkylinePacker::Rectangle const &first, SkylinePacker::Rectangle const &second)
+{
+    return first.x < second.x + second.width && second.x < first.x + first.width &&
+           first.y < second.y + second.height && second.y < first.y + first.height;
+}
+
+Image solidImage(Size width, Size height, std::uint8_t value)
+{
+    auto size = static_cast<size_t>(width * height) * Image::CHANNELS_COUNT;
+    return {width, height, std::vector<std::uint8_t>(size, value)};
+}
+
+// NOLINTNEXTLINE
+TEST(SkylinePacker_Insert, EqualSquares_FillTheBin)
+{
+    SkylinePacker packer(64, 64);
+    std::vector<SkylinePacker::Rectangle> rectangles;
+    for (size_t i = 0; i < 16; i++)
+    {
+        auto rectangle = packer.insert(16, 16);
+        ASSERT_TRUE(rectangle.has_value());
+        rectangles.push_back(*rectangle);
+    }
+
+    EXPECT_FALSE(packer.insert(1, 1).has_value());
+    EXPECT_FLOAT_EQ(packer.occupancy(), 1.0F);
+    for (size_t i = 0; i < rectangles.size(); i++)
+    {
+        for (size_t j = i + 1; j < rectangles.size(); j++)
+        {
+            EXPECT_FALSE(overlap(rectangles[i], rectangles[j]));
+        }
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(SkylinePacker_Insert, MixedSizes_DoNotOverlapAndStayInside)
+{
+    SkylinePacker packer(100, 100);
+    std::vector<SkylinePacker::Rectangle> rectangles;
+    for (Size size : {40, 30, 30, 25, 20, 20, 15, 10, 10, 5, 5, 5})
+    {
+        auto rectangle = packer.insert(size, size / 2 + 5);
+        ASSERT_TRUE(rectangle.has_value());
+        EXPECT_LE(rectangle->x + rectangle->width, 100);
+        EXPECT_LE(rectangle->y + rectangle->height, 100);
+        for (auto const &other : rectangles)
+        {
+            EXPECT_FALSE(overlap(*rectangle, other));
+        }
+        rectangles.push_back(*rectangle);
+    }
+
+    EXPECT_FALSE(packer.insert(101, 1).has_value());
+    EXPECT_THROW(SkylinePacker(0, 10), std::invalid_argument);
+}
+
+// NOLINTNEXTLINE
+TEST(TextureArrayBuilder_Build, SmallImages_ArePackedIntoOneArrayWithPadding)
+{
+    TextureArrayBuilder builder(32, 8, 2);
+    auto first = builder.add(solidImage(8, 8, 10));
+    auto second = builder.add(solidImage(4, 6, 20));
+    auto result = builder.build();
+
+    ASSERT_EQ(result.arrays.size(), 1);
+    ASSERT_EQ(result.arrays[0].size(), 1);
+    Image const &atlas = result.arrays[0][0];
+    EXPECT_EQ(atlas.width(), 32);
+
+    for (auto [index, value] : {std::pair{first, 10}, std::pair{second, 20}})
+    {
+        auto const &region = result.regions[index];
+        EXPECT_EQ(region.array, 0);
+        EXPECT_EQ(region.layer, 0);
+
+        // Corners of the image, and the padding right outside of them
+        for (auto textureCoordinates : {pf::gl::types::FVec2(0.0F, 0.0F),
+                                        pf::gl::types::FVec2(0.99F, 0.99F)})
+        {
+            auto remapped = region.remap(textureCoordinates);
+            auto x = static_cast<pf::gl::types::Int>(remapped.x * 32.0F);
+            auto y = static_cast<pf::gl::types::Int>(remapped.y * 32.0F);
+            EXPECT_EQ(atlas.pixel(x, y)[0], value);
+            EXPECT_EQ(atlas.pixel(x + (textureCoordinates.x > 0.5F ? 2 : -2), y)[0], value);
+        }
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(TextureArrayBuilder_Build, LargeImages_AreGroupedBySize)
+{
+    TextureArrayBuilder builder(32, 8, 2);
+    auto first = builder.add(solidImage(16, 16, 1));
+    auto second = builder.add(solidImage(16, 32, 2));
+    auto third = builder.add(solidImage(16, 16, 3));
+    auto small = builder.add(solidImage(8, 8, 4));
+    auto result = builder.build();
+
+    ASSERT_EQ(result.arrays.size(), 3);
+    EXPECT_EQ(result.regions[first].array, result.regions[third].array);
+    EXPECT_EQ(result.regions[first].layer, 0);
+    EXPECT_EQ(result.regions[third].layer, 1);
+    EXPECT_NE(result.regions[second].array, result.regions[first].array);
+    EXPECT_EQ(result.regions[small].array, 0);
+
+    Image const &layer = result.arrays[result.regions[third].array][result.regions[third].layer];
+    EXPECT_EQ(layer.pixels()[0], 3);
+    EXPECT_FLOAT_EQ(result.regions[third].remap({0.25F, 0.5F}).x, 0.25F);
+
+    EXPECT_THROW(TextureArrayBuilder(16, 16, 1), std::invalid_argument);
+}
@@ -0,0 +1,125 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <pf_gl/BlockCompressor.hpp>
+#include <pf_gl/Image.hpp>
+#include <pf_gl/TextureFile.hpp>
+#include <pf_gl/ValueTypes.hpp>
+
+using pf::gl::BlockCompressor;
+using pf::gl::Image;
+using pf::gl::TextureFile;
+using pf::gl::types::Size;
+
+/**
+ * Full mip chain of a 20x12 texture, each level filled with its own index.
+ */
+std::vector<std::vector<std::byte>> createLevels(BlockCompressor::Format format)
+{
+    std::vector<std::vector<std::byte>> levels;
+    for (Size level = 0; level < 5; level++)
+    {
+        levels.emplace_back(BlockCompressor::compressedSize(
+                                format, std::max(1, 20 >> level), std::max(1, 12 >> level)),
+                            std::byte(level + 1));
+    }
+    return levels;
+}
+
+// NOLINTNEXTLINE
+TEST(TextureFile_Write, GivenLevels_ReadsBackTheSameTexture)
+{
+    auto path = std::filesystem::temp_directory_path() / "pf-gl-texture-file.ktx2";
+    auto levels = createLevels(BlockCompressor::BC7);
+    TextureFile::write(path, BlockCompressor::BC7, true, 20, 12, levels);
+
+    TextureFile file(path);
+    EXPECT_EQ(file.format(), BlockCompressor::BC7);
+    EXPECT_TRUE(file.srgb());
+    EXPECT_EQ(file.width(), 20);
+    EXPECT_EQ(file.height(), 12);
+    ASSERT_EQ(file.levelsCount(), 5);
+    for (Size i = 0; i < file.levelsCount(); i++)
+    {
+        auto level = file.level(i);
+        ASSERT_EQ(level.size(), levels[static_cast<size_t>(i)].size());
+        EXPECT_TRUE(std::equal(level.begin(), level.end(), levels[static_cast<size_t>(i)].begin()));
+
+        // Aligned to the block size within the file
+        auto offset = level.data() - file.level(file.levelsCount() - 1).data();
+        EXPECT_EQ(offset % 16, 0);
+    }
+    std::filesystem::remove(path);
+}
+
+// NOLINTNEXTLINE
+TEST(TextureFile_Write, CompressedImage_MatchesTheLevelSizes)
+{
+    auto path = std::filesystem::temp_directory_path() / "pf-gl-texture-file-image.ktx2";
+    Image image(7, 5, std::vector<std::uint8_t>(7 * 5 * 4, 200));
+
+    std::vector<std::vector<std::byte>> levels;
+    Size levelsCount = image.levelsCount();
+    for (Size i = 0; i < levelsCount; i++)
+    {
+        levels.push_back(BlockCompressor::compress(image, BlockCompressor::BC1));
+        image = image.downsample();
+    }
+    TextureFile::write(path, BlockCompressor::BC1, false, 7, 5, levels);
+
+    TextureFile file(path);
+    EXPECT_EQ(file.levelsCount(), 3);
+    EXPECT_EQ(file.level(0).size(), 2 * 2 * 8);
+    EXPECT_EQ(file.level(2).size(), 8);
+    std::filesystem::remove(path);
+}
+
+// NOLINTNEXTLINE
+TEST(TextureFile_Write, WrongLevelSize_Throws)
+{
+    auto path = std::filesystem::temp_directory_path() / "pf-gl-texture-file-wrong.ktx2";
+    auto levels = createLevels(BlockCompressor::BC1);
+    levels[2].pop_back();
+
+    EXPECT_THROW(TextureFile::write(path, BlockCompressor::BC1, false, 20, 12, levels),
+                 std::invalid_argument);
+    EXPECT_THROW(TextureFile::write(
+                     path, BlockCompressor::BC5, true, 20, 12, createLevels(BlockCompressor::BC5)),
+                 std::invalid_argument);
+}
+
+// NOLINTNEXTLINE
+TEST(TextureFile_Constructor, WrongIdentifier_Throws)
+{
+    auto path = std::filesystem::temp_directory_path() / "pf-gl-texture-file-identifier.ktx2";
+    TextureFile::write(
+        path, BlockCompressor::BC3, false, 20, 12, createLevels(BlockCompressor::BC3));
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(5);
+        file.put('3');
+    }
+
+    EXPECT_THROW(TextureFile file(path), std::runtime_error);
+    std::filesystem::remove(path);
+}
+
+// NOLINTNEXTLINE
+TEST(TextureFile_Constructor, TruncatedFile_Throws)
+{
+    auto path = std::filesystem::temp_directory_path() / "pf-gl-texture-file-truncated.ktx2";
+    TextureFile::write(
+        path, BlockCompressor::BC3, false, 20, 12, createLevels(BlockCompressor::BC3));
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 16);
+
+    EXPECT_THROW(TextureFile file(path), std::runtime_error);
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,90 @@
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <variant>
+
+#include <gtest/gtest.h>
+
+#include <pf_gl/ValueTypes.hpp>
+
+namespace types = pf::gl::types;
+
+static_assert(types::sizeInBytes(types::FLOAT_MATRIX_4) == sizeof(types::FMat4));
+static_assert(types::sizeInBytes(types::SHORT_VECTOR_4) == sizeof(types::ShortVec4));
+static_assert(types::sizeInBytes(types::INT_2_10_10_10_REV) == sizeof(types::UInt));
+static_assert(types::scalarCount(types::FLOAT_VECTOR_3) == 3);
+static_assert(types::openglScalar(types::HALF_FLOAT_VECTOR_2) == GL_HALF_FLOAT);
+
+namespace
+{
+
+struct ExpectedType
+{
+    types::ValueType type;
+    size_t variantIndex;
+    types::BinarySize size;
+};
+
+template <typename T>
+ExpectedType expected(types::ValueType type)
+{
+    return {.type = type,
+            .variantIndex = types::ValueTypeVariant(std::in_place_type<T>).index(),
+            .size = sizeof(T)};
+}
+
+} // namespace
+
+// NOLINTNEXTLINE
+TEST(ValueTypes_Meta, EveryType_MatchesTheVariant)
+{
+    // Half floats and the packed vectors are stored as the unsigned integers of the same size
+    std::array<ExpectedType, types::VALUE_TYPE_TO_META.size()> const expectedTypes = {{
+        expected<types::Float>(types::FLOAT),
+        expected<types::FVec2>(types::FLOAT_VECTOR_2),
+        expected<types::FVec3>(types::FLOAT_VECTOR_3),
+        expected<types::FVec4>(types::FLOAT_VECTOR_4),
+        expected<types::Double>(types::DOUBLE),
+        expected<types::DVec2>(types::DOUBLE_VECTOR_2),
+        expected<types::DVec3>(types::DOUBLE_VECTOR_3),
+        expected<types::DVec4>(types::DOUBLE_VECTOR_4),
+        expected<types::FMat2>(types::FLOAT_MATRIX_2),
+        expected<types::FMat3>(types::FLOAT_MATRIX_3),
+        expected<types::FMat4>(types::FLOAT_MATRIX_4),
+        expected<types::UInt>(types::UNSIGNED_INT),
+        expected<types::Int>(types::INT),
+        expected<types::IntVec2>(types::INT_VECTOR_2),
+        expected<types::Size>(types::SIZE),
+        expected<types::BinarySize>(types::BINARY_SIZE),
+        expected<types::Bool>(types::BOOL),
+        expected<types::Byte>(types::BYTE),
+        expected<types::Short>(types::SHORT),
+        expected<types::UShort>(types::UNSIGNED_SHORT),
+        expected<types::ShortVec4>(types::SHORT_VECTOR_4),
+        expected<types::UShort>(types::HALF_FLOAT),
+        expected<types::HalfVec2>(types::HALF_FLOAT_VECTOR_2),
+        expected<types::UInt>(types::INT_2_10_10_10_REV),
+    }};
+
+    for (size_t i = 0; i < expectedTypes.size(); i++)
+    {
+        ExpectedType const &expectedType = expectedTypes[i];
+        types::ValueTypeMeta const &meta = types::VALUE_TYPE_TO_META[i];
+        ASSERT_EQ(meta.type, expectedType.type) << meta.name;
+        EXPECT_EQ(meta.defaultValue.index(), expectedType.variantIndex) << meta.name;
+        EXPECT_EQ(types::sizeInBytes(meta.type), expectedType.size) << meta.name;
+    }
+
+    EXPECT_EQ(std::get<types::FMat3>(types::defaultValue(types::FLOAT_MATRIX_3)),
+              types::FMat3(1.0F));
+    EXPECT_EQ(types::openglScalar(types::BOOL), GL_FALSE);
+}
+
+// NOLINTNEXTLINE
+TEST(ValueTypes_Meta, UnknownType_Throws)
+{
+    auto unknown = static_cast<types::ValueType>(types::INT_2_10_10_10_REV + 1);
+
+    EXPECT_THROW(static_cast<void>(types::sizeInBytes(unknown)), std::runtime_error);
+    EXPECT_THROW(static_cast<void>(types::name(unknown)), std::runtime_error);
+}
@@ -0,0 +1,56 @@
+#include <cstddef>
+
+#include <gtest/gtest.h>
+
+#include <pf_gl/VertexFormat.hpp>
+#include <pf_gl/VertexLayout.hpp>
+#include <pf_gl/ValueTypes.hpp>
+
+namespace types = pf::gl::types;
+
+using pf::gl::VertexField;
+using pf::gl::VertexFormat;
+using pf::gl::VertexLayout;
+
+namespace
+{
+
+struct ColoredVertex
+{
+    types::FVec3 position;
+    types::FVec4 color;
+    types::FVec2 textureCoordinates;
+};
+
+using ColoredVertexFormat =
+    VertexFormat<ColoredVertex,
+                 VertexField<types::FLOAT_VECTOR_3, pf::gl::POSITION>,
+                 VertexField<types::FLOAT_VECTOR_4, pf::gl::COLOR, true>,
+                 VertexField<types::FLOAT_VECTOR_2, pf::gl::TEXTURE_COORDINATES>>;
+
+static_assert(ColoredVertexFormat::STRIDE == sizeof(ColoredVertex));
+static_assert(ColoredVertexFormat::OFFSETS[1] == offsetof(ColoredVertex, color));
+static_assert(ColoredVertexFormat::OFFSETS[2] == offsetof(ColoredVertex, textureCoordinates));
+static_assert(ColoredVertexFormat::ATTRIBUTES[1].normalized);
+
+} // namespace
+
+// NOLINTNEXTLINE
+TEST(VertexFormat_Layout, SameAsRunTimeLayout)
+{
+    VertexLayout layout = ColoredVertexFormat::layout();
+    VertexLayout runTimeLayout({
+        {types::FLOAT_VECTOR_3, pf::gl::POSITION},
+        {types::FLOAT_VECTOR_4, pf::gl::COLOR, true},
+        {types::FLOAT_VECTOR_2, pf::gl::TEXTURE_COORDINATES},
+    });
+
+    EXPECT_EQ(layout, runTimeLayout);
+    ASSERT_EQ(layout.size(), ColoredVertexFormat::ATTRIBUTES_COUNT);
+    EXPECT_EQ(layout.stride(), ColoredVertexFormat::STRIDE);
+    for (std::size_t i = 0; i < layout.size(); i++)
+    {
+        EXPECT_EQ(layout.offset(i), ColoredVertexFormat::OFFSETS.at(i));
+    }
+    EXPECT_FALSE(layout == VertexLayout({{types::FLOAT_VECTOR_3, pf::gl::POSITION}}));
+}
@@ -0,0 +1,131 @@
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+#include <glm/glm.hpp>
+
+#include <pf_gl/VertexQuantizer.hpp>
+#include <pf_gl/BoundingVolumes.hpp>
+#include <pf_gl/ValueTypes.hpp>
+
+using pf::gl::BoundingBox;
+using pf::gl::VertexQuantizer;
+using pf::gl::types::Float;
+using pf::gl::types::FMat3;
+using pf::gl::types::FVec2;
+using pf::gl::types::FVec3;
+using pf::gl::types::FVec4;
+
+// NOLINTNEXTLINE
+TEST(VertexQuantizer_HalfFloat, ExactValues_RoundTrip)
+{
+    for (Float value : {0.0F, 1.0F, -2.0F, 0.5F, 0.099975586F, 65504.0F, 6.1035156e-05F})
+    {
+        EXPECT_EQ(VertexQuantizer::fromHalfFloat(VertexQuantizer::toHalfFloat(value)), value);
+    }
+    EXPECT_EQ(VertexQuantizer::toHalfFloat(1.0F), 0x3C00);
+    EXPECT_EQ(VertexQuantizer::toHalfFloat(-2.0F), 0xC000);
+}
+
+// NOLINTNEXTLINE
+TEST(VertexQuantizer_HalfFloat, OutOfRange_BecomesInfinityOrSubnormal)
+{
+    EXPECT_EQ(VertexQuantizer::toHalfFloat(70000.0F), 0x7C00);
+    EXPECT_EQ(VertexQuantizer::toHalfFloat(-std::numeric_limits<Float>::infinity()), 0xFC00);
+    EXPECT_TRUE(std::isnan(VertexQuantizer::fromHalfFloat(
+        VertexQuantizer::toHalfFloat(std::numeric_limits<Float>::quiet_NaN()))));
+
+    // The smallest subnormal half float is 2^-24
+    EXPECT_EQ(VertexQuantizer::toHalfFloat(std::ldexp(1.0F, -24)), 0x0001);
+    EXPECT_EQ(VertexQuantizer::toHalfFloat(std::ldexp(1.0F, -26)), 0x0000);
+}
+
+// NOLINTNEXTLINE
+TEST(VertexQuantizer_HalfFloat, TextureCoordinates_AreCloseEnough)
+{
+    for (Float value = -4.0F; value <= 4.0F; value += 0.01F)
+    {
+        auto restored = VertexQuantizer::fromHalfFloat(VertexQuantizer::toHalfFloat(value));
+        // 10 bits of mantissa
+        EXPECT_NEAR(restored, value, std::abs(value) / 1024.0F + 1e-7F);
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(VertexQuantizer_Snorm10, UnitVectors_RoundTrip)
+{
+    for (FVec3 vector : {FVec3(1.0F, 0.0F, 0.0F),
+                         FVec3(0.0F, -1.0F, 0.0F),
+                         FVec3(0.0F, 0.0F, -1.0F),
+                         glm::normalize(FVec3(1.0F, -2.0F, 3.0F))})
+    {
+        FVec3 restored = VertexQuantizer::fromSnorm10(VertexQuantizer::toSnorm10(vector));
+        for (glm::length_t axis = 0; axis < 3; axis++)
+        {
+            EXPECT_NEAR(restored[axis], vector[axis], 1.0F / 1022.0F);
+        }
+    }
+    EXPECT_EQ(VertexQuantizer::toSnorm10(FVec3(1.0F, 0.0F, 0.0F)), 511U);
+    EXPECT_EQ(VertexQuantizer::toSnorm10(FVec3(0.0F, -1.0F, 0.0F)), 513U << 10);
+}
+
+// NOLINTNEXTLINE
+TEST(VertexQuantizer_Quantize, Positions_AreWithinPrecisionOfBox)
+{
+    BoundingBox box{.min = FVec3(-3.0F, 10.0F, 0.0F), .max = FVec3(5.0F, 12.0F, 100.0F)};
+    VertexQuantizer quantizer(box);
+
+    for (FVec3 position : {box.min, box.max, box.center(), FVec3(1.2345F, 11.1F, 42.42F)})
+    {
+        auto vertex = quantizer.quantize(position, FVec3(0.0F, 1.0F, 0.0F), FVec2(0.0F));
+        FVec3 restored = quantizer.dequantizePosition(vertex.position);
+        FVec4 transformed = quantizer.dequantizationMatrix() *
+                            FVec4(VertexQuantizer::fromSnorm16(vertex.position.x),
+                                  VertexQuantizer::fromSnorm16(vertex.position.y),
+                                  VertexQuantizer::fromSnorm16(vertex.position.z),
+                                  1.0F);
+
+        for (glm::length_t axis = 0; axis < 3; axis++)
+        {
+            Float precision = box.extents()[axis] / VertexQuantizer::MAX_SNORM_16;
+            EXPECT_NEAR(restored[axis], position[axis], precision);
+            EXPECT_NEAR(transformed[axis], restored[axis], precision);
+        }
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(VertexQuantizer_Quantize, Normals_ComeOutRightAfterNormalMatrix)
+{
+    // A stretched box makes the dequantization scale strongly non-uniform
+    BoundingBox box{.min = FVec3(0.0F), .max = FVec3(100.0F, 1.0F, 10.0F)};
+    VertexQuantizer quantizer(box);
+    FVec3 normal = glm::normalize(FVec3(1.0F, 1.0F, 1.0F));
+
+    auto vertex = quantizer.quantize(box.center(), normal, FVec2(0.0F));
+    FMat3 normalMatrix = glm::transpose(glm::inverse(FMat3(quantizer.dequantizationMatrix())));
+    FVec3 restored = glm::normalize(normalMatrix * VertexQuantizer::fromSnorm10(vertex.normal));
+
+    EXPECT_GT(glm::dot(restored, normal), 0.999F);
+}
+
+// NOLINTNEXTLINE
+TEST(VertexQuantizer_Constructor, FlatBox_HasInvertibleMatrix)
+{
+    BoundingBox box{.min = FVec3(-1.0F, 0.0F, -1.0F), .max = FVec3(1.0F, 0.0F, 1.0F)};
+    VertexQuantizer quantizer(box);
+
+    auto vertex = quantizer.quantize(FVec3(0.5F, 0.0F, -0.5F), FVec3(0.0F, 1.0F, 0.0F), FVec2());
+    FVec3 restored = quantizer.dequantizePosition(vertex.position);
+
+    EXPECT_EQ(quantizer.dequantizationMatrix()[1][1], 1.0F);
+    EXPECT_NEAR(restored.y, 0.0F, 1e-6F);
+    EXPECT_NEAR(restored.x, 0.5F, 1e-4F);
+}
+
+// NOLINTNEXTLINE
+TEST(VertexQuantizer_Constructor, EmptyBox_Throws)
+{
+    EXPECT_THROW(VertexQuantizer quantizer(BoundingBox::EMPTY), std::invalid_argument);
+}
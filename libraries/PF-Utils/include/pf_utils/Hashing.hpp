@@ -2,6 +2,8 @@
 #define HASHING_HPP
 
 #include <cstddef>
+#include <cstdint>
+#include <string_view>
 #include <utility>
 #include <functional>
 
@@ -11,6 +13,15 @@ namespace pf::util
 template <typename T, typename... Rest>
 void hashCombine(size_t &seed, T const &value, Rest... rest);
 
+std::uint64_t constexpr FNV1A_OFFSET_BASIS = 0xcbf29ce484222325;
+std::uint64_t constexpr FNV1A_PRIME = 0x100000001b3;
+
+/**
+ * 64-bit FNV-1a hash. Unlike `std::hash` it is the same on every platform and every run, so it can
+ * be stored. Feeding the previous hash as the seed hashes several strings as if they were one.
+ */
+std::uint64_t constexpr fnv1a(std::string_view data, std::uint64_t seed = FNV1A_OFFSET_BASIS);
+
 struct PairHash
 {
 public:
@@ -29,6 +40,17 @@ void hashCombine(size_t &seed, T const &value, Rest... rest)
     (hashCombine(seed, rest), ...);
 }
 
+std::uint64_t constexpr fnv1a(std::string_view data, std::uint64_t seed)
+{
+    std::uint64_t hash = seed;
+    for (char character : data)
+    {
+        hash ^= static_cast<std::uint8_t>(character);
+        hash *= FNV1A_PRIME;
+    }
+    return hash;
+}
+
 template <typename T, typename U>
 size_t PairHash::operator()(std::pair<T, U> const &x) const
 {
@@ -0,0 +1,34 @@
+#ifndef LZ4_HPP
+#define LZ4_HPP
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+/**
+ * Compression in the LZ4 block format: a sequence of literal runs and back-references of at least
+ * four bytes into the previous 64 KiB. The compressor is a single pass with a hash table, it trades
+ * the ratio for the speed, the decompressor is little more than a bunch of `memcpy` calls.
+ *
+ * The blocks carry no size or checksum, the size of the decompressed data has to be stored
+ * separately.
+ */
+namespace pf::util::lz4
+{
+
+/**
+ * Upper bound of the size of the compressed data, for the incompressible input.
+ */
+size_t compressBound(size_t size);
+
+std::vector<std::byte> compress(std::span<std::byte const> data);
+
+/**
+ * The output span must have the exact size of the decompressed data.
+ * @throws std::runtime_error in case the block is malformed or does not match the output size.
+ */
+void decompress(std::span<std::byte const> compressed, std::span<std::byte> decompressed);
+
+} // namespace pf::util::lz4
+
+#endif // !LZ4_HPP
@@ -0,0 +1,48 @@
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+
+namespace pf::util
+{
+
+/**
+ * Read-only memory mapping of the whole file. The pages are loaded by the OS on the first access,
+ * the mapping asks for them to be read ahead, since the files are expected to be read through from
+ * the beginning to the end.
+ */
+class MappedFile final
+{
+public:
+    /**
+     * @throws std::runtime_error in case the file cannot be opened or mapped.
+     */
+    explicit MappedFile(std::filesystem::path const &path);
+
+    MappedFile(MappedFile const &) = delete;
+    MappedFile(MappedFile &&other) noexcept;
+
+    ~MappedFile();
+
+    MappedFile &operator=(MappedFile const &) = delete;
+    MappedFile &operator=(MappedFile &&other) noexcept;
+
+    [[nodiscard]] std::span<std::byte const> bytes() const;
+
+private:
+    std::byte const *_data = nullptr;
+    size_t _size = 0;
+
+#ifdef _WIN32
+    void *_file = nullptr;
+    void *_mapping = nullptr;
+#endif
+
+    void unmap() noexcept;
+};
+
+} // namespace pf::util
+
+#endif // !MAPPED_FILE_HPP
@@ -0,0 +1,115 @@
+#ifndef PERFECT_HASH_HPP
+#define PERFECT_HASH_HPP
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+#include <pf_utils/Hashing.hpp>
+
+namespace pf::util
+{
+
+/**
+ * Seeded FNV-1a of a string, the default hash of the `PerfectHashMap`.
+ */
+struct SeededFnv1a
+{
+    std::uint64_t constexpr operator()(std::string_view key, std::uint64_t seed) const
+    {
+        return fnv1a(key, seed);
+    }
+};
+
+/**
+ * Map of a fixed set of keys built at compile time. The seed of the hash is searched for until no
+ * two keys land in the same slot, so a lookup is a single hash and a single comparison, and it can
+ * be evaluated at compile time as well.
+ *
+ * The hash takes the key and the seed. A set of keys no seed works for (the seeds are only tried
+ * up to `MAX_SEED_ATTEMPTS`), as well as a repeated key, fails the compilation.
+ */
+template <typename Key, typename Value, std::size_t SIZE, typename Hash = SeededFnv1a>
+class PerfectHashMap final
+{
+public:
+    /**
+     * A quarter of the slots is used at most, a seed is found after a few attempts then.
+     */
+    static std::size_t constexpr SLOTS_COUNT = std::bit_ceil(SIZE * 4);
+    static std::size_t constexpr MAX_SEED_ATTEMPTS = 10'000;
+
+    consteval explicit PerfectHashMap(std::array<std::pair<Key, Value>, SIZE> const &entries)
+    {
+        for (std::size_t i = 0; i < SIZE; i++)
+        {
+            for (std::size_t j = i + 1; j < SIZE; j++)
+            {
+                if (entries[i].first == entries[j].first)
+                {
+                    throw std::invalid_argument("The keys of a perfect hash map must be unique.");
+                }
+            }
+        }
+
+        for (std::size_t attempt = 0; attempt < MAX_SEED_ATTEMPTS; attempt++)
+        {
+            _seed = FNV1A_OFFSET_BASIS + attempt;
+            _used = {};
+            bool collided = false;
+            for (std::size_t i = 0; i < SIZE && !collided; i++)
+            {
+                std::size_t slot = slotOf(entries[i].first);
+                collided = _used[slot];
+                _used[slot] = true;
+                _keys[slot] = entries[i].first;
+                _values[slot] = entries[i].second;
+            }
+            if (!collided)
+            {
+                return;
+            }
+        }
+        throw std::logic_error("No seed places the keys into distinct slots.");
+    }
+
+    [[nodiscard]] constexpr std::optional<Value> find(Key const &key) const
+    {
+        std::size_t slot = slotOf(key);
+        if (!_used[slot] || !(_keys[slot] == key))
+        {
+            return std::nullopt;
+        }
+        return _values[slot];
+    }
+
+    [[nodiscard]] constexpr bool contains(Key const &key) const
+    {
+        return find(key).has_value();
+    }
+
+    [[nodiscard]] constexpr std::uint64_t seed() const
+    {
+        return _seed;
+    }
+
+private:
+    std::uint64_t _seed = FNV1A_OFFSET_BASIS;
+    std::array<bool, SLOTS_COUNT> _used = {};
+    std::array<Key, SLOTS_COUNT> _keys = {};
+    std::array<Value, SLOTS_COUNT> _values = {};
+
+    [[nodiscard]] constexpr std::size_t slotOf(Key const &key) const
+    {
+        return static_cast<std::size_t>(Hash{}(key, _seed)) & (SLOTS_COUNT - 1);
+    }
+};
+
+} // namespace pf::util
+
+#endif // !PERFECT_HASH_HPP
@@ -0,0 +1,74 @@
+#ifndef WORKER_POOL_HPP
+#define WORKER_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+namespace pf::util
+{
+
+/**
+ * Persistent threads for the parallel loops run every frame. The threads are started once and
+ * sleep between the loops, so a loop only costs a wake up instead of starting and joining threads.
+ */
+class WorkerPool final
+{
+public:
+    /**
+     * Zero threads count means that the number of the hardware threads is used. The thread calling
+     * `run` takes part in the work too, so one thread less is started.
+     */
+    explicit WorkerPool(size_t threadsCount = 0);
+
+    WorkerPool(WorkerPool const &) = delete;
+    WorkerPool(WorkerPool &&) = delete;
+
+    ~WorkerPool();
+
+    WorkerPool &operator=(WorkerPool const &) = delete;
+    WorkerPool &operator=(WorkerPool &&) = delete;
+
+    /**
+     * Calls `task` for every index in [0; tasksCount), spread over the threads, and blocks until
+     * all of them are done. Must not be called from the tasks themselves.
+     *
+     * @throws Rethrows the first exception thrown by the tasks, the rest of the tasks still run.
+     */
+    void run(size_t tasksCount, std::function<void(size_t)> const &task);
+
+    /**
+     * Including the calling thread.
+     */
+    [[nodiscard]] size_t threadsCount() const;
+
+private:
+    std::mutex _mutex;
+    std::condition_variable_any _workAdded;
+    std::condition_variable _workFinished;
+
+    // Published under the mutex before the workers are woken up
+    std::function<void(size_t)> const *_task = nullptr;
+    size_t _tasksCount = 0;
+    size_t _generation = 0;
+    size_t _busyWorkers = 0;
+    std::exception_ptr _error;
+
+    std::atomic<size_t> _nextTask = 0;
+
+    // Joined before anything else is destroyed
+    std::vector<std::jthread> _threads;
+
+    void work(std::stop_token const &stopToken);
+    void runTasks();
+};
+
+} // namespace pf::util
+
+#endif // !WORKER_POOL_HPP
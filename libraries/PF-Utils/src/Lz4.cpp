@@ -0,0 +1,249 @@
+#include <pf_utils/Lz4.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <fmt/format.h>
+
+namespace pf::util::lz4
+{
+
+namespace
+{
+
+size_t const MIN_MATCH = 4;
+
+/**
+ * The format requires the last bytes of a block to be literals, and the last match to start a bit
+ * earlier than that, so that the decompressor can copy in larger chunks near the end.
+ */
+size_t const LAST_LITERALS = 5;
+size_t const MATCH_FIND_LIMIT = 12;
+
+size_t const MAX_OFFSET = 65535;
+size_t const HASH_BITS = 14;
+
+/**
+ * Lengths of 15 and more are continued in the following bytes.
+ */
+std::uint8_t const LENGTH_MASK = 15;
+
+std::uint32_t read32(std::byte const *pointer)
+{
+    std::uint32_t value = 0;
+    std::memcpy(&value, pointer, sizeof(value));
+    return value;
+}
+
+size_t hash(std::uint32_t sequence)
+{
+    // Knuth's multiplicative hash
+    return (sequence * 2654435761U) >> (32 - HASH_BITS);
+}
+
+void writeLength(std::vector<std::byte> &output, size_t length)
+{
+    for (; length >= 255; length -= 255)
+    {
+        output.push_back(std::byte(255));
+    }
+    output.push_back(static_cast<std::byte>(length));
+}
+
+void writeSequence(std::vector<std::byte> &output,
+                   std::span<std::byte const> literals,
+                   size_t offset,
+                   size_t matchLength)
+{
+    size_t literalsLength = literals.size();
+    size_t matchExtraLength = matchLength > 0 ? matchLength - MIN_MATCH : 0;
+
+    auto token = static_cast<std::uint8_t>(
+        (std::min<size_t>(literalsLength, LENGTH_MASK) << 4) |
+        (matchLength > 0 ? std::min<size_t>(matchExtraLength, LENGTH_MASK) : 0));
+    output.push_back(static_cast<std::byte>(token));
+
+    if (literalsLength >= LENGTH_MASK)
+    {
+        writeLength(output, literalsLength - LENGTH_MASK);
+    }
+    output.insert(output.end(), literals.begin(), literals.end());
+
+    // The last sequence has only the literals
+    if (matchLength == 0)
+    {
+        return;
+    }
+    output.push_back(static_cast<std::byte>(offset & 0xFFU));
+    output.push_back(static_cast<std::byte>(offset >> 8));
+    if (matchExtraLength >= LENGTH_MASK)
+    {
+        writeLength(output, matchExtraLength - LENGTH_MASK);
+    }
+}
+
+} // namespace
+
+size_t compressBound(size_t size)
+{
+    return size + size / 255 + 16;
+}
+
+std::vector<std::byte> compress(std::span<std::byte const> data)
+{
+    std::vector<std::byte> output;
+    output.reserve(compressBound(data.size()));
+
+    size_t size = data.size();
+    size_t anchor = 0;
+
+    if (size > MATCH_FIND_LIMIT)
+    {
+        // Positions are stored shifted by one, so that zero means an empty slot
+        std::vector<std::uint32_t> hashTable(size_t(1) << HASH_BITS, 0);
+        size_t position = 0;
+
+        while (position + MATCH_FIND_LIMIT < size)
+        {
+            std::uint32_t sequence = read32(data.data() + position);
+            std::uint32_t &entry = hashTable[hash(sequence)];
+            size_t candidate = entry;
+            entry = static_cast<std::uint32_t>(position + 1);
+
+            if (candidate == 0 || position - (candidate - 1) > MAX_OFFSET ||
+                read32(data.data() + candidate - 1) != sequence)
+            {
+                position++;
+                continue;
+            }
+            candidate--;
+
+            size_t matchLength = MIN_MATCH;
+            size_t matchEnd = size - LAST_LITERALS;
+            while (position + matchLength < matchEnd &&
+                   data[candidate + matchLength] == data[position + matchLength])
+            {
+                matchLength++;
+            }
+
+            // The match may also start a bit earlier than the hashed sequence
+            while (position > anchor && candidate > 0 && data[position - 1] == data[candidate - 1])
+            {
+                position--;
+                candidate--;
+                matchLength++;
+            }
+
+            writeSequence(output,
+                          data.subspan(anchor, position - anchor),
+                          position - candidate,
+                          matchLength);
+            position += matchLength;
+            anchor = position;
+        }
+    }
+
+    writeSequence(output, data.subspan(anchor), 0, 0);
+    return output;
+}
+
+void decompress(std::span<std::byte const> compressed, std::span<std::byte> decompressed)
+{
+    size_t input = 0, output = 0;
+
+    auto readLength = [&compressed, &input]()
+    {
+        size_t length = 0;
+        std::uint8_t byte = 0;
+        do
+        {
+            if (input >= compressed.size())
+            {
+                throw std::runtime_error("LZ4 block ends in the middle of a length.");
+            }
+            byte = static_cast<std::uint8_t>(compressed[input++]);
+            length += byte;
+        } while (byte == 255);
+        return length;
+    };
+
+    while (true)
+    {
+        if (input >= compressed.size())
+        {
+            throw std::runtime_error("LZ4 block ends without the last literals.");
+        }
+        auto token = static_cast<std::uint8_t>(compressed[input++]);
+
+        size_t literalsLength = token >> 4;
+        if (literalsLength == LENGTH_MASK)
+        {
+            literalsLength += readLength();
+        }
+        if (literalsLength > compressed.size() - input ||
+            literalsLength > decompressed.size() - output)
+        {
+            throw std::runtime_error("LZ4 literals run out of the block bounds.");
+        }
+        std::memcpy(decompressed.data() + output, compressed.data() + input, literalsLength);
+        input += literalsLength;
+        output += literalsLength;
+
+        if (input == compressed.size())
+        {
+            break;
+        }
+
+        if (compressed.size() - input < 2)
+        {
+            throw std::runtime_error("LZ4 block ends in the middle of an offset.");
+        }
+        size_t offset = static_cast<size_t>(compressed[input]) |
+                        (static_cast<size_t>(compressed[input + 1]) << 8);
+        input += 2;
+        if (offset == 0 || offset > output)
+        {
+            throw std::runtime_error(fmt::format("Invalid LZ4 match offset: {}.", offset));
+        }
+
+        size_t matchLength = token & LENGTH_MASK;
+        if (matchLength == LENGTH_MASK)
+        {
+            matchLength += readLength();
+        }
+        matchLength += MIN_MATCH;
+        if (matchLength > decompressed.size() - output)
+        {
+            throw std::runtime_error("LZ4 match runs out of the output bounds.");
+        }
+
+        std::byte *destination = decompressed.data() + output;
+        std::byte const *source = destination - offset;
+        if (offset >= matchLength)
+        {
+            std::memcpy(destination, source, matchLength);
+        }
+        else
+        {
+            // Overlapping match repeats the last `offset` bytes
+            for (size_t i = 0; i < matchLength; i++)
+            {
+                destination[i] = source[i];
+            }
+        }
+        output += matchLength;
+    }
+
+    if (output != decompressed.size())
+    {
+        throw std::runtime_error(fmt::format(
+            "LZ4 block decompressed into {} bytes, expected {}.", output, decompressed.size()));
+    }
+}
+
+} // namespace pf::util::lz4
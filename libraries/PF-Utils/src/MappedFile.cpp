@@ -0,0 +1,170 @@
+#include <pf_utils/MappedFile.hpp>
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+#include <stdexcept>
+#include <utility>
+
+#include <fmt/format.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace pf::util
+{
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(std::filesystem::path const &path)
+{
+    _file = CreateFileW(path.c_str(),
+                        GENERIC_READ,
+                        FILE_SHARE_READ,
+                        nullptr,
+                        OPEN_EXISTING,
+                        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                        nullptr);
+    if (_file == INVALID_HANDLE_VALUE)
+    {
+        _file = nullptr;
+        throw std::runtime_error(fmt::format("Failed to open the file: \"{}\".", path.string()));
+    }
+
+    LARGE_INTEGER fileSize;
+    if (GetFileSizeEx(_file, &fileSize) == 0)
+    {
+        unmap();
+        throw std::runtime_error(
+            fmt::format("Failed to get the file size: \"{}\".", path.string()));
+    }
+    _size = static_cast<size_t>(fileSize.QuadPart);
+    if (_size == 0)
+    {
+        return;
+    }
+
+    _mapping = CreateFileMappingW(_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    void *view = _mapping != nullptr ? MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (view == nullptr)
+    {
+        unmap();
+        throw std::runtime_error(fmt::format("Failed to map the file: \"{}\".", path.string()));
+    }
+    _data = static_cast<std::byte const *>(view);
+}
+
+void MappedFile::unmap() noexcept
+{
+    if (_data != nullptr)
+    {
+        UnmapViewOfFile(_data);
+    }
+    if (_mapping != nullptr)
+    {
+        CloseHandle(_mapping);
+    }
+    if (_file != nullptr)
+    {
+        CloseHandle(_file);
+    }
+    _data = nullptr;
+    _mapping = nullptr;
+    _file = nullptr;
+    _size = 0;
+}
+
+#else
+
+MappedFile::MappedFile(std::filesystem::path const &path)
+{
+    int file = open(path.c_str(), O_RDONLY);
+    if (file < 0)
+    {
+        throw std::runtime_error(fmt::format("Failed to open the file: \"{}\".", path.string()));
+    }
+
+    struct stat fileStatus = {};
+    if (fstat(file, &fileStatus) != 0)
+    {
+        close(file);
+        throw std::runtime_error(
+            fmt::format("Failed to get the file size: \"{}\".", path.string()));
+    }
+    _size = static_cast<size_t>(fileStatus.st_size);
+    if (_size == 0)
+    {
+        close(file);
+        return;
+    }
+
+    // The mapping keeps the file referenced, the descriptor is not needed anymore
+    void *view = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file);
+    if (view == MAP_FAILED)
+    {
+        _size = 0;
+        throw std::runtime_error(fmt::format("Failed to map the file: \"{}\".", path.string()));
+    }
+    // Only hints, the mapping works all the same in case they are ignored
+    madvise(view, _size, MADV_SEQUENTIAL);
+    madvise(view, _size, MADV_WILLNEED);
+    _data = static_cast<std::byte const *>(view);
+}
+
+void MappedFile::unmap() noexcept
+{
+    if (_data != nullptr)
+    {
+        munmap(const_cast<std::byte *>(_data), _size);
+    }
+    _data = nullptr;
+    _size = 0;
+}
+
+#endif
+
+MappedFile::MappedFile(MappedFile &&other) noexcept
+    : _data(std::exchange(other._data, nullptr))
+    , _size(std::exchange(other._size, 0))
+#ifdef _WIN32
+    , _file(std::exchange(other._file, nullptr))
+    , _mapping(std::exchange(other._mapping, nullptr))
+#endif
+{
+}
+
+MappedFile::~MappedFile()
+{
+    unmap();
+}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept
+{
+    if (this != &other)
+    {
+        unmap();
+        _data = std::exchange(other._data, nullptr);
+        _size = std::exchange(other._size, 0);
+#ifdef _WIN32
+        _file = std::exchange(other._file, nullptr);
+        _mapping = std::exchange(other._mapping, nullptr);
+#endif
+    }
+    return *this;
+}
+
+std::span<std::byte const> MappedFile::bytes() const
+{
+    return {_data, _size};
+}
+
+} // namespace pf::util
@@ -0,0 +1,119 @@
+#include <pf_utils/WorkerPool.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <utility>
+
+namespace pf::util
+{
+
+WorkerPool::WorkerPool(size_t threadsCount)
+{
+    if (threadsCount == 0)
+    {
+        threadsCount = std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+    for (size_t i = 1; i < threadsCount; i++)
+    {
+        _threads.emplace_back([this](std::stop_token const &stopToken) { work(stopToken); });
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    for (auto &thread : _threads)
+    {
+        thread.request_stop();
+    }
+    _threads.clear();
+}
+
+void WorkerPool::run(size_t tasksCount, std::function<void(size_t)> const &task)
+{
+    if (tasksCount == 0)
+    {
+        return;
+    }
+
+    {
+        std::scoped_lock lock(_mutex);
+        _task = &task;
+        _tasksCount = tasksCount;
+        _nextTask = 0;
+        _busyWorkers = _threads.size();
+        _generation++;
+    }
+    _workAdded.notify_all();
+
+    runTasks();
+
+    std::exception_ptr error;
+    {
+        std::unique_lock lock(_mutex);
+        _workFinished.wait(lock, [this] { return _busyWorkers == 0; });
+        _task = nullptr;
+        error = std::exchange(_error, nullptr);
+    }
+    if (error != nullptr)
+    {
+        std::rethrow_exception(error);
+    }
+}
+
+size_t WorkerPool::threadsCount() const
+{
+    return _threads.size() + 1;
+}
+
+void WorkerPool::work(std::stop_token const &stopToken)
+{
+    size_t finishedGeneration = 0;
+    while (true)
+    {
+        {
+            std::unique_lock lock(_mutex);
+            if (!_workAdded.wait(lock,
+                                 stopToken,
+                                 [this, finishedGeneration]
+                                 { return _generation != finishedGeneration; }))
+            {
+                return;
+            }
+            finishedGeneration = _generation;
+        }
+
+        runTasks();
+
+        {
+            std::scoped_lock lock(_mutex);
+            _busyWorkers--;
+        }
+        _workFinished.notify_one();
+    }
+}
+
+void WorkerPool::runTasks()
+{
+    for (size_t index = _nextTask++; index < _tasksCount; index = _nextTask++)
+    {
+        try
+        {
+            (*_task)(index);
+        }
+        catch (...)
+        {
+            std::scoped_lock lock(_mutex);
+            if (_error == nullptr)
+            {
+                _error = std::current_exception();
+            }
+        }
+    }
+}
+
+} // namespace pf::util
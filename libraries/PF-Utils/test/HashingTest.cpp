@@ -0,0 +1,20 @@
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+#include <pf_utils/Hashing.hpp>
+
+// NOLINTNEXTLINE
+TEST(Hashing_Fnv1a, ReferenceValues_SameHashes)
+{
+    static_assert(pf::util::fnv1a("") == pf::util::FNV1A_OFFSET_BASIS);
+
+    EXPECT_EQ(pf::util::fnv1a("a"), std::uint64_t(0xaf63dc4c8601ec8c));
+    EXPECT_EQ(pf::util::fnv1a("foobar"), std::uint64_t(0x85944171f73967e8));
+}
+
+// NOLINTNEXTLINE
+TEST(Hashing_Fnv1a, SeededWithPreviousHash_SameAsConcatenated)
+{
+    EXPECT_EQ(pf::util::fnv1a("bar", pf::util::fnv1a("foo")), pf::util::fnv1a("foobar"));
+}
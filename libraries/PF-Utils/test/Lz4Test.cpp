@@ -0,0 +1,120 @@
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <pf_utils/Lz4.hpp>
+
+namespace lz4 = pf::util::lz4;
+
+std::vector<std::byte> toBytes(std::string_view text)
+{
+    auto const *begin = reinterpret_cast<std::byte const *>(text.data());
+    return {begin, begin + text.size()};
+}
+
+std::vector<std::byte> roundTrip(std::vector<std::byte> const &data)
+{
+    std::vector<std::byte> compressed = lz4::compress(data);
+    EXPECT_LE(compressed.size(), lz4::compressBound(data.size()));
+
+    std::vector<std::byte> decompressed(data.size());
+    lz4::decompress(compressed, decompressed);
+    return decompressed;
+}
+
+// NOLINTNEXTLINE
+TEST(Lz4_RoundTrip, Empty_StaysEmpty)
+{
+    std::vector<std::byte> data;
+
+    EXPECT_EQ(roundTrip(data), data);
+}
+
+// NOLINTNEXTLINE
+TEST(Lz4_RoundTrip, ShortText_IsRestored)
+{
+    auto data = toBytes("Hello!");
+
+    EXPECT_EQ(roundTrip(data), data);
+}
+
+// NOLINTNEXTLINE
+TEST(Lz4_RoundTrip, RandomBytes_AreRestored)
+{
+    std::mt19937 randomEngine(42);
+    std::uniform_int_distribution<int> distribution(0, 255);
+    std::vector<std::byte> data(100000);
+    for (auto &byte : data)
+    {
+        byte = static_cast<std::byte>(distribution(randomEngine));
+    }
+
+    EXPECT_EQ(roundTrip(data), data);
+}
+
+// NOLINTNEXTLINE
+TEST(Lz4_RoundTrip, RepeatedPattern_IsRestoredAndCompressed)
+{
+    // Vertex-like data: the same few floats over and over with a counter in between
+    std::vector<std::byte> data;
+    for (std::uint32_t i = 0; i < 10000; i++)
+    {
+        auto text = toBytes("position normal uv ");
+        data.insert(data.end(), text.begin(), text.end());
+        data.push_back(static_cast<std::byte>(i % 7));
+    }
+
+    std::vector<std::byte> compressed = lz4::compress(data);
+    std::vector<std::byte> decompressed(data.size());
+    lz4::decompress(compressed, decompressed);
+
+    EXPECT_EQ(decompressed, data);
+    EXPECT_LT(compressed.size(), data.size() / 10);
+}
+
+// NOLINTNEXTLINE
+TEST(Lz4_RoundTrip, LongRunOfSameByte_IsRestored)
+{
+    // The match overlaps itself and its length takes several extra bytes
+    std::vector<std::byte> data(5000, std::byte('a'));
+    data.push_back(std::byte('b'));
+
+    EXPECT_EQ(roundTrip(data), data);
+}
+
+// NOLINTNEXTLINE
+TEST(Lz4_Decompress, WrongOutputSize_Throws)
+{
+    auto data = toBytes("abcabcabcabcabcabcabcabcabcabc");
+    std::vector<std::byte> compressed = lz4::compress(data);
+    std::vector<std::byte> decompressed(data.size() + 1);
+
+    EXPECT_THROW(lz4::decompress(compressed, decompressed), std::runtime_error);
+}
+
+// NOLINTNEXTLINE
+TEST(Lz4_Decompress, OffsetBeforeBeginning_Throws)
+{
+    // One literal, then a match with offset 2 while only one byte has been written
+    std::vector<std::byte> compressed = {
+        std::byte(0x10), std::byte('a'), std::byte(0x02), std::byte(0x00), std::byte(0x00)};
+    std::vector<std::byte> decompressed(5);
+
+    EXPECT_THROW(lz4::decompress(compressed, decompressed), std::runtime_error);
+}
+
+// NOLINTNEXTLINE
+TEST(Lz4_Decompress, TruncatedBlock_Throws)
+{
+    auto data = toBytes("abcabcabcabcabcabcabcabcabcabc");
+    std::vector<std::byte> compressed = lz4::compress(data);
+    compressed.resize(compressed.size() / 2);
+    std::vector<std::byte> decompressed(data.size());
+
+    EXPECT_THROW(lz4::decompress(compressed, decompressed), std::runtime_error);
+}
@@ -0,0 +1,63 @@
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <gtest/gtest.h>
+
+#include <pf_utils/MappedFile.hpp>
+
+std::filesystem::path writeTemporaryFile(std::string const &name, std::string const &contents)
+{
+    auto path = std::filesystem::temp_directory_path() / name;
+    std::ofstream file(path, std::ios::binary);
+    file << contents;
+    return path;
+}
+
+// NOLINTNEXTLINE
+TEST(MappedFile_Constructor, ExistingFile_MapsItsContents)
+{
+    auto path = writeTemporaryFile("pf-utils-mapped-file.bin", "mapped contents");
+
+    pf::util::MappedFile file(path);
+    auto bytes = file.bytes();
+
+    EXPECT_EQ(std::string(reinterpret_cast<char const *>(bytes.data()), bytes.size()),
+              "mapped contents");
+    std::filesystem::remove(path);
+}
+
+// NOLINTNEXTLINE
+TEST(MappedFile_Constructor, EmptyFile_HasNoBytes)
+{
+    auto path = writeTemporaryFile("pf-utils-mapped-file-empty.bin", "");
+
+    pf::util::MappedFile file(path);
+
+    EXPECT_TRUE(file.bytes().empty());
+    std::filesystem::remove(path);
+}
+
+// NOLINTNEXTLINE
+TEST(MappedFile_Constructor, MissingFile_Throws)
+{
+    auto path = std::filesystem::temp_directory_path() / "pf-utils-file-that-does-not-exist.bin";
+
+    EXPECT_THROW(pf::util::MappedFile file(path), std::runtime_error);
+}
+
+// NOLINTNEXTLINE
+TEST(MappedFile_Move, MovedFrom_IsEmpty)
+{
+    auto path = writeTemporaryFile("pf-utils-mapped-file-moved.bin", "abc");
+
+    pf::util::MappedFile file(path);
+    pf::util::MappedFile movedFile(std::move(file));
+
+    EXPECT_TRUE(file.bytes().empty()); // NOLINT(bugprone-use-after-move)
+    EXPECT_EQ(movedFile.bytes().size(), 3);
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,48 @@
+#include <array>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <gtest/gtest.h>
+
+#include <pf_utils/PerfectHash.hpp>
+
+namespace
+{
+
+pf::util::PerfectHashMap constexpr COLORS(std::to_array<std::pair<std::string_view, int>>({
+    {"red", 1},
+    {"green", 2},
+    {"blue", 3},
+    {"cyan", 4},
+    {"magenta", 5},
+    {"yellow", 6},
+    {"black", 7},
+    {"white", 8},
+}));
+
+} // namespace
+
+// NOLINTNEXTLINE
+TEST(PerfectHashMap_Find, CompileTime_SameAsRunTime)
+{
+    static_assert(COLORS.find("magenta") == 5);
+    static_assert(!COLORS.contains("orange"));
+
+    std::string key = "yellow";
+    EXPECT_EQ(COLORS.find(key), 6);
+    EXPECT_EQ(COLORS.find("red"), 1);
+}
+
+// NOLINTNEXTLINE
+TEST(PerfectHashMap_Find, MissingKeys_Nothing)
+{
+    for (std::string_view key : {"", "re", "redd", "Red", "whitey"})
+    {
+        EXPECT_FALSE(COLORS.find(key).has_value()) << key;
+    }
+    for (std::string_view key : {"red", "green", "blue", "cyan", "black", "white"})
+    {
+        EXPECT_TRUE(COLORS.contains(key)) << key;
+    }
+}
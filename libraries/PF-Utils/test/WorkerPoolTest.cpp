@@ -0,0 +1,50 @@
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <pf_utils/WorkerPool.hpp>
+
+using pf::util::WorkerPool;
+
+// NOLINTNEXTLINE
+TEST(WorkerPool_Run, RepeatedRuns_EveryTaskOnce)
+{
+    WorkerPool workers(4);
+    ASSERT_EQ(workers.threadsCount(), 4);
+
+    for (size_t run = 0; run < 100; run++)
+    {
+        std::vector<std::atomic<int>> calls(run % 7 + 1);
+        workers.run(calls.size(), [&calls](size_t index) { calls[index]++; });
+        for (auto const &count : calls)
+        {
+            EXPECT_EQ(count, 1);
+        }
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(WorkerPool_Run, ThrowingTask_RethrownAfterTheRest)
+{
+    WorkerPool workers(3);
+    std::atomic<int> finished = 0;
+
+    EXPECT_THROW(workers.run(16,
+                             [&finished](size_t index)
+                             {
+                                 if (index == 5)
+                                 {
+                                     throw std::runtime_error("Task failed.");
+                                 }
+                                 finished++;
+                             }),
+                 std::runtime_error);
+    EXPECT_EQ(finished, 15);
+
+    // The pool is still usable afterwards
+    workers.run(2, [&finished](size_t) { finished++; });
+    EXPECT_EQ(finished, 17);
+}
@@ -0,0 +1,191 @@
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <pf_gl/BlockCompressor.hpp>
+#include <pf_gl/Image.hpp>
+#include <pf_gl/Mesh.hpp>
+#include <pf_gl/MeshData.hpp>
+#include <pf_gl/MeshFile.hpp>
+#include <pf_gl/ModelImporter.hpp>
+#include <pf_gl/TextureFile.hpp>
+
+void printUsage()
+{
+    std::cerr << "Usage: Asset-Cooker <input model> <output " << pf::gl::MeshFile::EXTENSION
+              << " file> [--quantize] [--compress]\n"
+              << "       Asset-Cooker <input image> <output " << pf::gl::TextureFile::EXTENSION
+              << " file> [--format bc1|bc3|bc5|bc7] [--srgb] [--flip]" << std::endl;
+}
+
+/**
+ * Imports a model with assimp, optimizes its meshes, generates the levels of detail and writes all
+ * of it into a cooked mesh file, which is loaded at runtime without any processing.
+ */
+bool cookModel(std::filesystem::path const &inputPath,
+               std::filesystem::path const &outputPath,
+               std::vector<std::string> const &options)
+{
+    auto vertexCompression = pf::gl::Mesh::UNCOMPRESSED;
+    auto compression = pf::gl::MeshFile::NO_COMPRESSION;
+
+    for (auto const &option : options)
+    {
+        if (option == "--quantize")
+        {
+            vertexCompression = pf::gl::Mesh::QUANTIZED;
+        }
+        else if (option == "--compress")
+        {
+            compression = pf::gl::MeshFile::LZ4_COMPRESSION;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    pf::gl::ModelImporter importer(inputPath);
+    std::filesystem::path outputDirectory = std::filesystem::absolute(outputPath).parent_path();
+
+    std::vector<pf::gl::MeshData> meshes;
+    for (auto const &mesh : importer.meshes())
+    {
+        pf::gl::MeshData data = pf::gl::Mesh::prepare(
+            mesh.vertices, mesh.indices, mesh.levelsOfDetail, vertexCompression);
+
+        // Textures are looked up relative to the cooked file when it is loaded
+        for (auto textureReference : mesh.textures)
+        {
+            textureReference.path = std::filesystem::relative(
+                std::filesystem::absolute(textureReference.path), outputDirectory);
+            data.textures.push_back(std::move(textureReference));
+        }
+
+        std::cout << "Mesh #" << meshes.size() << ": " << mesh.vertices.size() << " vertices, "
+                  << mesh.indices.size() / 3 << " triangles, " << data.levelsOfDetail.size()
+                  << " levels of detail, " << data.vertices.size() + data.indices.size()
+                  << " bytes" << std::endl;
+        meshes.push_back(std::move(data));
+    }
+
+    pf::gl::MeshFile::write(outputPath, meshes, compression);
+    return true;
+}
+
+/**
+ * Compresses the image and each level of its mip chain, so that nothing but the upload is left to
+ * do at runtime.
+ */
+bool cookTexture(std::filesystem::path const &inputPath,
+                 std::filesystem::path const &outputPath,
+                 std::vector<std::string> const &options)
+{
+    auto format = pf::gl::BlockCompressor::BC7;
+    bool srgb = false;
+    bool flipVertically = false;
+
+    for (size_t i = 0; i < options.size(); i++)
+    {
+        if (options[i] == "--format" && i + 1 < options.size())
+        {
+            std::string const &formatName = options[++i];
+            if (formatName == "bc1")
+            {
+                format = pf::gl::BlockCompressor::BC1;
+            }
+            else if (formatName == "bc3")
+            {
+                format = pf::gl::BlockCompressor::BC3;
+            }
+            else if (formatName == "bc5")
+            {
+                format = pf::gl::BlockCompressor::BC5;
+            }
+            else if (formatName == "bc7")
+            {
+                format = pf::gl::BlockCompressor::BC7;
+            }
+            else
+            {
+                return false;
+            }
+        }
+        else if (options[i] == "--srgb")
+        {
+            srgb = true;
+        }
+        else if (options[i] == "--flip")
+        {
+            flipVertically = true;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    pf::gl::Image image(inputPath, flipVertically);
+    pf::gl::types::Size width = image.width();
+    pf::gl::types::Size height = image.height();
+    pf::gl::types::Size levelsCount = image.levelsCount();
+
+    std::vector<std::vector<std::byte>> levels;
+    for (pf::gl::types::Size level = 0; level < levelsCount; level++)
+    {
+        levels.push_back(pf::gl::BlockCompressor::compress(image, format));
+        std::cout << "Level #" << level << ": " << image.width() << "x" << image.height() << ", "
+                  << levels.back().size() << " bytes" << std::endl;
+        if (level + 1 < levelsCount)
+        {
+            image = image.downsample(srgb);
+        }
+    }
+
+    pf::gl::TextureFile::write(outputPath, format, srgb, width, height, levels);
+    return true;
+}
+
+int main(int argc, char const **argv)
+{
+    std::vector<std::string> arguments(argv + 1, argv + argc);
+    if (arguments.size() < 2)
+    {
+        printUsage();
+        return 1;
+    }
+
+    std::filesystem::path inputPath = arguments[0];
+    std::filesystem::path outputPath = arguments[1];
+    std::vector<std::string> options(arguments.begin() + 2, arguments.end());
+
+    try
+    {
+        auto startTime = std::chrono::high_resolution_clock::now();
+
+        bool cooked = outputPath.extension() == pf::gl::TextureFile::EXTENSION
+                          ? cookTexture(inputPath, outputPath, options)
+                          : cookModel(inputPath, outputPath, options);
+        if (!cooked)
+        {
+            printUsage();
+            return 1;
+        }
+
+        auto cookingTime = std::chrono::duration<float>(std::chrono::high_resolution_clock::now() -
+                                                        startTime);
+        std::cout << "Written " << outputPath.string() << " ("
+                  << std::filesystem::file_size(outputPath) << " bytes) in "
+                  << cookingTime.count() << " s" << std::endl;
+    }
+    catch (std::exception const &e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
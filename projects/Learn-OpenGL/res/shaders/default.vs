@@ -12,6 +12,9 @@ uniform mat4 u_model;
 uniform mat4 u_view;
 uniform mat4 u_projection;
 
+// The depth pre-pass compiles this shader on its own, the depth must match the main pass exactly
+invariant gl_Position;
+
 void main()
 {
     gl_Position = u_projection * u_view * u_model * vec4(a_position, 1.0);
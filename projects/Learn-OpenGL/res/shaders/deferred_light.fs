@@ -0,0 +1,85 @@
+#version 430
+
+// Lighting pass of the deferred renderer, draws one light at a time, see `DeferredRenderer`
+
+#define DIRECTIONAL_LIGHT 0
+#define POINT_LIGHT 1
+#define SPOT_LIGHT 2
+
+// Everything is in view space, unused members are left as they are
+struct Light
+{
+    vec3 position;
+    vec3 direction;
+    float cosCutOff;
+    float cosOuterCutOff;
+    vec3 ambient;
+    vec3 diffuse;
+    vec3 specular;
+    // constant, linear and quadratic factors
+    vec3 falloff;
+};
+
+out vec4 FragmentColor;
+
+uniform sampler2D u_normalDepth;
+uniform sampler2D u_albedoSpecular;
+uniform mat4 u_projection;
+
+uniform int u_lightType;
+uniform Light u_light;
+
+#include "normal_encoding.glsl"
+
+void main()
+{
+    ivec2 pixel = ivec2(gl_FragCoord.xy);
+    vec4 normalDepth = texelFetch(u_normalDepth, pixel, 0);
+    float depth = normalDepth.z;
+    if (depth <= 0.0)
+    {
+        // No geometry there
+        discard;
+    }
+    vec4 albedoSpecular = texelFetch(u_albedoSpecular, pixel, 0);
+    vec3 albedo = albedoSpecular.rgb;
+    float shininess = normalDepth.w;
+
+    // The view ray through the pixel, scaled to the stored depth
+    vec2 ndc = (gl_FragCoord.xy / vec2(textureSize(u_normalDepth, 0))) * 2.0 - 1.0;
+    vec3 position = vec3(ndc.x / u_projection[0][0], ndc.y / u_projection[1][1], -1.0) * depth;
+    vec3 normal = decodeNormal(normalDepth.xy);
+    vec3 directionToCamera = normalize(-position);
+
+    vec3 directionToLight = normalize(-u_light.direction);
+    float attenuation = 1.0;
+    float intensity = 1.0;
+    float specularPower = 1.0;
+    if (u_lightType != DIRECTIONAL_LIGHT)
+    {
+        directionToLight = normalize(u_light.position - position);
+        float distanceToLight = length(u_light.position - position);
+        attenuation = 1.0 / dot(u_light.falloff,
+                                vec3(1.0, distanceToLight, distanceToLight * distanceToLight));
+        specularPower = 3.0;
+    }
+    if (u_lightType == SPOT_LIGHT)
+    {
+        float dotLightDirection = dot(directionToLight, normalize(-u_light.direction));
+        intensity = clamp((dotLightDirection - u_light.cosOuterCutOff) /
+                              (u_light.cosCutOff - u_light.cosOuterCutOff),
+                          0.0,
+                          1.0);
+    }
+
+    vec3 reflectionDirection = reflect(-directionToLight, normal);
+    float diffuseStrength = max(dot(normal, directionToLight), 0.0);
+    float specularStrength = pow(diffuseStrength, specularPower) *
+                             pow(max(dot(directionToCamera, reflectionDirection), 0.0), shininess);
+
+    vec3 ambient = u_light.ambient * albedo;
+    vec3 diffuse = u_light.diffuse * diffuseStrength * albedo;
+    vec3 specular = u_light.specular * specularStrength * albedoSpecular.a;
+
+    FragmentColor = vec4(intensity * attenuation * (ambient + diffuse + specular), 1.0);
+}
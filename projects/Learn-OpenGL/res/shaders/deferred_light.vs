@@ -0,0 +1,16 @@
+#version 430
+
+layout(location = 0) in vec3 a_position;
+
+uniform mat4 u_model;
+uniform mat4 u_view;
+uniform mat4 u_projection;
+
+// The fullscreen quad of the directional light is already in clip space
+uniform bool u_fullscreen;
+
+void main()
+{
+    gl_Position = u_fullscreen ? vec4(a_position.xy, 0.0, 1.0)
+                               : u_projection * u_view * u_model * vec4(a_position, 1.0);
+}
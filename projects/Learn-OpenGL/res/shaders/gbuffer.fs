@@ -0,0 +1,21 @@
+#version 430
+
+// Geometry pass of the deferred renderer, see `GBuffer` for the layout of the attachments and
+// "material.glsl" for the textures
+
+in vec3 Normal;
+in vec3 FragmentPosition;
+in vec2 TextureCoordinates;
+
+layout(location = 0) out vec4 NormalDepth;
+layout(location = 1) out vec4 AlbedoSpecular;
+
+#include "material.glsl"
+#include "normal_encoding.glsl"
+
+void main()
+{
+    NormalDepth = vec4(encodeNormal(normalize(Normal)), -FragmentPosition.z, u_shininess);
+    AlbedoSpecular = vec4(diffuseColor(TextureCoordinates),
+                          texture(u_specularTexture[0], TextureCoordinates).r);
+}
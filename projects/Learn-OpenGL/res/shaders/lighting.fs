@@ -1,5 +1,8 @@
 #version 430
 
+// Compiled per set of lights by `ShaderLibrary`, DIRECTIONAL_LIGHT_ENABLED, POINT_LIGHTS_ENABLED
+// and SPOT_LIGHT_ENABLED decide which of them are applied, see "material.glsl" for the textures
+
 struct DirectionalLight
 {
     vec3 direction;
@@ -8,15 +11,15 @@ struct DirectionalLight
     vec3 specular;
 };
 
+// Lights are assigned to the clusters of the view frustum on the CPU, see `ClusteredLights`
 struct PointLight
 {
-    vec3 position;
-    vec3 ambient;
-    vec3 diffuse;
-    vec3 specular;
-    float constantFactor;
-    float linearFactor;
-    float quadraticFactor;
+    vec4 positionRadius;
+    vec4 ambient;
+    vec4 diffuse;
+    vec4 specular;
+    // constant, linear and quadratic factors
+    vec4 falloff;
 };
 
 struct SpotLight
@@ -39,21 +42,29 @@ in vec2 TextureCoordinates;
 
 out vec4 FragmentColor;
 
-#define MAX_POINT_LIGHTS_COUNT 16
-uniform PointLight u_pointLights[MAX_POINT_LIGHTS_COUNT];
-uniform int u_pointLightsCount;
+layout(std430, binding = 0) readonly buffer PointLights
+{
+    PointLight pointLights[];
+};
 
-uniform DirectionalLight u_directionalLight;
-uniform bool u_directionalLightEnabled;
+layout(std430, binding = 1) readonly buffer LightClusters
+{
+    uvec4 clustersCount;
+    // screen tiles per pixel in xy, depth slice scale and bias in zw
+    vec4 clusterScale;
+    // offset and count in the light indices
+    uvec2 clusters[];
+};
+
+layout(std430, binding = 2) readonly buffer LightIndices
+{
+    uint lightIndices[];
+};
 
+uniform DirectionalLight u_directionalLight;
 uniform SpotLight u_spotLight;
-uniform bool u_spotLightEnabled;
 
-#define MAX_DIFFUSE_TEXTURES_COUNT 1
-#define MAX_SPECULAR_TEXTURES_COUNT 1
-uniform sampler2D u_diffuseTexture[MAX_DIFFUSE_TEXTURES_COUNT];
-uniform sampler2D u_specularTexture[MAX_SPECULAR_TEXTURES_COUNT];
-uniform float u_shininess;
+#include "material.glsl"
 
 vec3 calculateDirectionalLight(DirectionalLight light, vec3 normal, vec3 directionToCamera);
 
@@ -69,27 +80,30 @@ vec3 calculateSpotLight(SpotLight light,
 
 float linearizeDepth(float depth, float near, float far);
 
+uvec2 clusterLights();
+
 void main()
 {
     vec3 normal = normalize(Normal);
     vec3 directionToCamera = normalize(-FragmentPosition);
     vec3 resultColor = vec3(0.0);
 
-    if (u_directionalLightEnabled)
-    {
-        resultColor += calculateDirectionalLight(u_directionalLight, normal, directionToCamera);
-    }
+#ifdef DIRECTIONAL_LIGHT_ENABLED
+    resultColor += calculateDirectionalLight(u_directionalLight, normal, directionToCamera);
+#endif
 
-    for (int i = 0; i < min(MAX_POINT_LIGHTS_COUNT, u_pointLightsCount); i++)
+#ifdef POINT_LIGHTS_ENABLED
+    uvec2 lights = clusterLights();
+    for (uint i = lights.x; i < lights.x + lights.y; i++)
     {
-        resultColor +=
-            calculatePointLight(u_pointLights[i], normal, FragmentPosition, directionToCamera);
+        resultColor += calculatePointLight(
+            pointLights[lightIndices[i]], normal, FragmentPosition, directionToCamera);
     }
+#endif
 
-    if (u_spotLightEnabled)
-    {
-        resultColor += calculateSpotLight(u_spotLight, normal, FragmentPosition, directionToCamera);
-    }
+#ifdef SPOT_LIGHT_ENABLED
+    resultColor += calculateSpotLight(u_spotLight, normal, FragmentPosition, directionToCamera);
+#endif
 
     FragmentColor = vec4(resultColor, 1.0);
 }
@@ -103,9 +117,8 @@ vec3 calculateDirectionalLight(DirectionalLight light, vec3 normal, vec3 directi
         pow(diffuseStrength, 1.0) *
         pow(max(dot(directionToCamera, reflectionDirection), 0.0), u_shininess);
 
-    vec3 ambient = light.ambient * vec3(texture(u_diffuseTexture[0], TextureCoordinates));
-    vec3 diffuse =
-        light.diffuse * diffuseStrength * vec3(texture(u_diffuseTexture[0], TextureCoordinates));
+    vec3 ambient = light.ambient * diffuseColor(TextureCoordinates);
+    vec3 diffuse = light.diffuse * diffuseStrength * diffuseColor(TextureCoordinates);
     vec3 specular =
         light.specular * specularStrength * vec3(texture(u_specularTexture[0], TextureCoordinates));
 
@@ -117,21 +130,21 @@ vec3 calculatePointLight(PointLight light,
                          vec3 fragmentPosition,
                          vec3 directionToCamera)
 {
-    vec3 directionToLight = normalize(light.position - fragmentPosition);
+    vec3 lightPosition = light.positionRadius.xyz;
+    vec3 directionToLight = normalize(lightPosition - fragmentPosition);
     vec3 reflectionDirection = reflect(-directionToLight, normal);
     float diffuseStrength = max(dot(normal, directionToLight), 0.0);
     float specularStrength =
         pow(diffuseStrength, 3.0) *
         pow(max(dot(directionToCamera, reflectionDirection), 0.0), u_shininess);
-    float distanceToLight = length(light.position - fragmentPosition);
-    float attenuation = 1.0 / (light.constantFactor + light.linearFactor * distanceToLight +
-                               light.quadraticFactor * distanceToLight * distanceToLight);
+    float distanceToLight = length(lightPosition - fragmentPosition);
+    float attenuation = 1.0 / dot(light.falloff.xyz,
+                                  vec3(1.0, distanceToLight, distanceToLight * distanceToLight));
 
-    vec3 ambient = light.ambient * vec3(texture(u_diffuseTexture[0], TextureCoordinates));
-    vec3 diffuse =
-        light.diffuse * diffuseStrength * vec3(texture(u_diffuseTexture[0], TextureCoordinates));
-    vec3 specular =
-        light.specular * specularStrength * vec3(texture(u_specularTexture[0], TextureCoordinates));
+    vec3 ambient = light.ambient.rgb * diffuseColor(TextureCoordinates);
+    vec3 diffuse = light.diffuse.rgb * diffuseStrength * diffuseColor(TextureCoordinates);
+    vec3 specular = light.specular.rgb * specularStrength *
+                    vec3(texture(u_specularTexture[0], TextureCoordinates));
 
     return attenuation * (ambient + diffuse + specular);
 }
@@ -154,9 +167,8 @@ vec3 calculateSpotLight(SpotLight light, vec3 normal, vec3 fragmentPosition, vec
               0.0,
               1.0);
 
-    vec3 ambient = light.ambient * vec3(texture(u_diffuseTexture[0], TextureCoordinates));
-    vec3 diffuse =
-        light.diffuse * diffuseStrength * vec3(texture(u_diffuseTexture[0], TextureCoordinates));
+    vec3 ambient = light.ambient * diffuseColor(TextureCoordinates);
+    vec3 diffuse = light.diffuse * diffuseStrength * diffuseColor(TextureCoordinates);
     vec3 specular =
         light.specular * specularStrength * vec3(texture(u_specularTexture[0], TextureCoordinates));
 
@@ -169,3 +181,12 @@ float linearizeDepth(float depth, float near, float far)
     float ndc = depth * 2.0 - 1.0;
     return (2.0 * near * far) / (far + near - ndc * (far - near));
 }
+
+uvec2 clusterLights()
+{
+    // Same slicing as in `LightClusterer::depthSlice`
+    float depthSlice = log(max(-FragmentPosition.z, 1e-6)) * clusterScale.z + clusterScale.w;
+    uvec3 cluster = uvec3(uvec2(gl_FragCoord.xy * clusterScale.xy), uint(max(depthSlice, 0.0)));
+    cluster = min(cluster, clustersCount.xyz - 1u);
+    return clusters[(cluster.z * clustersCount.y + cluster.y) * clustersCount.x + cluster.x];
+}
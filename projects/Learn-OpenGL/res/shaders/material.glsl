@@ -0,0 +1,30 @@
+// Textures and shininess set by `Mesh`, the counts can be defined by the application
+
+// With DIFFUSE_TEXTURE_ARRAY_ENABLED the diffuse color comes from the layer of the mesh in a
+// texture array, the texture coordinates are remapped into the layer at import
+
+#ifndef MAX_DIFFUSE_TEXTURES_COUNT
+#define MAX_DIFFUSE_TEXTURES_COUNT 1
+#endif
+
+#ifndef MAX_SPECULAR_TEXTURES_COUNT
+#define MAX_SPECULAR_TEXTURES_COUNT 1
+#endif
+
+#ifdef DIFFUSE_TEXTURE_ARRAY_ENABLED
+uniform sampler2DArray u_diffuseTextureArray;
+uniform int u_textureLayer;
+#else
+uniform sampler2D u_diffuseTexture[MAX_DIFFUSE_TEXTURES_COUNT];
+#endif
+uniform sampler2D u_specularTexture[MAX_SPECULAR_TEXTURES_COUNT];
+uniform float u_shininess;
+
+vec3 diffuseColor(vec2 textureCoordinates)
+{
+#ifdef DIFFUSE_TEXTURE_ARRAY_ENABLED
+    return texture(u_diffuseTextureArray, vec3(textureCoordinates, u_textureLayer)).rgb;
+#else
+    return texture(u_diffuseTexture[0], textureCoordinates).rgb;
+#endif
+}
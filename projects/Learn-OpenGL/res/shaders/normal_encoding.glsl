@@ -0,0 +1,24 @@
+// Octahedral mapping: the unit sphere is projected onto an octahedron, which is unfolded into a
+// square
+
+vec2 encodeNormal(vec3 normal)
+{
+    vec2 octahedron = normal.xy / (abs(normal.x) + abs(normal.y) + abs(normal.z));
+    if (normal.z >= 0.0)
+    {
+        return octahedron;
+    }
+    vec2 signs = vec2(octahedron.x >= 0.0 ? 1.0 : -1.0, octahedron.y >= 0.0 ? 1.0 : -1.0);
+    return (1.0 - abs(octahedron.yx)) * signs;
+}
+
+vec3 decodeNormal(vec2 octahedron)
+{
+    vec3 normal = vec3(octahedron, 1.0 - abs(octahedron.x) - abs(octahedron.y));
+    if (normal.z < 0.0)
+    {
+        vec2 signs = vec2(normal.x >= 0.0 ? 1.0 : -1.0, normal.y >= 0.0 ? 1.0 : -1.0);
+        normal.xy = (1.0 - abs(normal.yx)) * signs;
+    }
+    return normalize(normal);
+}
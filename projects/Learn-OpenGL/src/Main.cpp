@@ -1,11 +1,16 @@
 #include <array>
+#include <cstddef>
 #include <cmath>
 #include <iterator>
 #include <memory>
+#include <optional>
+#include <span>
 #include <string>
+#include <utility>
 #include <chrono>
 #include <iostream>
 #include <filesystem>
+#include <vector>
 
 #include <glad/glad.h>
 #include <glm/glm.hpp>
@@ -19,8 +24,13 @@
 #include <pf_gl/ElementBuffer.hpp>
 #include <pf_gl/VertexArray.hpp>
 #include <pf_gl/Shader.hpp>
+#include <pf_gl/ShaderBuilder.hpp>
+#include <pf_gl/ShaderCache.hpp>
+#include <pf_gl/ShaderLibrary.hpp>
 #include <pf_gl/MinecraftCamera.hpp>
 #include <pf_gl/Texture.hpp>
+#include <pf_gl/TextureLoader.hpp>
+#include <pf_gl/TextureStreamer.hpp>
 #include <pf_gl/EulerTransform3D.hpp>
 #include <pf_gl/Transform3D.hpp>
 #include <pf_gl/Mesh.hpp>
@@ -29,6 +39,13 @@
 #include <pf_gl/ValueTypes.hpp>
 #include <pf_gl/DrawingContext3D.hpp>
 #include <pf_gl/Material.hpp>
+#include <pf_gl/BoundingVolumes.hpp>
+#include <pf_gl/ClusteredLights.hpp>
+#include <pf_gl/DeferredRenderer.hpp>
+#include <pf_gl/DepthPrePass.hpp>
+#include <pf_gl/BoundingVolumeHierarchy.hpp>
+#include <pf_gl/FrustumCuller.hpp>
+#include <pf_gl/MeshOptimizer.hpp>
 
 pf::gl::types::Size const WINDOW_WIDTH = 1600;
 pf::gl::types::Size const WINDOW_HEIGHT = 900;
@@ -45,8 +62,30 @@ std::filesystem::path const DEFAULT_VERTEX_SHADER_PATH =
 std::filesystem::path const LIGHTING_FRAGMENT_SHADER_PATH =
     "projects/Learn-OpenGL/res/shaders/lighting.fs";
 
+std::filesystem::path const GBUFFER_FRAGMENT_SHADER_PATH =
+    "projects/Learn-OpenGL/res/shaders/gbuffer.fs";
+
+std::filesystem::path const DEFERRED_LIGHT_VERTEX_SHADER_PATH =
+    "projects/Learn-OpenGL/res/shaders/deferred_light.vs";
+
+std::filesystem::path const DEFERRED_LIGHT_FRAGMENT_SHADER_PATH =
+    "projects/Learn-OpenGL/res/shaders/deferred_light.fs";
+
+/**
+ * Linked programs are kept between the launches, the first launch after a change of the shaders or
+ * the driver compiles them.
+ */
+std::filesystem::path const SHADER_CACHE_PATH =
+    std::filesystem::temp_directory_path() / "Learn-OpenGL" / "shaders";
+
 std::filesystem::path const BARREL_MODEL_PATH = "projects/Learn-OpenGL/res/models/barrel.obj";
 
+/**
+ * Produced by the Asset-Cooker from the model above, loaded instead of it when present.
+ */
+std::filesystem::path const BARREL_COOKED_MODEL_PATH =
+    "projects/Learn-OpenGL/res/models/barrel.pfmesh";
+
 pf::gl::DrawingContext3D createDrawingContext(pf::gl::Window const &window)
 {
     pf::gl::DrawingContext3D drawingContext;
@@ -138,6 +177,51 @@ pf::gl::DrawingContext3D createDrawingContext(pf::gl::Window const &window)
     return drawingContext;
 }
 
+/**
+ * Bits of the permutations of the lighting shader. The geometry pass of the deferred path is built
+ * from the same list, it only checks the texture array.
+ */
+enum LightingFeature : pf::gl::ShaderLibrary::Features
+{
+    DIRECTIONAL_LIGHT_FEATURE = 1U << 0U,
+    POINT_LIGHTS_FEATURE = 1U << 1U,
+    SPOT_LIGHT_FEATURE = 1U << 2U,
+    DIFFUSE_TEXTURE_ARRAY_FEATURE = 1U << 3U,
+};
+
+std::vector<std::string> const LIGHTING_FEATURE_NAMES = {
+    "DIRECTIONAL_LIGHT_ENABLED",
+    "POINT_LIGHTS_ENABLED",
+    "SPOT_LIGHT_ENABLED",
+    "DIFFUSE_TEXTURE_ARRAY_ENABLED",
+};
+
+pf::gl::ShaderLibrary::Features lightingFeatures(pf::gl::DrawingContext3D const &drawingContext)
+{
+    pf::gl::ShaderLibrary::Features features = 0;
+    if (drawingContext.directionalLight.has_value())
+    {
+        features |= DIRECTIONAL_LIGHT_FEATURE;
+    }
+    if (drawingContext.pointLights.has_value() && !drawingContext.pointLights->empty())
+    {
+        features |= POINT_LIGHTS_FEATURE;
+    }
+    if (drawingContext.spotLight.has_value())
+    {
+        features |= SPOT_LIGHT_FEATURE;
+    }
+    return features;
+}
+
+void printOptimizationReport(char const *meshName, pf::gl::MeshOptimizer::Report const &report)
+{
+    std::cout << meshName << " mesh: " << report.verticesCountBefore << " -> "
+              << report.verticesCountAfter << " vertices, ACMR " << report.before.acmr << " -> "
+              << report.after.acmr << ", ATVR " << report.before.atvr << " -> "
+              << report.after.atvr << std::endl;
+}
+
 std::unique_ptr<pf::gl::Mesh> createCubeMesh(std::shared_ptr<pf::gl::Window> const &window)
 {
     std::array<GLfloat, 288> cubeRawVertices = {
@@ -241,6 +325,14 @@ std::unique_ptr<pf::gl::Mesh> createCubeMesh(std::shared_ptr<pf::gl::Window> con
         cubeIndices.push_back(i);
     }
 
+    // Every corner of the cube is listed once per triangle, welding leaves one per side
+    auto report = pf::gl::MeshOptimizer::optimize(std::as_writable_bytes(std::span(cubeVertices)),
+                                                  sizeof(pf::gl::Mesh::SimpleVertex),
+                                                  offsetof(pf::gl::Mesh::SimpleVertex, position),
+                                                  cubeIndices);
+    cubeVertices.resize(report.verticesCountAfter);
+    printOptimizationReport("Cube", report);
+
     auto mesh = std::make_unique<pf::gl::Mesh>(window,
                                                cubeVertices,
                                                cubeIndices,
@@ -309,22 +401,67 @@ int main(int /*argc*/, const char ** /*argv*/)
     window->enableCursor(false);
     glEnable(GL_DEPTH_TEST);
 
-    pf::gl::Shader colorShader(window, SIMPLE_VERTEX_SHADER_PATH, COLOR_FRAGMENT_SHADER_PATH);
-    pf::gl::Shader lightingShader(
-        window, DEFAULT_VERTEX_SHADER_PATH, LIGHTING_FRAGMENT_SHADER_PATH);
+    // Every program is issued up front, the driver compiles them while the models are loaded
+    auto shadersStartTime = std::chrono::high_resolution_clock::now();
+    auto shaderCache = std::make_shared<pf::gl::ShaderCache>(SHADER_CACHE_PATH);
+    pf::gl::ShaderBuilder shaderBuilder(window, shaderCache);
+
+    auto colorShaderHandle =
+        shaderBuilder.add(SIMPLE_VERTEX_SHADER_PATH, COLOR_FRAGMENT_SHADER_PATH);
+    auto deferredLightShaderHandle =
+        shaderBuilder.add(DEFERRED_LIGHT_VERTEX_SHADER_PATH, DEFERRED_LIGHT_FRAGMENT_SHADER_PATH);
+    auto depthOnlyShaderHandle = shaderBuilder.addDepthOnly(DEFAULT_VERTEX_SHADER_PATH);
 
     pf::gl::DrawingContext3D drawingContext = createDrawingContext(*window);
 
 
     // * Barrels *
 
+    // Textures are decoded in the background and show up once they are uploaded, the cooked ones
+    // are streamed in as the barrels get closer
+    auto textureLoader = std::make_shared<pf::gl::TextureLoader>(window);
+    auto textureStreamer = std::make_shared<pf::gl::TextureStreamer>(window);
+    std::filesystem::path barrelModelPath = std::filesystem::exists(BARREL_COOKED_MODEL_PATH)
+                                                ? BARREL_COOKED_MODEL_PATH
+                                                : BARREL_MODEL_PATH;
+
+    // The imported barrels take their diffuse texture from an array, which is bound once for all
+    // of them instead of on every draw, so they share the meshes of the first one
+    bool const diffuseTextureArrays = barrelModelPath == BARREL_MODEL_PATH;
+    pf::gl::ShaderLibrary::Features const barrelsTextureFeatures =
+        diffuseTextureArrays ? DIFFUSE_TEXTURE_ARRAY_FEATURE : 0;
+
     for (auto &barrel : barrels)
     {
         std::unique_ptr<pf::gl::Transform3D> transform =
             pf::gl::EulerTransform3D::Builder().withShift(barrel.position).build();
-        barrel.model = std::make_unique<pf::gl::Model>(
-            window, BARREL_MODEL_PATH, std::move(transform), pf::gl::Material{.shininess = 32.0F});
+        if (diffuseTextureArrays && &barrel != &barrels.front())
+        {
+            barrel.model = std::make_unique<pf::gl::Model>(window,
+                                                           barrels.front().model->meshes(),
+                                                           std::move(transform),
+                                                           pf::gl::Material{.shininess = 32.0F});
+        }
+        else
+        {
+            barrel.model = std::make_unique<pf::gl::Model>(window,
+                                                           barrelModelPath,
+                                                           std::move(transform),
+                                                           pf::gl::Material{.shininess = 32.0F},
+                                                           pf::gl::Mesh::QUANTIZED,
+                                                           textureLoader,
+                                                           textureStreamer,
+                                                           diffuseTextureArrays);
+        }
+        barrel.model->occlusionCulling(true);
     }
+    auto const &barrelsTextureArrays = barrels.front().model->textureArrays();
+    for (auto const &report : barrels.front().model->optimizationReports())
+    {
+        printOptimizationReport("Barrel", report);
+    }
+    std::cout << "Barrel GPU memory: " << barrels.front().model->sizeInBytes() << " bytes"
+              << std::endl;
 
 
     // * Point lights *
@@ -346,6 +483,80 @@ int main(int /*argc*/, const char ** /*argv*/)
         pointLightsModels.push_back(std::move(model));
     }
 
+    // * Shaders *
+
+    shaderBuilder.finish();
+    pf::gl::Shader colorShader = shaderBuilder.take(colorShaderHandle);
+
+    // Only the lights present in the scene are compiled into the lighting shader, F toggles the
+    // flashlight and switches to the other permutation
+    std::vector<pf::gl::ShaderDefinition> const texturesCounts = {
+        {.name = "MAX_DIFFUSE_TEXTURES_COUNT", .value = "1"},
+        {.name = "MAX_SPECULAR_TEXTURES_COUNT", .value = "1"},
+    };
+    pf::gl::ShaderLibrary lightingShaders(window,
+                                          DEFAULT_VERTEX_SHADER_PATH,
+                                          LIGHTING_FRAGMENT_SHADER_PATH,
+                                          LIGHTING_FEATURE_NAMES,
+                                          texturesCounts,
+                                          shaderCache);
+    lightingShaders.get(lightingFeatures(drawingContext) | barrelsTextureFeatures);
+    pf::gl::ShaderLibrary geometryShaders(window,
+                                          DEFAULT_VERTEX_SHADER_PATH,
+                                          GBUFFER_FRAGMENT_SHADER_PATH,
+                                          LIGHTING_FEATURE_NAMES,
+                                          texturesCounts,
+                                          shaderCache);
+    geometryShaders.get(barrelsTextureFeatures);
+    std::optional<pf::gl::SpotLight> hiddenFlashlight;
+    bool flashlightKeyPressed = false;
+
+    // A cold start compiles everything, a warm one only loads the binaries
+    auto const &cacheStatistics = shaderCache->statistics();
+    std::cout << "Shaders ready in "
+              << std::chrono::duration<float, std::milli>(
+                     std::chrono::high_resolution_clock::now() - shadersStartTime)
+                     .count()
+              << " ms" << (shaderBuilder.isParallel() ? " (compiled in parallel)" : "") << ": "
+              << cacheStatistics.hits << " from the cache, " << cacheStatistics.misses
+              << " compiled (" << cacheStatistics.rejected << " rejected by the driver)"
+              << std::endl;
+
+    // P toggles the depth pre-pass of the forward path, its cost is printed with the statistics (I)
+    pf::gl::DepthPrePass depthPrePass(window, shaderBuilder.take(depthOnlyShaderHandle));
+    bool depthPrePassKeyPressed = false;
+
+    // Fragments only go through the lights of their own cluster of the frustum
+    pf::gl::ClusteredLights clusteredLights(window);
+
+    // Tab switches to the deferred shading, the light cubes are drawn forward on top of it anyway
+    pf::gl::DeferredRenderer deferredRenderer(window,
+                                              shaderBuilder.take(deferredLightShaderHandle));
+    bool renderingPathKeyPressed = false;
+
+
+    // * Culling *
+
+    pf::gl::FrustumCuller frustumCuller;
+    std::vector<pf::gl::BoundingBox> barrelsBounds(barrels.size());
+    std::vector<pf::gl::types::UInt> visibleBarrels;
+    visibleBarrels.reserve(barrels.size());
+
+    // The texture levels of the visible barrels are picked by their size on the screen
+    std::vector<pf::gl::types::Float> barrelsScreenSizes;
+    barrelsScreenSizes.reserve(barrels.size());
+
+    // I prints the statistics of the current frame, nothing is printed from the loop otherwise
+    bool statisticsKeyPressed = false;
+
+    // Only used for picking here, there are too few barrels for the hierarchical culling to pay off
+    pf::gl::BoundingVolumeHierarchy barrelsTree;
+    std::vector<pf::gl::types::UInt> barrelsProxies;
+    for (pf::gl::types::UInt i = 0; i < barrels.size(); i++)
+    {
+        barrelsProxies.push_back(barrelsTree.insert(barrels.at(i).model->worldBoundingBox(), i));
+    }
+
 
     // * Main loop *
 
@@ -364,6 +575,29 @@ int main(int /*argc*/, const char ** /*argv*/)
         lastUpdateTime = currentTime;
 
         api->pollEvents();
+        textureLoader->update();
+        textureStreamer->update();
+
+        if (window->isKeyPressed(GLFW_KEY_TAB) && !renderingPathKeyPressed)
+        {
+            drawingContext.renderingPath =
+                drawingContext.renderingPath == pf::gl::DrawingContext3D::FORWARD
+                    ? pf::gl::DrawingContext3D::DEFERRED
+                    : pf::gl::DrawingContext3D::FORWARD;
+        }
+        renderingPathKeyPressed = window->isKeyPressed(GLFW_KEY_TAB);
+
+        if (window->isKeyPressed(GLFW_KEY_P) && !depthPrePassKeyPressed)
+        {
+            depthPrePass.enabled(!depthPrePass.enabled());
+        }
+        depthPrePassKeyPressed = window->isKeyPressed(GLFW_KEY_P);
+
+        if (window->isKeyPressed(GLFW_KEY_F) && !flashlightKeyPressed)
+        {
+            std::swap(drawingContext.spotLight, hiddenFlashlight);
+        }
+        flashlightKeyPressed = window->isKeyPressed(GLFW_KEY_F);
 
         glm::vec3 inputVector =
             glm::vec3(static_cast<int>(window->isKeyPressed(GLFW_KEY_W)) -
@@ -385,6 +619,12 @@ int main(int /*argc*/, const char ** /*argv*/)
         drawingContext.camera->aspectRatio(
             gsl::narrow_cast<pf::gl::types::Float>(window->width()) /
             gsl::narrow_cast<pf::gl::types::Float>(window->height()));
+        drawingContext.viewportSize =
+            pf::gl::types::FVec2(gsl::narrow_cast<pf::gl::types::Float>(window->width()),
+                                 gsl::narrow_cast<pf::gl::types::Float>(window->height()));
+        clusteredLights.update(drawingContext.camera.value(),
+                               drawingContext.viewportSize.value(),
+                               drawingContext.pointLights.value());
 
 
         // * Draw *
@@ -394,9 +634,7 @@ int main(int /*argc*/, const char ** /*argv*/)
 
         // barrels
 
-        lightingShader.use();
-
-        for (auto const &barrel : barrels)
+        for (auto &barrel : barrels)
         {
             auto scale = pf::gl::EulerTransform3D::Builder()
                              .withScale(glm::vec3(1.0F + 0.0035F * std::sin(secondsSinceStart)))
@@ -413,8 +651,108 @@ int main(int /*argc*/, const char ** /*argv*/)
             deltaTransform = deltaTransform->combine(
                 *translateBack->combine(*rotate->combine(*scale->combine(*translate))));
             barrel.model->transform(std::move(barrel.model->transform().combine(*deltaTransform)));
+        }
 
-            barrel.model->render(lightingShader, drawingContext);
+        for (size_t i = 0; i < barrels.size(); i++)
+        {
+            barrelsBounds[i] = barrels.at(i).model->worldBoundingBox();
+            barrelsTree.move(barrelsProxies[i], barrelsBounds[i]);
+        }
+        frustumCuller.resetStatistics();
+        frustumCuller.cull(drawingContext.camera->frustum(), barrelsBounds, visibleBarrels);
+        frustumCuller.screenSizes(drawingContext.camera->position(),
+                                  drawingContext.camera->projectionMatrix()[1][1] *
+                                      drawingContext.viewportSize->y,
+                                  visibleBarrels,
+                                  barrelsScreenSizes);
+        for (size_t i = 0; i < visibleBarrels.size(); i++)
+        {
+            barrels.at(visibleBarrels[i]).model->requestTextureLevels(barrelsScreenSizes[i]);
+        }
+
+        bool const deferred = drawingContext.renderingPath == pf::gl::DrawingContext3D::DEFERRED;
+        pf::gl::Shader &barrelsShader =
+            deferred
+                ? geometryShaders.get(barrelsTextureFeatures)
+                : lightingShaders.get(lightingFeatures(drawingContext) | barrelsTextureFeatures);
+        if (deferred)
+        {
+            deferredRenderer.beginGeometryPass();
+            barrelsShader.use();
+        }
+        else
+        {
+            depthPrePass.beginDepthPass();
+            if (depthPrePass.enabled())
+            {
+                for (auto barrelIndex : visibleBarrels)
+                {
+                    barrels.at(barrelIndex)
+                        .model->renderPositions(depthPrePass.shader(), drawingContext);
+                }
+            }
+            depthPrePass.beginMainPass();
+
+            barrelsShader.use();
+            clusteredLights.bind();
+        }
+
+        for (auto const &textureArray : barrelsTextureArrays)
+        {
+            textureArray->bind();
+        }
+
+        pf::gl::types::Size barrelsTrianglesCount = 0;
+        auto barrelsTextureBinds =
+            gsl::narrow_cast<pf::gl::types::Size>(barrelsTextureArrays.size());
+        for (auto barrelIndex : visibleBarrels)
+        {
+            barrels.at(barrelIndex).model->render(barrelsShader, drawingContext);
+            barrelsTrianglesCount += barrels.at(barrelIndex).model->trianglesCount();
+            for (auto const &mesh : barrels.at(barrelIndex).model->meshes())
+            {
+                barrelsTextureBinds += mesh->texturesCount();
+            }
+        }
+
+        if (deferred)
+        {
+            deferredRenderer.endGeometryPass(drawingContext);
+        }
+        else
+        {
+            depthPrePass.endMainPass();
+        }
+
+        bool const printStatistics = window->isKeyPressed(GLFW_KEY_I) && !statisticsKeyPressed;
+        statisticsKeyPressed = window->isKeyPressed(GLFW_KEY_I);
+        if (printStatistics)
+        {
+            auto const &statistics = frustumCuller.statistics();
+            std::cout << "Frustum culling: " << statistics.visibleCount << " drawn, "
+                      << statistics.culledCount << " culled, " << barrelsTrianglesCount
+                      << " triangles" << std::endl;
+            std::cout << "Barrels texture binds: " << barrelsTextureBinds << " ("
+                      << barrelsTextureArrays.size() << " texture arrays)" << std::endl;
+            if (!deferred)
+            {
+                std::cout << "Depth pre-pass " << (depthPrePass.enabled() ? "on" : "off")
+                          << ": depth " << depthPrePass.depthPassMilliseconds() << " ms, main "
+                          << depthPrePass.mainPassMilliseconds() << " ms" << std::endl;
+            }
+            for (auto const &texture : textureStreamer->statistics())
+            {
+                std::cout << "Texture " << texture.path.filename().string() << ": levels from #"
+                          << texture.baseLevel << " of " << texture.levelsCount << ", "
+                          << texture.residentBytes << " bytes" << std::endl;
+            }
+
+            auto pickedBarrel = barrelsTree.raycast(drawingContext.camera->ray());
+            if (pickedBarrel.has_value())
+            {
+                std::cout << "Looking at the barrel #" << pickedBarrel->userData << " ("
+                          << pickedBarrel->distance << " units away)" << std::endl;
+            }
         }
 
         // point lights
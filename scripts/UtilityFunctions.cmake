@@ -45,6 +45,23 @@ function(setup_tests target_name)
         DEPENDS ${target_name})
 endfunction()
 
+# Builds every source inside the "benchmark" directory as a standalone executable linked against the
+# given target
+function(setup_benchmarks target_name)
+    if(NOT BUILD_BENCHMARKS)
+        return()
+    endif()
+
+    file(GLOB benchmark_sources ${CMAKE_CURRENT_SOURCE_DIR}/benchmark/*.cpp)
+
+    foreach(benchmark_path IN LISTS benchmark_sources)
+        get_filename_component(benchmark_name ${benchmark_path} NAME_WE)
+
+        add_executable(${benchmark_name} ${benchmark_path})
+        target_link_libraries(${benchmark_name} PRIVATE ${target_name})
+    endforeach()
+endfunction()
+
 # Sets up a generic executable project. Any private dependencies to be linked are passed by
 # ${ARGV1}. Public dependencies are passed by ${ARGV2}.
 function(setup_project project_name)
@@ -58,6 +75,7 @@ function(setup_project project_name)
     target_link_libraries(${project_name} PUBLIC ${public_dependencies})
 
     setup_tests(${project_name})
+    setup_benchmarks(${project_name})
 endfunction()
 
 # Sets up a generic library. Any private dependencies to be linked are passed by ${ARGV1}. Public
@@ -76,6 +94,7 @@ function(setup_library library_name)
     target_link_libraries(${library_name} PUBLIC ${public_dependencies})
 
     setup_tests(${library_name})
+    setup_benchmarks(${library_name})
 endfunction()
 
 function(setup_generic_opengl_project project_name)